@@ -0,0 +1,12 @@
+namespace Dc
+{
+    public class Prefab
+    {
+        public Prefab(string name)
+        {
+            Name = name;
+        }
+
+        public string Name { get; private set; }
+    }
+}
@@ -7,9 +7,24 @@ namespace Dc
         public static Entity CreateEntity(string name = "New entity") => new Entity(CreateEntity_Native(name));
         public static void RemoveEntity(Entity entity) => RemoveEntity_Native(entity.Id);
 
+        public static Entity[] Instantiate(Prefab prefab, int count, Matrix4[] transforms)
+        {
+            ulong[] ids = new ulong[count];
+            int instantiatedCount = Instantiate_Native(prefab.Name, count, transforms, ids);
+
+            Entity[] entities = new Entity[instantiatedCount];
+            for (int i = 0; i < instantiatedCount; ++i)
+            {
+                entities[i] = new Entity(ids[i]);
+            }
+            return entities;
+        }
+
         [MethodImpl(MethodImplOptions.InternalCall)]
         private static extern ulong CreateEntity_Native(string name);
         [MethodImpl(MethodImplOptions.InternalCall)]
         private static extern void RemoveEntity_Native(ulong entityId);
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern int Instantiate_Native(string prefabName, int count, Matrix4[] transforms, ulong[] entityIds);
     }
 }
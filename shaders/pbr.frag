@@ -435,8 +435,10 @@ void calc_normal()
     if (normal_tex_enabled)
     {
         mat3 TBN = mat3(fs_in.tangent, fs_in.bitangent, fs_in.normal);
-        vec3 normal = texture(normal_tex, fs_in.tex_coord).rgb;
-        normal = normal * 2.0 - 1.0;
+        // normal maps may only store x and y (BC5), so reconstruct z
+        vec3 normal;
+        normal.xy = texture(normal_tex, fs_in.tex_coord).rg * 2.0 - 1.0;
+        normal.z = sqrt(max(1.0 - dot(normal.xy, normal.xy), 0.0));
         normal = normalize(TBN * normal);
         pbr_params.normal = normal;
     }
@@ -30,12 +30,32 @@ uniform mat4 projection_matrix;
 uniform mat4 view_matrix;
 
 uniform mat4 model_matrix;
+// normal and tangent are octahedral encoded, the bitangent is only a sign
+uniform bool packed_vertices;
 #ifdef SKINNED
 uniform mat4 bones[MAX_BONES];
 #endif // SKINNED
 
+vec3 decode_octahedral(vec2 value)
+{
+  vec3 result = vec3(value, 1.0 - abs(value.x) - abs(value.y));
+  float t = max(-result.z, 0.0);
+  result.xy += vec2(result.x >= 0.0 ? -t : t, result.y >= 0.0 ? -t : t);
+  return normalize(result);
+}
+
 void main()
 {
+  vec3 in_normal_decoded = in_normal;
+  vec3 in_tangent_decoded = in_tangent;
+  float handedness = 1.0;
+  if (packed_vertices)
+  {
+    in_normal_decoded = decode_octahedral(in_normal.xy);
+    in_tangent_decoded = decode_octahedral(in_tangent.xy);
+    handedness = in_bitangent.x < 0.0 ? -1.0 : 1.0;
+  }
+
   #ifdef SKINNED
   mat4 bone_transform = bones[in_skin_bones.x] * in_skin_weights.x;
   bone_transform += bones[in_skin_bones.y] * in_skin_weights.y;
@@ -43,13 +63,13 @@ void main()
   bone_transform += bones[in_skin_bones.w] * in_skin_weights.w;
 
   vec4 position = bone_transform * vec4(in_position, 1.0);
-  vec3 normal = vec3(bone_transform * vec4(in_normal, 0.0));
-  vec3 tangent = vec3(bone_transform * vec4(in_tangent, 0.0));
+  vec3 normal = vec3(bone_transform * vec4(in_normal_decoded, 0.0));
+  vec3 tangent = vec3(bone_transform * vec4(in_tangent_decoded, 0.0));
   vec3 bitangent = vec3(bone_transform * vec4(in_bitangent, 0.0));
   #else // SKINNED
   vec4 position = vec4(in_position, 1.0);
-  vec3 normal = in_normal;
-  vec3 tangent = in_tangent;
+  vec3 normal = in_normal_decoded;
+  vec3 tangent = in_tangent_decoded;
   vec3 bitangent = in_bitangent;
   #endif // SKINNED
 
@@ -60,7 +80,7 @@ void main()
   vec3 T = normalize(transpose(inverse(mat3(view_model_matrix))) * tangent);
   vec3 B = normalize(transpose(inverse(mat3(view_model_matrix))) * bitangent);
   T = normalize(T - dot(T, N) * N);
-  B = cross(N, T);
+  B = cross(N, T) * handedness;
 
   vs_out.position = P.xyz;
   vs_out.position_world_space = vec3(model_matrix * position);
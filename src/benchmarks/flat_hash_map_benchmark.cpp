@@ -0,0 +1,233 @@
+#include "flat_hash_map.hpp"
+#include "uuid.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+
+constexpr std::size_t lookups_count{100000};
+
+std::vector<dc::Uuid> make_uuids(std::size_t count, std::uint64_t seed)
+{
+  std::mt19937_64       random{seed};
+  std::vector<dc::Uuid> uuids(count);
+  for (auto &uuid : uuids)
+  {
+    uuid = random();
+  }
+  return uuids;
+}
+
+/// Looks like the asset ids of a project, which share long prefixes
+std::vector<std::string> make_asset_ids(std::size_t count)
+{
+  std::vector<std::string> ids;
+  for (std::size_t i{0}; i < count; ++i)
+  {
+    ids.push_back("meshes/environment/props/prop_" + std::to_string(i) +
+                  ".dcmesh");
+  }
+  return ids;
+}
+
+/// Random order of lookups into the keys, so the lookups miss the caches
+template <typename T>
+std::vector<T> make_lookups(const std::vector<T> &keys)
+{
+  std::mt19937                               random{7};
+  std::uniform_int_distribution<std::size_t> distribution{0, keys.size() - 1};
+
+  std::vector<T> lookups(lookups_count);
+  for (auto &lookup : lookups)
+  {
+    lookup = keys[distribution(random)];
+  }
+  return lookups;
+}
+
+template <typename TMap, typename TKey>
+std::size_t sum_found(const TMap &map, const std::vector<TKey> &lookups)
+{
+  std::size_t sum{0};
+  for (const auto &key : lookups)
+  {
+    const auto iter = map.find(key);
+    if (iter != map.end())
+    {
+      sum += static_cast<std::size_t>(iter->second);
+    }
+  }
+  return sum;
+}
+
+} // namespace
+
+TEST_CASE("FlatHashMap with uuid keys", "[flat_hash_map]")
+{
+  // Scene::uuid_to_entity_map_ and the PhysicScene actors
+  const auto entities_count = GENERATE(std::size_t{1000}, std::size_t{100000});
+  const auto uuids          = make_uuids(entities_count, 1);
+  const auto hit_lookups    = make_lookups(uuids);
+  const auto miss_lookups   = make_uuids(lookups_count, 2);
+
+  std::unordered_map<dc::Uuid, std::uint32_t> unordered_map;
+  dc::FlatHashMap<dc::Uuid, std::uint32_t>    flat_hash_map;
+  for (std::size_t i{0}; i < uuids.size(); ++i)
+  {
+    unordered_map.emplace(uuids[i], static_cast<std::uint32_t>(i));
+    flat_hash_map.emplace(uuids[i], static_cast<std::uint32_t>(i));
+  }
+  REQUIRE(sum_found(flat_hash_map, hit_lookups) ==
+          sum_found(unordered_map, hit_lookups));
+
+  const auto suffix = ", " + std::to_string(entities_count) + " entries";
+
+  BENCHMARK("std::unordered_map insert" + suffix)
+  {
+    std::unordered_map<dc::Uuid, std::uint32_t> map;
+    for (std::size_t i{0}; i < uuids.size(); ++i)
+    {
+      map.emplace(uuids[i], static_cast<std::uint32_t>(i));
+    }
+    return map.size();
+  };
+
+  BENCHMARK("FlatHashMap insert" + suffix)
+  {
+    dc::FlatHashMap<dc::Uuid, std::uint32_t> map;
+    for (std::size_t i{0}; i < uuids.size(); ++i)
+    {
+      map.emplace(uuids[i], static_cast<std::uint32_t>(i));
+    }
+    return map.size();
+  };
+
+  BENCHMARK("std::unordered_map 100k hits" + suffix)
+  {
+    return sum_found(unordered_map, hit_lookups);
+  };
+
+  BENCHMARK("FlatHashMap 100k hits" + suffix)
+  {
+    return sum_found(flat_hash_map, hit_lookups);
+  };
+
+  BENCHMARK("std::unordered_map 100k misses" + suffix)
+  {
+    return sum_found(unordered_map, miss_lookups);
+  };
+
+  BENCHMARK("FlatHashMap 100k misses" + suffix)
+  {
+    return sum_found(flat_hash_map, miss_lookups);
+  };
+}
+
+TEST_CASE("FlatHashMap with asset id keys", "[flat_hash_map]")
+{
+  // the AssetCache maps get searched with the id of the requested asset
+  const auto ids     = make_asset_ids(5000);
+  const auto lookups = make_lookups(ids);
+
+  std::unordered_map<std::string, std::uint32_t> unordered_map;
+  dc::FlatHashMap<std::string, std::uint32_t>    flat_hash_map;
+  for (std::size_t i{0}; i < ids.size(); ++i)
+  {
+    unordered_map.emplace(ids[i], static_cast<std::uint32_t>(i));
+    flat_hash_map.emplace(ids[i], static_cast<std::uint32_t>(i));
+  }
+  REQUIRE(sum_found(flat_hash_map, lookups) ==
+          sum_found(unordered_map, lookups));
+
+  BENCHMARK("std::unordered_map 100k hits, 5000 asset ids")
+  {
+    return sum_found(unordered_map, lookups);
+  };
+
+  BENCHMARK("FlatHashMap 100k hits, 5000 asset ids")
+  {
+    return sum_found(flat_hash_map, lookups);
+  };
+}
+
+TEST_CASE("FlatHashMap with uniform name keys", "[flat_hash_map]")
+{
+  // GlShader::uniforms_ gets searched with literals. Before, they got turned
+  // into a std::string for every call
+  const std::vector<std::string_view> names{"model_matrix",
+                                            "view_matrix",
+                                            "projection_matrix",
+                                            "camera_position",
+                                            "albedo_texture",
+                                            "normal_texture",
+                                            "roughness_texture",
+                                            "ambient_occlusion_texture",
+                                            "emissive_texture",
+                                            "albedo_color",
+                                            "emissive_color",
+                                            "metallic_factor",
+                                            "transparency_factor",
+                                            "alpha_test",
+                                            "bone_transforms",
+                                            "light_space_matrix"};
+  const auto lookups = make_lookups(names);
+
+  std::unordered_map<std::string, std::uint32_t> unordered_map;
+  dc::FlatHashMap<std::string, std::uint32_t>    flat_hash_map;
+  for (std::size_t i{0}; i < names.size(); ++i)
+  {
+    unordered_map.emplace(std::string{names[i]},
+                          static_cast<std::uint32_t>(i));
+    flat_hash_map.emplace(std::string{names[i]},
+                          static_cast<std::uint32_t>(i));
+  }
+
+  BENCHMARK("std::unordered_map 100k uniform lookups through std::string")
+  {
+    std::size_t sum{0};
+    for (const auto name : lookups)
+    {
+      const auto iter = unordered_map.find(std::string{name});
+      if (iter != unordered_map.end())
+      {
+        sum += iter->second;
+      }
+    }
+    return sum;
+  };
+
+  BENCHMARK("FlatHashMap 100k uniform lookups through std::string_view")
+  {
+    return sum_found(flat_hash_map, lookups);
+  };
+
+  // a caller that sets the same uniform repeatedly hashes its name once
+  std::vector<std::size_t> hashes;
+  for (const auto name : lookups)
+  {
+    hashes.push_back(flat_hash_map.hash_key(name));
+  }
+
+  BENCHMARK("FlatHashMap 100k uniform lookups with precomputed hashes")
+  {
+    std::size_t sum{0};
+    for (std::size_t i{0}; i < lookups.size(); ++i)
+    {
+      const auto iter = flat_hash_map.find(lookups[i], hashes[i]);
+      if (iter != flat_hash_map.end())
+      {
+        sum += iter->second;
+      }
+    }
+    return sum;
+  };
+}
@@ -0,0 +1,84 @@
+#include "job_system.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+/// 1, 2, 4, ... up to the number of hardware threads
+std::vector<std::size_t> workers_counts()
+{
+  const auto hardware_threads =
+      std::max(static_cast<std::size_t>(std::thread::hardware_concurrency()),
+               std::size_t{1});
+
+  std::vector<std::size_t> counts;
+  for (std::size_t count{1}; count < hardware_threads; count *= 2)
+  {
+    counts.push_back(count);
+  }
+  counts.push_back(hardware_threads);
+  return counts;
+}
+
+} // namespace
+
+TEST_CASE("JobSystem parallel_for scaling", "[job_system]")
+{
+  // enough work per element that the scheduling overhead does not dominate
+  std::vector<float> values(1 << 20);
+  for (std::size_t i{0}; i < values.size(); ++i)
+  {
+    values[i] = static_cast<float>(i);
+  }
+
+  for (const auto workers_count : workers_counts())
+  {
+    dc::JobSystem job_system{workers_count, "Benchmark"};
+
+    BENCHMARK("parallel_for 1M elements, " + std::to_string(workers_count) +
+              " workers")
+    {
+      job_system.parallel_for(0,
+                              values.size(),
+                              4096,
+                              [&](std::size_t first, std::size_t last)
+                              {
+                                for (auto i{first}; i < last; ++i)
+                                {
+                                  values[i] = std::sqrt(values[i] * 1.0001f +
+                                                        std::sin(values[i]));
+                                }
+                              });
+      return values[values.size() / 2];
+    };
+  }
+}
+
+TEST_CASE("JobSystem small jobs scaling", "[job_system]")
+{
+  for (const auto workers_count : workers_counts())
+  {
+    dc::JobSystem job_system{workers_count, "Benchmark"};
+
+    BENCHMARK("10k empty jobs, " + std::to_string(workers_count) + " workers")
+    {
+      std::atomic<std::size_t> run_count{0};
+      dc::JobCounter           counter;
+      for (std::size_t i{0}; i < 10000; ++i)
+      {
+        job_system.submit([&run_count]() { ++run_count; }, &counter);
+      }
+      job_system.wait(counter);
+      return run_count.load();
+    };
+  }
+}
@@ -0,0 +1,98 @@
+#include "math.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+constexpr std::size_t transforms_count{10000};
+
+struct Transform
+{
+  glm::vec3 position_{0.0f};
+  glm::quat rotation_{1.0f, 0.0f, 0.0f, 0.0f};
+  glm::vec3 scale_{1.0f};
+};
+
+std::vector<Transform> make_transforms(std::size_t count)
+{
+  std::mt19937                          random{42};
+  std::uniform_real_distribution<float> distribution{-10.0f, 10.0f};
+
+  std::vector<Transform> transforms(count);
+  for (auto &transform : transforms)
+  {
+    transform.position_ = {distribution(random),
+                           distribution(random),
+                           distribution(random)};
+    transform.rotation_ = glm::normalize(glm::quat{distribution(random),
+                                                   distribution(random),
+                                                   distribution(random),
+                                                   distribution(random)});
+  }
+  return transforms;
+}
+
+/// Composed like TransformComponent does it
+glm::mat4 glm_transform_matrix(const Transform &transform)
+{
+  glm::mat4 transform_matrix{1.0f};
+  transform_matrix = glm::translate(transform_matrix, transform.position_);
+  transform_matrix *= glm::toMat4(transform.rotation_);
+  transform_matrix = glm::scale(transform_matrix, transform.scale_);
+  return transform_matrix;
+}
+
+} // namespace
+
+TEST_CASE("Composing transform matrices", "[math]")
+{
+  const auto                   transforms = make_transforms(transforms_count);
+  dc::AlignedVector<glm::mat4> matrices(transforms.size());
+  dc::math::TrsBuffer          trs_buffer;
+  trs_buffer.resize(transforms.size());
+  for (std::size_t i{0}; i < transforms.size(); ++i)
+  {
+    trs_buffer.set(i,
+                   transforms[i].position_,
+                   transforms[i].rotation_,
+                   transforms[i].scale_);
+  }
+
+  BENCHMARK("glm, 10k transforms")
+  {
+    for (std::size_t i{0}; i < transforms.size(); ++i)
+    {
+      matrices[i] = glm_transform_matrix(transforms[i]);
+    }
+    return matrices[transforms.size() / 2][3][0];
+  };
+
+  BENCHMARK("compose_transform_matrices, 10k transforms")
+  {
+    dc::math::compose_transform_matrices(trs_buffer.arrays(0),
+                                         transforms.size(),
+                                         matrices.data());
+    return matrices[transforms.size() / 2][3][0];
+  };
+
+  BENCHMARK("gather and compose_transform_matrices, 10k transforms")
+  {
+    // what the TransformSystem does for changed entities
+    for (std::size_t i{0}; i < transforms.size(); ++i)
+    {
+      trs_buffer.set(i,
+                     transforms[i].position_,
+                     transforms[i].rotation_,
+                     transforms[i].scale_);
+    }
+    dc::math::compose_transform_matrices(trs_buffer.arrays(0),
+                                         transforms.size(),
+                                         matrices.data());
+    return matrices[transforms.size() / 2][3][0];
+  };
+}
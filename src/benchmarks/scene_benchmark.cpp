@@ -0,0 +1,187 @@
+#include "asset_description.hpp"
+#include "binary_writer.hpp"
+#include "entity.hpp"
+#include "guid_component.hpp"
+#include "name_component.hpp"
+#include "point_light_component.hpp"
+#include "relationship_component.hpp"
+#include "scene.hpp"
+#include "transform_component.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace
+{
+
+constexpr std::size_t roots_count{10000};
+constexpr std::size_t children_count{9};
+
+/// Roots with one level of children, every tenth entity is a point light
+std::shared_ptr<dc::Scene> make_scene()
+{
+  auto scene = dc::Scene::create();
+  for (std::size_t i{0}; i < roots_count; ++i)
+  {
+    auto root = scene->create_entity("Root " + std::to_string(i));
+    root.set_position(glm::vec3{static_cast<float>(i), 0.0f, 0.0f});
+    root.add_component<dc::PointLightComponent>();
+    for (std::size_t j{0}; j < children_count; ++j)
+    {
+      auto child = scene->create_entity("Child " + std::to_string(j));
+      child.set_position(glm::vec3{0.0f, static_cast<float>(j), 0.0f});
+      root.add_child(child);
+    }
+  }
+  return scene;
+}
+
+/**
+ * The tagged format the scenes got saved in before the columns, kept here as
+ * baseline. Version 0 scenes are still read by Scene::read().
+ */
+void legacy_save(dc::Scene &scene, const std::filesystem::path &file_path)
+{
+  dc::BinaryWriter writer;
+
+  dc::AssetDescription asset_description{};
+  asset_description.version_ = 0;
+  asset_description.write(writer);
+
+  const auto &view = scene.all_entities_with<dc::GuidComponent>();
+  dc::write_value(writer, static_cast<std::uint64_t>(view.size()));
+  for (const auto &e : view)
+  {
+    dc::Entity entity{e, scene.shared_from_this()};
+    entity.component<dc::GuidComponent>().save(writer);
+    entity.component<dc::NameComponent>().save(writer);
+    entity.component<dc::TransformComponent>().save(writer);
+    entity.component<dc::RelationshipComponent>().save(writer);
+
+    if (entity.has_component<dc::PointLightComponent>())
+    {
+      dc::write_string(writer, "*pointlight*");
+      entity.component<dc::PointLightComponent>().save(writer);
+    }
+    dc::write_string(writer, "*end*");
+  }
+
+  writer.save(file_path);
+}
+
+/** Directory for the benchmark files, removed with everything in it */
+class TemporaryDirectory
+{
+public:
+  TemporaryDirectory()
+  {
+    path_ = std::filesystem::temp_directory_path() /
+            ("discite_scene_benchmark_" +
+             std::to_string(std::random_device{}()));
+    std::filesystem::create_directories(path_);
+  }
+
+  ~TemporaryDirectory()
+  {
+    std::error_code error_code{};
+    std::filesystem::remove_all(path_, error_code);
+  }
+
+  const std::filesystem::path &path() const { return path_; }
+
+private:
+  std::filesystem::path path_;
+};
+
+/// Reads the file into a new scene for every run, outside of the measurement
+void measure_read(Catch::Benchmark::Chronometer meter,
+                  const std::filesystem::path  &file_path)
+{
+  std::vector<std::shared_ptr<dc::Scene>> scenes;
+  for (int i{0}; i < meter.runs(); ++i)
+  {
+    scenes.push_back(dc::Scene::create());
+  }
+  meter.measure(
+      [&](int i)
+      { return scenes[static_cast<std::size_t>(i)]->read(file_path); });
+}
+
+std::size_t entities_count(dc::Scene &scene)
+{
+  return scene.all_entities_with<dc::GuidComponent>().size();
+}
+
+} // namespace
+
+TEST_CASE("Scene load time", "[scene]")
+{
+  const auto         scene = make_scene();
+  TemporaryDirectory directory;
+  const auto         legacy_file_path = directory.path() / "tagged.dcscn";
+  const auto         file_path        = directory.path() / "columns.dcscn";
+
+  legacy_save(*scene, legacy_file_path);
+  scene->save(file_path, dc::AssetDescription{});
+
+  // both formats load the same entities
+  const auto legacy_scene = dc::Scene::create();
+  legacy_scene->read(legacy_file_path);
+  const auto columns_scene = dc::Scene::create();
+  columns_scene->read(file_path);
+  REQUIRE(entities_count(*legacy_scene) == entities_count(*scene));
+  REQUIRE(entities_count(*columns_scene) == entities_count(*scene));
+  REQUIRE(columns_scene->all_entities_with<dc::PointLightComponent>().size() ==
+          roots_count);
+
+  const auto suffix = ", " + std::to_string(entities_count(*scene)) +
+                      " entities";
+
+  BENCHMARK_ADVANCED("read, tagged entities" + suffix)
+  (Catch::Benchmark::Chronometer meter)
+  {
+    measure_read(meter, legacy_file_path);
+  };
+
+  BENCHMARK_ADVANCED("read, entity columns" + suffix)
+  (Catch::Benchmark::Chronometer meter) { measure_read(meter, file_path); };
+}
+
+TEST_CASE("Scene snapshot and restore time", "[scene]")
+{
+  const auto         scene = make_scene();
+  TemporaryDirectory directory;
+  const auto         file_path = directory.path() / "columns.dcscn";
+  scene->save(file_path, dc::AssetDescription{});
+
+  // restoring brings back the entities that play mode removed or added
+  const auto  snapshot   = scene->snapshot();
+  const auto  count      = entities_count(*scene);
+  const auto &view       = scene->all_entities_with<dc::GuidComponent>();
+  const auto  removed_id = view.get<dc::GuidComponent>(view.front()).id_;
+  scene->remove_entity(removed_id);
+  scene->remove_entities();
+  scene->create_entity("Spawned");
+  REQUIRE(!scene->exists(removed_id));
+  scene->restore(snapshot);
+  REQUIRE(entities_count(*scene) == count);
+  REQUIRE(scene->exists(removed_id));
+
+  const auto suffix = ", " + std::to_string(count) + " entities";
+
+  BENCHMARK("snapshot" + suffix) { return scene->snapshot(); };
+
+  BENCHMARK("restore" + suffix) { scene->restore(snapshot); };
+
+  // without a snapshot the editor had to load the saved scene again
+  BENCHMARK_ADVANCED("read from file" + suffix)
+  (Catch::Benchmark::Chronometer meter) { measure_read(meter, file_path); };
+}
@@ -0,0 +1,103 @@
+#include "entity.hpp"
+#include "layer.hpp"
+#include "layer_stack.hpp"
+#include "scene.hpp"
+#include "script/script_wrapper.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+constexpr std::size_t entities_count{1000};
+
+/// Stands in for the engine layers the game layer comes after
+class EmptyLayer : public dc::Layer
+{
+public:
+  void init() override {}
+  void shutdown() override {}
+  bool update(float /*delta_time*/) override { return false; }
+  bool render() override { return false; }
+  bool on_event(const dc::Event & /*event*/) override { return false; }
+};
+
+/// Holds the scene like the game layer does through its scene asset
+class SceneLayer : public EmptyLayer
+{
+public:
+  explicit SceneLayer(std::shared_ptr<dc::Scene> scene)
+      : scene_{std::move(scene)}
+  {
+  }
+
+  std::shared_ptr<dc::Scene> scene() const { return scene_; }
+
+private:
+  std::shared_ptr<dc::Scene> scene_;
+};
+
+} // namespace
+
+TEST_CASE("Entity lookup of the script wrapper", "[script_wrapper]")
+{
+  const auto                 scene = dc::Scene::create();
+  std::vector<std::uint64_t> entity_ids;
+  for (std::size_t i{0}; i < entities_count; ++i)
+  {
+    auto entity = scene->create_entity("Entity " + std::to_string(i));
+    entity.set_position(glm::vec3{static_cast<float>(i)});
+    entity_ids.push_back(entity.id());
+  }
+
+  dc::LayerStack layer_stack;
+  layer_stack.push_layer(std::make_unique<EmptyLayer>());
+  layer_stack.push_layer(std::make_unique<EmptyLayer>());
+  layer_stack.push_layer(std::make_unique<SceneLayer>(scene));
+
+  // what every wrapper call did before the script system set the scene
+  BENCHMARK("1000 positions, scene looked up per call")
+  {
+    glm::vec3 sum{0.0f};
+    for (const auto entity_id : entity_ids)
+    {
+      const auto scene_layer = layer_stack.layer<SceneLayer>();
+      const auto call_scene  = scene_layer->scene();
+      const auto entity      = call_scene->entity_ref(entity_id);
+      sum += entity.position();
+    }
+    return sum;
+  };
+
+  BENCHMARK("1000 positions, scene resolved once")
+  {
+    glm::vec3 sum{0.0f};
+    for (const auto entity_id : entity_ids)
+    {
+      const auto entity = scene->entity_ref(entity_id);
+      sum += entity.position();
+    }
+    return sum;
+  };
+
+  BENCHMARK("1000 Dc_Entity_GetPosition in a ScopedScene")
+  {
+    dc::script_wrapper::ScopedScene scoped_scene{scene.get()};
+
+    glm::vec3 sum{0.0f};
+    for (const auto entity_id : entity_ids)
+    {
+      glm::vec3 position{};
+      dc::script_wrapper::Dc_Entity_GetPosition(entity_id, &position);
+      sum += position;
+    }
+    return sum;
+  };
+}
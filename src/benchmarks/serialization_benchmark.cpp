@@ -0,0 +1,267 @@
+#include "binary_reader.hpp"
+#include "binary_writer.hpp"
+#include "block_compression.hpp"
+#include "filesystem.hpp"
+#include "job_system.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+constexpr std::size_t records_count{10000};
+
+/** Roughly what a scene stores per entity */
+struct Record
+{
+  std::uint64_t        uuid_{0};
+  std::string          name_;
+  std::array<float, 3> position_{};
+  std::array<float, 3> rotation_{};
+  std::array<float, 3> scale_{};
+  std::uint64_t        parent_uuid_{0};
+  std::uint32_t        flags_{0};
+};
+
+std::vector<Record> make_records()
+{
+  std::mt19937                          random{42};
+  std::uniform_real_distribution<float> distribution{-100.0f, 100.0f};
+
+  std::vector<Record> records(records_count);
+  for (std::size_t i{0}; i < records.size(); ++i)
+  {
+    auto &record        = records[i];
+    record.uuid_        = random();
+    record.name_        = "Entity " + std::to_string(i);
+    record.position_    = {distribution(random),
+                           distribution(random),
+                           distribution(random)};
+    record.rotation_    = {distribution(random), 0.0f, 0.0f};
+    record.scale_       = {1.0f, 1.0f, 1.0f};
+    record.parent_uuid_ = i > 0 ? records[i / 2].uuid_ : 0;
+    record.flags_       = static_cast<std::uint32_t>(i % 7);
+  }
+  return records;
+}
+
+// The per value FILE serialization the BinaryReader and BinaryWriter
+// replaced, kept here as baseline
+
+template <typename T> void legacy_write_value(std::FILE *file, const T &value)
+{
+  std::fwrite(&value, sizeof(T), 1, file);
+}
+
+template <typename T> void legacy_read_value(std::FILE *file, T &value)
+{
+  std::fread(&value, sizeof(T), 1, file);
+}
+
+void legacy_write_string(std::FILE *file, const std::string &str)
+{
+  legacy_write_value(file, static_cast<std::uint32_t>(str.size()));
+  std::fwrite(str.data(), 1, str.size(), file);
+}
+
+void legacy_read_string(std::FILE *file, std::string &str)
+{
+  std::uint32_t length{};
+  legacy_read_value(file, length);
+  std::vector<char> chars(length);
+  std::fread(chars.data(), 1, length, file);
+  str.assign(chars.begin(), chars.end());
+}
+
+void legacy_save(const std::filesystem::path &file_path,
+                 const std::vector<Record>   &records)
+{
+  const auto file = std::fopen(file_path.string().c_str(), "wb");
+  if (!file)
+  {
+    throw std::runtime_error{"Could not open " + file_path.string()};
+  }
+  legacy_write_value(file, static_cast<std::uint64_t>(records.size()));
+  for (const auto &record : records)
+  {
+    legacy_write_value(file, record.uuid_);
+    legacy_write_string(file, record.name_);
+    legacy_write_value(file, record.position_);
+    legacy_write_value(file, record.rotation_);
+    legacy_write_value(file, record.scale_);
+    legacy_write_value(file, record.parent_uuid_);
+    legacy_write_value(file, record.flags_);
+  }
+  std::fclose(file);
+}
+
+std::vector<Record> legacy_read(const std::filesystem::path &file_path)
+{
+  const auto file = std::fopen(file_path.string().c_str(), "rb");
+  if (!file)
+  {
+    throw std::runtime_error{"Could not open " + file_path.string()};
+  }
+  std::uint64_t count{};
+  legacy_read_value(file, count);
+  std::vector<Record> records(count);
+  for (auto &record : records)
+  {
+    legacy_read_value(file, record.uuid_);
+    legacy_read_string(file, record.name_);
+    legacy_read_value(file, record.position_);
+    legacy_read_value(file, record.rotation_);
+    legacy_read_value(file, record.scale_);
+    legacy_read_value(file, record.parent_uuid_);
+    legacy_read_value(file, record.flags_);
+  }
+  std::fclose(file);
+  return records;
+}
+
+void write_records(dc::BinaryWriter &writer, const std::vector<Record> &records)
+{
+  dc::write_value(writer, static_cast<std::uint64_t>(records.size()));
+  for (const auto &record : records)
+  {
+    dc::write_value(writer, record.uuid_);
+    dc::write_string(writer, record.name_);
+    dc::write_value(writer, record.position_);
+    dc::write_value(writer, record.rotation_);
+    dc::write_value(writer, record.scale_);
+    dc::write_value(writer, record.parent_uuid_);
+    dc::write_value(writer, record.flags_);
+  }
+}
+
+std::vector<Record> read_records(dc::BinaryReader &reader)
+{
+  std::uint64_t count{};
+  dc::read_value(reader, count);
+  std::vector<Record> records(count);
+  for (auto &record : records)
+  {
+    dc::read_value(reader, record.uuid_);
+    dc::read_string(reader, record.name_);
+    dc::read_value(reader, record.position_);
+    dc::read_value(reader, record.rotation_);
+    dc::read_value(reader, record.scale_);
+    dc::read_value(reader, record.parent_uuid_);
+    dc::read_value(reader, record.flags_);
+  }
+  return records;
+}
+
+/** Directory for the benchmark files, removed with everything in it */
+class TemporaryDirectory
+{
+public:
+  TemporaryDirectory()
+  {
+    path_ = std::filesystem::temp_directory_path() /
+            ("discite_serialization_benchmark_" +
+             std::to_string(std::random_device{}()));
+    std::filesystem::create_directories(path_);
+  }
+
+  ~TemporaryDirectory()
+  {
+    std::error_code error_code{};
+    std::filesystem::remove_all(path_, error_code);
+  }
+
+  const std::filesystem::path &path() const { return path_; }
+
+private:
+  std::filesystem::path path_;
+};
+
+} // namespace
+
+TEST_CASE("Serialization of 10k records to a file", "[serialization]")
+{
+  const auto         records = make_records();
+  TemporaryDirectory directory;
+  const auto         legacy_file_path = directory.path() / "legacy.bin";
+  const auto         file_path        = directory.path() / "buffered.bin";
+
+  BENCHMARK("save, fwrite per value")
+  {
+    legacy_save(legacy_file_path, records);
+  };
+
+  BENCHMARK("save, BinaryWriter")
+  {
+    dc::BinaryWriter writer;
+    write_records(writer, records);
+    writer.save(file_path);
+  };
+
+  REQUIRE(legacy_read(legacy_file_path).size() == records.size());
+
+  BENCHMARK("read, fread per value")
+  {
+    return legacy_read(legacy_file_path);
+  };
+
+  BENCHMARK("read, BinaryReader")
+  {
+    const auto       data = dc::read_binary_file(file_path);
+    dc::BinaryReader reader{data.data(), data.size()};
+    return read_records(reader);
+  };
+}
+
+TEST_CASE("Block compression throughput", "[serialization]")
+{
+  // serialized records compress about like a scene
+  dc::BinaryWriter writer;
+  while (writer.size() < 8 * 1024 * 1024)
+  {
+    write_records(writer, make_records());
+  }
+  const auto data            = writer.release();
+  const auto compressed_data = dc::compress_blocks(data.data(), data.size());
+  REQUIRE(dc::decompressed_size(compressed_data.data(),
+                                compressed_data.size()) == data.size());
+
+  std::vector<std::uint8_t> decompressed_data(data.size());
+  dc::JobSystem job_system{std::thread::hardware_concurrency(), "Benchmark"};
+
+  BENCHMARK("compress_blocks " + std::to_string(data.size() >> 20) + " MiB")
+  {
+    return dc::compress_blocks(data.data(), data.size());
+  };
+
+  BENCHMARK("decompress_blocks, calling thread")
+  {
+    dc::decompress_blocks(compressed_data.data(),
+                          compressed_data.size(),
+                          decompressed_data.data(),
+                          decompressed_data.size());
+    return decompressed_data[0];
+  };
+
+  BENCHMARK("decompress_blocks, job system")
+  {
+    dc::decompress_blocks(compressed_data.data(),
+                          compressed_data.size(),
+                          decompressed_data.data(),
+                          decompressed_data.size(),
+                          &job_system);
+    return decompressed_data[0];
+  };
+  REQUIRE(decompressed_data == data);
+}
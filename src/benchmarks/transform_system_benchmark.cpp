@@ -0,0 +1,137 @@
+#include "entity.hpp"
+#include "relationship_component.hpp"
+#include "scene.hpp"
+#include "scene_events.hpp"
+#include "transform_component.hpp"
+#include "transform_system.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+constexpr std::size_t roots_count{1000};
+constexpr std::size_t children_count{4};
+
+/**
+ * The update every setter ran for the subtree of its entity before the
+ * TransformSystem, kept here as baseline. Appends the world matrices in depth
+ * first order
+ */
+void legacy_update_transform_matrix(dc::Entity              entity,
+                                    const glm::mat4        &parent_transform,
+                                    std::vector<glm::mat4> &world_matrices)
+{
+  while (entity.valid())
+  {
+    const auto transform =
+        parent_transform *
+        entity.component<dc::TransformComponent>().local_transform_matrix();
+    world_matrices.push_back(transform);
+    auto &relationship_component =
+        entity.component<dc::RelationshipComponent>();
+    legacy_update_transform_matrix(relationship_component.first_child_,
+                                   transform,
+                                   world_matrices);
+    entity = relationship_component.next_sibling_;
+  }
+}
+
+/// Roots with two levels of children below them
+std::vector<dc::Entity> make_hierarchy(dc::Scene &scene)
+{
+  std::vector<dc::Entity> roots;
+  for (std::size_t i{0}; i < roots_count; ++i)
+  {
+    auto root = scene.create_entity("Root " + std::to_string(i));
+    root.set_position(glm::vec3{static_cast<float>(i), 0.0f, 0.0f});
+    for (std::size_t j{0}; j < children_count; ++j)
+    {
+      auto child = scene.create_entity("Child");
+      child.set_position(glm::vec3{0.0f, static_cast<float>(j), 0.0f});
+      root.add_child(child);
+      for (std::size_t k{0}; k < children_count; ++k)
+      {
+        auto grandchild = scene.create_entity("Grandchild");
+        grandchild.set_position(
+            glm::vec3{0.0f, 0.0f, static_cast<float>(k)});
+        child.add_child(grandchild);
+      }
+    }
+    roots.push_back(root);
+  }
+  return roots;
+}
+
+void move_roots(std::vector<dc::Entity> &roots, std::size_t step)
+{
+  for (std::size_t i{0}; i < roots.size(); i += step)
+  {
+    roots[i].set_position(roots[i].position() + glm::vec3{0.0f, 1.0f, 0.0f});
+  }
+}
+
+} // namespace
+
+TEST_CASE("TransformSystem against the full recompute", "[transform_system]")
+{
+  const auto scene = dc::Scene::create();
+  auto       roots = make_hierarchy(*scene);
+
+  dc::TransformSystem transform_system;
+  transform_system.on_event(dc::SceneLoadedEvent{scene});
+  transform_system.update(0.0f);
+
+  // both get the same world matrices, the first grandchild comes after the
+  // root and the first child
+  auto child =
+      roots.back().component<dc::RelationshipComponent>().first_child_;
+  const auto grandchild =
+      child.component<dc::RelationshipComponent>().first_child_;
+  const auto             matrix = grandchild.transform_matrix();
+  std::vector<glm::mat4> world_matrices;
+  legacy_update_transform_matrix(roots.back(), glm::mat4{1.0f}, world_matrices);
+  const auto expected_matrix = world_matrices[2];
+  for (int i{0}; i < 4; ++i)
+  {
+    for (int j{0}; j < 4; ++j)
+    {
+      REQUIRE(matrix[i][j] == Approx(expected_matrix[i][j]).margin(1e-4));
+    }
+  }
+
+  const auto entities_suffix =
+      ", " + std::to_string(roots_count * (1 + children_count +
+                                           children_count * children_count)) +
+      " entities";
+
+  BENCHMARK("full recompute" + entities_suffix)
+  {
+    world_matrices.clear();
+    for (auto &root : roots)
+    {
+      legacy_update_transform_matrix(root, glm::mat4{1.0f}, world_matrices);
+    }
+  };
+
+  BENCHMARK("TransformSystem, nothing moved" + entities_suffix)
+  {
+    transform_system.update(0.0f);
+  };
+
+  BENCHMARK("TransformSystem, 1% of the roots moved" + entities_suffix)
+  {
+    move_roots(roots, 100);
+    transform_system.update(0.0f);
+  };
+
+  BENCHMARK("TransformSystem, every root moved" + entities_suffix)
+  {
+    move_roots(roots, 1);
+    transform_system.update(0.0f);
+  };
+}
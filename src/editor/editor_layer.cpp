@@ -11,6 +11,7 @@
 #include "scene_asset.hpp"
 #include "scene_panel.hpp"
 #include "serialization.hpp"
+#include "time.hpp"
 #include "viewport_panel.hpp"
 #include "window.hpp"
 
@@ -133,6 +134,27 @@ bool EditorLayer::on_key_event(const KeyEvent &event)
 
 bool EditorLayer::on_play_scene_event(const PlaySceneEvent &event)
 {
+  const auto game_layer = Engine::instance()->layer_stack()->layer<GameLayer>();
+  DC_ASSERT(game_layer, "Game layer not loaded");
+  const auto scene = game_layer->scene();
+  if (scene && scene->is_ready() && event.play_ != is_playing_)
+  {
+    if (event.play_)
+    {
+      DC_TIME_SCOPE("Snapshot scene");
+      snapshot_scene_ = scene->get();
+      scene_snapshot_ = scene->get()->snapshot();
+    }
+    else if (snapshot_scene_.lock() == scene->get())
+    {
+      // play mode changes must not end up in the saved scene
+      DC_TIME_SCOPE("Restore scene");
+      scene->get()->restore(scene_snapshot_);
+      snapshot_scene_ = {};
+      scene_snapshot_.clear();
+    }
+  }
+
   is_playing_ = event.play_;
 
   return false;
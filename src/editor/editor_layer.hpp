@@ -6,7 +6,9 @@
 #include "viewport_panel.hpp"
 #include "window.hpp"
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace dc
 {
@@ -24,6 +26,9 @@ public:
 
 private:
   bool is_playing_{false};
+  // state of the scene before play started
+  std::weak_ptr<Scene>      snapshot_scene_{};
+  std::vector<std::uint8_t> scene_snapshot_;
 
   void setup_game();
   void set_capture_mouse(bool value);
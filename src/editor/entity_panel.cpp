@@ -296,8 +296,10 @@ void EntityPanel::on_render()
                     skinned_mesh_name,
                     ImGuiInputTextFlags_EnterReturnsTrue))
     {
+      // animation state needs the skeleton right away
       auto handle = Engine::instance()->asset_cache()->load_asset(
-          Asset{skinned_mesh_name});
+          Asset{skinned_mesh_name},
+          AssetLoadMode::Sync);
       component.set_skinned_mesh_asset(
           std::dynamic_pointer_cast<SkinnedMeshAssetHandle>(handle));
     }
@@ -3,6 +3,8 @@
 #include "imgui_panel.hpp"
 #include "profiling.hpp"
 
+#include <string>
+
 namespace dc
 {
 PerformancePanel::PerformancePanel() : ImGuiPanel("Performance") {}
@@ -14,6 +16,40 @@ void PerformancePanel::on_render()
   Engine::instance()->performance_profiler()->for_each(
       [](const auto &name, auto time)
       { ImGui::Text("%s: %.3fms\n", name.c_str(), time); });
+
+  ImGui::Separator();
+
+  Engine::instance()->performance_profiler()->for_each_counter(
+      [](const auto &name, auto value)
+      {
+        ImGui::Text("%s: %llu\n",
+                    name.c_str(),
+                    static_cast<unsigned long long>(value));
+      });
+
+  ImGui::Separator();
+
+  const auto asset_cache_stats = Engine::instance()->asset_cache()->stats();
+  ImGui::Text("Asset cache hits: %llu misses: %llu evictions: %llu\n",
+              static_cast<unsigned long long>(asset_cache_stats.hits_),
+              static_cast<unsigned long long>(asset_cache_stats.misses_),
+              static_cast<unsigned long long>(asset_cache_stats.evictions_));
+
+  const auto print_residency = [](const auto &name, const auto &residency)
+  {
+    constexpr auto mb = 1024.0 * 1024.0;
+    ImGui::Text("%s: %zu assets, CPU %.2fMB, GPU %.2fMB\n",
+                name.c_str(),
+                residency.count_,
+                residency.cpu_size_ / mb,
+                residency.gpu_size_ / mb);
+  };
+  print_residency(std::string{"Resident"}, asset_cache_stats.total_);
+  for (const auto &[asset_type, residency] :
+       asset_cache_stats.residency_by_type_)
+  {
+    print_residency(asset_type, residency);
+  }
 }
 
 } // namespace dc
@@ -6,10 +6,13 @@
 #include "event.hpp"
 #include "imgui.h"
 #include "imgui_panel.hpp"
+#include "log.hpp"
 #include "name_component.hpp"
 #include "relationship_component.hpp"
 #include "scene.hpp"
 
+#include <exception>
+#include <filesystem>
 #include <limits>
 #include <memory>
 #include <string>
@@ -100,6 +103,15 @@ void ScenePanel::draw_entity_node(Entity entity)
     Engine::instance()->event_manager()->queue_event(event);
   }
 
+  if (ImGui::BeginPopupContextItem())
+  {
+    if (ImGui::MenuItem("Save as prefab"))
+    {
+      save_prefab(entity);
+    }
+    ImGui::EndPopup();
+  }
+
   if (opened)
   {
     auto child = entity.component<RelationshipComponent>().first_child_;
@@ -113,4 +125,29 @@ void ScenePanel::draw_entity_node(Entity entity)
   }
 }
 
+void ScenePanel::save_prefab(Entity entity)
+{
+  const auto scene = scene_.lock();
+  if (!scene)
+  {
+    return;
+  }
+
+  const auto path =
+      std::filesystem::path{"prefabs"} / (entity.name() + ".dcprefab");
+  const auto file_path = Engine::instance()->base_directory() / path;
+  try
+  {
+    std::filesystem::create_directories(file_path.parent_path());
+    scene->save_prefab(entity, file_path, AssetDescription{});
+    DC_LOG_INFO("Saved prefab {}", path.generic_string());
+  }
+  catch (const std::exception &error)
+  {
+    DC_LOG_WARN("Could not save prefab {}: {}",
+                path.generic_string(),
+                error.what());
+  }
+}
+
 } // namespace dc
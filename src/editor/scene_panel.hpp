@@ -37,6 +37,8 @@ private:
   bool on_scene_loaded(const SceneLoadedEvent &event);
 
   void draw_entity_node(Entity entity);
+
+  void save_prefab(Entity entity);
 };
 
 } // namespace dc
@@ -98,6 +98,9 @@ void ViewportPanel::on_render()
       view_render_info.set_viewport_info({0, 0, scene_width_, scene_height_});
     }
 
+    // the levels of detail got selected before the view was final
+    scene_render_info.select_lods(view_render_info);
+
     view_render_info.set_framebuffer(scene_framebuffer_.get());
     renderer->render(scene_render_info, view_render_info);
   }
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace dc
+{
+
+/// Size of a cache line and of the widest vector loads
+constexpr std::size_t cache_line_size{64};
+
+/** Allocator for containers whose data needs to start at an alignment */
+template <typename T, std::size_t Alignment = cache_line_size>
+class AlignedAllocator
+{
+public:
+  using value_type = T;
+
+  template <typename U> struct rebind
+  {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  AlignedAllocator() = default;
+
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U, Alignment> & /*other*/)
+  {
+  }
+
+  T *allocate(std::size_t count)
+  {
+    return static_cast<T *>(
+        ::operator new(count * sizeof(T), std::align_val_t{Alignment}));
+  }
+
+  void deallocate(T *pointer, std::size_t /*count*/)
+  {
+    ::operator delete(pointer, std::align_val_t{Alignment});
+  }
+
+  template <typename U>
+  bool operator==(const AlignedAllocator<U, Alignment> & /*other*/) const
+  {
+    return true;
+  }
+
+  template <typename U>
+  bool operator!=(const AlignedAllocator<U, Alignment> & /*other*/) const
+  {
+    return false;
+  }
+};
+
+/// Vector whose data starts at a cache line
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+} // namespace dc
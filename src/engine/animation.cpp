@@ -153,18 +153,18 @@ glm::vec3 BoneTransform::interpolate_position(double time) const
          glm::vec3(factor * delta.x, factor * delta.y, factor * delta.z);
 }
 
-void BoneTransform::save(FILE *file) const
+void BoneTransform::save(BinaryWriter &writer) const
 {
-  write_vector(file, bone_rotation_);
-  write_vector(file, bone_translation_);
-  write_vector(file, bone_scaling_);
+  write_vector(writer, bone_rotation_);
+  write_vector(writer, bone_translation_);
+  write_vector(writer, bone_scaling_);
 }
 
-void BoneTransform::read(FILE *file)
+void BoneTransform::read(BinaryReader &reader)
 {
-  read_vector(file, bone_rotation_);
-  read_vector(file, bone_translation_);
-  read_vector(file, bone_scaling_);
+  read_vector(reader, bone_rotation_);
+  read_vector(reader, bone_translation_);
+  read_vector(reader, bone_scaling_);
 }
 
 Animation::Animation(std::string                               name,
@@ -196,42 +196,42 @@ std::optional<BoneTransform> Animation::track(int index) const
   return tracks_[index];
 }
 
-void Animation::save(FILE *file) const
+void Animation::save(BinaryWriter &writer) const
 {
-  write_string(file, name_);
-  write_value(file, duration_);
-  write_value(file, ticks_per_second_);
+  write_string(writer, name_);
+  write_value(writer, duration_);
+  write_value(writer, ticks_per_second_);
 
-  write_value(file, tracks_.size());
+  write_value(writer, tracks_.size());
   for (std::size_t i = 0; i < tracks_.size(); ++i)
   {
     const auto &track     = tracks_[i];
     const auto &has_value = track.has_value();
-    write_value(file, has_value);
+    write_value(writer, has_value);
     if (has_value)
     {
-      track.value().save(file);
+      track.value().save(writer);
     }
   }
 }
 
-void Animation::read(FILE *file)
+void Animation::read(BinaryReader &reader)
 {
-  read_string(file, name_);
-  read_value(file, duration_);
-  read_value(file, ticks_per_second_);
+  read_string(reader, name_);
+  read_value(reader, duration_);
+  read_value(reader, ticks_per_second_);
 
   std::size_t tracks_size{0};
-  read_value(file, tracks_size);
+  read_value(reader, tracks_size);
   tracks_.resize(tracks_size);
   for (std::size_t i = 0; i < tracks_.size(); ++i)
   {
     bool has_value{false};
-    read_value(file, has_value);
+    read_value(reader, has_value);
     if (has_value)
     {
       BoneTransform bone_transform{};
-      bone_transform.read(file);
+      bone_transform.read(reader);
       tracks_[i] = std::move(bone_transform);
     }
   }
@@ -8,6 +8,9 @@
 namespace dc
 {
 
+class BinaryReader;
+class BinaryWriter;
+
 struct BoneRotation
 {
   double    time_;
@@ -34,8 +37,8 @@ struct BoneTransform
 
   glm::mat4 interpolate(double time) const;
 
-  void save(FILE *file) const;
-  void read(FILE *file);
+  void save(BinaryWriter &writer) const;
+  void read(BinaryReader &reader);
 
 private:
   std::size_t find_scaling(double time) const;
@@ -63,8 +66,8 @@ public:
   std::vector<std::optional<BoneTransform>> tracks() const;
   std::optional<BoneTransform>              track(int index) const;
 
-  void save(FILE *file) const;
-  void read(FILE *file);
+  void save(BinaryWriter &writer) const;
+  void read(BinaryReader &reader);
 
 private:
   std::string name_;
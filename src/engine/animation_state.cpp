@@ -84,18 +84,18 @@ void AnimationState::reset()
   }
 }
 
-void AnimationState::save(FILE *file) const
+void AnimationState::save(BinaryWriter &writer) const
 {
-  write_value(file, animation_time_);
-  write_value(file, is_endless_animation_);
-  write_value(file, active_animation_index_);
+  write_value(writer, animation_time_);
+  write_value(writer, is_endless_animation_);
+  write_value(writer, active_animation_index_);
 }
 
-void AnimationState::read(FILE *file)
+void AnimationState::read(BinaryReader &reader)
 {
-  read_value(file, animation_time_);
-  read_value(file, is_endless_animation_);
-  read_value(file, active_animation_index_);
+  read_value(reader, animation_time_);
+  read_value(reader, is_endless_animation_);
+  read_value(reader, active_animation_index_);
 
   reset();
   compute_bone_transforms(0);
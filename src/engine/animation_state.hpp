@@ -9,6 +9,9 @@
 namespace dc
 {
 
+class BinaryReader;
+class BinaryWriter;
+
 class AnimationState
 {
 public:
@@ -25,8 +28,8 @@ public:
   void                   compute_bone_transforms(double delta_time);
   std::vector<glm::mat4> bone_transforms() const;
 
-  void save(FILE *file) const;
-  void read(FILE *file);
+  void save(BinaryWriter &writer) const;
+  void read(BinaryReader &reader);
 
 private:
   std::shared_ptr<Skeleton> skeleton_;
@@ -0,0 +1,224 @@
+#include "asset_archive.hpp"
+#include "filesystem.hpp"
+#include "log.hpp"
+#include "profiling.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+
+namespace
+{
+
+void write_padding(FILE *file, std::uint64_t &offset)
+{
+  static constexpr std::uint8_t zeros[dc::asset_archive_alignment]{};
+
+  const auto padding = (dc::asset_archive_alignment -
+                        offset % dc::asset_archive_alignment) %
+                       dc::asset_archive_alignment;
+  std::fwrite(zeros, 1, padding, file);
+  offset += padding;
+}
+
+void write_bytes(FILE              *file,
+                 const void        *data,
+                 std::uint64_t      size,
+                 std::uint64_t     &offset,
+                 const std::string &file_path)
+{
+  if (size > 0 && std::fwrite(data, 1, size, file) != size)
+  {
+    throw std::runtime_error{"Could not write to " + file_path};
+  }
+  offset += size;
+}
+
+} // namespace
+
+namespace dc
+{
+
+std::uint64_t asset_archive_hash(std::string_view asset_id)
+{
+  // FNV-1a
+  std::uint64_t hash{0xcbf29ce484222325};
+  for (const auto c : asset_id)
+  {
+    hash ^= static_cast<std::uint8_t>(c == '\\' ? '/' : c);
+    hash *= 0x100000001b3;
+  }
+  return hash;
+}
+
+AssetArchive::AssetArchive(const std::filesystem::path &file_path)
+    : file_{file_path}
+{
+  AssetArchiveHeader header{};
+  if (file_.size() < sizeof(header))
+  {
+    throw std::runtime_error{"Asset archive is too small " +
+                             file_path.string()};
+  }
+  std::copy_n(file_.data(),
+              sizeof(header),
+              reinterpret_cast<std::uint8_t *>(&header));
+
+  const AssetArchiveHeader expected_header{};
+  if (header.magic_value_ != expected_header.magic_value_ ||
+      header.version_ != expected_header.version_)
+  {
+    throw std::runtime_error{"Unsupported asset archive " +
+                             file_path.string()};
+  }
+  const auto entries_size = header.entries_count_ * sizeof(AssetArchiveEntry);
+  if (header.entries_offset_ % alignof(AssetArchiveEntry) != 0 ||
+      header.entries_offset_ > file_.size() ||
+      entries_size > file_.size() - header.entries_offset_ ||
+      header.ids_offset_ > file_.size())
+  {
+    throw std::runtime_error{"Corrupt asset archive " + file_path.string()};
+  }
+
+  entries_ = reinterpret_cast<const AssetArchiveEntry *>(
+      file_.data() + header.entries_offset_);
+  entries_count_ = header.entries_count_;
+  ids_ = reinterpret_cast<const char *>(file_.data() + header.ids_offset_);
+  ids_size_ = file_.size() - header.ids_offset_;
+}
+
+std::optional<AssetData> AssetArchive::find(std::string_view asset_id) const
+{
+  const auto hash = asset_archive_hash(asset_id);
+
+  const auto entries_end = entries_ + entries_count_;
+  auto       iter        = std::lower_bound(entries_,
+                                 entries_end,
+                                 hash,
+                                 [](const AssetArchiveEntry &entry,
+                                    std::uint64_t            hash)
+                                 { return entry.hash_ < hash; });
+
+  // compare the ids in case of hash collisions
+  for (; iter != entries_end && iter->hash_ == hash; ++iter)
+  {
+    if (iter->id_offset_ > ids_size_ ||
+        iter->id_size_ > ids_size_ - iter->id_offset_)
+    {
+      DC_LOG_WARN("Asset {} lies outside of the asset archive", asset_id);
+      return std::nullopt;
+    }
+    const std::string_view id{ids_ + iter->id_offset_, iter->id_size_};
+    if (id.size() != asset_id.size() ||
+        !std::equal(id.begin(),
+                    id.end(),
+                    asset_id.begin(),
+                    [](char a, char b)
+                    {
+                      return (a == '\\' ? '/' : a) == (b == '\\' ? '/' : b);
+                    }))
+    {
+      continue;
+    }
+    if (iter->offset_ > file_.size() ||
+        iter->size_ > file_.size() - iter->offset_)
+    {
+      DC_LOG_WARN("Asset {} lies outside of the asset archive", asset_id);
+      return std::nullopt;
+    }
+
+    AssetData asset_data{};
+    asset_data.data_  = file_.data() + iter->offset_;
+    asset_data.size_  = iter->size_;
+    asset_data.owner_ = shared_from_this();
+    return asset_data;
+  }
+
+  return std::nullopt;
+}
+
+std::size_t AssetArchive::assets_count() const { return entries_count_; }
+
+void write_asset_archive(const std::filesystem::path    &data_directory,
+                         const std::vector<std::string> &asset_types,
+                         const std::filesystem::path    &archive_path)
+{
+  DC_PROFILE_SCOPE("write_asset_archive()");
+
+  std::vector<std::string> asset_ids;
+  for (const auto &entry :
+       std::filesystem::recursive_directory_iterator(data_directory))
+  {
+    if (!entry.is_regular_file())
+    {
+      continue;
+    }
+    const auto extension = entry.path().extension().string();
+    if (std::find(asset_types.begin(), asset_types.end(), extension) ==
+        asset_types.end())
+    {
+      continue;
+    }
+    asset_ids.push_back(
+        entry.path().lexically_relative(data_directory).generic_string());
+  }
+  // same input gives the same archive
+  std::sort(asset_ids.begin(), asset_ids.end());
+
+  // a failed build doesn't leave a broken archive behind
+  AtomicFile atomic_file{archive_path};
+  const auto file              = atomic_file.file();
+  const auto archive_file_path = archive_path.string();
+
+  AssetArchiveHeader header{};
+  std::uint64_t      offset{0};
+  write_bytes(file, &header, sizeof(header), offset, archive_file_path);
+
+  std::vector<AssetArchiveEntry> entries;
+  std::string                    ids;
+  for (const auto &asset_id : asset_ids)
+  {
+    const auto data = read_binary_file(data_directory / asset_id);
+
+    write_padding(file, offset);
+
+    AssetArchiveEntry entry{};
+    entry.hash_      = asset_archive_hash(asset_id);
+    entry.offset_    = offset;
+    entry.size_      = data.size();
+    entry.id_offset_ = ids.size();
+    entry.id_size_   = asset_id.size();
+    entries.push_back(entry);
+    ids += asset_id;
+
+    write_bytes(file, data.data(), data.size(), offset, archive_file_path);
+  }
+
+  std::sort(entries.begin(),
+            entries.end(),
+            [](const AssetArchiveEntry &a, const AssetArchiveEntry &b)
+            { return a.hash_ < b.hash_; });
+
+  write_padding(file, offset);
+  header.entries_count_  = entries.size();
+  header.entries_offset_ = offset;
+  write_bytes(file,
+              entries.data(),
+              entries.size() * sizeof(AssetArchiveEntry),
+              offset,
+              archive_file_path);
+
+  header.ids_offset_ = offset;
+  write_bytes(file, ids.data(), ids.size(), offset, archive_file_path);
+
+  std::fseek(file, 0, SEEK_SET);
+  write_bytes(file, &header, sizeof(header), offset, archive_file_path);
+
+  atomic_file.commit();
+
+  DC_LOG_INFO("Packed {} assets into {}",
+              asset_ids.size(),
+              archive_path.string());
+}
+
+} // namespace dc
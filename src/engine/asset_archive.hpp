@@ -0,0 +1,75 @@
+#pragma once
+
+#include "asset_data.hpp"
+#include "filesystem.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dc
+{
+
+/**
+ * Archive that packs many assets into one file, so that loading them doesn't
+ * need a file system lookup per asset. The file gets mapped into memory and
+ * assets are handed out as spans into the mapping.
+ *
+ * Layout:
+ *   AssetArchiveHeader
+ *   payloads, each aligned to asset_archive_alignment
+ *   table of contents, AssetArchiveEntry sorted by hash
+ *   asset ids of the entries
+ */
+struct AssetArchiveHeader
+{
+  std::uint32_t magic_value_{0x4b504344}; // DCPK
+  std::uint32_t version_{1};
+  std::uint64_t entries_count_{0};
+  std::uint64_t entries_offset_{0};
+  std::uint64_t ids_offset_{0};
+};
+
+struct AssetArchiveEntry
+{
+  std::uint64_t hash_{0};
+  std::uint64_t offset_{0};
+  std::uint64_t size_{0};
+  std::uint64_t id_offset_{0};
+  std::uint64_t id_size_{0};
+};
+
+constexpr std::uint64_t asset_archive_alignment = 64;
+
+std::uint64_t asset_archive_hash(std::string_view asset_id);
+
+class AssetArchive : public std::enable_shared_from_this<AssetArchive>
+{
+public:
+  explicit AssetArchive(const std::filesystem::path &file_path);
+
+  std::optional<AssetData> find(std::string_view asset_id) const;
+
+  std::size_t assets_count() const;
+
+private:
+  MappedFile               file_;
+  const AssetArchiveEntry *entries_{nullptr};
+  std::size_t              entries_count_{0};
+  const char              *ids_{nullptr};
+  std::size_t              ids_size_{0};
+};
+
+/**
+ * Packs all files in the data directory with one of the asset types into an
+ * archive.
+ */
+void write_asset_archive(const std::filesystem::path    &data_directory,
+                         const std::vector<std::string> &asset_types,
+                         const std::filesystem::path    &archive_path);
+
+} // namespace dc
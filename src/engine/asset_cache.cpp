@@ -1,11 +1,146 @@
 #include "asset_cache.hpp"
 #include "assert.hpp"
+#include "asset_description.hpp"
+#include "binary_reader.hpp"
+#include "binary_writer.hpp"
+#include "block_compression.hpp"
 #include "engine.hpp"
+#include "filesystem.hpp"
 #include "log.hpp"
+#include "profiling.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <thread>
+
+namespace
+{
+
+/**
+ * Returns the data with the payload decompressed and the codec in the header
+ * set to none, so loaders never see compressed data. Data of assets without
+ * a compression codec gets returned as it is.
+ */
+dc::AssetData decompress_asset_data(const dc::AssetData &asset_data,
+                                    dc::JobSystem       *job_system)
+{
+  std::uint32_t magic_value{0};
+  if (asset_data.size_ < sizeof(magic_value))
+  {
+    return asset_data;
+  }
+  std::memcpy(&magic_value, asset_data.data_, sizeof(magic_value));
+  if (magic_value != dc::asset_magic_value)
+  {
+    return asset_data;
+  }
+
+  dc::BinaryReader     reader{asset_data.data_, asset_data.size_};
+  dc::AssetDescription asset_description{};
+  asset_description.read(reader);
+  if (asset_description.compression_codec_ == dc::CompressionCodec::None)
+  {
+    return asset_data;
+  }
+  if (asset_description.compression_codec_ != dc::CompressionCodec::Lz)
+  {
+    throw std::runtime_error{"Unknown compression codec"};
+  }
+
+  DC_PROFILE_SCOPE("decompress_asset_data()");
+
+  const auto header_size     = reader.position();
+  const auto compressed_data = asset_data.data_ + header_size;
+  const auto compressed_size = asset_data.size_ - header_size;
+
+  asset_description.compression_codec_ = dc::CompressionCodec::None;
+  dc::BinaryWriter writer{};
+  asset_description.write(writer);
+  DC_ASSERT(writer.size() == header_size, "Header size changed");
+
+  const auto data = std::make_shared<std::vector<std::uint8_t>>(
+      header_size + dc::decompressed_size(compressed_data, compressed_size));
+  std::memcpy(data->data(), writer.data(), header_size);
+  dc::decompress_blocks(compressed_data,
+                        compressed_size,
+                        data->data() + header_size,
+                        data->size() - header_size,
+                        job_system);
+
+  dc::AssetData result{};
+  result.data_  = data->data();
+  result.size_  = data->size();
+  result.owner_ = data;
+  return result;
+}
+
+} // namespace
 
 namespace dc
 {
 
+AssetCache::~AssetCache()
+{
+  // stop the loader threads before the handles they work on go away
+  thread_pool_ = nullptr;
+}
+
+void AssetCache::init()
+{
+  main_thread_id_ = std::this_thread::get_id();
+
+  const auto config = Engine::instance()->config();
+
+  const auto is_async = config->config_value_bool("AssetCache",
+                                                  "async_loading",
+                                                  true);
+  default_load_mode_  = is_async ? AssetLoadMode::Async : AssetLoadMode::Sync;
+
+  const auto hardware_threads =
+      static_cast<int>(std::thread::hardware_concurrency());
+  const auto loader_threads =
+      config->config_value_int("AssetCache",
+                               "loader_threads",
+                               std::max(hardware_threads - 1, 1));
+  thread_pool_ = std::make_unique<ThreadPool>(loader_threads, "Asset loader");
+
+  const auto archive_file_path = std::filesystem::path{
+      config->config_value_string("AssetCache", "archive", "assets.dcpak")};
+  open_asset_archive(Engine::instance()->base_directory() / archive_file_path);
+
+  const auto memory_budget_mb =
+      config->config_value_int("AssetCache", "memory_budget_mb", 0);
+  memory_budget_ = static_cast<std::size_t>(std::max(memory_budget_mb, 0)) *
+                   1024 * 1024;
+
+  DC_LOG_INFO("Asset cache uses {} loader threads", loader_threads);
+}
+
+void AssetCache::open_asset_archive(const std::filesystem::path &file_path)
+{
+  if (!std::filesystem::exists(file_path))
+  {
+    DC_LOG_INFO("No asset archive {}, loading loose files",
+                file_path.string());
+    return;
+  }
+
+  try
+  {
+    asset_archive_ = std::make_shared<AssetArchive>(file_path);
+    DC_LOG_INFO("Opened asset archive {} with {} assets",
+                file_path.string(),
+                asset_archive_->assets_count());
+  }
+  catch (const std::exception &error)
+  {
+    DC_LOG_WARN("Could not open asset archive {}: {}",
+                file_path.string(),
+                error.what());
+  }
+}
+
 void AssetCache::register_asset_loader(std::string        asset_type,
                                        const AssetLoader &asset_loader)
 {
@@ -20,32 +155,390 @@ void AssetCache::register_asset_loader(std::string        asset_type,
 
 std::shared_ptr<AssetHandle> AssetCache::load_asset(const Asset &asset)
 {
+  return load_asset(asset, default_load_mode_);
+}
+
+std::shared_ptr<AssetHandle> AssetCache::load_asset(const Asset  &asset,
+                                                    AssetLoadMode load_mode)
+{
+  DC_PROFILE_SCOPE("AssetCache::load_asset()");
+
   if (asset.type().empty())
   {
     DC_LOG_WARN("Trying to load asset with emtpy name");
     return nullptr;
   }
+  if (load_mode == AssetLoadMode::Sync && !is_main_thread())
+  {
+    // assets can only be created on the main thread
+    load_mode = AssetLoadMode::Async;
+  }
+
   // check if asset already loaded and if yes, load it from cache
-  const auto asset_iter = asset_cache_.find(asset.id());
-  if (asset_iter != asset_cache_.end())
+  std::shared_ptr<AssetHandle> asset_handle;
+  {
+    std::shared_lock lock{asset_cache_mutex_};
+    const auto       asset_iter = asset_cache_.find(asset.id());
+    if (asset_iter != asset_cache_.end())
+    {
+      asset_handle                        = asset_iter->second.asset_handle_;
+      asset_iter->second.last_used_frame_ = frame_.load();
+    }
+  }
+  if (!asset_handle)
   {
-    return asset_iter->second;
+    return construct_asset(asset, load_mode);
+  }
+  ++hits_;
+
+  if (load_mode == AssetLoadMode::Sync)
+  {
+    // caller needs the asset right now, so don't wait for the next update
+    finish_pending_asset(asset.id());
+  }
+  return asset_handle;
+}
+
+std::shared_ptr<AssetHandle>
+AssetCache::construct_asset(const Asset &asset, AssetLoadMode load_mode)
+{
+  std::shared_ptr<AssetHandle>               asset_handle;
+  AssetHandleFuture                          asset_handle_future;
+  std::promise<std::shared_ptr<AssetHandle>> asset_handle_promise;
+  {
+    std::unique_lock lock{asset_cache_mutex_};
+
+    // another thread may have been faster
+    const auto asset_iter = asset_cache_.find(asset.id());
+    if (asset_iter != asset_cache_.end())
+    {
+      asset_handle                        = asset_iter->second.asset_handle_;
+      asset_iter->second.last_used_frame_ = frame_.load();
+    }
+    else
+    {
+      const auto iter = constructing_assets_.find(asset.id());
+      if (iter != constructing_assets_.end())
+      {
+        asset_handle_future = iter->second;
+      }
+      else
+      {
+        constructing_assets_[asset.id()] =
+            asset_handle_promise.get_future().share();
+      }
+    }
   }
 
+  if (asset_handle || asset_handle_future.valid())
+  {
+    ++hits_;
+    if (!asset_handle)
+    {
+      // share the handle that another thread constructs right now
+      asset_handle = asset_handle_future.get();
+    }
+    if (asset_handle && load_mode == AssetLoadMode::Sync)
+    {
+      finish_pending_asset(asset.id());
+    }
+    return asset_handle;
+  }
+
+  ++misses_;
+
   // find matching asset loader
-  const auto asset_loader_iter = asset_loaders_.find(asset.type());
-  if (asset_loader_iter == asset_loaders_.end())
+  const auto file_path = Engine::instance()->base_directory() / asset.id();
+  try
   {
-    DC_LOG_WARN("No such asset loader {}", asset.type());
-    return nullptr;
+    const auto asset_loader_iter = asset_loaders_.find(asset.type());
+    if (asset_loader_iter == asset_loaders_.end())
+    {
+      DC_LOG_WARN("No such asset loader {}", asset.type());
+    }
+    else
+    {
+      asset_handle = asset_loader_iter->second(file_path, asset);
+    }
+  }
+  catch (...)
+  {
+    {
+      std::unique_lock lock{asset_cache_mutex_};
+      constructing_assets_.erase(asset.id());
+    }
+    asset_handle_promise.set_exception(std::current_exception());
+    throw;
+  }
+
+  const auto is_loaded_async = asset_handle && !asset_handle->is_ready() &&
+                               (load_mode == AssetLoadMode::Async ||
+                                !is_main_thread() || !thread_pool_);
+  if (is_loaded_async)
+  {
+    // register before the handle gets published, so that synchronous loads
+    // of other callers can find it
+    std::lock_guard lock{pending_assets_mutex_};
+    pending_assets_[asset.id()] = asset_handle;
+  }
+
+  {
+    std::unique_lock lock{asset_cache_mutex_};
+    if (asset_handle)
+    {
+      auto &cached_asset            = asset_cache_[asset.id()];
+      cached_asset.asset_handle_    = asset_handle;
+      cached_asset.last_used_frame_ = frame_.load();
+    }
+    constructing_assets_.erase(asset.id());
+  }
+  asset_handle_promise.set_value(asset_handle);
+
+  if (!asset_handle || asset_handle->is_ready())
+  {
+    // loader did all the work already
+    return asset_handle;
+  }
+
+  if (!is_loaded_async)
+  {
+    load_asset_data(*asset_handle);
+    asset_handle->create();
+    Engine::instance()->gpu_upload_queue()->flush();
+    return asset_handle;
+  }
+
+  const auto load_task = [this, asset_handle]()
+  {
+    DC_PROFILE_SCOPE("AssetCache - Load asset");
+
+    load_asset_data(*asset_handle);
+    {
+      std::lock_guard lock{pending_assets_mutex_};
+      loaded_assets_.push_back(asset_handle->asset().id());
+    }
+    loaded_assets_condition_.notify_all();
+  };
+  if (thread_pool_)
+  {
+    thread_pool_->submit(load_task);
+  }
+  else
+  {
+    // no loader threads yet, load on this thread and create on the main
+    // thread
+    load_task();
   }
 
-  // load the asset from disk
-  const auto asset_handle = asset_loader_iter->second(
-      Engine::instance()->base_directory() / asset.id(),
-      asset);
-  asset_cache_[asset.id()] = asset_handle;
   return asset_handle;
 }
 
+AssetData AssetCache::read_asset_data(const std::string &asset_id) const
+{
+  if (asset_archive_)
+  {
+    if (const auto asset_data = asset_archive_->find(asset_id))
+    {
+      return decompress_asset_data(*asset_data,
+                                   Engine::instance()->job_system());
+    }
+  }
+
+  // fall back to loose files, so that assets can be changed without
+  // rebuilding the archive
+  const auto file_data = std::make_shared<std::vector<std::uint8_t>>(
+      read_binary_file(Engine::instance()->base_directory() / asset_id));
+
+  AssetData asset_data{};
+  asset_data.data_  = file_data->data();
+  asset_data.size_  = file_data->size();
+  asset_data.owner_ = file_data;
+  return decompress_asset_data(asset_data,
+                               Engine::instance()->job_system());
+}
+
+void AssetCache::load_asset_data(AssetHandle &asset_handle) const
+{
+  // loading runs on the loader threads, where nothing may escape. A failed
+  // asset still gets published and created, so that synchronous loads that
+  // wait for it wake up. It stays unready then
+  const auto asset_id = asset_handle.asset().id();
+  try
+  {
+    asset_handle.load(read_asset_data(asset_id));
+  }
+  catch (const std::exception &error)
+  {
+    DC_LOG_WARN("Could not read asset {}: {}", asset_id, error.what());
+  }
+  catch (...)
+  {
+    DC_LOG_WARN("Could not read asset {}: unknown error", asset_id);
+  }
+}
+
+void AssetCache::update()
+{
+  DC_PROFILE_SCOPE("AssetCache::update()");
+
+  std::vector<std::shared_ptr<AssetHandle>> loaded_asset_handles;
+  {
+    std::lock_guard lock{pending_assets_mutex_};
+    for (const auto &asset_id : loaded_assets_)
+    {
+      const auto iter = pending_assets_.find(asset_id);
+      if (iter == pending_assets_.end())
+      {
+        // got already finished by a synchronous load
+        continue;
+      }
+      loaded_asset_handles.push_back(iter->second);
+      pending_assets_.erase(iter);
+    }
+    loaded_assets_.clear();
+  }
+
+  // creating assets may load further assets, therefore don't hold the lock
+  for (const auto &asset_handle : loaded_asset_handles)
+  {
+    asset_handle->create();
+  }
+
+  evict_assets();
+  ++frame_;
+}
+
+void AssetCache::evict_assets()
+{
+  const std::size_t memory_budget = memory_budget_;
+  if (memory_budget == 0)
+  {
+    return;
+  }
+
+  std::unique_lock lock{asset_cache_mutex_};
+
+  std::size_t resident_size{0};
+  for (const auto &[asset_id, cached_asset] : asset_cache_)
+  {
+    resident_size += cached_asset.asset_handle_->cpu_size() +
+                     cached_asset.asset_handle_->gpu_size();
+  }
+  if (resident_size <= memory_budget)
+  {
+    return;
+  }
+
+  DC_PROFILE_SCOPE("AssetCache::evict_assets()");
+
+  // only the cache references these assets. Pending assets and assets with
+  // queued uploads are referenced by their tasks and therefore stay
+  std::vector<std::pair<std::uint64_t, std::string>> unused_assets;
+  for (const auto &[asset_id, cached_asset] : asset_cache_)
+  {
+    if (cached_asset.asset_handle_.use_count() == 1)
+    {
+      unused_assets.emplace_back(cached_asset.last_used_frame_, asset_id);
+    }
+  }
+  std::sort(unused_assets.begin(), unused_assets.end());
+
+  // assets that only got referenced by evicted assets become unused and get
+  // evicted in one of the next frames
+  for (const auto &[last_used_frame, asset_id] : unused_assets)
+  {
+    if (resident_size <= memory_budget)
+    {
+      break;
+    }
+    const auto iter = asset_cache_.find(asset_id);
+    resident_size -= iter->second.asset_handle_->cpu_size() +
+                     iter->second.asset_handle_->gpu_size();
+    asset_cache_.erase(iter);
+    ++evictions_;
+  }
+}
+
+void AssetCache::finish_pending_asset(const std::string &asset_id)
+{
+  DC_ASSERT(is_main_thread(), "Assets can only be created on the main thread");
+
+  std::shared_ptr<AssetHandle> asset_handle;
+  {
+    std::unique_lock lock{pending_assets_mutex_};
+    const auto       iter = pending_assets_.find(asset_id);
+    if (iter == pending_assets_.end())
+    {
+      return;
+    }
+    asset_handle = iter->second;
+    pending_assets_.erase(iter);
+
+    // wait until the loader thread is done with the asset
+    loaded_assets_condition_.wait(
+        lock,
+        [this, &asset_id]()
+        {
+          return std::find(loaded_assets_.begin(),
+                           loaded_assets_.end(),
+                           asset_id) != loaded_assets_.end();
+        });
+    loaded_assets_.erase(
+        std::find(loaded_assets_.begin(), loaded_assets_.end(), asset_id));
+  }
+
+  asset_handle->create();
+  Engine::instance()->gpu_upload_queue()->flush();
+}
+
+void AssetCache::set_memory_budget(std::size_t value)
+{
+  memory_budget_ = value;
+}
+
+std::size_t AssetCache::memory_budget() const { return memory_budget_; }
+
+AssetCacheStats AssetCache::stats() const
+{
+  AssetCacheStats stats{};
+  stats.hits_      = hits_;
+  stats.misses_    = misses_;
+  stats.evictions_ = evictions_;
+
+  std::shared_lock lock{asset_cache_mutex_};
+  for (const auto &[asset_id, cached_asset] : asset_cache_)
+  {
+    const auto &asset_handle = cached_asset.asset_handle_;
+    const auto  cpu_size     = asset_handle->cpu_size();
+    const auto  gpu_size     = asset_handle->gpu_size();
+
+    auto &type_residency =
+        stats.residency_by_type_[asset_handle->asset().type()];
+    ++type_residency.count_;
+    type_residency.cpu_size_ += cpu_size;
+    type_residency.gpu_size_ += gpu_size;
+
+    ++stats.total_.count_;
+    stats.total_.cpu_size_ += cpu_size;
+    stats.total_.gpu_size_ += gpu_size;
+  }
+
+  return stats;
+}
+
+bool AssetCache::is_main_thread() const
+{
+  return std::this_thread::get_id() == main_thread_id_;
+}
+
+void AssetCache::set_default_load_mode(AssetLoadMode value)
+{
+  default_load_mode_ = value;
+}
+
+AssetLoadMode AssetCache::default_load_mode() const
+{
+  return default_load_mode_;
+}
+
 } // namespace dc
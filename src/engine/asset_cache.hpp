@@ -1,12 +1,24 @@
 #pragma once
 
 #include "asset.hpp"
+#include "asset_archive.hpp"
 #include "asset_handle.hpp"
+#include "flat_hash_map.hpp"
+#include "thread_pool.hpp"
 
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <functional>
+#include <future>
+#include <map>
 #include <memory>
-#include <unordered_map>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
 
 namespace dc
 {
@@ -15,17 +27,144 @@ using AssetLoader =
     std::function<std::shared_ptr<AssetHandle>(const std::filesystem::path &,
                                                const Asset &asset)>;
 
+enum class AssetLoadMode
+{
+  /// Asset is ready when load_asset() returns
+  Sync,
+  /// Asset gets read on a loader thread and becomes ready in a later frame
+  Async,
+};
+
+struct AssetResidency
+{
+  std::size_t count_{0};
+  std::size_t cpu_size_{0};
+  std::size_t gpu_size_{0};
+};
+
+struct AssetCacheStats
+{
+  std::uint64_t hits_{0};
+  std::uint64_t misses_{0};
+  std::uint64_t evictions_{0};
+
+  AssetResidency                        total_{};
+  std::map<std::string, AssetResidency> residency_by_type_{};
+};
+
+/**
+ * Caches asset handles by asset id. load_asset() can be called from any
+ * thread. Concurrent requests for the same asset share one handle, so every
+ * asset gets read only once. Asset loaders need to be registered before
+ * loading starts.
+ *
+ * If the resident assets exceed the memory budget, the least recently used
+ * assets that are not referenced outside of the cache get evicted.
+ */
 class AssetCache
 {
 public:
+  ~AssetCache();
+
+  void init();
+
+  /**
+   * Assets that are in the archive get read from it. All other assets get
+   * read from loose files in the base directory.
+   */
+  void open_asset_archive(const std::filesystem::path &file_path);
+
+  /**
+   * Reads the bytes of an asset from the archive or the loose file. Throws
+   * std::runtime_error if the asset does not exist.
+   */
+  AssetData read_asset_data(const std::string &asset_id) const;
+
   void register_asset_loader(std::string        asset_type,
                              const AssetLoader &asset_loader);
 
   std::shared_ptr<AssetHandle> load_asset(const Asset &asset);
 
+  /**
+   * Synchronous loads need the main thread, because assets create their GL
+   * objects there. On other threads they fall back to asynchronous loads.
+   */
+  std::shared_ptr<AssetHandle> load_asset(const Asset  &asset,
+                                          AssetLoadMode load_mode);
+
+  /**
+   * Creates the assets that finished loading on the loader threads. Their
+   * GPU data gets uploaded through the GpuUploadQueue. Needs to be called
+   * from the main thread.
+   */
+  void update();
+
+  void          set_default_load_mode(AssetLoadMode value);
+  AssetLoadMode default_load_mode() const;
+
+  /// Budget for CPU and GPU memory in bytes. Zero disables eviction
+  void        set_memory_budget(std::size_t value);
+  std::size_t memory_budget() const;
+
+  AssetCacheStats stats() const;
+
 private:
-  std::unordered_map<std::string, AssetLoader>                  asset_loaders_;
-  std::unordered_map<std::string, std::shared_ptr<AssetHandle>> asset_cache_;
+  using AssetHandleFuture = std::shared_future<std::shared_ptr<AssetHandle>>;
+
+  struct CachedAsset
+  {
+    std::shared_ptr<AssetHandle> asset_handle_;
+    // gets touched by concurrent lookups under the shared lock
+    std::atomic<std::uint64_t> last_used_frame_{0};
+
+    CachedAsset() = default;
+
+    // the cache moves its entries when it grows, which only happens under
+    // the exclusive lock
+    CachedAsset(CachedAsset &&other) noexcept
+        : asset_handle_{std::move(other.asset_handle_)},
+          last_used_frame_{other.last_used_frame_.load()}
+    {
+    }
+  };
+
+  std::atomic<AssetLoadMode>  default_load_mode_{AssetLoadMode::Sync};
+  std::unique_ptr<ThreadPool> thread_pool_{};
+  std::thread::id             main_thread_id_{std::this_thread::get_id()};
+
+  std::atomic<std::size_t>   memory_budget_{0};
+  std::atomic<std::uint64_t> frame_{0};
+  std::atomic<std::uint64_t> hits_{0};
+  std::atomic<std::uint64_t> misses_{0};
+  std::atomic<std::uint64_t> evictions_{0};
+
+  FlatHashMap<std::string, AssetLoader> asset_loaders_;
+  std::shared_ptr<AssetArchive>         asset_archive_{};
+
+  // read mostly, lookups of cached assets only take a shared lock
+  mutable std::shared_mutex             asset_cache_mutex_;
+  FlatHashMap<std::string, CachedAsset> asset_cache_;
+  // handles that are currently constructed by an asset loader
+  FlatHashMap<std::string, AssetHandleFuture> constructing_assets_;
+
+  // assets that got submitted to the loader threads but are not created yet
+  std::mutex              pending_assets_mutex_;
+  std::condition_variable loaded_assets_condition_;
+  FlatHashMap<std::string, std::shared_ptr<AssetHandle>> pending_assets_;
+  // ids of assets that finished loading on a loader thread
+  std::vector<std::string> loaded_assets_;
+
+  std::shared_ptr<AssetHandle> construct_asset(const Asset  &asset,
+                                               AssetLoadMode load_mode);
+
+  /// Does not throw, the asset stays unready if its data can't be read
+  void load_asset_data(AssetHandle &asset_handle) const;
+
+  void evict_assets();
+
+  bool is_main_thread() const;
+
+  void finish_pending_asset(const std::string &asset_id);
 };
 
 } // namespace dc
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace dc
+{
+
+/**
+ * Bytes of an asset. Point either into a mapped asset archive or into the
+ * contents of a loose file. The owner keeps the memory alive.
+ */
+struct AssetData
+{
+  const std::uint8_t         *data_{nullptr};
+  std::size_t                 size_{0};
+  std::shared_ptr<const void> owner_{};
+};
+
+} // namespace dc
@@ -4,19 +4,21 @@
 namespace dc
 {
 
-void AssetDescription::write(FILE *file) const
+void AssetDescription::write(BinaryWriter &writer) const
 {
-  assert(file);
-  write_value(file, magic_value_);
-  write_value(file, version_);
-  write_string(file, original_file_);
-}
-
-void AssetDescription::write(std::ofstream &file) const
-{
-  write_value(file, magic_value_);
-  write_value(file, version_);
-  write_string(file, original_file_);
+  write_value(writer, magic_value_);
+  write_value(writer, version_);
+  write_string(writer, original_file_);
+  if (has_build_info())
+  {
+    write_value(writer, source_hash_);
+    write_value(writer, settings_hash_);
+    write_value(writer, importer_version_);
+  }
+  if (has_compression_codec())
+  {
+    write_value(writer, compression_codec_);
+  }
 }
 
 void AssetDescription::read(FILE *file)
@@ -25,6 +27,16 @@ void AssetDescription::read(FILE *file)
   read_value(file, magic_value_);
   read_value(file, version_);
   read_string(file, original_file_);
+  if (has_build_info())
+  {
+    read_value(file, source_hash_);
+    read_value(file, settings_hash_);
+    read_value(file, importer_version_);
+  }
+  if (has_compression_codec())
+  {
+    read_value(file, compression_codec_);
+  }
 }
 
 void AssetDescription::read(std::ifstream &file)
@@ -32,6 +44,44 @@ void AssetDescription::read(std::ifstream &file)
   read_value(file, magic_value_);
   read_value(file, version_);
   read_string(file, original_file_);
+  if (has_build_info())
+  {
+    read_value(file, source_hash_);
+    read_value(file, settings_hash_);
+    read_value(file, importer_version_);
+  }
+  if (has_compression_codec())
+  {
+    read_value(file, compression_codec_);
+  }
+}
+
+void AssetDescription::read(BinaryReader &reader)
+{
+  read_value(reader, magic_value_);
+  read_value(reader, version_);
+  read_string(reader, original_file_);
+  if (has_build_info())
+  {
+    read_value(reader, source_hash_);
+    read_value(reader, settings_hash_);
+    read_value(reader, importer_version_);
+  }
+  if (has_compression_codec())
+  {
+    read_value(reader, compression_codec_);
+  }
+}
+
+bool AssetDescription::has_build_info() const
+{
+  return magic_value_ == asset_magic_value_v1 ||
+         magic_value_ == asset_magic_value;
+}
+
+bool AssetDescription::has_compression_codec() const
+{
+  return magic_value_ == asset_magic_value;
 }
 
 } // namespace dc
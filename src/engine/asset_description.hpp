@@ -1,5 +1,7 @@
 #pragma once
 
+#include "block_compression.hpp"
+
 #include <cstdint>
 #include <cstdio>
 #include <fstream>
@@ -8,16 +10,39 @@
 namespace dc
 {
 
+class BinaryReader;
+class BinaryWriter;
+
+/// Magic value of descriptions written before the build info existed
+constexpr std::uint32_t asset_magic_value_v0{0xdeadbeef};
+/// Magic value of descriptions that are followed by the build info
+constexpr std::uint32_t asset_magic_value_v1{0xdeadbef0};
+/// Magic value of descriptions with build info and compression codec
+constexpr std::uint32_t asset_magic_value{0xdeadbef1};
+
 struct AssetDescription
 {
-  std::uint32_t magic_value_{0xdeadbeef};
+  std::uint32_t magic_value_{asset_magic_value};
   std::uint32_t version_{0};
   std::string   original_file_;
 
-  void write(FILE *file) const;
-  void write(std::ofstream &file) const;
+  // Build info. Tells what the asset got imported from, so that imports can
+  // be skipped if nothing changed. Zero if unknown
+  std::uint64_t source_hash_{0};
+  std::uint64_t settings_hash_{0};
+  std::uint32_t importer_version_{0};
+
+  // Codec of everything after the description. The asset cache hands out
+  // the decompressed data
+  CompressionCodec compression_codec_{CompressionCodec::None};
+
+  void write(BinaryWriter &writer) const;
   void read(FILE *file);
   void read(std::ifstream &file);
+  void read(BinaryReader &reader);
+
+  bool has_build_info() const;
+  bool has_compression_codec() const;
 };
 
 } // namespace dc
@@ -8,4 +8,14 @@ AssetHandle::AssetHandle(const Asset &asset) : asset_{asset} {}
 
 Asset AssetHandle::asset() const { return asset_; }
 
+std::size_t AssetHandle::cpu_size() const { return cpu_size_; }
+
+std::size_t AssetHandle::gpu_size() const { return gpu_size_; }
+
+void AssetHandle::set_memory_usage(std::size_t cpu_size, std::size_t gpu_size)
+{
+  cpu_size_ = cpu_size;
+  gpu_size_ = gpu_size;
+}
+
 } // namespace dc
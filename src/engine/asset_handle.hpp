@@ -1,13 +1,17 @@
 #pragma once
 
 #include "asset.hpp"
+#include "asset_data.hpp"
 
+#include <atomic>
+#include <cstddef>
 #include <filesystem>
+#include <memory>
 
 namespace dc
 {
 
-class AssetHandle
+class AssetHandle : public std::enable_shared_from_this<AssetHandle>
 {
 public:
   AssetHandle(const Asset &asset);
@@ -15,11 +19,36 @@ public:
 
   virtual bool is_ready() const = 0;
 
+  /**
+   * Decodes the asset data. The data is only valid during the call. If the
+   * asset gets loaded asynchronously this runs on a loader thread, therefore
+   * it must not touch OpenGL.
+   */
+  virtual void load(const AssetData & /*asset_data*/) {}
+
+  /**
+   * Creates the GPU resources from the data that got produced by load().
+   * Always runs on the main thread. Uploads can be queued on the
+   * GpuUploadQueue, in which case the asset becomes ready once they are done.
+   */
+  virtual void create() {}
+
   Asset asset() const;
 
+  /// Bytes of main memory that the asset keeps resident
+  std::size_t cpu_size() const;
+  /// Bytes of GPU memory that the asset keeps resident
+  std::size_t gpu_size() const;
+
+protected:
+  void set_memory_usage(std::size_t cpu_size, std::size_t gpu_size);
+
 private:
   std::filesystem::path file_path_;
   Asset asset_;
+
+  std::atomic<std::size_t> cpu_size_{0};
+  std::atomic<std::size_t> gpu_size_{0};
 };
 
 } // namespace dc
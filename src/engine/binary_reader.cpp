@@ -0,0 +1,42 @@
+#include "binary_reader.hpp"
+
+#include <cstring>
+
+namespace dc
+{
+
+BinaryReader::BinaryReader(const std::uint8_t *data, std::size_t size)
+    : data_{data},
+      size_{size}
+{
+}
+
+void BinaryReader::read(void *destination, std::size_t size)
+{
+  std::memcpy(destination, read_bytes(size), size);
+}
+
+const std::uint8_t *BinaryReader::read_bytes(std::size_t size)
+{
+  if (size > remaining())
+  {
+    throw std::runtime_error{"Unexpected end of data"};
+  }
+  const auto bytes = data_ + position_;
+  position_ += size;
+  return bytes;
+}
+
+std::size_t BinaryReader::position() const { return position_; }
+
+std::size_t BinaryReader::remaining() const { return size_ - position_; }
+
+void read_string(BinaryReader &reader, std::string &str)
+{
+  std::uint32_t length{};
+  read_value(reader, length);
+  const auto chars = reinterpret_cast<const char *>(reader.read_bytes(length));
+  str.assign(chars, length);
+}
+
+} // namespace dc
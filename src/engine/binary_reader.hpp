@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace dc
+{
+
+/**
+ * Reads binary data from memory. Throws std::runtime_error if a read goes
+ * past the end of the data.
+ */
+class BinaryReader
+{
+public:
+  BinaryReader(const std::uint8_t *data, std::size_t size);
+
+  void read(void *destination, std::size_t size);
+
+  /// Returns a pointer to the next size bytes and skips them
+  const std::uint8_t *read_bytes(std::size_t size);
+
+  std::size_t position() const;
+  std::size_t remaining() const;
+
+private:
+  const std::uint8_t *data_{};
+  std::size_t         size_{};
+  std::size_t         position_{0};
+};
+
+void read_string(BinaryReader &reader, std::string &str);
+
+template <typename T> void read_value(BinaryReader &reader, T &value)
+{
+  reader.read(&value, sizeof(T));
+}
+
+template <typename T>
+void read_vector(BinaryReader &reader, std::vector<T> &value)
+{
+  std::uint64_t count{};
+  read_value(reader, count);
+  if (count > reader.remaining() / sizeof(T))
+  {
+    throw std::runtime_error{"Vector is larger than the remaining data"};
+  }
+  value.resize(count);
+  if (count > 0)
+  {
+    reader.read(value.data(), sizeof(T) * count);
+  }
+}
+
+template <typename T>
+void read_vector_complex(BinaryReader &reader, std::vector<T> &value)
+{
+  std::uint64_t count{};
+  read_value(reader, count);
+  if (count > reader.remaining())
+  {
+    throw std::runtime_error{"Vector is larger than the remaining data"};
+  }
+  value.resize(count);
+  for (auto &v : value)
+  {
+    v.read(reader);
+  }
+}
+
+} // namespace dc
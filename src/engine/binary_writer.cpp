@@ -0,0 +1,71 @@
+#include "binary_writer.hpp"
+#include "filesystem.hpp"
+
+#include <cstdio>
+#include <stdexcept>
+#include <utility>
+
+namespace dc
+{
+
+void BinaryWriter::write(const void *source, std::size_t size)
+{
+  const auto bytes = static_cast<const std::uint8_t *>(source);
+  data_.insert(data_.end(), bytes, bytes + size);
+}
+
+void BinaryWriter::align(std::size_t alignment)
+{
+  const auto remainder = data_.size() % alignment;
+  if (remainder != 0)
+  {
+    data_.resize(data_.size() + alignment - remainder, 0);
+  }
+}
+
+const std::uint8_t *BinaryWriter::data() const { return data_.data(); }
+
+std::size_t BinaryWriter::size() const { return data_.size(); }
+
+void BinaryWriter::compress(std::size_t offset, CompressionCodec codec)
+{
+  if (codec == CompressionCodec::None)
+  {
+    return;
+  }
+  if (codec != CompressionCodec::Lz || offset > data_.size())
+  {
+    throw std::runtime_error{"Can not compress the data"};
+  }
+
+  const auto compressed_data =
+      compress_blocks(data_.data() + offset, data_.size() - offset);
+  data_.resize(offset);
+  data_.insert(data_.end(), compressed_data.begin(), compressed_data.end());
+}
+
+std::vector<std::uint8_t> BinaryWriter::release()
+{
+  auto data = std::move(data_);
+  data_.clear();
+  return data;
+}
+
+void BinaryWriter::save(const std::filesystem::path &file_path) const
+{
+  AtomicFile atomic_file{file_path};
+  if (std::fwrite(data_.data(), 1, data_.size(), atomic_file.file()) !=
+      data_.size())
+  {
+    throw std::runtime_error{"Could not write file " + file_path.string()};
+  }
+  atomic_file.commit();
+}
+
+void write_string(BinaryWriter &writer, const std::string &str)
+{
+  write_value(writer, static_cast<std::uint32_t>(str.size()));
+  writer.write(str.data(), str.size());
+}
+
+} // namespace dc
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "block_compression.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace dc
+{
+
+/**
+ * Writes binary data into a memory buffer, which gets written to a file with
+ * a single call. Counterpart of BinaryReader.
+ */
+class BinaryWriter
+{
+public:
+  void write(const void *source, std::size_t size);
+
+  /// Appends zero bytes until the position is a multiple of the alignment
+  void align(std::size_t alignment);
+
+  const std::uint8_t *data() const;
+  std::size_t         size() const;
+
+  /**
+   * Replaces everything after the offset with its compressed blocks. Does
+   * nothing for CompressionCodec::None.
+   */
+  void compress(std::size_t offset, CompressionCodec codec);
+
+  /// Moves the buffer out of the writer, which is empty afterwards
+  std::vector<std::uint8_t> release();
+
+  /// Writes the buffer atomically to the file. Throws on errors
+  void save(const std::filesystem::path &file_path) const;
+
+private:
+  std::vector<std::uint8_t> data_;
+};
+
+void write_string(BinaryWriter &writer, const std::string &str);
+
+template <typename T> void write_value(BinaryWriter &writer, const T &value)
+{
+  writer.write(&value, sizeof(T));
+}
+
+template <typename T>
+void write_vector(BinaryWriter &writer, const std::vector<T> &value)
+{
+  write_value(writer, static_cast<std::uint64_t>(value.size()));
+  if (!value.empty())
+  {
+    writer.write(value.data(), sizeof(T) * value.size());
+  }
+}
+
+template <typename T>
+void write_vector_complex(BinaryWriter &writer, const std::vector<T> &value)
+{
+  write_value(writer, static_cast<std::uint64_t>(value.size()));
+  for (const auto &v : value)
+  {
+    v.save(writer);
+  }
+}
+
+} // namespace dc
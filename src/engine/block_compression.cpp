@@ -0,0 +1,434 @@
+#include "block_compression.hpp"
+#include "binary_reader.hpp"
+#include "binary_writer.hpp"
+#include "job_system.hpp"
+#include "profiling.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+
+// DCBZ was the format without block checksums
+constexpr std::uint32_t block_compression_magic_value{0x32424344}; // DCB2
+
+// the size of a block that is stored uncompressed has this bit set
+constexpr std::uint32_t stored_block_flag{0x80000000};
+
+constexpr std::size_t min_match_length{4};
+constexpr std::size_t max_match_offset{0xffff};
+constexpr std::size_t hash_bits{14};
+
+struct BlockCompressionHeader
+{
+  std::uint32_t magic_value_{block_compression_magic_value};
+  std::uint32_t block_size_{0};
+  std::uint64_t size_{0};
+  std::uint64_t blocks_count_{0};
+};
+
+struct Block
+{
+  const std::uint8_t *data_{};
+  std::size_t         size_{0};
+  bool                is_stored_{false};
+
+  std::size_t destination_offset_{0};
+  std::size_t destination_size_{0};
+
+  std::uint32_t checksum_{0};
+};
+
+std::uint32_t load_u32(const std::uint8_t *data)
+{
+  std::uint32_t value{};
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+/**
+ * Checksum of the decompressed data of a block. Multiplicative hash over
+ * 64 bit words, fast enough to not show up next to the decompression.
+ */
+std::uint32_t block_checksum(const std::uint8_t *data, std::size_t size)
+{
+  std::uint64_t state{size};
+  std::size_t   position{0};
+  for (; position + sizeof(std::uint64_t) <= size;
+       position += sizeof(std::uint64_t))
+  {
+    std::uint64_t word{};
+    std::memcpy(&word, data + position, sizeof(word));
+    state = (state ^ word) * 0x9e3779b97f4a7c15ull;
+  }
+  for (; position < size; ++position)
+  {
+    state = (state ^ data[position]) * 0x9e3779b97f4a7c15ull;
+  }
+  state ^= state >> 32;
+  return static_cast<std::uint32_t>(state);
+}
+
+std::size_t hash_sequence(std::uint32_t sequence)
+{
+  return (sequence * 2654435761u) >> (32 - hash_bits);
+}
+
+void write_length(std::vector<std::uint8_t> &output, std::size_t length)
+{
+  while (length >= 255)
+  {
+    output.push_back(255);
+    length -= 255;
+  }
+  output.push_back(static_cast<std::uint8_t>(length));
+}
+
+/**
+ * A sequence is a token with both lengths, the literals and the match. The
+ * last sequence of a block only has literals.
+ */
+void write_sequence(std::vector<std::uint8_t> &output,
+                    const std::uint8_t        *literals,
+                    std::size_t                literals_count,
+                    std::size_t                match_offset,
+                    std::size_t                match_length)
+{
+  const auto is_last = match_length == 0;
+  const auto length  = is_last ? 0 : match_length - min_match_length;
+  const auto token   = static_cast<std::uint8_t>(
+      (std::min<std::size_t>(literals_count, 15) << 4) |
+      std::min<std::size_t>(length, 15));
+  output.push_back(token);
+  if (literals_count >= 15)
+  {
+    write_length(output, literals_count - 15);
+  }
+  output.insert(output.end(), literals, literals + literals_count);
+  if (is_last)
+  {
+    return;
+  }
+
+  output.push_back(static_cast<std::uint8_t>(match_offset & 0xff));
+  output.push_back(static_cast<std::uint8_t>(match_offset >> 8));
+  if (length >= 15)
+  {
+    write_length(output, length - 15);
+  }
+}
+
+/** Appends the compressed block to the output. Greedy hash chain of one */
+void compress_block(const std::uint8_t         *data,
+                    std::size_t                 size,
+                    std::vector<std::uint32_t> &positions,
+                    std::vector<std::uint8_t>  &output)
+{
+  // positions are stored plus one, zero marks an empty slot
+  std::fill(positions.begin(), positions.end(), 0u);
+
+  std::size_t anchor{0};
+  std::size_t position{0};
+  while (position + min_match_length <= size)
+  {
+    const auto sequence  = load_u32(data + position);
+    auto      &slot      = positions[hash_sequence(sequence)];
+    const auto candidate = static_cast<std::size_t>(slot);
+    slot                 = static_cast<std::uint32_t>(position + 1);
+
+    if (candidate == 0 || position + 1 - candidate > max_match_offset ||
+        load_u32(data + candidate - 1) != sequence)
+    {
+      // skip faster through data that does not compress
+      position += 1 + ((position - anchor) >> 6);
+      continue;
+    }
+
+    const auto match = candidate - 1;
+    auto       length{min_match_length};
+    while (position + length < size &&
+           data[match + length] == data[position + length])
+    {
+      ++length;
+    }
+
+    write_sequence(output,
+                   data + anchor,
+                   position - anchor,
+                   position - match,
+                   length);
+    position += length;
+    anchor = position;
+  }
+
+  write_sequence(output, data + anchor, size - anchor, 0, 0);
+}
+
+bool read_length(const std::uint8_t *data,
+                 std::size_t         size,
+                 std::size_t        &position,
+                 std::size_t        &length)
+{
+  std::uint8_t value{};
+  do
+  {
+    if (position >= size)
+    {
+      return false;
+    }
+    value = data[position++];
+    length += value;
+  } while (value == 255);
+  return true;
+}
+
+/** Returns false if the block is corrupt. Never writes out of bounds */
+bool decompress_block_data(const Block &block, std::uint8_t *destination)
+{
+  if (block.is_stored_)
+  {
+    if (block.size_ != block.destination_size_)
+    {
+      return false;
+    }
+    std::memcpy(destination, block.data_, block.size_);
+    return true;
+  }
+
+  const auto  data = block.data_;
+  const auto  size = block.size_;
+  std::size_t position{0};
+  std::size_t destination_position{0};
+  while (true)
+  {
+    if (position >= size)
+    {
+      return false;
+    }
+    const auto token = data[position++];
+
+    std::size_t literals_count = token >> 4;
+    if (literals_count == 15 &&
+        !read_length(data, size, position, literals_count))
+    {
+      return false;
+    }
+    if (literals_count > size - position ||
+        literals_count > block.destination_size_ - destination_position)
+    {
+      return false;
+    }
+    std::memcpy(destination + destination_position,
+                data + position,
+                literals_count);
+    position += literals_count;
+    destination_position += literals_count;
+    if (position == size)
+    {
+      return destination_position == block.destination_size_;
+    }
+
+    if (size - position < 2)
+    {
+      return false;
+    }
+    const std::size_t match_offset =
+        data[position] | (static_cast<std::size_t>(data[position + 1]) << 8);
+    position += 2;
+    std::size_t match_length = token & 0x0f;
+    if (match_length == 15 && !read_length(data, size, position, match_length))
+    {
+      return false;
+    }
+    match_length += min_match_length;
+    if (match_offset == 0 || match_offset > destination_position ||
+        match_length > block.destination_size_ - destination_position)
+    {
+      return false;
+    }
+
+    const auto match = destination + destination_position - match_offset;
+    const auto to    = destination + destination_position;
+    if (match_offset >= match_length)
+    {
+      std::memcpy(to, match, match_length);
+    }
+    else
+    {
+      // overlapping matches repeat the last bytes
+      for (std::size_t i{0}; i < match_length; ++i)
+      {
+        to[i] = match[i];
+      }
+    }
+    destination_position += match_length;
+  }
+}
+
+bool decompress_block(const Block &block, std::uint8_t *destination)
+{
+  return decompress_block_data(block, destination) &&
+         block_checksum(destination, block.destination_size_) ==
+             block.checksum_;
+}
+
+std::vector<Block> read_blocks(const std::uint8_t *data,
+                               std::size_t         size,
+                               std::size_t        &decompressed_size)
+{
+  dc::BinaryReader       reader{data, size};
+  BlockCompressionHeader header{};
+  dc::read_value(reader, header);
+  if (header.magic_value_ != block_compression_magic_value ||
+      header.block_size_ == 0 ||
+      header.blocks_count_ >
+          reader.remaining() / (2 * sizeof(std::uint32_t)) ||
+      // a length byte expands to at most 255 bytes
+      header.size_ / 256 > size ||
+      header.blocks_count_ !=
+          (header.size_ + header.block_size_ - 1) / header.block_size_)
+  {
+    throw std::runtime_error{"Corrupt compressed data"};
+  }
+
+  std::vector<std::uint32_t> block_sizes(header.blocks_count_);
+  std::vector<std::uint32_t> block_checksums(header.blocks_count_);
+  if (!block_sizes.empty())
+  {
+    reader.read(block_sizes.data(),
+                block_sizes.size() * sizeof(std::uint32_t));
+    reader.read(block_checksums.data(),
+                block_checksums.size() * sizeof(std::uint32_t));
+  }
+
+  std::vector<Block> blocks(block_sizes.size());
+  for (std::size_t i{0}; i < blocks.size(); ++i)
+  {
+    auto &block               = blocks[i];
+    block.is_stored_          = (block_sizes[i] & stored_block_flag) != 0;
+    block.size_               = block_sizes[i] & ~stored_block_flag;
+    block.data_               = reader.read_bytes(block.size_);
+    block.destination_offset_ = i * header.block_size_;
+    block.destination_size_ =
+        std::min<std::size_t>(header.block_size_,
+                              header.size_ - block.destination_offset_);
+    block.checksum_ = block_checksums[i];
+  }
+
+  if (reader.remaining() != 0)
+  {
+    throw std::runtime_error{"Corrupt compressed data"};
+  }
+
+  decompressed_size = header.size_;
+  return blocks;
+}
+
+} // namespace
+
+namespace dc
+{
+
+std::vector<std::uint8_t> compress_blocks(const std::uint8_t *data,
+                                          std::size_t         size)
+{
+  DC_PROFILE_SCOPE("compress_blocks()");
+
+  const auto blocks_count =
+      (size + compression_block_size - 1) / compression_block_size;
+
+  BlockCompressionHeader header{};
+  header.block_size_   = static_cast<std::uint32_t>(compression_block_size);
+  header.size_         = size;
+  header.blocks_count_ = blocks_count;
+
+  std::vector<std::uint32_t> block_sizes(blocks_count);
+  std::vector<std::uint32_t> block_checksums(blocks_count);
+  std::vector<std::uint8_t>  blocks_data;
+  blocks_data.reserve(size / 2);
+  std::vector<std::uint32_t> positions(std::size_t{1} << hash_bits);
+  for (std::size_t i{0}; i < blocks_count; ++i)
+  {
+    const auto block_data = data + i * compression_block_size;
+    const auto block_size =
+        std::min(compression_block_size, size - i * compression_block_size);
+
+    const auto offset = blocks_data.size();
+    compress_block(block_data, block_size, positions, blocks_data);
+    auto compressed_size = blocks_data.size() - offset;
+    if (compressed_size >= block_size)
+    {
+      blocks_data.resize(offset);
+      blocks_data.insert(blocks_data.end(),
+                         block_data,
+                         block_data + block_size);
+      compressed_size = block_size | stored_block_flag;
+    }
+    block_sizes[i]     = static_cast<std::uint32_t>(compressed_size);
+    block_checksums[i] = block_checksum(block_data, block_size);
+  }
+
+  BinaryWriter writer{};
+  write_value(writer, header);
+  writer.write(block_sizes.data(),
+               block_sizes.size() * sizeof(std::uint32_t));
+  writer.write(block_checksums.data(),
+               block_checksums.size() * sizeof(std::uint32_t));
+  writer.write(blocks_data.data(), blocks_data.size());
+  return writer.release();
+}
+
+std::size_t decompressed_size(const std::uint8_t *data, std::size_t size)
+{
+  std::size_t result{0};
+  read_blocks(data, size, result);
+  return result;
+}
+
+void decompress_blocks(const std::uint8_t *data,
+                       std::size_t         size,
+                       std::uint8_t       *destination,
+                       std::size_t         destination_size,
+                       JobSystem          *job_system)
+{
+  DC_PROFILE_SCOPE("decompress_blocks()");
+
+  std::size_t size_of_blocks{0};
+  const auto  blocks = read_blocks(data, size, size_of_blocks);
+  if (size_of_blocks != destination_size)
+  {
+    throw std::runtime_error{"Compressed data does not fit the destination"};
+  }
+
+  std::atomic<bool> is_corrupt{false};
+  const auto        decompress_range = [&](std::size_t first, std::size_t last)
+  {
+    for (auto i{first}; i < last; ++i)
+    {
+      const auto &block = blocks[i];
+      if (!decompress_block(block, destination + block.destination_offset_))
+      {
+        is_corrupt = true;
+      }
+    }
+  };
+
+  if (job_system)
+  {
+    job_system->parallel_for(0, blocks.size(), 1, decompress_range);
+  }
+  else
+  {
+    decompress_range(0, blocks.size());
+  }
+
+  if (is_corrupt)
+  {
+    throw std::runtime_error{"Corrupt compressed block"};
+  }
+}
+
+} // namespace dc
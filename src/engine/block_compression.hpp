@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dc
+{
+
+class JobSystem;
+
+/** Codecs of asset payloads. They get stored, so only append */
+enum class CompressionCodec : std::uint32_t
+{
+  None,
+  /// Byte oriented LZ77 in the style of LZ4, fast to decompress
+  Lz,
+};
+
+/**
+ * Size of the blocks the data gets split into. Every block gets compressed
+ * on its own, so blocks can be decompressed in parallel.
+ */
+constexpr std::size_t compression_block_size{128 * 1024};
+
+/**
+ * Compresses the data block by block. Blocks that do not get smaller are
+ * stored as they are. Every block keeps a checksum of its data, so that
+ * corrupt blocks get detected when they are decompressed.
+ */
+std::vector<std::uint8_t> compress_blocks(const std::uint8_t *data,
+                                          std::size_t         size);
+
+/**
+ * Size of the data before compression. Throws std::runtime_error if the
+ * compressed data is corrupt.
+ */
+std::size_t decompressed_size(const std::uint8_t *data, std::size_t size);
+
+/**
+ * Decompresses into the destination, which needs to be decompressed_size()
+ * bytes large. If a job system is given, the blocks get decompressed as
+ * jobs and the calling thread helps with them. Throws std::runtime_error if
+ * the compressed data is corrupt.
+ */
+void decompress_blocks(const std::uint8_t *data,
+                       std::size_t         size,
+                       std::uint8_t       *destination,
+                       std::size_t         destination_size,
+                       JobSystem          *job_system = nullptr);
+
+} // namespace dc
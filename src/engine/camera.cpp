@@ -206,44 +206,44 @@ void Camera::recalculate_projection_matrix()
 
 glm::mat4 Camera::projection_matrix() const { return projection_matrix_; }
 
-void Camera::save(FILE *file) const
-{
-    write_value(file, position_);
-    write_value(file, front_);
-    write_value(file, front_movement_);
-    write_value(file, world_up_);
-    write_value(file, up_);
-    write_value(file, right_);
-    write_value(file, yaw_);
-    write_value(file, pitch_);
-    write_value(file, movement_speed_);
-    write_value(file, mouse_sensitivity_);
-    write_value(file, zoom_);
-    write_value(file, free_fly_);
-    write_value(file, near_plane_);
-    write_value(file, far_plane_);
-    write_value(file, aspect_ratio_);
-    write_value(file, projection_matrix_);
-}
-
-void Camera::read(FILE *file)
-{
-  read_value(file, position_);
-  read_value(file, front_);
-  read_value(file, front_movement_);
-  read_value(file, world_up_);
-  read_value(file, up_);
-  read_value(file, right_);
-  read_value(file, yaw_);
-  read_value(file, pitch_);
-  read_value(file, movement_speed_);
-  read_value(file, mouse_sensitivity_);
-  read_value(file, zoom_);
-  read_value(file, free_fly_);
-  read_value(file, near_plane_);
-  read_value(file, far_plane_);
-  read_value(file, aspect_ratio_);
-  read_value(file, projection_matrix_);
+void Camera::save(BinaryWriter &writer) const
+{
+    write_value(writer, position_);
+    write_value(writer, front_);
+    write_value(writer, front_movement_);
+    write_value(writer, world_up_);
+    write_value(writer, up_);
+    write_value(writer, right_);
+    write_value(writer, yaw_);
+    write_value(writer, pitch_);
+    write_value(writer, movement_speed_);
+    write_value(writer, mouse_sensitivity_);
+    write_value(writer, zoom_);
+    write_value(writer, free_fly_);
+    write_value(writer, near_plane_);
+    write_value(writer, far_plane_);
+    write_value(writer, aspect_ratio_);
+    write_value(writer, projection_matrix_);
+}
+
+void Camera::read(BinaryReader &reader)
+{
+  read_value(reader, position_);
+  read_value(reader, front_);
+  read_value(reader, front_movement_);
+  read_value(reader, world_up_);
+  read_value(reader, up_);
+  read_value(reader, right_);
+  read_value(reader, yaw_);
+  read_value(reader, pitch_);
+  read_value(reader, movement_speed_);
+  read_value(reader, mouse_sensitivity_);
+  read_value(reader, zoom_);
+  read_value(reader, free_fly_);
+  read_value(reader, near_plane_);
+  read_value(reader, far_plane_);
+  read_value(reader, aspect_ratio_);
+  read_value(reader, projection_matrix_);
 }
 
 void Camera::set_enable_acceleration(bool value)
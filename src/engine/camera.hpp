@@ -7,6 +7,9 @@
 namespace dc
 {
 
+class BinaryReader;
+class BinaryWriter;
+
 enum class ProjectionType : std::uint8_t
 {
   Orthographic = 0,
@@ -62,8 +65,8 @@ public:
 
   glm::mat4 projection_matrix() const;
 
-  void save(FILE *file) const;
-  void read(FILE *file);
+  void save(BinaryWriter &writer) const;
+  void read(BinaryReader &reader);
 
 private:
   glm::vec3 position_{0.0f};
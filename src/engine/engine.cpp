@@ -14,9 +14,11 @@
 #include "time.hpp"
 #include "window.hpp"
 
+#include <algorithm>
 #include <cstdlib>
 #include <memory>
 #include <stdexcept>
+#include <thread>
 
 namespace dc
 {
@@ -96,9 +98,9 @@ void Engine::init_logger()
   constexpr auto ansi_grey     = "\033[0;90m";
 
   #ifdef _WIN32
-  auto sink = std::make_shared<spdlog::sinks::wincolor_stdout_sink_st>();
+  auto sink = std::make_shared<spdlog::sinks::wincolor_stdout_sink_mt>();
   #else
-  auto sink = std::make_shared<spdlog::sinks::ansicolor_stdout_sink_st>();
+  auto sink = std::make_shared<spdlog::sinks::ansicolor_stdout_sink_mt>();
   sink->set_color(spdlog::level::debug, ansi_grey);
   sink->set_color(spdlog::level::info, ansi_blue);
   sink->set_color(spdlog::level::warn, ansi_yellow);
@@ -167,7 +169,19 @@ void Engine::init(int argc, char *argv[], bool show_window)
   layer_stack_.register_asset_loaders();
   load_config();
   init_logger();
+
+  const auto hardware_threads =
+      static_cast<int>(std::thread::hardware_concurrency());
+  const auto job_threads =
+      config_->config_value_int("JobSystem",
+                                "worker_threads",
+                                std::max(hardware_threads - 1, 1));
+  job_system_ = std::make_unique<JobSystem>(job_threads, "Jobs");
+  DC_LOG_INFO("Job system uses {} worker threads", job_threads);
+
+  asset_cache_->init();
   window_ = std::make_shared<Window>(show_window);
+  gpu_upload_queue_->init();
   layer_stack_.init();
 }
 
@@ -189,6 +203,18 @@ void Engine::main_loop()
         event_manager_->dispatch_events();
       }
 
+      {
+        DC_PROFILE_SCOPE("Engine::main_loop() - Create loaded assets");
+        DC_TIME_SCOPE_PERF("Create loaded assets");
+        asset_cache_->update();
+      }
+
+      {
+        DC_PROFILE_SCOPE("Engine::main_loop() - GPU uploads");
+        DC_TIME_SCOPE_PERF("GPU uploads");
+        gpu_upload_queue_->process();
+      }
+
       // calculate delta time
       const auto delta_time = (current_time_millis() - last_time) / 1000.0f;
       last_time             = current_time_millis();
@@ -219,9 +245,13 @@ void Engine::shutdown()
   layer_stack_.shutdown();
   layer_stack_.clear();
 
-  // unload asset cache
+  // drop pending uploads and unload asset cache
+  gpu_upload_queue_->shutdown();
   asset_cache_ = nullptr;
 
+  // layers and asset loaders submit jobs until they are gone
+  job_system_ = nullptr;
+
   // stop the window
   window_ = nullptr;
 
@@ -247,6 +277,13 @@ PerformanceProfiler *Engine::performance_profiler()
 
 AssetCache *Engine::asset_cache() const { return asset_cache_.get(); }
 
+GpuUploadQueue *Engine::gpu_upload_queue() const
+{
+  return gpu_upload_queue_.get();
+}
+
+JobSystem *Engine::job_system() const { return job_system_.get(); }
+
 AssetImporterManager *Engine::asset_importer_manager() const
 {
   return asset_importer_manager_.get();
@@ -4,7 +4,9 @@
 #include "asset_importer_manager.hpp"
 #include "config.hpp"
 #include "event_manager.hpp"
+#include "gpu_upload_queue.hpp"
 #include "gl.hpp"
+#include "job_system.hpp"
 #include "layer_stack.hpp"
 #include "log.hpp"
 #include "time.hpp"
@@ -34,6 +36,8 @@ public:
   PerformanceProfiler *performance_profiler();
 
   AssetCache           *asset_cache() const;
+  GpuUploadQueue       *gpu_upload_queue() const;
+  JobSystem            *job_system() const;
   AssetImporterManager *asset_importer_manager() const;
   std::filesystem::path base_directory() const;
 
@@ -46,7 +50,10 @@ private:
   LayerStack                    layer_stack_;
   std::shared_ptr<Window>       window_;
   std::unique_ptr<EventManager> event_manager_{};
+  std::unique_ptr<JobSystem>    job_system_{};
   std::unique_ptr<AssetCache> asset_cache_{std::make_unique<AssetCache>()};
+  std::unique_ptr<GpuUploadQueue> gpu_upload_queue_{
+      std::make_unique<GpuUploadQueue>()};
   std::unique_ptr<AssetImporterManager> asset_importer_manager_{
       std::make_unique<AssetImporterManager>()};
 
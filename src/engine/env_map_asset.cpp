@@ -1,6 +1,7 @@
 #include "env_map_asset.hpp"
 #include "asset.hpp"
 #include "asset_handle.hpp"
+#include "binary_reader.hpp"
 #include "environment_map.hpp"
 #include "gl_cube_texture.hpp"
 #include "log.hpp"
@@ -12,34 +13,46 @@
 namespace dc
 {
 
-EnvMapAssetHandle::EnvMapAssetHandle(const std::filesystem::path &file_path,
-                                     const Asset &                asset)
-    : AssetHandle(asset)
+EnvMapAssetHandle::EnvMapAssetHandle(const Asset &asset) : AssetHandle(asset) {}
+
+EnvMapAssetHandle::~EnvMapAssetHandle() = default;
+
+void EnvMapAssetHandle::load(const AssetData &asset_data)
 {
   try
   {
-    EnvironmentMapDescription env_map_description{};
-    env_map_description.read(file_path);
+    auto env_map_description = std::make_unique<EnvironmentMapDescription>();
+    BinaryReader reader{asset_data.data_, asset_data.size_};
+    env_map_description->read(reader);
 
-    if (env_map_description.env_map_data_.empty())
+    if (env_map_description->env_map_data_.empty())
     {
-      throw std::runtime_error("Env map " + file_path.string() +
-                               " data is empty");
+      throw std::runtime_error("Env map " + asset().id() + " data is empty");
     }
-
-    env_map_ =
-        std::make_shared<EnvironmentMap>(asset.id(),
-                                         env_map_description.env_map_data_);
-    ;
+    env_map_description_ = std::move(env_map_description);
   }
   catch (const std::runtime_error &error)
   {
     DC_LOG_WARN("Could not load env map asset {}: {}",
-                file_path.string(),
+                asset().id(),
                 error.what());
   }
 }
 
+void EnvMapAssetHandle::create()
+{
+  if (!env_map_description_)
+  {
+    return;
+  }
+
+  set_memory_usage(env_map_description_->env_map_data_.size(), 0);
+  env_map_ = std::make_shared<EnvironmentMap>(
+      asset().id(),
+      std::move(env_map_description_->env_map_data_));
+  env_map_description_ = nullptr;
+}
+
 bool EnvMapAssetHandle::is_ready() const { return env_map_ != nullptr; }
 
 std::shared_ptr<EnvironmentMap> EnvMapAssetHandle::get() const
@@ -48,9 +61,10 @@ std::shared_ptr<EnvironmentMap> EnvMapAssetHandle::get() const
 }
 
 std::shared_ptr<AssetHandle>
-env_map_asset_loader(const std::filesystem::path &file_path, const Asset &asset)
+env_map_asset_loader(const std::filesystem::path & /*file_path*/,
+                     const Asset &asset)
 {
-  return std::make_shared<EnvMapAssetHandle>(file_path, asset);
+  return std::make_shared<EnvMapAssetHandle>(asset);
 }
 
 } // namespace dc
@@ -10,17 +10,24 @@
 namespace dc
 {
 
+struct EnvironmentMapDescription;
+
 class EnvMapAssetHandle : public AssetHandle
 {
 public:
-  EnvMapAssetHandle(const std::filesystem::path &file_path, const Asset &asset);
+  EnvMapAssetHandle(const Asset &asset);
+  ~EnvMapAssetHandle() override;
 
   bool is_ready() const override;
 
+  void load(const AssetData &asset_data) override;
+  void create() override;
+
   std::shared_ptr<EnvironmentMap> get() const;
 
 private:
-  std::shared_ptr<EnvironmentMap> env_map_{};
+  std::unique_ptr<EnvironmentMapDescription> env_map_description_{};
+  std::shared_ptr<EnvironmentMap>            env_map_{};
 };
 
 std::shared_ptr<AssetHandle>
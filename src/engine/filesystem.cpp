@@ -4,6 +4,16 @@
 #include <fstream>
 #include <ios>
 #include <stdexcept>
+#include <system_error>
+
+#ifdef WIN32
+#include <windows.h>
+#else // WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // WIN32
 
 namespace dc
 {
@@ -11,14 +21,166 @@ namespace dc
 std::vector<std::uint8_t>
 read_binary_file(const std::filesystem::path &file_path)
 {
-  std::ifstream instream(file_path, std::ios::in | std::ios::binary);
+  std::ifstream instream(file_path,
+                         std::ios::in | std::ios::binary | std::ios::ate);
   if (!instream.is_open())
   {
     throw std::runtime_error("Could not open " + file_path.string());
   }
-  std::vector<uint8_t> data((std::istreambuf_iterator<char>(instream)),
-                            std::istreambuf_iterator<char>());
+  // read the whole file at once instead of going char by char
+  std::vector<std::uint8_t> data(static_cast<std::size_t>(instream.tellg()));
+  instream.seekg(0);
+  instream.read(reinterpret_cast<char *>(data.data()), data.size());
+  if (!instream)
+  {
+    throw std::runtime_error("Could not read " + file_path.string());
+  }
   return data;
 }
 
+AtomicFile::AtomicFile(const std::filesystem::path &file_path)
+    : file_path_{file_path},
+      temp_file_path_{file_path}
+{
+  temp_file_path_ += ".tmp";
+  file_ = std::fopen(temp_file_path_.string().c_str(), "wb");
+  if (!file_)
+  {
+    throw std::runtime_error("Could not open file " + file_path.string());
+  }
+}
+
+AtomicFile::~AtomicFile()
+{
+  if (file_)
+  {
+    std::fclose(file_);
+    std::error_code error;
+    std::filesystem::remove(temp_file_path_, error);
+  }
+}
+
+std::FILE *AtomicFile::file() const { return file_; }
+
+void AtomicFile::commit()
+{
+  const auto has_write_error = std::ferror(file_) != 0;
+  const auto close_result    = std::fclose(file_);
+  file_                      = nullptr;
+  if (has_write_error || close_result != 0)
+  {
+    std::error_code error;
+    std::filesystem::remove(temp_file_path_, error);
+    throw std::runtime_error("Could not write " + file_path_.string());
+  }
+
+  std::filesystem::rename(temp_file_path_, file_path_);
+}
+
+#ifdef WIN32
+
+MappedFile::MappedFile(const std::filesystem::path &file_path)
+{
+  file_ = CreateFileW(file_path.wstring().c_str(),
+                      GENERIC_READ,
+                      FILE_SHARE_READ,
+                      nullptr,
+                      OPEN_EXISTING,
+                      FILE_ATTRIBUTE_NORMAL,
+                      nullptr);
+  if (file_ == INVALID_HANDLE_VALUE)
+  {
+    file_ = nullptr;
+    throw std::runtime_error("Could not open " + file_path.string());
+  }
+
+  LARGE_INTEGER file_size{};
+  GetFileSizeEx(file_, &file_size);
+  size_ = static_cast<std::size_t>(file_size.QuadPart);
+  if (size_ == 0)
+  {
+    return;
+  }
+
+  mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mapping_)
+  {
+    CloseHandle(file_);
+    throw std::runtime_error("Could not map " + file_path.string());
+  }
+  data_ = static_cast<const std::uint8_t *>(
+      MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+  if (!data_)
+  {
+    CloseHandle(mapping_);
+    CloseHandle(file_);
+    throw std::runtime_error("Could not map " + file_path.string());
+  }
+}
+
+MappedFile::~MappedFile()
+{
+  if (data_)
+  {
+    UnmapViewOfFile(data_);
+  }
+  if (mapping_)
+  {
+    CloseHandle(mapping_);
+  }
+  if (file_)
+  {
+    CloseHandle(file_);
+  }
+}
+
+#else // WIN32
+
+MappedFile::MappedFile(const std::filesystem::path &file_path)
+{
+  const auto file = open(file_path.c_str(), O_RDONLY);
+  if (file < 0)
+  {
+    throw std::runtime_error("Could not open " + file_path.string());
+  }
+
+  struct stat file_stat
+  {
+  };
+  if (fstat(file, &file_stat) != 0)
+  {
+    close(file);
+    throw std::runtime_error("Could not stat " + file_path.string());
+  }
+  size_ = static_cast<std::size_t>(file_stat.st_size);
+  if (size_ == 0)
+  {
+    close(file);
+    return;
+  }
+
+  const auto data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file, 0);
+  // the mapping stays valid after the file got closed
+  close(file);
+  if (data == MAP_FAILED)
+  {
+    throw std::runtime_error("Could not map " + file_path.string());
+  }
+  data_ = static_cast<const std::uint8_t *>(data);
+}
+
+MappedFile::~MappedFile()
+{
+  if (data_)
+  {
+    munmap(const_cast<std::uint8_t *>(data_), size_);
+  }
+}
+
+#endif // WIN32
+
+const std::uint8_t *MappedFile::data() const { return data_; }
+
+std::size_t MappedFile::size() const { return size_; }
+
 } // namespace dc
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <cstdio>
 #include <filesystem>
 #include <vector>
 
@@ -9,4 +11,60 @@ namespace dc
 
 std::vector<std::uint8_t>
 read_binary_file(const std::filesystem::path &file_path);
-}
+
+/**
+ * Writes a file under a temporary name and moves it to its final name on
+ * commit. An interrupted or failed write never leaves a half written file
+ * behind, the previous file stays untouched. Uncommitted files get removed.
+ */
+class AtomicFile
+{
+public:
+  explicit AtomicFile(const std::filesystem::path &file_path);
+  ~AtomicFile();
+
+  std::FILE *file() const;
+
+  /// Closes the file and replaces the target with it. Throws on write errors
+  void commit();
+
+private:
+  std::filesystem::path file_path_;
+  std::filesystem::path temp_file_path_;
+  std::FILE            *file_{nullptr};
+
+  AtomicFile(const AtomicFile &)            = delete;
+  AtomicFile(AtomicFile &&)                 = delete;
+  AtomicFile &operator=(const AtomicFile &) = delete;
+  AtomicFile &operator=(AtomicFile &&)      = delete;
+};
+
+/**
+ * Maps a file read only into memory. Pages get loaded by the OS on first
+ * access.
+ */
+class MappedFile
+{
+public:
+  explicit MappedFile(const std::filesystem::path &file_path);
+  ~MappedFile();
+
+  const std::uint8_t *data() const;
+  std::size_t         size() const;
+
+private:
+  const std::uint8_t *data_{nullptr};
+  std::size_t         size_{0};
+
+#ifdef WIN32
+  void *file_{nullptr};
+  void *mapping_{nullptr};
+#endif // WIN32
+
+  MappedFile(const MappedFile &)            = delete;
+  MappedFile(MappedFile &&)                 = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  MappedFile &operator=(MappedFile &&)      = delete;
+};
+
+} // namespace dc
@@ -0,0 +1,417 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dc
+{
+
+/**
+ * Default hash of FlatHashMap. Strings get hashed as std::string_view, so
+ * maps with std::string keys can be searched with std::string_view and
+ * string literals without constructing a std::string.
+ */
+template <typename T> struct FlatHash
+{
+  std::size_t operator()(const T &value) const { return std::hash<T>{}(value); }
+};
+
+template <> struct FlatHash<std::string>
+{
+  using is_transparent = void;
+
+  std::size_t operator()(std::string_view value) const
+  {
+    return std::hash<std::string_view>{}(value);
+  }
+};
+
+/**
+ * Hash map with open addressing and linear probing. The entries are stored
+ * in one array instead of one node per entry and the hashes are stored in a
+ * separate dense array, so probing mostly touches the hashes and compares
+ * keys only when the hashes match. The hashes get computed once per
+ * insertion and are reused when the map grows. Callers that search the same
+ * key repeatedly can compute its hash once with hash_key() and pass it to
+ * find().
+ *
+ * Unlike std::unordered_map, inserting and erasing entries invalidates all
+ * iterators and references into the map.
+ */
+template <typename TKey,
+          typename TValue,
+          typename THash     = FlatHash<TKey>,
+          typename TKeyEqual = std::equal_to<>>
+class FlatHashMap
+{
+public:
+  using key_type    = TKey;
+  using mapped_type = TValue;
+  using value_type  = std::pair<TKey, TValue>;
+  using size_type   = std::size_t;
+
+  template <bool IsConst> class Iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = FlatHashMap::value_type;
+    using difference_type   = std::ptrdiff_t;
+    using pointer =
+        std::conditional_t<IsConst, const value_type *, value_type *>;
+    using reference =
+        std::conditional_t<IsConst, const value_type &, value_type &>;
+
+    Iterator() = default;
+
+    /// Iterators convert to const iterators
+    template <bool IsOtherConst,
+              typename = std::enable_if_t<IsConst && !IsOtherConst>>
+    Iterator(const Iterator<IsOtherConst> &other)
+        : map_{other.map_},
+          index_{other.index_}
+    {
+    }
+
+    reference operator*() const { return *map_->slots_[index_]; }
+    pointer   operator->() const { return &*map_->slots_[index_]; }
+
+    Iterator &operator++()
+    {
+      index_ = map_->next_index(index_ + 1);
+      return *this;
+    }
+
+    Iterator operator++(int)
+    {
+      auto iter = *this;
+      ++*this;
+      return iter;
+    }
+
+    bool operator==(const Iterator &other) const
+    {
+      return index_ == other.index_;
+    }
+
+    bool operator!=(const Iterator &other) const
+    {
+      return index_ != other.index_;
+    }
+
+  private:
+    template <bool> friend class Iterator;
+    friend class FlatHashMap;
+
+    using MapPointer =
+        std::conditional_t<IsConst, const FlatHashMap *, FlatHashMap *>;
+
+    MapPointer  map_{};
+    std::size_t index_{};
+
+    Iterator(MapPointer map, std::size_t index) : map_{map}, index_{index} {}
+  };
+
+  using iterator       = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  iterator       begin() { return iterator{this, next_index(0)}; }
+  const_iterator begin() const { return const_iterator{this, next_index(0)}; }
+  iterator       end() { return iterator{this, hashes_.size()}; }
+  const_iterator end() const { return const_iterator{this, hashes_.size()}; }
+
+  bool        empty() const { return size_ == 0; }
+  std::size_t size() const { return size_; }
+
+  /// Makes room for count entries without growing
+  void reserve(std::size_t count)
+  {
+    auto capacity = min_capacity;
+    while (count * max_load_denominator > capacity * max_load_numerator)
+    {
+      capacity *= 2;
+    }
+    if (capacity > hashes_.size())
+    {
+      rehash(capacity);
+    }
+  }
+
+  /// Removes all entries but keeps the memory
+  void clear()
+  {
+    for (std::size_t i{0}; i < hashes_.size(); ++i)
+    {
+      hashes_[i] = empty_hash;
+      slots_[i].reset();
+    }
+    size_ = 0;
+  }
+
+  /**
+   * Hash of a key like it is stored in the map. Can be passed to find() to
+   * search a key without hashing it again.
+   */
+  template <typename TLookupKey>
+  std::size_t hash_key(const TLookupKey &key) const
+  {
+    return mix_hash(hash_(key)) | occupied_bit;
+  }
+
+  template <typename TLookupKey> iterator find(const TLookupKey &key)
+  {
+    return find(key, hash_key(key));
+  }
+
+  template <typename TLookupKey>
+  const_iterator find(const TLookupKey &key) const
+  {
+    return find(key, hash_key(key));
+  }
+
+  template <typename TLookupKey>
+  iterator find(const TLookupKey &key, std::size_t hash)
+  {
+    const auto index = find_index(key, hash);
+    return index == no_index ? end() : iterator{this, index};
+  }
+
+  template <typename TLookupKey>
+  const_iterator find(const TLookupKey &key, std::size_t hash) const
+  {
+    const auto index = find_index(key, hash);
+    return index == no_index ? end() : const_iterator{this, index};
+  }
+
+  template <typename TLookupKey> bool contains(const TLookupKey &key) const
+  {
+    return find_index(key, hash_key(key)) != no_index;
+  }
+
+  template <typename TLookupKey>
+  std::size_t count(const TLookupKey &key) const
+  {
+    return contains(key) ? 1 : 0;
+  }
+
+  /// Throws std::out_of_range if the key does not exist
+  template <typename TLookupKey> TValue &at(const TLookupKey &key)
+  {
+    const auto index = find_index(key, hash_key(key));
+    if (index == no_index)
+    {
+      throw std::out_of_range{"FlatHashMap has no such key"};
+    }
+    return slots_[index]->second;
+  }
+
+  /// Throws std::out_of_range if the key does not exist
+  template <typename TLookupKey> const TValue &at(const TLookupKey &key) const
+  {
+    const auto index = find_index(key, hash_key(key));
+    if (index == no_index)
+    {
+      throw std::out_of_range{"FlatHashMap has no such key"};
+    }
+    return slots_[index]->second;
+  }
+
+  /**
+   * Constructs the value from the arguments if the key does not exist yet.
+   * Returns the entry of the key and whether it got inserted.
+   */
+  template <typename TLookupKey, typename... TArgs>
+  std::pair<iterator, bool> try_emplace(TLookupKey &&key, TArgs &&...args)
+  {
+    const auto hash  = hash_key(key);
+    const auto index = find_index(key, hash);
+    if (index != no_index)
+    {
+      return {iterator{this, index}, false};
+    }
+
+    const auto free_index = grow_and_find_free_index(hash);
+    slots_[free_index].emplace(
+        std::piecewise_construct,
+        std::forward_as_tuple(std::forward<TLookupKey>(key)),
+        std::forward_as_tuple(std::forward<TArgs>(args)...));
+    hashes_[free_index] = hash;
+    ++size_;
+    return {iterator{this, free_index}, true};
+  }
+
+  /// Same as try_emplace(), an existing value does not get replaced
+  template <typename TLookupKey, typename... TArgs>
+  std::pair<iterator, bool> emplace(TLookupKey &&key, TArgs &&...args)
+  {
+    return try_emplace(std::forward<TLookupKey>(key),
+                       std::forward<TArgs>(args)...);
+  }
+
+  template <typename TLookupKey> TValue &operator[](TLookupKey &&key)
+  {
+    return try_emplace(std::forward<TLookupKey>(key)).first->second;
+  }
+
+  void erase(const_iterator iter) { erase_index(iter.index_); }
+
+  void erase(iterator iter) { erase_index(iter.index_); }
+
+  /// Returns the number of erased entries
+  template <typename TLookupKey> std::size_t erase(const TLookupKey &key)
+  {
+    const auto index = find_index(key, hash_key(key));
+    if (index == no_index)
+    {
+      return 0;
+    }
+    erase_index(index);
+    return 1;
+  }
+
+private:
+  static constexpr std::size_t min_capacity{16};
+  // grows when more than 7/8 of the slots are occupied
+  static constexpr std::size_t max_load_numerator{7};
+  static constexpr std::size_t max_load_denominator{8};
+
+  // stored hashes always have the top bit set, so zero marks a free slot
+  static constexpr std::size_t empty_hash{0};
+  static constexpr std::size_t occupied_bit{
+      std::size_t{1} << (std::numeric_limits<std::size_t>::digits - 1)};
+  static constexpr std::size_t no_index{
+      std::numeric_limits<std::size_t>::max()};
+
+  std::vector<std::size_t>               hashes_;
+  std::vector<std::optional<value_type>> slots_;
+  std::size_t                            size_{0};
+
+  THash     hash_{};
+  TKeyEqual key_equal_{};
+
+  // std::hash of integers is the identity, so the bits get mixed before the
+  // low bits select the slot
+  static std::size_t mix_hash(std::size_t hash)
+  {
+    auto value = static_cast<std::uint64_t>(hash);
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdull;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ull;
+    value ^= value >> 33;
+    return static_cast<std::size_t>(value);
+  }
+
+  std::size_t next_index(std::size_t index) const
+  {
+    while (index < hashes_.size() && hashes_[index] == empty_hash)
+    {
+      ++index;
+    }
+    return index;
+  }
+
+  template <typename TLookupKey>
+  std::size_t find_index(const TLookupKey &key, std::size_t hash) const
+  {
+    if (size_ == 0)
+    {
+      return no_index;
+    }
+
+    // the load factor guarantees a free slot that ends the probing
+    const auto mask = hashes_.size() - 1;
+    for (auto i = hash & mask;; i = (i + 1) & mask)
+    {
+      if (hashes_[i] == empty_hash)
+      {
+        return no_index;
+      }
+      if (hashes_[i] == hash && key_equal_(slots_[i]->first, key))
+      {
+        return i;
+      }
+    }
+  }
+
+  std::size_t grow_and_find_free_index(std::size_t hash)
+  {
+    if ((size_ + 1) * max_load_denominator >
+        hashes_.size() * max_load_numerator)
+    {
+      rehash(std::max(hashes_.size() * 2, min_capacity));
+    }
+
+    const auto mask = hashes_.size() - 1;
+    auto       i    = hash & mask;
+    while (hashes_[i] != empty_hash)
+    {
+      i = (i + 1) & mask;
+    }
+    return i;
+  }
+
+  void rehash(std::size_t capacity)
+  {
+    auto old_hashes = std::move(hashes_);
+    auto old_slots  = std::move(slots_);
+    hashes_         = std::vector<std::size_t>(capacity, empty_hash);
+    slots_          = std::vector<std::optional<value_type>>(capacity);
+
+    const auto mask = capacity - 1;
+    for (std::size_t i{0}; i < old_hashes.size(); ++i)
+    {
+      if (old_hashes[i] == empty_hash)
+      {
+        continue;
+      }
+      auto j = old_hashes[i] & mask;
+      while (hashes_[j] != empty_hash)
+      {
+        j = (j + 1) & mask;
+      }
+      hashes_[j] = old_hashes[i];
+      slots_[j].emplace(std::move(*old_slots[i]));
+    }
+  }
+
+  // shifts the following entries of the probe sequence back instead of
+  // leaving a tombstone, so lookups never probe erased slots
+  void erase_index(std::size_t index)
+  {
+    const auto mask = hashes_.size() - 1;
+    hashes_[index]  = empty_hash;
+    slots_[index].reset();
+    --size_;
+
+    auto i = (index + 1) & mask;
+    while (hashes_[i] != empty_hash)
+    {
+      // the entry may only move if the free slot lies between its home slot
+      // and its current slot
+      const auto home = hashes_[i] & mask;
+      if (((i - home) & mask) >= ((i - index) & mask))
+      {
+        hashes_[index] = hashes_[i];
+        slots_[index].emplace(std::move(*slots_[i]));
+        hashes_[i] = empty_hash;
+        slots_[i].reset();
+        index = i;
+      }
+      i = (i + 1) & mask;
+    }
+  }
+};
+
+} // namespace dc
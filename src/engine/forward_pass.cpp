@@ -563,12 +563,19 @@ void ForwardPass::render_meshes(
         }
 
         mesh_shader_->set_uniform("model_matrix", mesh.model_matrix_);
+        mesh_shader_->set_uniform("packed_vertices",
+                                  mesh.mesh_->vertex_format() ==
+                                      VertexFormat::Packed);
 
         int texture_slot = global_texture_slot;
         set_material(*mesh_shader_, texture_slot, *material);
 
         const auto vertex_array = mesh.mesh_->vertex_array();
-        draw(*vertex_array, GL_TRIANGLES);
+        const auto lod          = mesh.mesh_->lod(mesh.lod_);
+        draw_range(*vertex_array,
+                   GL_TRIANGLES,
+                   lod.first_index_,
+                   lod.indices_count_);
     }
 
     mesh_shader_->unbind();
@@ -624,6 +631,9 @@ void ForwardPass::render_skinned_meshes(
         skinned_mesh_shader_->set_uniform("model_matrix",
                                           skinned_mesh.model_matrix_);
         skinned_mesh_shader_->set_uniform("bones[0]", skinned_mesh.bones_);
+        skinned_mesh_shader_->set_uniform(
+            "packed_vertices",
+            skinned_sub_mesh->vertex_format() == VertexFormat::Packed);
 
         int texture_slot = global_texture_slot;
         set_material(*skinned_mesh_shader_, texture_slot, *material);
@@ -670,7 +680,11 @@ void ForwardPass::render_meshes_depth_prepass(
         depth_only_shader_->set_uniform("tex", 1);
 
         const auto vertex_array = mesh.mesh_->vertex_array();
-        draw(*vertex_array, GL_TRIANGLES);
+        const auto lod          = mesh.mesh_->lod(mesh.lod_);
+        draw_range(*vertex_array,
+                   GL_TRIANGLES,
+                   lod.first_index_,
+                   lod.indices_count_);
     }
     depth_only_shader_->unbind();
 }
@@ -1,6 +1,9 @@
 #include "frame_data.hpp"
 #include "gl_framebuffer.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 namespace dc
 {
 
@@ -78,6 +81,65 @@ std::vector<DebugLineInfo> SceneRenderInfo::debug_lines() const
 
 EnvironmentMap SceneRenderInfo::env_map() const { return env_map_; }
 
+void SceneRenderInfo::set_lod_settings(const LodSettings &lod_settings)
+{
+  lod_settings_ = lod_settings;
+}
+
+LodSettings SceneRenderInfo::lod_settings() const { return lod_settings_; }
+
+void SceneRenderInfo::select_lods(const ViewRenderInfo &view_render_info)
+{
+  const auto viewport_height =
+      static_cast<float>(view_render_info.viewport_info().height_);
+  const auto is_perspective =
+      view_render_info.projection_type() == ProjectionType::Perspective;
+  if (viewport_height <= 0.0f ||
+      (is_perspective && view_render_info.fov() <= 0.0f))
+  {
+    return;
+  }
+
+  // pixels of one unit at distance one, orthographic views map one unit to
+  // one pixel
+  const auto projection_scale =
+      is_perspective
+          ? viewport_height * 0.5f /
+                std::tan(glm::radians(view_render_info.fov()) * 0.5f)
+          : 1.0f;
+  const auto min_distance = std::max(view_render_info.near_plane(), 0.01f);
+  const auto max_pixel_error = lod_settings_.max_pixel_error_ /
+                               std::max(lod_settings_.quality_bias_, 0.01f);
+  const auto max_shadow_pixel_error =
+      max_pixel_error * std::max(lod_settings_.shadow_bias_, 1.0f);
+  const auto view_position = view_render_info.view_position();
+
+  for (auto &mesh_info : meshes_)
+  {
+    const auto &model_matrix = mesh_info.model_matrix_;
+    const auto  scale = std::max({glm::length(glm::vec3{model_matrix[0]}),
+                                 glm::length(glm::vec3{model_matrix[1]}),
+                                 glm::length(glm::vec3{model_matrix[2]})});
+
+    auto pixels_per_unit = projection_scale * scale;
+    if (is_perspective)
+    {
+      const glm::vec3 center{
+          model_matrix *
+          glm::vec4{mesh_info.mesh_->bounding_sphere_center(), 1.0f}};
+      const auto distance =
+          glm::length(center - view_position) -
+          mesh_info.mesh_->bounding_sphere_radius() * scale;
+      pixels_per_unit /= std::max(distance, min_distance);
+    }
+
+    mesh_info.lod_ =
+        mesh_info.mesh_->select_lod(pixels_per_unit, max_pixel_error);
+    mesh_info.shadow_lod_ =
+        mesh_info.mesh_->select_lod(pixels_per_unit, max_shadow_pixel_error);
+  }
+}
+
 void ViewRenderInfo::set_projection_type(ProjectionType projection_type)
 {
   projection_type_ = projection_type;
@@ -9,6 +9,7 @@
 #include "point_light.hpp"
 #include "skinned_mesh.hpp"
 
+#include <cstdint>
 #include <optional>
 
 namespace dc
@@ -18,6 +19,19 @@ struct MeshInfo
 {
   glm::mat4 model_matrix_;
   SubMesh  *mesh_;
+  // levels of detail for the main view and the shadow passes
+  std::uint32_t lod_{0};
+  std::uint32_t shadow_lod_{0};
+};
+
+struct LodSettings
+{
+  // largest error of a level of detail on screen in pixels
+  float max_pixel_error_{1.0f};
+  // above 1 prefers finer levels, below 1 coarser levels
+  float quality_bias_{1.0f};
+  // scales the allowed error of the shadow passes
+  float shadow_bias_{4.0f};
 };
 
 struct SkinnedMeshInfo
@@ -42,6 +56,8 @@ struct DebugLineInfo
                 glm::vec3 end_color);
 };
 
+class ViewRenderInfo;
+
 class SceneRenderInfo
 {
 public:
@@ -64,6 +80,15 @@ public:
   void add_debug_lines(const std::vector<DebugLineInfo> &debug_lines);
   std::vector<DebugLineInfo> debug_lines() const;
 
+  void        set_lod_settings(const LodSettings &lod_settings);
+  LodSettings lod_settings() const;
+
+  /**
+   * Selects the levels of detail of all meshes from their projected size in
+   * the view. Needs to run again if the view changes.
+   */
+  void select_lods(const ViewRenderInfo &view_render_info);
+
 private:
   std::vector<MeshInfo>        meshes_;
   std::vector<SkinnedMeshInfo> skinned_meshes_;
@@ -71,6 +96,7 @@ private:
   DirectionalLight             directional_light_;
   EnvironmentMap               env_map_;
   std::vector<DebugLineInfo>   debug_lines_;
+  LodSettings                  lod_settings_;
 };
 
 struct ViewportInfo
@@ -2,6 +2,8 @@
 #include "gl.hpp"
 #include "gl_vertex_array.hpp"
 
+#include <cstdint>
+
 namespace dc
 {
 
@@ -29,6 +31,21 @@ void draw(const GlVertexArray &vertex_array, GLenum mode, long count)
   }
 }
 
+void draw_range(const GlVertexArray &vertex_array,
+                GLenum               mode,
+                std::uint32_t        first_index,
+                std::uint32_t        indices_count)
+{
+  vertex_array.bind();
+
+  const auto offset = static_cast<std::uintptr_t>(first_index) *
+                      sizeof(std::uint32_t);
+  glDrawElements(mode,
+                 static_cast<GLsizei>(indices_count),
+                 GL_UNSIGNED_INT,
+                 reinterpret_cast<const void *>(offset));
+}
+
 void compute(std::uint32_t x_size, std::uint32_t y_size, std::uint32_t z_size)
 {
   glDispatchCompute(x_size, y_size, z_size);
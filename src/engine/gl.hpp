@@ -4,6 +4,14 @@
 
 #include <cstdint>
 
+// S3TC is not part of core OpenGL, but supported by all desktop drivers
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
 namespace dc
 {
 
@@ -13,6 +21,12 @@ void draw(const GlVertexArray &vertex_array,
           GLenum               mode  = GL_TRIANGLES,
           long                 count = -1);
 
+/** Draws a range of the index buffer of the vertex array */
+void draw_range(const GlVertexArray &vertex_array,
+                GLenum               mode,
+                std::uint32_t        first_index,
+                std::uint32_t        indices_count);
+
 void compute(std::uint32_t x_size, std::uint32_t y_size, std::uint32_t z_size);
 
 } // namespace dc
@@ -16,6 +16,13 @@ GlIndexBuffer::GlIndexBuffer(const std::vector<std::uint32_t> &indices)
                        0);
 }
 
+GlIndexBuffer::GlIndexBuffer(std::size_t count, GLbitfield flags)
+    : count_{static_cast<GLsizei>(count)}
+{
+  glCreateBuffers(1, &id_);
+  glNamedBufferStorage(id_, count * sizeof(std::uint32_t), nullptr, flags);
+}
+
 GlIndexBuffer::~GlIndexBuffer()
 {
   if (id_)
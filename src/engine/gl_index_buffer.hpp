@@ -2,6 +2,7 @@
 
 #include "gl.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -12,6 +13,8 @@ class GlIndexBuffer
 {
 public:
   GlIndexBuffer(const std::vector<std::uint32_t> &indices);
+  /// Creates an uninitialized buffer for count indices
+  GlIndexBuffer(std::size_t count, GLbitfield flags = 0);
   ~GlIndexBuffer();
 
   void bind();
@@ -312,7 +312,7 @@ void GlShader::bind() { glUseProgram(program_id_); }
 
 void GlShader::unbind() { glUseProgram(0); }
 
-GLint GlShader::uniform_location(const std::string &name)
+GLint GlShader::uniform_location(std::string_view name)
 {
   const auto iter = uniforms_.find(name);
   if (iter == uniforms_.end())
@@ -330,51 +330,51 @@ GLint GlShader::uniform_location(const std::string &name)
     return;                                                                    \
   }
 
-void GlShader::set_uniform(const std::string &name, bool value)
+void GlShader::set_uniform(std::string_view name, bool value)
 {
   GET_UNIFORM_OR_RETURN(name, location)
   glUniform1i(location, static_cast<int>(value));
 }
 
-void GlShader::set_uniform(const std::string &name, int value)
+void GlShader::set_uniform(std::string_view name, int value)
 {
   GET_UNIFORM_OR_RETURN(name, location)
   glUniform1i(location, static_cast<int>(value));
 }
 
-void GlShader::set_uniform(const std::string &name, float value)
+void GlShader::set_uniform(std::string_view name, float value)
 {
   GET_UNIFORM_OR_RETURN(name, location)
   glUniform1f(location, value);
 }
 
-void GlShader::set_uniform(const std::string &name, const glm::vec3 &value)
+void GlShader::set_uniform(std::string_view name, const glm::vec3 &value)
 {
 
   GET_UNIFORM_OR_RETURN(name, location)
   glUniform3fv(location, 1, glm::value_ptr(value));
 }
 
-void GlShader::set_uniform(const std::string &name, const glm::vec4 &value)
+void GlShader::set_uniform(std::string_view name, const glm::vec4 &value)
 {
 
   GET_UNIFORM_OR_RETURN(name, location)
   glUniform4fv(location, 1, glm::value_ptr(value));
 }
 
-void GlShader::set_uniform(const std::string &name, const glm::mat2 &value)
+void GlShader::set_uniform(std::string_view name, const glm::mat2 &value)
 {
   GET_UNIFORM_OR_RETURN(name, location)
   glUniformMatrix2fv(location, 1, GL_FALSE, glm::value_ptr(value));
 }
 
-void GlShader::set_uniform(const std::string &name, const glm::mat4 &value)
+void GlShader::set_uniform(std::string_view name, const glm::mat4 &value)
 {
   GET_UNIFORM_OR_RETURN(name, location)
   glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
 }
 
-void GlShader::set_uniform(const std::string            &name,
+void GlShader::set_uniform(std::string_view              name,
                            const std::vector<glm::mat4> &value)
 {
   GET_UNIFORM_OR_RETURN(name, location)
@@ -384,14 +384,14 @@ void GlShader::set_uniform(const std::string            &name,
                      glm::value_ptr(value[0]));
 }
 
-void GlShader::set_uniform(const std::string        &name,
+void GlShader::set_uniform(std::string_view          name,
                            const std::vector<float> &value)
 {
   GET_UNIFORM_OR_RETURN(name, location)
   glUniform1fv(location, value.size(), value.data());
 }
 
-  void GlShader::set_uniform(const std::string &     name,
+void GlShader::set_uniform(std::string_view        name,
                            const std::vector<int> &value)
 {
   GET_UNIFORM_OR_RETURN(name, location)
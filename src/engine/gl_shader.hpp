@@ -1,12 +1,14 @@
 #pragma once
 
 #include "gl_index_buffer.hpp"
+#include "flat_hash_map.hpp"
 #include "gl_vertex_buffer.hpp"
 #include "math.hpp"
 
 #include <filesystem>
 #include <iostream>
-#include <unordered_map>
+#include <string>
+#include <string_view>
 #include <vector>
 
 namespace dc
@@ -44,17 +46,17 @@ public:
   void bind();
   void unbind();
 
-  void set_uniform(const std::string &name, bool value);
-  void set_uniform(const std::string &name, int value);
-  void set_uniform(const std::string &name, float value);
-  void set_uniform(const std::string &name, const glm::vec3 &value);
-  void set_uniform(const std::string &name, const glm::vec4 &value);
-  void set_uniform(const std::string &name, const glm::mat2 &value);
-  void set_uniform(const std::string &name, const glm::mat4 &value);
-  void set_uniform(const std::string            &name,
+  void set_uniform(std::string_view name, bool value);
+  void set_uniform(std::string_view name, int value);
+  void set_uniform(std::string_view name, float value);
+  void set_uniform(std::string_view name, const glm::vec3 &value);
+  void set_uniform(std::string_view name, const glm::vec4 &value);
+  void set_uniform(std::string_view name, const glm::mat2 &value);
+  void set_uniform(std::string_view name, const glm::mat4 &value);
+  void set_uniform(std::string_view              name,
                    const std::vector<glm::mat4> &value);
-  void set_uniform(const std::string &name, const std::vector<float> &value);
-  void set_uniform(const std::string &name, const std::vector<int> &value);
+  void set_uniform(std::string_view name, const std::vector<float> &value);
+  void set_uniform(std::string_view name, const std::vector<int> &value);
 
 private:
   struct UniformInfo
@@ -65,14 +67,14 @@ private:
 
   GLuint program_id_{};
 
-  std::unordered_map<std::string, UniformInfo> uniforms_;
+  FlatHashMap<std::string, UniformInfo> uniforms_;
 
   GlShader(const GlShader &) = delete;
   void operator=(const GlShader &) = delete;
   GlShader(GlShader &&)            = delete;
   void operator=(GlShader &&) = delete;
 
-  [[nodiscard]] GLint uniform_location(const std::string &name);
+  [[nodiscard]] GLint uniform_location(std::string_view name);
 
   GLuint compile_shader(const std::string              &shader_code,
                         GLenum                          type,
@@ -24,10 +24,17 @@ GlTexture::GlTexture(const GlTextureConfig &config)
   {
     glCreateTextures(GL_TEXTURE_2D, 1, &id_);
 
-    mipmap_levels_ =
-        config.generate_mipmaps_
-            ? math::calc_mipmap_levels_2d(config.width_, config.height_)
-            : 1;
+    if (config.mipmap_levels_ > 0)
+    {
+      mipmap_levels_ = config.mipmap_levels_;
+    }
+    else
+    {
+      mipmap_levels_ =
+          config.generate_mipmaps_
+              ? math::calc_mipmap_levels_2d(config.width_, config.height_)
+              : 1;
+    }
 
     glTextureStorage2D(id_,
                        mipmap_levels_,
@@ -68,13 +75,16 @@ GlTexture::GlTexture(const GlTextureConfig &config)
     glTextureParameteri(id_, GL_TEXTURE_MAG_FILTER, config.mag_filter_);
   }
 
-  // generate mipmaps if needed
-  if (config.generate_mipmaps_ && config.msaa_ == 0)
+  // generate mipmaps if needed. Textures without data get their mipmaps
+  // generated after the data got uploaded
+  if (config.generate_mipmaps_ && config.msaa_ == 0 && config.data_)
   {
-    glGenerateTextureMipmap(id_);
+    generate_mipmaps();
   }
 }
 
+void GlTexture::generate_mipmaps() { glGenerateTextureMipmap(id_); }
+
 GlTexture::~GlTexture() { glDeleteTextures(1, &id_); }
 
 GLuint GlTexture::id() const { return id_; }
@@ -24,6 +24,8 @@ struct GlTextureConfig
   GLint    min_filter_{GL_LINEAR_MIPMAP_LINEAR};
   GLint    mag_filter_{GL_LINEAR};
   unsigned generate_mipmaps_{true};
+  // levels of the storage. 0 uses the full chain if mipmaps get generated
+  GLuint mipmap_levels_{0};
 
   GLenum type_{GL_UNSIGNED_BYTE};
 };
@@ -41,6 +43,8 @@ public:
 
   void bind_unit(int unit) const;
 
+  void generate_mipmaps();
+
   GLenum format() const;
   GLenum sized_format() const;
 
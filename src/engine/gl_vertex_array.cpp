@@ -28,27 +28,22 @@ void GlVertexArray::add_vertex_buffer(
 
     glEnableVertexArrayAttrib(id_, binding_point_);
 
-    switch (layout_element.type)
+    if (layout_element.is_integer)
     {
-    case GL_FLOAT:
-      glVertexArrayAttribFormat(id_,
-                                binding_point_,
-                                layout_element.count,
-                                layout_element.type,
-                                GL_FALSE,
-                                offset);
-      break;
-
-    case GL_INT:
       glVertexArrayAttribIFormat(id_,
                                  binding_point_,
                                  layout_element.count,
                                  layout_element.type,
                                  offset);
-      break;
-
-    default:
-      DC_FAIL("Can not handle Glsl type");
+    }
+    else
+    {
+      glVertexArrayAttribFormat(id_,
+                                binding_point_,
+                                layout_element.count,
+                                layout_element.type,
+                                layout_element.is_normalized,
+                                offset);
     }
 
     glVertexArrayAttribBinding(id_, binding_point_, static_cast<GLsizei>(vertex_buffers_.size()));
@@ -1,6 +1,30 @@
 #include "gl_vertex_buffer.hpp"
 
+namespace
+{
+
+GLsizei gl_type_size(GLenum type)
+{
+  switch (type)
+  {
+  case GL_BYTE:
+  case GL_UNSIGNED_BYTE:
+    return 1;
+  case GL_SHORT:
+  case GL_UNSIGNED_SHORT:
+  case GL_HALF_FLOAT:
+    return 2;
+  case GL_INT:
+  case GL_UNSIGNED_INT:
+  case GL_FLOAT:
+    return 4;
+  default:
+    DC_FAIL("Can not handle vertex attribute type");
+  }
+  return 0;
+}
 
+} // namespace
 
 namespace dc
 {
@@ -19,9 +43,36 @@ void GlVertexBufferLayout::push_float(unsigned count)
 void GlVertexBufferLayout::push_int(unsigned count)
 {
   GlVertexBufferLayoutElement element{};
-  element.type   = GL_INT;
-  element.count  = count;
-  element.size   = element.count * sizeof(int);
+  element.type       = GL_INT;
+  element.count      = count;
+  element.size       = element.count * sizeof(int);
+  element.is_integer = true;
+  elements_.push_back(element);
+
+  size_ += element.size;
+}
+
+void GlVertexBufferLayout::push_converted(GLenum   type,
+                                          unsigned count,
+                                          bool     is_normalized)
+{
+  GlVertexBufferLayoutElement element{};
+  element.type          = type;
+  element.count         = count;
+  element.size          = element.count * gl_type_size(type);
+  element.is_normalized = is_normalized ? GL_TRUE : GL_FALSE;
+  elements_.push_back(element);
+
+  size_ += element.size;
+}
+
+void GlVertexBufferLayout::push_integer(GLenum type, unsigned count)
+{
+  GlVertexBufferLayoutElement element{};
+  element.type       = type;
+  element.count      = count;
+  element.size       = element.count * gl_type_size(type);
+  element.is_integer = true;
   elements_.push_back(element);
 
   size_ += element.size;
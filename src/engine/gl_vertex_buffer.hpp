@@ -11,9 +11,12 @@ namespace dc
 
 struct GlVertexBufferLayoutElement
 {
-  GLsizei  size;
-  unsigned count;
-  GLenum   type;
+  GLsizei   size;
+  unsigned  count;
+  GLenum    type;
+  // integer attributes stay integers in the shader
+  bool      is_integer;
+  GLboolean is_normalized;
 };
 
 class GlVertexBufferLayout
@@ -22,6 +25,14 @@ public:
   void push_float(unsigned count);
   void push_int(unsigned count);
 
+  /**
+   * Attribute of the given type that gets converted to float. Normalized
+   * integers map to [0, 1] or [-1, 1].
+   */
+  void push_converted(GLenum type, unsigned count, bool is_normalized);
+  /// Integer attribute of the given type that gets read as int
+  void push_integer(GLenum type, unsigned count);
+
   std::vector<GlVertexBufferLayoutElement> elements() const;
 
   GLsizei size() const;
@@ -0,0 +1,361 @@
+#include "gpu_upload_queue.hpp"
+#include "assert.hpp"
+#include "defer.hpp"
+#include "engine.hpp"
+#include "profiling.hpp"
+#include "time.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+
+constexpr std::size_t staging_alignment = 16;
+
+std::size_t align_up(std::size_t value, std::size_t alignment)
+{
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+void wait_for_fence(GLsync fence)
+{
+  while (true)
+  {
+    const auto result = glClientWaitSync(fence,
+                                         GL_SYNC_FLUSH_COMMANDS_BIT,
+                                         1000 * 1000 * 1000);
+    if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED ||
+        result == GL_WAIT_FAILED)
+    {
+      return;
+    }
+  }
+}
+
+} // namespace
+
+namespace dc
+{
+
+GpuUploadQueue::~GpuUploadQueue() { shutdown(); }
+
+void GpuUploadQueue::init()
+{
+  const auto config = Engine::instance()->config();
+  budget_millis_ =
+      config->config_value_float("GpuUploadQueue", "budget_ms", 2.0f);
+  const auto staging_buffer_size_mb =
+      config->config_value_int("GpuUploadQueue", "staging_buffer_size_mb", 48);
+
+  segment_size_ = align_up(static_cast<std::size_t>(staging_buffer_size_mb) *
+                               1024 * 1024 / segments_count,
+                           staging_alignment);
+  const auto staging_buffer_size = segment_size_ * segments_count;
+
+  const GLbitfield flags =
+      GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+  glCreateBuffers(1, &staging_buffer_);
+  glNamedBufferStorage(staging_buffer_, staging_buffer_size, nullptr, flags);
+  staging_data_ = static_cast<std::uint8_t *>(
+      glMapNamedBufferRange(staging_buffer_, 0, staging_buffer_size, flags));
+  DC_ASSERT(staging_data_, "Could not map staging buffer");
+}
+
+void GpuUploadQueue::shutdown()
+{
+  tasks_.clear();
+
+  for (auto &fence : segment_fences_)
+  {
+    if (fence)
+    {
+      glDeleteSync(fence);
+      fence = nullptr;
+    }
+  }
+
+  if (staging_buffer_)
+  {
+    glUnmapNamedBuffer(staging_buffer_);
+    glDeleteBuffers(1, &staging_buffer_);
+    staging_buffer_ = 0;
+    staging_data_   = nullptr;
+  }
+}
+
+void GpuUploadQueue::push(GpuUploadTask task)
+{
+  tasks_.push_back(std::move(task));
+}
+
+void GpuUploadQueue::process()
+{
+  DC_PROFILE_SCOPE("GpuUploadQueue::process()");
+
+  uploaded_bytes_ = 0;
+
+  begin_segment();
+  process_tasks(true);
+  end_segment();
+
+  const auto profiler = Engine::instance()->performance_profiler();
+  profiler->set_per_frame_counter("Upload queue depth", tasks_.size());
+  profiler->set_per_frame_counter("Uploaded bytes", uploaded_bytes_);
+}
+
+void GpuUploadQueue::flush()
+{
+  DC_PROFILE_SCOPE("GpuUploadQueue::flush()");
+
+  begin_segment();
+  process_tasks(false);
+  end_segment();
+}
+
+void GpuUploadQueue::process_tasks(bool use_budget)
+{
+  Timer timer;
+  while (!tasks_.empty())
+  {
+    if (use_budget && timer.elapsed_millis() >= budget_millis_)
+    {
+      break;
+    }
+
+    if (segment_offset_ >= segment_size_)
+    {
+      if (use_budget)
+      {
+        // staging memory of this frame is used up
+        break;
+      }
+      end_segment();
+      begin_segment();
+    }
+
+    // tasks may push new tasks, so don't hold on to the front reference
+    auto task = std::move(tasks_.front());
+    tasks_.pop_front();
+    if (!task(*this))
+    {
+      tasks_.push_front(std::move(task));
+    }
+  }
+}
+
+void GpuUploadQueue::begin_segment()
+{
+  auto &fence = segment_fences_[segment_index_];
+  if (fence)
+  {
+    // make sure the GPU is done copying out of this segment
+    wait_for_fence(fence);
+    glDeleteSync(fence);
+    fence = nullptr;
+  }
+  segment_offset_ = 0;
+}
+
+void GpuUploadQueue::end_segment()
+{
+  if (segment_offset_ == 0)
+  {
+    return;
+  }
+
+  segment_fences_[segment_index_] =
+      glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  segment_index_  = (segment_index_ + 1) % segments_count;
+  segment_offset_ = 0;
+}
+
+std::size_t GpuUploadQueue::upload_buffer(GLuint      buffer,
+                                          std::size_t offset,
+                                          const void *data,
+                                          std::size_t size)
+{
+  DC_ASSERT(staging_data_, "Upload queue is not initialized");
+
+  const auto available = segment_size_ - segment_offset_;
+  const auto staged    = std::min(size, available);
+  if (staged == 0)
+  {
+    return 0;
+  }
+
+  const auto staging_offset = segment_index_ * segment_size_ + segment_offset_;
+  std::memcpy(staging_data_ + staging_offset, data, staged);
+  glCopyNamedBufferSubData(staging_buffer_,
+                           buffer,
+                           staging_offset,
+                           offset,
+                           staged);
+
+  segment_offset_ = align_up(segment_offset_ + staged, staging_alignment);
+  uploaded_bytes_ += staged;
+  return staged;
+}
+
+int GpuUploadQueue::upload_texture_rows(GLuint              texture,
+                                        GLint               level,
+                                        GLint               width,
+                                        GLint               first_row,
+                                        GLint               rows_count,
+                                        GLenum              format,
+                                        GLenum              type,
+                                        std::size_t         row_size,
+                                        const std::uint8_t *rows)
+{
+  DC_ASSERT(staging_data_, "Upload queue is not initialized");
+
+  // staged rows are tightly packed
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  defer(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+
+  if (row_size > segment_size_)
+  {
+    // row does not fit into the staging memory at all, upload it directly
+    glTextureSubImage2D(texture,
+                        level,
+                        0,
+                        first_row,
+                        width,
+                        1,
+                        format,
+                        type,
+                        rows);
+    uploaded_bytes_ += row_size;
+    return 1;
+  }
+
+  std::size_t staging_offset{};
+  const auto  staged_rows =
+      stage_rows(rows_count, row_size, rows, staging_offset);
+  if (staged_rows == 0)
+  {
+    return 0;
+  }
+
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, staging_buffer_);
+  glTextureSubImage2D(texture,
+                      level,
+                      0,
+                      first_row,
+                      width,
+                      static_cast<GLsizei>(staged_rows),
+                      format,
+                      type,
+                      reinterpret_cast<const void *>(staging_offset));
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+  return static_cast<int>(staged_rows);
+}
+
+int GpuUploadQueue::upload_compressed_texture_rows(
+    GLuint              texture,
+    GLint               level,
+    GLint               width,
+    GLint               height,
+    GLint               first_block_row,
+    GLint               block_rows_count,
+    GLenum              format,
+    std::size_t         block_row_size,
+    const std::uint8_t *block_rows)
+{
+  DC_ASSERT(staging_data_, "Upload queue is not initialized");
+
+  // a row of blocks covers four rows of pixels, the last one may cover less
+  const auto y_offset    = first_block_row * 4;
+  const auto rows_height = [y_offset, height](std::size_t block_rows)
+  {
+    return std::min(static_cast<GLint>(block_rows) * 4, height - y_offset);
+  };
+
+  if (block_row_size > segment_size_)
+  {
+    // row does not fit into the staging memory at all, upload it directly
+    glCompressedTextureSubImage2D(texture,
+                                  level,
+                                  0,
+                                  y_offset,
+                                  width,
+                                  rows_height(1),
+                                  format,
+                                  static_cast<GLsizei>(block_row_size),
+                                  block_rows);
+    uploaded_bytes_ += block_row_size;
+    return 1;
+  }
+
+  std::size_t staging_offset{};
+  const auto  staged_rows = stage_rows(block_rows_count,
+                                      block_row_size,
+                                      block_rows,
+                                      staging_offset);
+  if (staged_rows == 0)
+  {
+    return 0;
+  }
+
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, staging_buffer_);
+  glCompressedTextureSubImage2D(
+      texture,
+      level,
+      0,
+      y_offset,
+      width,
+      rows_height(staged_rows),
+      format,
+      static_cast<GLsizei>(staged_rows * block_row_size),
+      reinterpret_cast<const void *>(staging_offset));
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+  return static_cast<int>(staged_rows);
+}
+
+std::size_t GpuUploadQueue::stage_rows(std::size_t         rows_count,
+                                       std::size_t         row_size,
+                                       const std::uint8_t *rows,
+                                       std::size_t        &staging_offset)
+{
+  const auto available   = segment_size_ - segment_offset_;
+  const auto staged_rows = std::min(rows_count, available / row_size);
+  if (staged_rows == 0)
+  {
+    // not even a single row fits, wait for the next segment
+    segment_offset_ = segment_size_;
+    return 0;
+  }
+  const auto staged = staged_rows * row_size;
+
+  staging_offset = segment_index_ * segment_size_ + segment_offset_;
+  std::memcpy(staging_data_ + staging_offset, rows, staged);
+
+  segment_offset_ = align_up(segment_offset_ + staged, staging_alignment);
+  uploaded_bytes_ += staged;
+  return staged_rows;
+}
+
+GpuUploadTask
+make_buffer_upload_task(GLuint buffer, const void *data, std::size_t size)
+{
+  const auto bytes = static_cast<const std::uint8_t *>(data);
+  return [buffer, bytes, size, offset = std::size_t{0}](
+             GpuUploadQueue &upload_queue) mutable
+  {
+    offset += upload_queue.upload_buffer(buffer,
+                                         offset,
+                                         bytes + offset,
+                                         size - offset);
+    return offset == size;
+  };
+}
+
+std::size_t GpuUploadQueue::queue_depth() const { return tasks_.size(); }
+
+void GpuUploadQueue::set_budget_millis(float value) { budget_millis_ = value; }
+
+float GpuUploadQueue::budget_millis() const { return budget_millis_; }
+
+} // namespace dc
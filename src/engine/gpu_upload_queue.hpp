@@ -0,0 +1,123 @@
+#pragma once
+
+#include "gl.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+
+namespace dc
+{
+
+class GpuUploadQueue;
+
+/**
+ * A step of an upload. Gets called until it returns true. Each call should
+ * only upload as much as the staging memory allows, so that large assets get
+ * spread over several frames.
+ */
+using GpuUploadTask = std::function<bool(GpuUploadQueue &upload_queue)>;
+
+/**
+ * Uploads asset data to the GPU on the main thread within a per frame time
+ * budget. Data gets copied into a persistently mapped staging buffer that is
+ * split into one segment per frame in flight.
+ */
+class GpuUploadQueue
+{
+public:
+  ~GpuUploadQueue();
+
+  void init();
+  void shutdown();
+
+  void push(GpuUploadTask task);
+
+  /// Processes uploads until the frame budget is used up
+  void process();
+
+  /// Processes all uploads, ignoring the frame budget
+  void flush();
+
+  /**
+   * Stages up to size bytes and copies them to the buffer. Returns the
+   * number of bytes that got staged. Can be less than size, if the staging
+   * memory of this frame is used up.
+   */
+  std::size_t upload_buffer(GLuint      buffer,
+                            std::size_t offset,
+                            const void *data,
+                            std::size_t size);
+
+  /**
+   * Stages as many full rows of the image as possible and copies them into
+   * the texture level. Returns the number of rows that got staged.
+   */
+  int upload_texture_rows(GLuint              texture,
+                          GLint               level,
+                          GLint               width,
+                          GLint               first_row,
+                          GLint               rows_count,
+                          GLenum              format,
+                          GLenum              type,
+                          std::size_t         row_size,
+                          const std::uint8_t *rows);
+
+  /**
+   * Stages as many full rows of 4x4 blocks as possible and copies them into
+   * the compressed texture level. Returns the number of block rows that got
+   * staged.
+   */
+  int upload_compressed_texture_rows(GLuint              texture,
+                                     GLint               level,
+                                     GLint               width,
+                                     GLint               height,
+                                     GLint               first_block_row,
+                                     GLint               block_rows_count,
+                                     GLenum              format,
+                                     std::size_t         block_row_size,
+                                     const std::uint8_t *block_rows);
+
+  std::size_t queue_depth() const;
+
+  void  set_budget_millis(float value);
+  float budget_millis() const;
+
+private:
+  static constexpr std::size_t segments_count = 3;
+
+  float budget_millis_{2.0f};
+
+  std::deque<GpuUploadTask> tasks_;
+
+  GLuint        staging_buffer_{};
+  std::uint8_t *staging_data_{};
+  std::size_t   segment_size_{};
+
+  std::array<GLsync, segments_count> segment_fences_{};
+  std::size_t                        segment_index_{0};
+  std::size_t                        segment_offset_{0};
+
+  std::size_t uploaded_bytes_{0};
+
+  std::size_t stage_rows(std::size_t         rows_count,
+                         std::size_t         row_size,
+                         const std::uint8_t *rows,
+                         std::size_t        &staging_offset);
+
+  void begin_segment();
+  void end_segment();
+
+  void process_tasks(bool use_budget);
+};
+
+/**
+ * Creates a task that uploads size bytes of data into the buffer. The data
+ * and the buffer need to stay alive until the task is done.
+ */
+GpuUploadTask
+make_buffer_upload_task(GLuint buffer, const void *data, std::size_t size);
+
+} // namespace dc
@@ -273,7 +273,8 @@ unsigned char *Image::data() { return data_.data(); }
 
 void Image::load_from_file(const std::filesystem::path &file_path)
 {
-  stbi_set_flip_vertically_on_load(true);
+  // images get loaded on several threads at once
+  stbi_set_flip_vertically_on_load_thread(true);
   const auto data = stbi_load(file_path.string().c_str(),
                               &width_,
                               &height_,
@@ -290,6 +291,26 @@ void Image::load_from_file(const std::filesystem::path &file_path)
   stbi_image_free(data);
 }
 
+void Image::load_from_memory(const std::uint8_t *data, std::size_t size)
+{
+  stbi_set_flip_vertically_on_load_thread(true);
+  const auto pixels = stbi_load_from_memory(data,
+                                            static_cast<int>(size),
+                                            &width_,
+                                            &height_,
+                                            &channels_count_,
+                                            0);
+  if (!pixels)
+  {
+    throw std::runtime_error("Could not load image from memory");
+  }
+
+  const auto pixels_size = width_ * height_ * channels_count_;
+  data_.resize(pixels_size);
+  std::memcpy(data_.data(), pixels, pixels_size);
+  stbi_image_free(pixels);
+}
+
 void Image::set_pixel(int x, int y, const glm::vec4 &color)
 {
   switch (format_)
@@ -55,6 +55,7 @@ public:
   unsigned char       *data();
 
   void load_from_file(const std::filesystem::path &file_path);
+  void load_from_memory(const std::uint8_t *data, std::size_t size);
 
   void      set_pixel(int x, int y, const glm::vec4 &color);
   glm::vec4 pixel(int x, int y) const;
@@ -0,0 +1,237 @@
+#include "import_manifest.hpp"
+#include "binary_reader.hpp"
+#include "engine.hpp"
+#include "filesystem.hpp"
+#include "log.hpp"
+#include "serialization.hpp"
+#include "util.hpp"
+
+#include <cstdio>
+#include <stdexcept>
+#include <system_error>
+
+namespace dc
+{
+
+void ImportManifest::add_source(const std::filesystem::path &file_path,
+                                std::uint64_t                hash)
+{
+  // the importers can get started from different working directories
+  const auto file_path_str =
+      std::filesystem::absolute(file_path).lexically_normal().string();
+  for (const auto &source : sources_)
+  {
+    if (source.file_path_ == file_path_str)
+    {
+      return;
+    }
+  }
+  sources_.push_back({file_path_str, hash});
+}
+
+void ImportManifest::add_output(const std::filesystem::path &file_path,
+                                const AssetDescription      &asset_description)
+{
+  outputs_.push_back({file_path.generic_string(),
+                      asset_description.source_hash_,
+                      asset_description.settings_hash_,
+                      asset_description.importer_version_});
+}
+
+std::uint64_t ImportManifest::source_hash() const
+{
+  auto hash = hash_seed;
+  for (const auto &source : sources_)
+  {
+    hash = hash_bytes(&source.hash_, sizeof(source.hash_), hash);
+  }
+  return hash;
+}
+
+bool ImportManifest::is_up_to_date(std::uint32_t importer_version,
+                                   std::uint64_t settings_hash) const
+{
+  if (importer_version_ != importer_version ||
+      settings_hash_ != settings_hash || sources_.empty())
+  {
+    return false;
+  }
+
+  try
+  {
+    for (const auto &source : sources_)
+    {
+      if (!std::filesystem::exists(source.file_path_) ||
+          hash_file(source.file_path_) != source.hash_)
+      {
+        DC_LOG_DEBUG("Source {} changed", source.file_path_);
+        return false;
+      }
+    }
+
+    const auto base_directory = Engine::instance()->base_directory();
+    for (const auto &output : outputs_)
+    {
+      // another import could have overwritten the output
+      AssetDescription asset_description{};
+      asset_description.source_hash_      = output.source_hash_;
+      asset_description.settings_hash_    = output.settings_hash_;
+      asset_description.importer_version_ = output.importer_version_;
+      if (!is_output_up_to_date(base_directory / output.file_path_,
+                                asset_description))
+      {
+        DC_LOG_DEBUG("Output {} is stale", output.file_path_);
+        return false;
+      }
+    }
+  }
+  catch (const std::exception &error)
+  {
+    DC_LOG_DEBUG("Could not check import manifest: {}", error.what());
+    return false;
+  }
+
+  return true;
+}
+
+void ImportManifest::save(const std::filesystem::path &file_path) const
+{
+  BinaryWriter writer{};
+
+  AssetDescription asset_description{};
+  asset_description.source_hash_      = source_hash();
+  asset_description.settings_hash_    = settings_hash_;
+  asset_description.importer_version_ = importer_version_;
+  asset_description.write(writer);
+
+  write_value(writer, static_cast<std::uint64_t>(sources_.size()));
+  for (const auto &source : sources_)
+  {
+    write_string(writer, source.file_path_);
+    write_value(writer, source.hash_);
+  }
+  write_value(writer, static_cast<std::uint64_t>(outputs_.size()));
+  for (const auto &output : outputs_)
+  {
+    write_string(writer, output.file_path_);
+    write_value(writer, output.source_hash_);
+    write_value(writer, output.settings_hash_);
+    write_value(writer, output.importer_version_);
+  }
+
+  writer.save(file_path);
+}
+
+void ImportManifest::read(const std::filesystem::path &file_path)
+{
+  const auto   data = read_binary_file(file_path);
+  BinaryReader reader{data.data(), data.size()};
+
+  AssetDescription asset_description{};
+  asset_description.read(reader);
+  if (!asset_description.has_build_info())
+  {
+    throw std::runtime_error{"Import manifest " + file_path.string() +
+                             " has no build info"};
+  }
+  settings_hash_    = asset_description.settings_hash_;
+  importer_version_ = asset_description.importer_version_;
+
+  std::uint64_t count{};
+  read_value(reader, count);
+  sources_.clear();
+  for (std::uint64_t i{0}; i < count; ++i)
+  {
+    Source source{};
+    read_string(reader, source.file_path_);
+    read_value(reader, source.hash_);
+    sources_.push_back(std::move(source));
+  }
+  read_value(reader, count);
+  outputs_.clear();
+  for (std::uint64_t i{0}; i < count; ++i)
+  {
+    Output output{};
+    read_string(reader, output.file_path_);
+    read_value(reader, output.source_hash_);
+    read_value(reader, output.settings_hash_);
+    read_value(reader, output.importer_version_);
+    outputs_.push_back(std::move(output));
+  }
+}
+
+std::filesystem::path
+import_manifest_file_path(const std::filesystem::path &output_file_path)
+{
+  // the output extension keeps manifests of meshes and scenes with the same
+  // name apart
+  return Engine::instance()->base_directory() / "imports" /
+         (output_file_path.filename().string() + ".dcimp");
+}
+
+bool is_output_up_to_date(const std::filesystem::path &file_path,
+                          const AssetDescription      &asset_description)
+{
+  std::error_code error_code{};
+  if (!std::filesystem::is_regular_file(file_path, error_code))
+  {
+    return false;
+  }
+
+  const auto file = std::fopen(file_path.string().c_str(), "rb");
+  if (!file)
+  {
+    return false;
+  }
+  AssetDescription file_asset_description{};
+  bool             is_failed{false};
+  try
+  {
+    file_asset_description.read(file);
+    is_failed = std::ferror(file) || std::feof(file);
+  }
+  catch (const std::exception &)
+  {
+    // a corrupt string length can fail the allocation
+    is_failed = true;
+  }
+  std::fclose(file);
+
+  return !is_failed && file_asset_description.has_build_info() &&
+         file_asset_description.source_hash_ ==
+             asset_description.source_hash_ &&
+         file_asset_description.settings_hash_ ==
+             asset_description.settings_hash_ &&
+         file_asset_description.importer_version_ ==
+             asset_description.importer_version_;
+}
+
+bool is_import_up_to_date(const std::filesystem::path &manifest_file_path,
+                          std::uint32_t                importer_version,
+                          std::uint64_t                settings_hash)
+{
+  if (!std::filesystem::exists(manifest_file_path))
+  {
+    return false;
+  }
+
+  ImportManifest manifest{};
+  try
+  {
+    manifest.read(manifest_file_path);
+  }
+  catch (const std::runtime_error &error)
+  {
+    DC_LOG_WARN("Could not read import manifest: {}", error.what());
+    return false;
+  }
+  return manifest.is_up_to_date(importer_version, settings_hash);
+}
+
+std::uint64_t hash_file(const std::filesystem::path &file_path)
+{
+  const auto data = read_binary_file(file_path);
+  return hash_bytes(data.data(), data.size());
+}
+
+} // namespace dc
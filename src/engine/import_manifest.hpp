@@ -0,0 +1,84 @@
+#pragma once
+
+#include "asset_description.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace dc
+{
+
+/**
+ * Remembers which files an import read and wrote. The next import of the
+ * same file can be skipped if no source changed, the settings and importer
+ * are the same and all outputs still are the ones this import wrote.
+ */
+struct ImportManifest
+{
+  struct Source
+  {
+    std::string   file_path_;
+    std::uint64_t hash_{0};
+  };
+
+  struct Output
+  {
+    // relative to the base directory
+    std::string   file_path_;
+    std::uint64_t source_hash_{0};
+    std::uint64_t settings_hash_{0};
+    std::uint32_t importer_version_{0};
+  };
+
+  std::uint32_t       importer_version_{0};
+  std::uint64_t       settings_hash_{0};
+  std::vector<Source> sources_;
+  std::vector<Output> outputs_;
+
+  /// Adds the source if it's not added yet
+  void add_source(const std::filesystem::path &file_path, std::uint64_t hash);
+  void add_output(const std::filesystem::path &file_path,
+                  const AssetDescription      &asset_description);
+
+  /// Combined hash of all sources in the order they got added
+  std::uint64_t source_hash() const;
+
+  /**
+   * True if importer and settings match, no source changed and every output
+   * still holds what this import wrote. Never throws, unreadable files count
+   * as changed.
+   */
+  bool is_up_to_date(std::uint32_t importer_version,
+                     std::uint64_t settings_hash) const;
+
+  void save(const std::filesystem::path &file_path) const;
+  void read(const std::filesystem::path &file_path);
+};
+
+/**
+ * Where the manifest of the import that writes the output lives. The output
+ * is relative to the base directory.
+ */
+std::filesystem::path
+import_manifest_file_path(const std::filesystem::path &output_file_path);
+
+/**
+ * True if the manifest exists and is up to date. Used to skip imports. Never
+ * throws.
+ */
+/**
+ * True if the file exists and got built from the same source with the same
+ * settings and importer version as the description says. Never throws.
+ */
+bool is_output_up_to_date(const std::filesystem::path &file_path,
+                          const AssetDescription      &asset_description);
+
+bool is_import_up_to_date(const std::filesystem::path &manifest_file_path,
+                          std::uint32_t                importer_version,
+                          std::uint64_t                settings_hash);
+
+std::uint64_t hash_file(const std::filesystem::path &file_path);
+
+} // namespace dc
@@ -1,6 +1,16 @@
 #include "importer.hpp"
+#include "engine.hpp"
+#include "filesystem.hpp"
+#include "image.hpp"
+#include "log.hpp"
+#include "util.hpp"
 
+#include <algorithm>
 #include <cctype>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 namespace dc
 {
@@ -24,4 +34,306 @@ std::filesystem::path sanitize_file_path(const std::filesystem::path &file_path)
   return (file_path_str + file_path.extension().string());
 }
 
+TextureFormat texture_format_for_usage(TextureUsage usage, bool has_alpha)
+{
+  switch (usage)
+  {
+  case TextureUsage::Albedo:
+  {
+    if (!has_alpha)
+    {
+      return TextureFormat::Bc1;
+    }
+    const auto alpha_compression =
+        Engine::instance()->config()->config_value_string("TextureImport",
+                                                          "alpha_compression",
+                                                          "bc7");
+    return alpha_compression == "bc3" ? TextureFormat::Bc3
+                                      : TextureFormat::Bc7;
+  }
+  case TextureUsage::Normal:
+    return TextureFormat::Bc5;
+  case TextureUsage::Data:
+    return TextureFormat::Bc1;
+  }
+  return TextureFormat::Rgba8;
+}
+
+std::uint64_t texture_import_settings_hash(TextureUsage usage)
+{
+  const auto alpha_compression =
+      Engine::instance()->config()->config_value_string("TextureImport",
+                                                        "alpha_compression",
+                                                        "bc7");
+  const auto hash = hash_bytes(&usage, sizeof(usage));
+  return hash_bytes(alpha_compression.data(), alpha_compression.size(), hash);
+}
+
+std::uint64_t texture_import_settings_hash()
+{
+  auto hash = hash_seed;
+  for (const auto usage :
+       {TextureUsage::Albedo, TextureUsage::Normal, TextureUsage::Data})
+  {
+    const auto usage_hash = texture_import_settings_hash(usage);
+    hash = hash_bytes(&usage_hash, sizeof(usage_hash), hash);
+  }
+  return hash;
+}
+
+CompressionCodec asset_compression_codec()
+{
+  const auto compression =
+      Engine::instance()->config()->config_value_string("AssetImport",
+                                                        "compression",
+                                                        "lz");
+  return compression == "lz" ? CompressionCodec::Lz : CompressionCodec::None;
+}
+
+TextureDescription import_texture_description(const Image &image,
+                                              TextureUsage usage)
+{
+  if (image.format() != ImageFormat::UnsignedByte)
+  {
+    throw std::runtime_error("Can not compress float textures");
+  }
+
+  const auto width          = image.width();
+  const auto height         = image.height();
+  const auto channels_count = image.channels_count();
+  if (width <= 0 || height <= 0 || channels_count < 1 || channels_count > 4)
+  {
+    throw std::runtime_error("Invalid texture");
+  }
+
+  // expand to rgba8. One and two channels are gray respectively gray alpha
+  const auto pixels_count =
+      static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+  const auto                data = image.data();
+  std::vector<std::uint8_t> pixels(pixels_count * 4);
+  bool                      has_alpha{false};
+  for (std::size_t i{0}; i < pixels_count; ++i)
+  {
+    const auto source = data + i * channels_count;
+    const auto target = pixels.data() + i * 4;
+    if (channels_count <= 2)
+    {
+      target[0] = target[1] = target[2] = source[0];
+    }
+    else
+    {
+      target[0] = source[0];
+      target[1] = source[1];
+      target[2] = source[2];
+    }
+    target[3] = (channels_count == 2 || channels_count == 4)
+                    ? source[channels_count - 1]
+                    : 255;
+    has_alpha = has_alpha || target[3] != 255;
+  }
+
+  TextureDescription texture_description{};
+  texture_description.format_ = texture_format_for_usage(usage, has_alpha);
+  texture_description.width_  = width;
+  texture_description.height_ = height;
+  texture_description.levels_ = encode_texture_levels(
+      pixels.data(), width, height, texture_description.format_);
+  return texture_description;
+}
+
+TextureImportQueue::TextureImportQueue(
+    std::shared_ptr<ImportManifest> manifest)
+    : manifest_{std::move(manifest)}
+{
+  const auto threads_count =
+      std::max(std::thread::hardware_concurrency(), 1u);
+  thread_pool_ =
+      std::make_unique<ThreadPool>(threads_count, "Texture importer");
+}
+
+TextureImportQueue::~TextureImportQueue() { wait(); }
+
+std::string
+TextureImportQueue::push(const std::filesystem::path &source_file_path,
+                         const std::filesystem::path &output_file_path,
+                         TextureUsage                 usage)
+{
+  const auto output = output_file_path.string();
+
+  const auto output_iter = outputs_.find(output);
+  if (output_iter != outputs_.end())
+  {
+    // texture was already imported
+    return output_iter->second;
+  }
+
+  // reading is cheap compared to decoding and compressing, so the content
+  // hash gets computed right away
+  auto source_data = std::make_shared<std::vector<std::uint8_t>>(
+      read_binary_file(source_file_path));
+  const auto source_hash =
+      hash_bytes(source_data->data(), source_data->size());
+  const auto settings_hash = texture_import_settings_hash(usage);
+  const auto hash =
+      hash_bytes(&settings_hash, sizeof(settings_hash), source_hash);
+  manifest_->add_source(source_file_path, source_hash);
+
+  const auto content_iter = content_outputs_.find(hash);
+  if (content_iter != content_outputs_.end())
+  {
+    DC_LOG_DEBUG("Texture {} has the same content as {}",
+                 source_file_path.string(),
+                 content_iter->second);
+    outputs_[output] = content_iter->second;
+    return content_iter->second;
+  }
+  outputs_[output]       = output;
+  content_outputs_[hash] = output;
+
+  AssetDescription asset_description{};
+  asset_description.original_file_ = normalize_path(source_file_path).string();
+  // build info to skip the import next time
+  asset_description.source_hash_      = source_hash;
+  asset_description.settings_hash_    = settings_hash;
+  asset_description.importer_version_ = texture_importer_version;
+  manifest_->add_output(output_file_path, asset_description);
+
+  const auto imported_file_path =
+      Engine::instance()->base_directory() / output_file_path;
+  if (is_output_up_to_date(imported_file_path, asset_description))
+  {
+    DC_LOG_DEBUG("Texture {} is up to date", output);
+    return output;
+  }
+
+  {
+    std::lock_guard lock{mutex_};
+    ++pending_count_;
+  }
+
+  thread_pool_->submit(
+      [this, source_data, usage, asset_description, imported_file_path]()
+      {
+        try
+        {
+          // store GPU ready levels so that loading needs no decoding
+          Image image{};
+          image.load_from_memory(source_data->data(), source_data->size());
+          const auto texture_description =
+              import_texture_description(image, usage);
+          texture_description.save(imported_file_path, asset_description);
+          finish_import(false);
+        }
+        // anything escaping would block wait() forever
+        catch (const std::exception &error)
+        {
+          DC_LOG_WARN("Could not import texture {}: {}",
+                      asset_description.original_file_,
+                      error.what());
+          finish_import(true);
+        }
+      });
+
+  return output;
+}
+
+void TextureImportQueue::wait()
+{
+  std::unique_lock lock{mutex_};
+  condition_.wait(lock, [this]() { return pending_count_ == 0; });
+}
+
+std::size_t TextureImportQueue::failed_count() const
+{
+  std::lock_guard lock{mutex_};
+  return failed_count_;
+}
+
+void TextureImportQueue::finish_import(bool is_failed)
+{
+  {
+    std::lock_guard lock{mutex_};
+    --pending_count_;
+    if (is_failed)
+    {
+      ++failed_count_;
+    }
+  }
+  condition_.notify_all();
+}
+
+void import_directory(
+    const std::filesystem::path                                 &directory,
+    const std::function<bool(const std::filesystem::path &)>    &is_importable,
+    const std::function<bool(const std::filesystem::path &file_path,
+                             const std::string           &name)> &import)
+{
+  std::vector<std::filesystem::path> file_paths;
+  for (const auto &entry :
+       std::filesystem::recursive_directory_iterator(directory))
+  {
+    if (entry.is_regular_file() && is_importable(entry.path()))
+    {
+      file_paths.push_back(entry.path());
+    }
+  }
+  std::sort(file_paths.begin(), file_paths.end());
+
+  std::mutex              mutex;
+  std::condition_variable condition;
+  std::size_t             pending_count{file_paths.size()};
+  std::size_t             imported_count{0};
+  std::size_t             failed_count{0};
+
+  {
+    const auto threads_count =
+        std::max(std::thread::hardware_concurrency(), 1u);
+    ThreadPool thread_pool{threads_count, "Batch importer"};
+    for (const auto &file_path : file_paths)
+    {
+      auto relative_file_path = file_path.lexically_relative(directory);
+      relative_file_path.replace_extension();
+      auto name = relative_file_path.generic_string();
+      std::replace(name.begin(), name.end(), '/', '_');
+
+      thread_pool.submit(
+          [&, file_path, name]()
+          {
+            bool is_imported{false};
+            bool is_failed{false};
+            try
+            {
+              is_imported = import(file_path, name);
+            }
+            catch (const std::exception &error)
+            {
+              DC_LOG_ERROR("Could not import {}: {}",
+                           file_path.string(),
+                           error.what());
+              is_failed = true;
+            }
+
+            {
+              std::lock_guard lock{mutex};
+              imported_count += is_imported ? 1 : 0;
+              failed_count += is_failed ? 1 : 0;
+              --pending_count;
+            }
+            condition.notify_all();
+          });
+    }
+
+    // the pool drops queued tasks on destruction
+    std::unique_lock lock{mutex};
+    condition.wait(lock, [&pending_count]() { return pending_count == 0; });
+  }
+
+  DC_LOG_INFO("Imported {} of {} files in {}, {} up to date, {} failed",
+              imported_count,
+              file_paths.size(),
+              directory.string(),
+              file_paths.size() - imported_count - failed_count,
+              failed_count);
+}
+
 } // namespace dc
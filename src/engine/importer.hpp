@@ -1,11 +1,115 @@
 #pragma once
 
+#include "import_manifest.hpp"
+#include "serialization.hpp"
+#include "texture_compression.hpp"
+#include "thread_pool.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 namespace dc
 {
 
+class Image;
+
+/// Increment if imported textures change
+constexpr std::uint32_t texture_importer_version{1};
+
+/** What a texture is used for. Decides how the texture gets compressed */
+enum class TextureUsage
+{
+  Albedo,
+  Normal,
+  Data,
+};
+
 std::filesystem::path
 sanitize_file_path(const std::filesystem::path &file_path);
-}
+
+TextureFormat texture_format_for_usage(TextureUsage usage, bool has_alpha);
+
+/// Hash of all settings that change how a texture gets imported
+std::uint64_t texture_import_settings_hash(TextureUsage usage);
+/// Combined settings hash of all usages
+std::uint64_t texture_import_settings_hash();
+
+/// Codec meshes and environment maps get compressed with
+CompressionCodec asset_compression_codec();
+
+/**
+ * Generates the mip chain of the image and compresses it in the format that
+ * fits the usage.
+ */
+TextureDescription import_texture_description(const Image &image,
+                                              TextureUsage usage);
+
+/**
+ * Imports textures on all cores. Sources with the same content and usage get
+ * imported only once, even if they are referenced under different paths or
+ * by different meshes. Outputs that are up to date don't get imported again.
+ * Sources and outputs get recorded in the manifest. Outputs get written
+ * atomically.
+ */
+class TextureImportQueue
+{
+public:
+  explicit TextureImportQueue(std::shared_ptr<ImportManifest> manifest);
+  /// Waits for all queued imports
+  ~TextureImportQueue();
+
+  /**
+   * Queues the import of the source into the output, which is relative to
+   * the base directory. Returns the output the texture will be imported to,
+   * which is the output of an identical texture if one got queued before.
+   * Throws if the source can not be read.
+   */
+  std::string push(const std::filesystem::path &source_file_path,
+                   const std::filesystem::path &output_file_path,
+                   TextureUsage                 usage);
+
+  void wait();
+
+  std::size_t failed_count() const;
+
+private:
+  std::unique_ptr<ThreadPool> thread_pool_;
+
+  // only used by the thread that pushes
+  std::shared_ptr<ImportManifest>                manifest_;
+  std::unordered_map<std::string, std::string>   outputs_;
+  std::unordered_map<std::uint64_t, std::string> content_outputs_;
+
+  mutable std::mutex      mutex_;
+  std::condition_variable condition_;
+  std::size_t             pending_count_{0};
+  std::size_t             failed_count_{0};
+
+  void finish_import(bool is_failed);
+
+  TextureImportQueue(const TextureImportQueue &)            = delete;
+  TextureImportQueue(TextureImportQueue &&)                 = delete;
+  TextureImportQueue &operator=(const TextureImportQueue &) = delete;
+  TextureImportQueue &operator=(TextureImportQueue &&)      = delete;
+};
+
+/**
+ * Imports every file below the directory for which is_importable returns
+ * true, on all cores. The name of an import is the file path relative to
+ * the directory without extension. The import returns false if it got
+ * skipped because it is up to date. Failed imports get logged and don't stop
+ * the others.
+ */
+void import_directory(
+    const std::filesystem::path                                 &directory,
+    const std::function<bool(const std::filesystem::path &)>    &is_importable,
+    const std::function<bool(const std::filesystem::path &file_path,
+                             const std::string           &name)> &import);
+} // namespace dc
@@ -0,0 +1,282 @@
+#include "job_system.hpp"
+#include "log.hpp"
+#include "profiling.hpp"
+
+#include <algorithm>
+#include <exception>
+
+namespace
+{
+
+// set on the worker threads, so that jobs submitted from a worker go to its
+// own deque
+thread_local const dc::JobSystem *current_job_system{nullptr};
+thread_local std::size_t          current_job_worker_index{0};
+
+} // namespace
+
+namespace dc
+{
+
+bool JobCounter::is_done() const { return count_ == 0; }
+
+JobSystem::JobSystem(std::size_t threads_count, const std::string &name)
+    : name_{name}
+{
+  threads_count = std::max(threads_count, std::size_t{1});
+  worker_queues_.reserve(threads_count);
+  for (std::size_t i{0}; i < threads_count; ++i)
+  {
+    worker_queues_.push_back(std::make_unique<WorkerQueue>());
+  }
+
+  threads_.reserve(threads_count);
+  for (std::size_t i{0}; i < threads_count; ++i)
+  {
+    threads_.emplace_back([this, i]() { worker_loop(i); });
+  }
+}
+
+JobSystem::~JobSystem()
+{
+  {
+    std::lock_guard lock{sleep_mutex_};
+    is_stopped_ = true;
+  }
+  sleep_condition_.notify_all();
+
+  for (auto &thread : threads_)
+  {
+    thread.join();
+  }
+}
+
+void JobSystem::submit(Job job, JobCounter *counter)
+{
+  if (counter)
+  {
+    ++counter->count_;
+  }
+
+  QueuedJob  queued_job{std::move(job), counter};
+  const auto worker_index = current_worker_index();
+  if (worker_index < worker_queues_.size())
+  {
+    auto           &worker_queue = *worker_queues_[worker_index];
+    std::lock_guard lock{worker_queue.mutex_};
+    worker_queue.jobs_.push_back(std::move(queued_job));
+  }
+  else
+  {
+    std::lock_guard lock{shared_jobs_mutex_};
+    shared_jobs_.push_back(std::move(queued_job));
+  }
+
+  {
+    std::lock_guard lock{sleep_mutex_};
+    ++queued_jobs_count_;
+  }
+  sleep_condition_.notify_one();
+}
+
+void JobSystem::wait(JobCounter &counter)
+{
+  DC_PROFILE_SCOPE("JobSystem::wait()");
+
+  const auto worker_index = current_worker_index();
+  while (!counter.is_done())
+  {
+    if (run_job(worker_index))
+    {
+      continue;
+    }
+
+    // the remaining jobs of the counter run on other threads
+    std::unique_lock lock{sleep_mutex_};
+    sleep_condition_.wait(
+        lock,
+        [&]() { return counter.is_done() || queued_jobs_count_ > 0; });
+  }
+}
+
+void JobSystem::parallel_for(
+    std::size_t                                          first,
+    std::size_t                                          last,
+    std::size_t                                          chunk_size,
+    const std::function<void(std::size_t, std::size_t)> &function)
+{
+  if (first >= last)
+  {
+    return;
+  }
+
+  chunk_size              = std::max(chunk_size, std::size_t{1});
+  const auto chunks_count = (last - first + chunk_size - 1) / chunk_size;
+  if (chunks_count == 1)
+  {
+    function(first, last);
+    return;
+  }
+
+  std::mutex         exception_mutex;
+  std::exception_ptr exception{};
+  const auto         run_chunk = [&](std::size_t i)
+  {
+    const auto chunk_first = first + i * chunk_size;
+    try
+    {
+      function(chunk_first, std::min(chunk_first + chunk_size, last));
+    }
+    catch (...)
+    {
+      std::lock_guard lock{exception_mutex};
+      if (!exception)
+      {
+        exception = std::current_exception();
+      }
+    }
+  };
+
+  // the calling thread takes the first chunk and helps with the others
+  JobCounter counter;
+  for (std::size_t i{1}; i < chunks_count; ++i)
+  {
+    submit([&run_chunk, i]() { run_chunk(i); }, &counter);
+  }
+  run_chunk(0);
+  wait(counter);
+
+  if (exception)
+  {
+    std::rethrow_exception(exception);
+  }
+}
+
+std::size_t JobSystem::threads_count() const { return threads_.size(); }
+
+void JobSystem::worker_loop(std::size_t worker_index)
+{
+  DC_PROFILE_THREAD(name_.c_str());
+
+  current_job_system       = this;
+  current_job_worker_index = worker_index;
+
+  while (true)
+  {
+    if (run_job(worker_index))
+    {
+      continue;
+    }
+
+    std::unique_lock lock{sleep_mutex_};
+    sleep_condition_.wait(
+        lock,
+        [this]() { return is_stopped_ || queued_jobs_count_ > 0; });
+    if (is_stopped_)
+    {
+      return;
+    }
+  }
+}
+
+std::size_t JobSystem::current_worker_index() const
+{
+  return current_job_system == this ? current_job_worker_index
+                                    : worker_queues_.size();
+}
+
+std::optional<JobSystem::QueuedJob>
+JobSystem::take_job(std::size_t worker_index)
+{
+  std::optional<QueuedJob> queued_job;
+  const auto               take = [&](std::deque<QueuedJob> &jobs, bool is_back)
+  {
+    if (jobs.empty())
+    {
+      return false;
+    }
+    if (is_back)
+    {
+      queued_job = std::move(jobs.back());
+      jobs.pop_back();
+    }
+    else
+    {
+      queued_job = std::move(jobs.front());
+      jobs.pop_front();
+    }
+    --queued_jobs_count_;
+    return true;
+  };
+
+  // the newest own job is the most likely to be in the cache
+  const auto workers_count = worker_queues_.size();
+  if (worker_index < workers_count)
+  {
+    auto           &worker_queue = *worker_queues_[worker_index];
+    std::lock_guard lock{worker_queue.mutex_};
+    if (take(worker_queue.jobs_, true))
+    {
+      return queued_job;
+    }
+  }
+
+  {
+    std::lock_guard lock{shared_jobs_mutex_};
+    if (take(shared_jobs_, false))
+    {
+      return queued_job;
+    }
+  }
+
+  // steal the oldest job of another worker, those tend to be the largest
+  for (std::size_t i{1}; i <= workers_count; ++i)
+  {
+    const auto victim_index = (worker_index + i) % workers_count;
+    if (victim_index == worker_index)
+    {
+      continue;
+    }
+    auto           &worker_queue = *worker_queues_[victim_index];
+    std::lock_guard lock{worker_queue.mutex_};
+    if (take(worker_queue.jobs_, false))
+    {
+      return queued_job;
+    }
+  }
+
+  return std::nullopt;
+}
+
+bool JobSystem::run_job(std::size_t worker_index)
+{
+  auto queued_job = take_job(worker_index);
+  if (!queued_job)
+  {
+    return false;
+  }
+
+  try
+  {
+    queued_job->job_();
+  }
+  catch (const std::exception &error)
+  {
+    DC_LOG_ERROR("Unhandled exception in job: {}", error.what());
+  }
+  catch (...)
+  {
+    DC_LOG_ERROR("Unhandled unknown exception in job");
+  }
+
+  const auto counter = queued_job->counter_;
+  if (counter && --counter->count_ == 0)
+  {
+    // waiting threads check the counter under the lock
+    std::lock_guard lock{sleep_mutex_};
+    sleep_condition_.notify_all();
+  }
+  return true;
+}
+
+} // namespace dc
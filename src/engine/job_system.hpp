@@ -0,0 +1,142 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dc
+{
+
+using Job = std::function<void()>;
+
+/** Counts the unfinished jobs that got submitted with it */
+class JobCounter
+{
+public:
+  bool is_done() const;
+
+private:
+  friend class JobSystem;
+
+  std::atomic<std::size_t> count_{0};
+};
+
+/**
+ * Runs short jobs on worker threads. Every worker has its own deque: jobs
+ * that get submitted from a worker go to the back of its deque and get run
+ * from there, while idle workers steal from the front of the other deques.
+ * Jobs from other threads go to a shared queue. Threads that wait for a
+ * counter run jobs in the meantime, so jobs can submit jobs and wait for
+ * them.
+ *
+ * Jobs should not block on IO, the asset loaders have their own threads for
+ * that.
+ */
+class JobSystem
+{
+public:
+  JobSystem(std::size_t threads_count, const std::string &name);
+
+  /// Pending jobs get dropped, so nobody may wait for a counter anymore
+  ~JobSystem();
+
+  /**
+   * Can be called from any thread. Exceptions of the job get logged. The
+   * counter needs to outlive the job.
+   */
+  void submit(Job job, JobCounter *counter = nullptr);
+
+  /// Runs jobs until all jobs of the counter are done
+  void wait(JobCounter &counter);
+
+  /**
+   * Calls the function with chunks of [first, last) on the workers and the
+   * calling thread and returns once all chunks are done. The first
+   * exception of the function gets rethrown.
+   */
+  void parallel_for(
+      std::size_t                                          first,
+      std::size_t                                          last,
+      std::size_t                                          chunk_size,
+      const std::function<void(std::size_t, std::size_t)> &function);
+
+  /**
+   * Calls the function for every entity of an entt view. The entities of
+   * the leading storage of the view get split into chunks and the ones that
+   * are not in the view get skipped. The function may only access the
+   * components of the entity it gets called for.
+   */
+  template <typename TView, typename TFunction>
+  void parallel_for_each(const TView &view,
+                         std::size_t  chunk_size,
+                         TFunction    function)
+  {
+    const auto &storage  = view.handle();
+    const auto  entities = storage.data();
+    parallel_for(0,
+                 storage.size(),
+                 chunk_size,
+                 [&](std::size_t first, std::size_t last)
+                 {
+                   for (auto i{first}; i < last; ++i)
+                   {
+                     if (view.contains(entities[i]))
+                     {
+                       function(entities[i]);
+                     }
+                   }
+                 });
+  }
+
+  std::size_t threads_count() const;
+
+private:
+  struct QueuedJob
+  {
+    Job         job_;
+    JobCounter *counter_{};
+  };
+
+  struct WorkerQueue
+  {
+    std::mutex            mutex_;
+    std::deque<QueuedJob> jobs_;
+  };
+
+  std::string                               name_;
+  std::vector<std::unique_ptr<WorkerQueue>> worker_queues_;
+  std::vector<std::thread>                  threads_;
+
+  std::mutex            shared_jobs_mutex_;
+  std::deque<QueuedJob> shared_jobs_;
+
+  // idle workers and waiting threads sleep until jobs get queued or a
+  // counter is done
+  std::atomic<std::size_t> queued_jobs_count_{0};
+  std::mutex               sleep_mutex_;
+  std::condition_variable  sleep_condition_;
+  bool                     is_stopped_{false};
+
+  void worker_loop(std::size_t worker_index);
+
+  /// Index of the worker of the calling thread or threads_count()
+  std::size_t current_worker_index() const;
+
+  std::optional<QueuedJob> take_job(std::size_t worker_index);
+  bool                     run_job(std::size_t worker_index);
+
+  JobSystem(const JobSystem &)            = delete;
+  JobSystem(JobSystem &&)                 = delete;
+  JobSystem &operator=(const JobSystem &) = delete;
+  JobSystem &operator=(JobSystem &&)      = delete;
+};
+
+} // namespace dc
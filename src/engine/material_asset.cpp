@@ -1,6 +1,7 @@
 #include "material_asset.hpp"
 #include "asset.hpp"
 #include "asset_handle.hpp"
+#include "binary_reader.hpp"
 #include "engine.hpp"
 #include "log.hpp"
 #include "material.hpp"
@@ -13,71 +14,92 @@
 namespace dc
 {
 
-MaterialAssetHandle::MaterialAssetHandle(const std::filesystem::path &file_path, const Asset&asset) : AssetHandle{asset}
+MaterialAssetHandle::MaterialAssetHandle(const Asset &asset)
+    : AssetHandle{asset}
+{
+}
+
+MaterialAssetHandle::~MaterialAssetHandle() = default;
+
+void MaterialAssetHandle::load(const AssetData &asset_data)
 {
   try
   {
-    MaterialDescription material_description{};
-    material_description.read(file_path);
-
-    const auto asset_cache = Engine::instance()->asset_cache();
-    material_              = std::make_shared<Material>();
-
-    if (!material_description.albedo_texture_name_.empty())
-    {
-      material_->set_albedo_texture(
-          std::dynamic_pointer_cast<TextureAssetHandle>(asset_cache->load_asset(
-              Asset{material_description.albedo_texture_name_})));
-    }
-    material_->set_albedo_color(material_description.albedo_color_);
-
-    if (!material_description.emissive_texture_name_.empty())
-    {
-      material_->set_emissive_texture(
-          std::dynamic_pointer_cast<TextureAssetHandle>(asset_cache->load_asset(
-              Asset{material_description.emissive_texture_name_})));
-    }
-    material_->set_emissive_color(material_description.emissive_color_);
-
-    material_->set_roughness_texture(
-        std::dynamic_pointer_cast<TextureAssetHandle>(asset_cache->load_asset(
-            Asset{material_description.roughness_texture_name_})));
-    material_->set_roughness(material_description.roughness_);
-
-    if (!material_description.ambient_occlusion_texture_name_.empty())
-    {
-      material_->set_ambient_occlusion_texture(
-          std::dynamic_pointer_cast<TextureAssetHandle>(asset_cache->load_asset(
-              Asset{material_description.ambient_occlusion_texture_name_})));
-    }
-
-    if (!material_description.normal_texture_name_.empty())
-    {
-      material_->set_normal_texture(
-          std::dynamic_pointer_cast<TextureAssetHandle>(asset_cache->load_asset(
-              Asset{material_description.normal_texture_name_})));
-    }
-
-    // TODO: Handle transparency
-    material_->set_transparent(false);
+    auto material_description = std::make_unique<MaterialDescription>();
+    BinaryReader reader{asset_data.data_, asset_data.size_};
+    material_description->read(reader);
+    material_description_ = std::move(material_description);
   }
   catch (const std::runtime_error &error)
   {
     DC_LOG_WARN("Could not load material asset {}: {}",
-                file_path.string(),
+                asset().id(),
                 error.what());
   }
 }
 
+void MaterialAssetHandle::create()
+{
+  if (!material_description_)
+  {
+    return;
+  }
+  const auto &material_description = *material_description_;
+
+  const auto asset_cache = Engine::instance()->asset_cache();
+  auto       material    = std::make_shared<Material>();
+
+  if (!material_description.albedo_texture_name_.empty())
+  {
+    material->set_albedo_texture(
+        std::dynamic_pointer_cast<TextureAssetHandle>(asset_cache->load_asset(
+            Asset{material_description.albedo_texture_name_})));
+  }
+  material->set_albedo_color(material_description.albedo_color_);
+
+  if (!material_description.emissive_texture_name_.empty())
+  {
+    material->set_emissive_texture(
+        std::dynamic_pointer_cast<TextureAssetHandle>(asset_cache->load_asset(
+            Asset{material_description.emissive_texture_name_})));
+  }
+  material->set_emissive_color(material_description.emissive_color_);
+
+  material->set_roughness_texture(
+      std::dynamic_pointer_cast<TextureAssetHandle>(asset_cache->load_asset(
+          Asset{material_description.roughness_texture_name_})));
+  material->set_roughness(material_description.roughness_);
+
+  if (!material_description.ambient_occlusion_texture_name_.empty())
+  {
+    material->set_ambient_occlusion_texture(
+        std::dynamic_pointer_cast<TextureAssetHandle>(asset_cache->load_asset(
+            Asset{material_description.ambient_occlusion_texture_name_})));
+  }
+
+  if (!material_description.normal_texture_name_.empty())
+  {
+    material->set_normal_texture(
+        std::dynamic_pointer_cast<TextureAssetHandle>(asset_cache->load_asset(
+            Asset{material_description.normal_texture_name_})));
+  }
+
+  // TODO: Handle transparency
+  material->set_transparent(false);
+
+  material_description_ = nullptr;
+  material_             = std::move(material);
+}
+
 bool MaterialAssetHandle::is_ready() const { return material_ != nullptr; }
 
 std::shared_ptr<Material> MaterialAssetHandle::get() const { return material_; }
 
 std::shared_ptr<AssetHandle>
-material_asset_loader(const std::filesystem::path &file_path,
-                      const Asset                 &asset)
+material_asset_loader(const std::filesystem::path & /*file_path*/,
+                      const Asset &asset)
 {
-  return std::make_shared<MaterialAssetHandle>(file_path, asset);
+  return std::make_shared<MaterialAssetHandle>(asset);
 }
 
 } // namespace dc
@@ -9,18 +9,24 @@
 namespace dc
 {
 
+struct MaterialDescription;
+
 class MaterialAssetHandle : public AssetHandle
 {
 public:
-  MaterialAssetHandle(const std::filesystem::path &file_path,
-                      const Asset                 &asset);
+  MaterialAssetHandle(const Asset &asset);
+  ~MaterialAssetHandle() override;
 
   bool is_ready() const override;
 
+  void load(const AssetData &asset_data) override;
+  void create() override;
+
   std::shared_ptr<Material> get() const;
 
 private:
-  std::shared_ptr<Material> material_;
+  std::unique_ptr<MaterialDescription> material_description_;
+  std::shared_ptr<Material>            material_;
 };
 
 std::shared_ptr<AssetHandle>
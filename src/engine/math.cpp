@@ -1,5 +1,169 @@
 #include "math.hpp"
 
+#if defined(__SSE2__) || defined(_M_X64)
+#define DC_MATH_SSE
+#include <immintrin.h>
+#endif
+
+namespace
+{
+
+/// Writes the matrix of one transform, column major
+void compose_transform_matrix(const dc::math::TrsArrays &trs,
+                              std::size_t                i,
+                              float                     *matrix)
+{
+  const auto x = trs.rotation_x_[i];
+  const auto y = trs.rotation_y_[i];
+  const auto z = trs.rotation_z_[i];
+  const auto w = trs.rotation_w_[i];
+
+  const auto sx = trs.scale_x_[i];
+  const auto sy = trs.scale_y_[i];
+  const auto sz = trs.scale_z_[i];
+
+  matrix[0]  = (1.0f - 2.0f * (y * y + z * z)) * sx;
+  matrix[1]  = 2.0f * (x * y + w * z) * sx;
+  matrix[2]  = 2.0f * (x * z - w * y) * sx;
+  matrix[3]  = 0.0f;
+  matrix[4]  = 2.0f * (x * y - w * z) * sy;
+  matrix[5]  = (1.0f - 2.0f * (x * x + z * z)) * sy;
+  matrix[6]  = 2.0f * (y * z + w * x) * sy;
+  matrix[7]  = 0.0f;
+  matrix[8]  = 2.0f * (x * z + w * y) * sz;
+  matrix[9]  = 2.0f * (y * z - w * x) * sz;
+  matrix[10] = (1.0f - 2.0f * (x * x + y * y)) * sz;
+  matrix[11] = 0.0f;
+  matrix[12] = trs.position_x_[i];
+  matrix[13] = trs.position_y_[i];
+  matrix[14] = trs.position_z_[i];
+  matrix[15] = 1.0f;
+}
+
+#ifdef DC_MATH_SSE
+
+// the kernel is written once for both vector widths, these overloads pick
+// the instructions
+
+__m128 load(const float *data, __m128 /*tag*/) { return _mm_loadu_ps(data); }
+__m128 splat(float value, __m128 /*tag*/) { return _mm_set1_ps(value); }
+__m128 add(__m128 a, __m128 b) { return _mm_add_ps(a, b); }
+__m128 sub(__m128 a, __m128 b) { return _mm_sub_ps(a, b); }
+__m128 mul(__m128 a, __m128 b) { return _mm_mul_ps(a, b); }
+
+/// Transposes the rows of a column into the columns of four matrices
+void store_column(__m128      row_0,
+                  __m128      row_1,
+                  __m128      row_2,
+                  __m128      row_3,
+                  std::size_t column,
+                  float      *matrices)
+{
+  _MM_TRANSPOSE4_PS(row_0, row_1, row_2, row_3);
+  _mm_storeu_ps(matrices + 0 * 16 + column * 4, row_0);
+  _mm_storeu_ps(matrices + 1 * 16 + column * 4, row_1);
+  _mm_storeu_ps(matrices + 2 * 16 + column * 4, row_2);
+  _mm_storeu_ps(matrices + 3 * 16 + column * 4, row_3);
+}
+
+// enabled by the USE_AVX build option
+#ifdef __AVX__
+
+__m256 load(const float *data, __m256 /*tag*/)
+{
+  return _mm256_loadu_ps(data);
+}
+__m256 splat(float value, __m256 /*tag*/) { return _mm256_set1_ps(value); }
+__m256 add(__m256 a, __m256 b) { return _mm256_add_ps(a, b); }
+__m256 sub(__m256 a, __m256 b) { return _mm256_sub_ps(a, b); }
+__m256 mul(__m256 a, __m256 b) { return _mm256_mul_ps(a, b); }
+
+void store_column(__m256      row_0,
+                  __m256      row_1,
+                  __m256      row_2,
+                  __m256      row_3,
+                  std::size_t column,
+                  float      *matrices)
+{
+  store_column(_mm256_castps256_ps128(row_0),
+               _mm256_castps256_ps128(row_1),
+               _mm256_castps256_ps128(row_2),
+               _mm256_castps256_ps128(row_3),
+               column,
+               matrices);
+  store_column(_mm256_extractf128_ps(row_0, 1),
+               _mm256_extractf128_ps(row_1, 1),
+               _mm256_extractf128_ps(row_2, 1),
+               _mm256_extractf128_ps(row_3, 1),
+               column,
+               matrices + 4 * 16);
+}
+
+#endif
+
+/**
+ * Writes the matrices of as many transforms as the vector has lanes. Every
+ * lane computes the same as compose_transform_matrix().
+ */
+template <typename TVector>
+void compose_transform_lanes(const dc::math::TrsArrays &trs,
+                             std::size_t                i,
+                             float                     *matrices)
+{
+  const TVector tag{};
+  const auto    x = load(trs.rotation_x_ + i, tag);
+  const auto    y = load(trs.rotation_y_ + i, tag);
+  const auto    z = load(trs.rotation_z_ + i, tag);
+  const auto    w = load(trs.rotation_w_ + i, tag);
+
+  const auto one  = splat(1.0f, tag);
+  const auto two  = splat(2.0f, tag);
+  const auto zero = splat(0.0f, tag);
+
+  const auto xx = mul(x, x);
+  const auto yy = mul(y, y);
+  const auto zz = mul(z, z);
+  const auto xy = mul(x, y);
+  const auto xz = mul(x, z);
+  const auto yz = mul(y, z);
+  const auto wx = mul(w, x);
+  const auto wy = mul(w, y);
+  const auto wz = mul(w, z);
+
+  const auto sx = load(trs.scale_x_ + i, tag);
+  const auto sy = load(trs.scale_y_ + i, tag);
+  const auto sz = load(trs.scale_z_ + i, tag);
+
+  store_column(mul(sub(one, mul(two, add(yy, zz))), sx),
+               mul(mul(two, add(xy, wz)), sx),
+               mul(mul(two, sub(xz, wy)), sx),
+               zero,
+               0,
+               matrices);
+  store_column(mul(mul(two, sub(xy, wz)), sy),
+               mul(sub(one, mul(two, add(xx, zz))), sy),
+               mul(mul(two, add(yz, wx)), sy),
+               zero,
+               1,
+               matrices);
+  store_column(mul(mul(two, add(xz, wy)), sz),
+               mul(mul(two, sub(yz, wx)), sz),
+               mul(sub(one, mul(two, add(xx, yy))), sz),
+               zero,
+               2,
+               matrices);
+  store_column(load(trs.position_x_ + i, tag),
+               load(trs.position_y_ + i, tag),
+               load(trs.position_z_ + i, tag),
+               one,
+               3,
+               matrices);
+}
+
+#endif
+
+} // namespace
+
 namespace dc::math
 {
 
@@ -141,4 +305,119 @@ int calc_mipmap_levels_2d(int width, int height)
   return levels;
 }
 
+void TrsBuffer::resize(std::size_t count)
+{
+  for (auto array : {&position_x_,
+                     &position_y_,
+                     &position_z_,
+                     &rotation_x_,
+                     &rotation_y_,
+                     &rotation_z_,
+                     &rotation_w_,
+                     &scale_x_,
+                     &scale_y_,
+                     &scale_z_})
+  {
+    array->resize(count);
+  }
+}
+
+std::size_t TrsBuffer::size() const { return position_x_.size(); }
+
+void TrsBuffer::set(std::size_t      index,
+                    const glm::vec3 &position,
+                    const glm::quat &rotation,
+                    const glm::vec3 &scale)
+{
+  position_x_[index] = position.x;
+  position_y_[index] = position.y;
+  position_z_[index] = position.z;
+  rotation_x_[index] = rotation.x;
+  rotation_y_[index] = rotation.y;
+  rotation_z_[index] = rotation.z;
+  rotation_w_[index] = rotation.w;
+  scale_x_[index]    = scale.x;
+  scale_y_[index]    = scale.y;
+  scale_z_[index]    = scale.z;
+}
+
+TrsArrays TrsBuffer::arrays(std::size_t first) const
+{
+  TrsArrays trs{};
+  trs.position_x_ = position_x_.data() + first;
+  trs.position_y_ = position_y_.data() + first;
+  trs.position_z_ = position_z_.data() + first;
+  trs.rotation_x_ = rotation_x_.data() + first;
+  trs.rotation_y_ = rotation_y_.data() + first;
+  trs.rotation_z_ = rotation_z_.data() + first;
+  trs.rotation_w_ = rotation_w_.data() + first;
+  trs.scale_x_    = scale_x_.data() + first;
+  trs.scale_y_    = scale_y_.data() + first;
+  trs.scale_z_    = scale_z_.data() + first;
+  return trs;
+}
+
+void AffineMatrixBuffer::resize(std::size_t count)
+{
+  for (auto &array : elements_)
+  {
+    array.resize(count);
+  }
+}
+
+std::size_t AffineMatrixBuffer::size() const { return elements_[0].size(); }
+
+void AffineMatrixBuffer::set(std::size_t index, const glm::mat4 &matrix)
+{
+  for (glm::length_t column{0}; column < 4; ++column)
+  {
+    for (glm::length_t row{0}; row < 3; ++row)
+    {
+      elements_[column * 3 + row][index] = matrix[column][row];
+    }
+  }
+}
+
+glm::mat4 AffineMatrixBuffer::get(std::size_t index) const
+{
+  glm::mat4 matrix{1.0f};
+  for (glm::length_t column{0}; column < 4; ++column)
+  {
+    for (glm::length_t row{0}; row < 3; ++row)
+    {
+      matrix[column][row] = elements_[column * 3 + row][index];
+    }
+  }
+  return matrix;
+}
+
+void compose_transform_matrices(const TrsArrays &trs,
+                                std::size_t      count,
+                                glm::mat4       *matrices)
+{
+  if (count == 0)
+  {
+    return;
+  }
+
+  const auto  data = glm::value_ptr(*matrices);
+  std::size_t i{0};
+#ifdef __AVX__
+  for (; i + 8 <= count; i += 8)
+  {
+    compose_transform_lanes<__m256>(trs, i, data + i * 16);
+  }
+#endif
+#ifdef DC_MATH_SSE
+  for (; i + 4 <= count; i += 4)
+  {
+    compose_transform_lanes<__m128>(trs, i, data + i * 16);
+  }
+#endif
+  for (; i < count; ++i)
+  {
+    compose_transform_matrix(trs, i, data + i * 16);
+  }
+}
+
 } // namespace math
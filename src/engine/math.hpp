@@ -1,5 +1,7 @@
 #pragma once
 
+#include "aligned_allocator.hpp"
+
 #include <glm/ext/matrix_transform.hpp>
 #include <glm/ext/quaternion_trigonometric.hpp>
 #include <glm/ext/scalar_constants.hpp>
@@ -16,6 +18,8 @@
 #include <glm/gtx/string_cast.hpp>
 #include <glm/trigonometric.hpp>
 
+#include <array>
+#include <cstddef>
 #include <vector>
 
 namespace dc::math
@@ -52,4 +56,79 @@ struct BoundingBox
 
 int calc_mipmap_levels_2d(int width, int height);
 
+/** Translations, rotations and scales as one array per component */
+struct TrsArrays
+{
+  const float *position_x_{};
+  const float *position_y_{};
+  const float *position_z_{};
+
+  const float *rotation_x_{};
+  const float *rotation_y_{};
+  const float *rotation_z_{};
+  const float *rotation_w_{};
+
+  const float *scale_x_{};
+  const float *scale_y_{};
+  const float *scale_z_{};
+};
+
+/** Owns cache line aligned TrsArrays */
+class TrsBuffer
+{
+public:
+  void        resize(std::size_t count);
+  std::size_t size() const;
+
+  void set(std::size_t      index,
+           const glm::vec3 &position,
+           const glm::quat &rotation,
+           const glm::vec3 &scale);
+
+  /// Arrays that start at the index
+  TrsArrays arrays(std::size_t first) const;
+
+private:
+  AlignedVector<float> position_x_;
+  AlignedVector<float> position_y_;
+  AlignedVector<float> position_z_;
+
+  AlignedVector<float> rotation_x_;
+  AlignedVector<float> rotation_y_;
+  AlignedVector<float> rotation_z_;
+  AlignedVector<float> rotation_w_;
+
+  AlignedVector<float> scale_x_;
+  AlignedVector<float> scale_y_;
+  AlignedVector<float> scale_z_;
+};
+
+/**
+ * Owns cache line aligned affine matrices as one array per element. The last
+ * row is always 0, 0, 0, 1 and does not get stored.
+ */
+class AffineMatrixBuffer
+{
+public:
+  void        resize(std::size_t count);
+  std::size_t size() const;
+
+  void      set(std::size_t index, const glm::mat4 &matrix);
+  glm::mat4 get(std::size_t index) const;
+
+private:
+  // column major like glm, column c and row r are stored at c * 3 + r
+  std::array<AlignedVector<float>, 12> elements_;
+};
+
+/**
+ * Composes the matrices translate * rotate * scale, the same as the glm
+ * functions do. Processes eight transforms per iteration if the engine gets
+ * built with USE_AVX and four with SSE. Remaining transforms and other
+ * targets use a scalar loop.
+ */
+void compose_transform_matrices(const TrsArrays &trs,
+                                std::size_t      count,
+                                glm::mat4       *matrices);
+
 } // namespace math
@@ -1,4 +1,5 @@
 #include "mesh.hpp"
+#include "asset_data.hpp"
 #include "gl.hpp"
 #include "gl_index_buffer.hpp"
 #include "gl_texture.hpp"
@@ -16,79 +17,412 @@
 #include <algorithm>
 
 #include <cstddef>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <stdexcept>
+#include <string>
 
-namespace dc
+namespace
 {
 
-void SubMeshDescription::save(FILE *file) const
+static_assert(sizeof(dc::MeshDataHeader) % dc::mesh_data_alignment == 0);
+static_assert(sizeof(dc::MeshDataSubMesh) % dc::mesh_data_alignment == 0);
+static_assert(sizeof(dc::MeshLod) == 16);
+
+std::uint64_t align_mesh_data(std::uint64_t offset)
 {
-  write_vector(file, vertices_);
-  write_vector(file, indices_);
-  write_string(file, material_name_);
+  return (offset + dc::mesh_data_alignment - 1) /
+         dc::mesh_data_alignment * dc::mesh_data_alignment;
 }
 
-void SubMeshDescription::read(FILE *file)
+/** Writes the data padded to the next aligned size */
+void write_mesh_data(dc::BinaryWriter &writer,
+                     const void       *data,
+                     std::uint64_t     size)
 {
-  read_vector(file, vertices_);
-  read_vector(file, indices_);
-  read_string(file, material_name_);
+  writer.write(data, size);
+  writer.align(dc::mesh_data_alignment);
 }
 
-void MeshDescription::save(const std::filesystem::path &file_path,
-                           const AssetDescription      &asset_description) const
+/** Returns the bytes at the offset if they lie inside of the data */
+const std::uint8_t *mesh_data_range(const std::uint8_t *data,
+                                    std::uint64_t       data_size,
+                                    std::uint64_t       offset,
+                                    std::uint64_t       count,
+                                    std::uint64_t       element_size,
+                                    std::size_t         alignment)
 {
-  const auto file = std::fopen(file_path.string().c_str(), "wb");
-  if (!file)
+  if (offset > data_size || count > (data_size - offset) / element_size)
   {
-    throw std::runtime_error{"Could not open file " + file_path.string()};
+    throw std::runtime_error{"Mesh data lies outside of the file"};
   }
-  defer(std::fclose(file));
+  const auto range = data + offset;
+  if (reinterpret_cast<std::uintptr_t>(range) % alignment != 0)
+  {
+    throw std::runtime_error{"Mesh data is not aligned"};
+  }
+  return range;
+}
+
+/** A single level that covers all indices */
+std::vector<dc::MeshLod> full_detail_lods(std::size_t indices_count)
+{
+  dc::MeshLod lod{};
+  lod.indices_count_ = static_cast<std::uint32_t>(indices_count);
+  return {lod};
+}
 
-  asset_description.write(file);
+/** Sphere around the bounding box of the positions */
+void compute_bounding_sphere(dc::SubMeshView &sub_mesh,
+                             std::size_t      vertex_size)
+{
+  if (sub_mesh.vertices_count_ == 0)
+  {
+    return;
+  }
 
-  write_value(file, static_cast<std::uint64_t>(sub_meshes_.size()));
-  for (const auto &sub_mesh : sub_meshes_)
+  glm::vec3 min{std::numeric_limits<float>::max()};
+  glm::vec3 max{std::numeric_limits<float>::lowest()};
+  for (std::size_t i{0}; i < sub_mesh.vertices_count_; ++i)
   {
-    sub_mesh.save(file);
+    glm::vec3 position;
+    std::memcpy(&position,
+                sub_mesh.vertices_ + i * vertex_size,
+                sizeof(glm::vec3));
+    min = glm::min(min, position);
+    max = glm::max(max, position);
   }
+
+  sub_mesh.bounding_sphere_center_ = (min + max) * 0.5f;
+  sub_mesh.bounding_sphere_radius_ = glm::length(max - min) * 0.5f;
 }
 
-AssetDescription MeshDescription::read(const std::filesystem::path &file_path)
+} // namespace
+
+namespace dc
 {
-  const auto file = std::fopen(file_path.string().c_str(), "rb");
-  if (!file)
+
+void SubMeshDescription::save(BinaryWriter &writer) const
+{
+  write_vector(writer, vertices_);
+  write_vector(writer, indices_);
+  write_string(writer, material_name_);
+}
+
+void SubMeshDescription::read(BinaryReader &reader)
+{
+  read_vector(reader, vertices_);
+  read_vector(reader, indices_);
+  read_string(reader, material_name_);
+}
+
+void MeshDescription::save(const std::filesystem::path &file_path,
+                           const AssetDescription      &asset_description) const
+{
+  BinaryWriter writer{};
+
+  auto versioned_asset_description     = asset_description;
+  versioned_asset_description.version_ = 3;
+  versioned_asset_description.write(writer);
+  const auto payload_offset = writer.size();
+
+  // the header starts aligned in the file, so that everything after it stays
+  // aligned if the file gets mapped
+  writer.align(mesh_data_alignment);
+
+  const auto vertex_size = mesh_vertex_size(vertex_format_);
+
+  MeshDataHeader header{};
+  header.sub_meshes_count_ = static_cast<std::uint32_t>(sub_meshes_.size());
+  header.vertex_format_    = vertex_format_;
+  header.vertex_size_      = static_cast<std::uint32_t>(vertex_size);
+
+  std::vector<MeshDataSubMesh>      table(sub_meshes_.size());
+  std::vector<std::vector<MeshLod>> lods(sub_meshes_.size());
+  auto offset = align_mesh_data(sizeof(MeshDataHeader) +
+                                sizeof(MeshDataSubMesh) * table.size());
+  for (std::size_t i{0}; i < table.size(); ++i)
   {
-    throw std::runtime_error{"Could not open file " + file_path.string()};
+    const auto &sub_mesh = sub_meshes_[i];
+    auto       &entry    = table[i];
+
+    lods[i] = sub_mesh.lods_.empty()
+                  ? full_detail_lods(sub_mesh.indices_.size())
+                  : sub_mesh.lods_;
+
+    entry.vertices_offset_ = offset;
+    entry.vertices_count_  = sub_mesh.vertices_.size();
+    offset += align_mesh_data(sub_mesh.vertices_.size() * vertex_size);
+
+    entry.indices_offset_ = offset;
+    entry.indices_count_  = sub_mesh.indices_.size();
+    offset +=
+        align_mesh_data(sub_mesh.indices_.size() * sizeof(std::uint32_t));
+
+    entry.material_name_offset_ = offset;
+    entry.material_name_size_   = sub_mesh.material_name_.size();
+    offset += align_mesh_data(sub_mesh.material_name_.size());
+
+    entry.lods_offset_ = offset;
+    entry.lods_count_  = lods[i].size();
+    offset += align_mesh_data(lods[i].size() * sizeof(MeshLod));
   }
-  defer(std::fclose(file));
+  header.data_size_ = offset;
 
+  write_value(writer, header);
+  write_mesh_data(writer, table.data(), table.size() * sizeof(MeshDataSubMesh));
+  std::vector<PackedVertex> packed_vertices;
+  for (std::size_t i{0}; i < sub_meshes_.size(); ++i)
+  {
+    const auto &sub_mesh = sub_meshes_[i];
+    const void *vertices = sub_mesh.vertices_.data();
+    if (vertex_format_ == VertexFormat::Packed)
+    {
+      packed_vertices.resize(sub_mesh.vertices_.size());
+      std::transform(sub_mesh.vertices_.begin(),
+                     sub_mesh.vertices_.end(),
+                     packed_vertices.begin(),
+                     pack_vertex);
+      vertices = packed_vertices.data();
+    }
+    write_mesh_data(writer, vertices, sub_mesh.vertices_.size() * vertex_size);
+    write_mesh_data(writer,
+                    sub_mesh.indices_.data(),
+                    sub_mesh.indices_.size() * sizeof(std::uint32_t));
+    write_mesh_data(writer,
+                    sub_mesh.material_name_.data(),
+                    sub_mesh.material_name_.size());
+    write_mesh_data(writer, lods[i].data(), lods[i].size() * sizeof(MeshLod));
+  }
+  // the padding gets compressed too, so the decompressed data keeps the layout
+  writer.compress(payload_offset, asset_description.compression_codec_);
+  writer.save(file_path);
+}
+
+AssetDescription MeshDescription::read(BinaryReader &reader)
+{
   AssetDescription asset_description;
-  asset_description.read(file);
+  asset_description.read(reader);
+  if (asset_description.version_ != 0)
+  {
+    throw std::runtime_error{"Use read_mesh_view() for version 1 to 3"};
+  }
 
   std::uint64_t sub_meshes_count{};
-  read_value(file, sub_meshes_count);
+  read_value(reader, sub_meshes_count);
   for (std::uint64_t i = 0; i < sub_meshes_count; ++i)
   {
     SubMeshDescription sub_mesh_description{};
-    sub_mesh_description.read(file);
+    sub_mesh_description.read(reader);
     sub_meshes_.push_back(std::move(sub_mesh_description));
   }
 
   return asset_description;
 }
 
+MeshView read_mesh_view(const AssetData &asset_data)
+{
+  BinaryReader     reader{asset_data.data_, asset_data.size_};
+  AssetDescription asset_description;
+  asset_description.read(reader);
+
+  if (asset_description.version_ == 0)
+  {
+    BinaryReader description_reader{asset_data.data_, asset_data.size_};
+    auto         description = std::make_shared<MeshDescription>();
+    description->read(description_reader);
+    return make_mesh_view(std::move(description));
+  }
+  if (asset_description.version_ < 1 || asset_description.version_ > 3)
+  {
+    throw std::runtime_error{"Unsupported mesh version " +
+                             std::to_string(asset_description.version_)};
+  }
+
+  const auto header_offset = align_mesh_data(reader.position());
+  if (header_offset > asset_data.size_)
+  {
+    throw std::runtime_error{"Mesh has no header"};
+  }
+  reader.read_bytes(header_offset - reader.position());
+  const auto data = asset_data.data_ + header_offset;
+
+  MeshDataHeader header{};
+  reader.read(&header,
+              asset_description.version_ == 1
+                  ? offsetof(MeshDataHeader, vertex_format_)
+                  : sizeof(MeshDataHeader));
+  if (header.magic_value_ != MeshDataHeader{}.magic_value_ ||
+      header.data_size_ > asset_data.size_ - header_offset)
+  {
+    throw std::runtime_error{"Corrupt mesh header"};
+  }
+  if (header.vertex_format_ != VertexFormat::Float &&
+      header.vertex_format_ != VertexFormat::Packed)
+  {
+    throw std::runtime_error{"Unsupported vertex format"};
+  }
+  const auto vertex_size = mesh_vertex_size(header.vertex_format_);
+  if (asset_description.version_ >= 2 && header.vertex_size_ != vertex_size)
+  {
+    throw std::runtime_error{"Vertex size does not match the vertex format"};
+  }
+  // entries of older versions end before the lod table
+  const auto entry_size = asset_description.version_ >= 3
+                              ? sizeof(MeshDataSubMesh)
+                              : offsetof(MeshDataSubMesh, lods_offset_);
+  if (header.sub_meshes_count_ > reader.remaining() / entry_size)
+  {
+    throw std::runtime_error{"Corrupt mesh sub mesh table"};
+  }
+
+  MeshView mesh_view{};
+  mesh_view.vertex_format_ = header.vertex_format_;
+  mesh_view.owner_         = asset_data.owner_;
+  mesh_view.sub_meshes_.resize(header.sub_meshes_count_);
+  for (auto &sub_mesh : mesh_view.sub_meshes_)
+  {
+    MeshDataSubMesh entry{};
+    reader.read(&entry, entry_size);
+
+    // both vertex formats only contain four byte values
+    sub_mesh.vertices_       = mesh_data_range(data,
+                                               header.data_size_,
+                                               entry.vertices_offset_,
+                                               entry.vertices_count_,
+                                               vertex_size,
+                                               alignof(Vertex));
+    sub_mesh.vertices_count_ = entry.vertices_count_;
+
+    sub_mesh.indices_ = reinterpret_cast<const std::uint32_t *>(
+        mesh_data_range(data,
+                        header.data_size_,
+                        entry.indices_offset_,
+                        entry.indices_count_,
+                        sizeof(std::uint32_t),
+                        alignof(std::uint32_t)));
+    sub_mesh.indices_count_ = entry.indices_count_;
+
+    const auto material_name = reinterpret_cast<const char *>(
+        mesh_data_range(data,
+                        header.data_size_,
+                        entry.material_name_offset_,
+                        entry.material_name_size_,
+                        1,
+                        1));
+    sub_mesh.material_name_.assign(material_name, entry.material_name_size_);
+
+    if (entry.lods_count_ == 0)
+    {
+      sub_mesh.lods_ = full_detail_lods(entry.indices_count_);
+    }
+    else
+    {
+      const auto lods = reinterpret_cast<const MeshLod *>(
+          mesh_data_range(data,
+                          header.data_size_,
+                          entry.lods_offset_,
+                          entry.lods_count_,
+                          sizeof(MeshLod),
+                          alignof(MeshLod)));
+      sub_mesh.lods_.assign(lods, lods + entry.lods_count_);
+    }
+    for (const auto &lod : sub_mesh.lods_)
+    {
+      if (static_cast<std::uint64_t>(lod.first_index_) + lod.indices_count_ >
+          entry.indices_count_)
+      {
+        throw std::runtime_error{"Mesh lod lies outside of the indices"};
+      }
+    }
+    sub_mesh.lod_indices_count_ = entry.indices_count_;
+    sub_mesh.indices_count_     = sub_mesh.lods_.front().indices_count_;
+
+    compute_bounding_sphere(sub_mesh, vertex_size);
+  }
+
+  return mesh_view;
+}
+
+MeshView make_mesh_view(std::shared_ptr<const MeshDescription> description)
+{
+  MeshView mesh_view{};
+  for (const auto &sub_mesh : description->sub_meshes_)
+  {
+    auto &sub_mesh_view           = mesh_view.sub_meshes_.emplace_back();
+    sub_mesh_view.vertices_ =
+        reinterpret_cast<const std::uint8_t *>(sub_mesh.vertices_.data());
+    sub_mesh_view.vertices_count_ = sub_mesh.vertices_.size();
+    sub_mesh_view.indices_        = sub_mesh.indices_.data();
+    sub_mesh_view.lods_ = sub_mesh.lods_.empty()
+                              ? full_detail_lods(sub_mesh.indices_.size())
+                              : sub_mesh.lods_;
+    sub_mesh_view.indices_count_ = sub_mesh_view.lods_.front().indices_count_;
+    sub_mesh_view.lod_indices_count_ = sub_mesh.indices_.size();
+    sub_mesh_view.material_name_     = sub_mesh.material_name_;
+    compute_bounding_sphere(sub_mesh_view, sizeof(Vertex));
+  }
+  mesh_view.owner_ = std::move(description);
+  return mesh_view;
+}
+
+std::size_t mesh_vertex_size(VertexFormat vertex_format)
+{
+  return vertex_format == VertexFormat::Packed ? sizeof(PackedVertex)
+                                               : sizeof(Vertex);
+}
+
+GlVertexBufferLayout mesh_vertex_buffer_layout(VertexFormat vertex_format)
+{
+  GlVertexBufferLayout layout;
+  if (vertex_format == VertexFormat::Packed)
+  {
+    layout.push_float(3);                           // position
+    layout.push_converted(GL_SHORT, 2, true);       // octahedral normal
+    layout.push_converted(GL_SHORT, 2, true);       // octahedral tangent
+    layout.push_converted(GL_BYTE, 4, true);        // bitangent sign
+    layout.push_converted(GL_HALF_FLOAT, 2, false); // tex coords
+    return layout;
+  }
+
+  layout.push_float(3); // position
+  layout.push_float(3); // normal
+  layout.push_float(3); // tangent
+  layout.push_float(3); // bitanget
+  layout.push_float(2); // tex coords
+  return layout;
+}
+
+PackedVertex pack_vertex(const Vertex &vertex)
+{
+  PackedVertex packed_vertex{};
+  packed_vertex.position = vertex.position;
+  packed_vertex.normal   = encode_octahedral(vertex.normal);
+  packed_vertex.tangent  = encode_octahedral(vertex.tangent);
+  packed_vertex.bitangent_sign[0] =
+      bitangent_sign(vertex.normal, vertex.tangent, vertex.bitangent);
+  packed_vertex.tex_coords = {float_to_half(vertex.tex_coords.x),
+                              float_to_half(vertex.tex_coords.y)};
+  return packed_vertex;
+}
+
 SubMesh::SubMesh(std::unique_ptr<GlVertexArray>       vertex_array,
-                 std::shared_ptr<MaterialAssetHandle> material)
+                 std::shared_ptr<MaterialAssetHandle> material,
+                 VertexFormat                         vertex_format)
     : vertex_array_{std::move(vertex_array)},
-      material_{material}
+      material_{material},
+      vertex_format_{vertex_format}
 {
 }
 
 SubMesh::SubMesh(SubMesh &&other)
     : vertex_array_{std::move(other.vertex_array_)},
-      material_{std::move(other.material_)}
+      material_{std::move(other.material_)},
+      vertex_format_{other.vertex_format_},
+      lods_{std::move(other.lods_)},
+      bounding_sphere_center_{other.bounding_sphere_center_},
+      bounding_sphere_radius_{other.bounding_sphere_radius_}
 {
   other.vertex_array_ = nullptr;
   other.material_     = nullptr;
@@ -100,10 +434,66 @@ void SubMesh::operator=(SubMesh &&other)
   other.vertex_array_ = nullptr;
   material_           = std::move(other.material_);
   other.material_     = nullptr;
+  vertex_format_      = other.vertex_format_;
+  lods_               = std::move(other.lods_);
+  bounding_sphere_center_ = other.bounding_sphere_center_;
+  bounding_sphere_radius_ = other.bounding_sphere_radius_;
 }
 
 GlVertexArray *SubMesh::vertex_array() const { return vertex_array_.get(); }
 
+VertexFormat SubMesh::vertex_format() const { return vertex_format_; }
+
+void SubMesh::set_lods(std::vector<MeshLod> lods) { lods_ = std::move(lods); }
+
+MeshLod SubMesh::lod(std::uint32_t level) const
+{
+  if (lods_.empty())
+  {
+    const auto index_buffer = vertex_array_->index_buffer();
+    return full_detail_lods(index_buffer ? index_buffer->count() : 0).front();
+  }
+  return lods_[std::min<std::size_t>(level, lods_.size() - 1)];
+}
+
+std::size_t SubMesh::lods_count() const
+{
+  return std::max<std::size_t>(lods_.size(), 1);
+}
+
+std::uint32_t SubMesh::select_lod(float pixels_per_unit,
+                                  float max_pixel_error) const
+{
+  // errors grow with the level, so the first level above the limit ends
+  // the search
+  std::uint32_t level{0};
+  for (std::size_t i{1}; i < lods_.size(); ++i)
+  {
+    if (lods_[i].error_ * pixels_per_unit > max_pixel_error)
+    {
+      break;
+    }
+    level = static_cast<std::uint32_t>(i);
+  }
+  return level;
+}
+
+void SubMesh::set_bounding_sphere(const glm::vec3 &center, float radius)
+{
+  bounding_sphere_center_ = center;
+  bounding_sphere_radius_ = radius;
+}
+
+glm::vec3 SubMesh::bounding_sphere_center() const
+{
+  return bounding_sphere_center_;
+}
+
+float SubMesh::bounding_sphere_radius() const
+{
+  return bounding_sphere_radius_;
+}
+
 Material *SubMesh::material() const
 {
 
@@ -115,9 +505,19 @@ Material *SubMesh::material() const
   return material_->get().get();
 }
 
-Mesh::Mesh(Mesh &&other) { meshes_ = std::move(other.meshes_); }
+Mesh::Mesh(Mesh &&other)
+{
+  meshes_        = std::move(other.meshes_);
+  geometry_      = std::move(other.geometry_);
+  weak_geometry_ = std::move(other.weak_geometry_);
+}
 
-void Mesh::operator=(Mesh &&other) { meshes_ = std::move(other.meshes_); }
+void Mesh::operator=(Mesh &&other)
+{
+  meshes_        = std::move(other.meshes_);
+  geometry_      = std::move(other.geometry_);
+  weak_geometry_ = std::move(other.weak_geometry_);
+}
 
 std::vector<SubMesh *> Mesh::meshes() const
 {
@@ -135,11 +535,18 @@ void Mesh::set_meshes(std::vector<std::unique_ptr<SubMesh>> meshes)
   meshes_ = std::move(meshes);
 }
 
-void Mesh::set_description(MeshDescription value)
+void Mesh::set_geometry(std::shared_ptr<const MeshView> geometry,
+                        bool                            is_resident)
+{
+  weak_geometry_ = geometry;
+  geometry_      = is_resident ? std::move(geometry) : nullptr;
+}
+
+std::shared_ptr<const MeshView> Mesh::geometry() const
 {
-  mesh_description_ = std::move(value);
+  return weak_geometry_.lock();
 }
 
-MeshDescription Mesh::get_description() const { return mesh_description_; }
+bool Mesh::is_geometry_resident() const { return geometry_ != nullptr; }
 
 } // namespace dc
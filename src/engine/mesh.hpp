@@ -2,11 +2,16 @@
 
 #include "asset_description.hpp"
 #include "gl_vertex_array.hpp"
+#include "gl_vertex_buffer.hpp"
 #include "material.hpp"
 #include "material_asset.hpp"
+#include "vertex_format.hpp"
 
+#include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <assimp/Importer.hpp>
 #include <assimp/material.h>
@@ -16,6 +21,10 @@
 namespace dc
 {
 
+class BinaryReader;
+class BinaryWriter;
+struct AssetData;
+
 struct Vertex
 {
   glm::vec3 position;
@@ -25,40 +34,157 @@ struct Vertex
   glm::vec2 tex_coords;
 };
 
+/**
+ * Range of the index buffer of a sub mesh that draws one level of detail.
+ * Level 0 is the full detail mesh. The error is the object space distance of
+ * the level to the full detail mesh.
+ */
+struct MeshLod
+{
+  std::uint32_t first_index_{0};
+  std::uint32_t indices_count_{0};
+  float         error_{0.0f};
+  std::uint32_t reserved_{0};
+};
+
 struct SubMeshDescription
 {
-  std::vector<Vertex>        vertices_;
+  std::vector<Vertex> vertices_;
+  // indices of all levels of detail, starting with the full detail level
   std::vector<std::uint32_t> indices_;
   std::string                material_name_;
+  // empty if the sub mesh has only the full detail level
+  std::vector<MeshLod> lods_;
 
-  void save(FILE *file) const;
-  void read(FILE *file);
+  void save(BinaryWriter &writer) const;
+  void read(BinaryReader &reader);
 };
 
+/**
+ * Saves in the version 3 layout, which can be used in place by
+ * read_mesh_view(). Reading only supports version 0 files.
+ */
 struct MeshDescription
 {
   std::vector<SubMeshDescription> sub_meshes_;
+  // format of the saved vertices, the description always holds full floats
+  VertexFormat vertex_format_{VertexFormat::Float};
 
   void             save(const std::filesystem::path &file_path,
                         const AssetDescription      &asset_description) const;
-  AssetDescription read(const std::filesystem::path &file_path);
+  AssetDescription read(BinaryReader &reader);
+};
+
+/** Alignment of the header and the blobs of a .dcmesh file */
+constexpr std::size_t mesh_data_alignment{16};
+
+/**
+ * Header of a version 1 to 3 .dcmesh file. Follows the asset description at
+ * the next aligned offset and is followed by the sub mesh table. All offsets
+ * are relative to the start of the header. Version 1 ends before the vertex
+ * format and always uses VertexFormat::Float.
+ */
+struct MeshDataHeader
+{
+  std::uint32_t magic_value_{0x48534d44}; // DMSH
+  std::uint32_t sub_meshes_count_{0};
+  std::uint64_t data_size_{0};
+  VertexFormat  vertex_format_{VertexFormat::Float};
+  std::uint32_t vertex_size_{0};
+  // keeps the sub mesh table aligned
+  std::uint64_t reserved_{0};
+};
+
+struct MeshDataSubMesh
+{
+  std::uint64_t vertices_offset_{0};
+  std::uint64_t vertices_count_{0};
+  std::uint64_t indices_offset_{0};
+  std::uint64_t indices_count_{0};
+  std::uint64_t material_name_offset_{0};
+  std::uint64_t material_name_size_{0};
+  // only in version 3, older versions have only the full detail level
+  std::uint64_t lods_offset_{0};
+  std::uint64_t lods_count_{0};
+};
+
+/**
+ * Geometry of a sub mesh. Points into memory owned by the MeshView. The
+ * vertices are Vertex or PackedVertex depending on the vertex format, both
+ * start with the position. The indices count covers the full detail level,
+ * the coarser levels follow it in the same array.
+ */
+struct SubMeshView
+{
+  const std::uint8_t  *vertices_{nullptr};
+  std::size_t          vertices_count_{0};
+  const std::uint32_t *indices_{nullptr};
+  std::size_t          indices_count_{0};
+  std::size_t          lod_indices_count_{0};
+  std::vector<MeshLod> lods_;
+  std::string          material_name_;
+  glm::vec3            bounding_sphere_center_{0.0f};
+  float                bounding_sphere_radius_{0.0f};
+};
+
+/**
+ * Geometry of a mesh without copying it. Points either into the loaded
+ * .dcmesh file or into a MeshDescription for old files. Gets shared as
+ * immutable geometry by the GPU upload, physics cooking and tools.
+ */
+struct MeshView
+{
+  std::vector<SubMeshView>    sub_meshes_;
+  VertexFormat                vertex_format_{VertexFormat::Float};
+  std::shared_ptr<const void> owner_;
 };
 
+/** Version 1 to 3 files are used in place, version 0 files get decoded */
+MeshView read_mesh_view(const AssetData &asset_data);
+
+MeshView make_mesh_view(std::shared_ptr<const MeshDescription> description);
+
+std::size_t          mesh_vertex_size(VertexFormat vertex_format);
+GlVertexBufferLayout mesh_vertex_buffer_layout(VertexFormat vertex_format);
+
+PackedVertex pack_vertex(const Vertex &vertex);
+
 class SubMesh
 {
 public:
   SubMesh(std::unique_ptr<GlVertexArray>       vertex_array,
-          std::shared_ptr<MaterialAssetHandle> material);
+          std::shared_ptr<MaterialAssetHandle> material,
+          VertexFormat vertex_format = VertexFormat::Float);
 
   SubMesh(SubMesh &&other);
   void operator=(SubMesh &&other);
 
   GlVertexArray *vertex_array() const;
   Material      *material() const;
+  VertexFormat   vertex_format() const;
+
+  void set_lods(std::vector<MeshLod> lods);
+  /// Returns the whole index buffer if the sub mesh has no levels of detail
+  MeshLod     lod(std::uint32_t level) const;
+  std::size_t lods_count() const;
+
+  /**
+   * Picks the coarsest level whose error stays below the max pixel error.
+   * Pixels per unit is the projected size of one object space unit.
+   */
+  std::uint32_t select_lod(float pixels_per_unit, float max_pixel_error) const;
+
+  void      set_bounding_sphere(const glm::vec3 &center, float radius);
+  glm::vec3 bounding_sphere_center() const;
+  float     bounding_sphere_radius() const;
 
 private:
   std::unique_ptr<GlVertexArray>       vertex_array_;
   std::shared_ptr<MaterialAssetHandle> material_;
+  VertexFormat                         vertex_format_{VertexFormat::Float};
+  std::vector<MeshLod>                 lods_;
+  glm::vec3                            bounding_sphere_center_{0.0f};
+  float                                bounding_sphere_radius_{0.0f};
 
   SubMesh(const SubMesh &) = delete;
   void operator=(const SubMesh &) = delete;
@@ -74,11 +200,21 @@ public:
   void set_meshes(std::vector<std::unique_ptr<SubMesh>> meshes);
   std::vector<SubMesh *> meshes() const;
 
-  void            set_description(MeshDescription value);
-  MeshDescription get_description() const;
+  /**
+   * CPU geometry of the mesh. Non resident geometry is only referenced
+   * weakly. It stays alive as long as some consumer holds on to it.
+   */
+  void set_geometry(std::shared_ptr<const MeshView> geometry,
+                    bool                            is_resident);
+
+  /// Returns null if the geometry is not resident and nobody uses it anymore
+  std::shared_ptr<const MeshView> geometry() const;
+
+  bool is_geometry_resident() const;
 
 private:
-  MeshDescription mesh_description_;
+  std::shared_ptr<const MeshView> geometry_{};
+  std::weak_ptr<const MeshView>   weak_geometry_{};
 
   std::vector<std::unique_ptr<SubMesh>> meshes_;
 };
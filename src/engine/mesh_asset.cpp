@@ -3,6 +3,7 @@
 #include "asset_handle.hpp"
 #include "engine.hpp"
 #include "gl_index_buffer.hpp"
+#include "gpu_upload_queue.hpp"
 #include "gl_vertex_buffer.hpp"
 #include "log.hpp"
 #include "material_asset.hpp"
@@ -15,51 +16,129 @@
 namespace dc
 {
 
-MeshAssetHandle::MeshAssetHandle(const std::filesystem::path &file_path,
-                                 const Asset                 &asset)
-    : AssetHandle{asset}
+MeshAssetHandle::MeshAssetHandle(const Asset &asset) : AssetHandle{asset} {}
+
+void MeshAssetHandle::load(const AssetData &asset_data)
 {
   try
   {
-    MeshDescription mesh_description{};
-    mesh_description.read(file_path);
-
-    std::vector<std::unique_ptr<SubMesh>> meshes;
-    for (const auto &sub_mesh : mesh_description.sub_meshes_)
-    {
-      const auto asset_cache = Engine::instance()->asset_cache();
-      const auto material    = std::dynamic_pointer_cast<MaterialAssetHandle>(
-          asset_cache->load_asset(Asset{sub_mesh.material_name_}));
-
-      const auto index_buffer =
-          std::make_shared<GlIndexBuffer>(sub_mesh.indices_);
-
-      GlVertexBufferLayout layout;
-      layout.push_float(3); // position
-      layout.push_float(3); // normal
-      layout.push_float(3); // tangent
-      layout.push_float(3); // bitanget
-      layout.push_float(2); // tex coords
-      const auto vertex_buffer =
-          std::make_shared<GlVertexBuffer>(sub_mesh.vertices_, layout);
-
-      auto vertex_array = std::make_unique<GlVertexArray>();
-      vertex_array->add_vertex_buffer(vertex_buffer);
-      vertex_array->set_index_buffer(index_buffer);
-
-      auto mesh = std::make_unique<SubMesh>(std::move(vertex_array), material);
-      meshes.push_back(std::move(mesh));
-    }
-
-    mesh_ = std::make_shared<Mesh>();
-    mesh_->set_meshes(std::move(meshes));
-    mesh_->set_description(std::move(mesh_description));
+    // keeps the asset data alive, the buffers get filled straight from it
+    mesh_view_ = std::make_unique<MeshView>(read_mesh_view(asset_data));
   }
   catch (const std::runtime_error &error)
   {
     DC_LOG_WARN("Could not load mesh asset {}: {}",
-                file_path.string(),
+                asset().id(),
+                error.what());
+  }
+}
+
+void MeshAssetHandle::create()
+{
+  if (!mesh_view_)
+  {
+    return;
+  }
+  // shared with the upload tasks until the upload is done
+  const std::shared_ptr<MeshView> mesh_view{std::move(mesh_view_)};
+
+  const auto asset_cache  = Engine::instance()->asset_cache();
+  const auto upload_queue = Engine::instance()->gpu_upload_queue();
+
+  const auto vertex_format = mesh_view->vertex_format_;
+
+  std::size_t                           buffers_size{0};
+  std::vector<std::unique_ptr<SubMesh>> meshes;
+  for (const auto &sub_mesh : mesh_view->sub_meshes_)
+  {
+    const auto material = std::dynamic_pointer_cast<MaterialAssetHandle>(
+        asset_cache->load_asset(Asset{sub_mesh.material_name_}));
+
+    // the coarser levels of detail share the index buffer
+    const auto indices_size =
+        sub_mesh.lod_indices_count_ * sizeof(std::uint32_t);
+    const auto index_buffer =
+        std::make_shared<GlIndexBuffer>(sub_mesh.lod_indices_count_);
+    upload_queue->push(make_buffer_upload_task(index_buffer->id(),
+                                               sub_mesh.indices_,
+                                               indices_size));
+
+    const auto vertices_size =
+        sub_mesh.vertices_count_ * mesh_vertex_size(vertex_format);
+    const auto vertex_buffer = std::make_shared<GlVertexBuffer>(
+        vertices_size,
+        mesh_vertex_buffer_layout(vertex_format),
+        0);
+    upload_queue->push(make_buffer_upload_task(vertex_buffer->id(),
+                                               sub_mesh.vertices_,
+                                               vertices_size));
+    buffers_size += vertices_size + indices_size;
+
+    auto vertex_array = std::make_unique<GlVertexArray>();
+    vertex_array->add_vertex_buffer(vertex_buffer);
+    vertex_array->set_index_buffer(index_buffer);
+
+    auto mesh = std::make_unique<SubMesh>(std::move(vertex_array),
+                                          material,
+                                          vertex_format);
+    mesh->set_lods(sub_mesh.lods_);
+    mesh->set_bounding_sphere(sub_mesh.bounding_sphere_center_,
+                              sub_mesh.bounding_sphere_radius_);
+    meshes.push_back(std::move(mesh));
+  }
+
+  auto new_mesh = std::make_shared<Mesh>();
+  new_mesh->set_meshes(std::move(meshes));
+
+  // without resident geometry the CPU memory gets freed after the upload,
+  // consumers that need the geometry later read it again
+  const auto is_geometry_resident =
+      Engine::instance()->config()->config_value_bool("AssetCache",
+                                                      "resident_mesh_geometry",
+                                                      false);
+
+  // mesh becomes ready after all buffers got uploaded
+  const auto self =
+      std::static_pointer_cast<MeshAssetHandle>(shared_from_this());
+  upload_queue->push(
+      [self, new_mesh, mesh_view, buffers_size, is_geometry_resident](
+          GpuUploadQueue & /*upload_queue*/)
+      {
+        new_mesh->set_geometry(mesh_view, is_geometry_resident);
+        self->set_memory_usage(is_geometry_resident ? buffers_size : 0,
+                               buffers_size);
+        self->mesh_ = new_mesh;
+        return true;
+      });
+}
+
+std::shared_ptr<const MeshView> MeshAssetHandle::geometry() const
+{
+  if (!mesh_)
+  {
+    return nullptr;
+  }
+  if (auto geometry = mesh_->geometry())
+  {
+    return geometry;
+  }
+
+  try
+  {
+    const auto asset_data =
+        Engine::instance()->asset_cache()->read_asset_data(asset().id());
+    const std::shared_ptr<const MeshView> geometry{
+        std::make_shared<MeshView>(read_mesh_view(asset_data))};
+    // consumers that ask while this one holds the geometry share it
+    mesh_->set_geometry(geometry, mesh_->is_geometry_resident());
+    return geometry;
+  }
+  catch (const std::runtime_error &error)
+  {
+    DC_LOG_WARN("Could not read geometry of mesh asset {}: {}",
+                asset().id(),
                 error.what());
+    return nullptr;
   }
 }
 
@@ -68,9 +147,10 @@ bool MeshAssetHandle::is_ready() const { return mesh_ != nullptr; }
 std::shared_ptr<Mesh> MeshAssetHandle::get() const { return mesh_; }
 
 std::shared_ptr<AssetHandle>
-mesh_asset_loader(const std::filesystem::path &file_path, const Asset &asset)
+mesh_asset_loader(const std::filesystem::path & /*file_path*/,
+                  const Asset &asset)
 {
-  return std::make_shared<MeshAssetHandle>(file_path, asset);
+  return std::make_shared<MeshAssetHandle>(asset);
 }
 
 } // namespace dc
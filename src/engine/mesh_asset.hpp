@@ -13,14 +13,25 @@ namespace dc
 class MeshAssetHandle : public AssetHandle
 {
 public:
-  MeshAssetHandle(const std::filesystem::path &file_path, const Asset &asset);
+  MeshAssetHandle(const Asset &asset);
 
   bool is_ready() const override;
 
+  void load(const AssetData &asset_data) override;
+  void create() override;
+
   std::shared_ptr<Mesh> get() const;
 
+  /**
+   * CPU geometry of the loaded mesh. Gets read again from the asset data if
+   * it is not resident and no other consumer holds it.
+   */
+  std::shared_ptr<const MeshView> geometry() const;
+
 private:
-  std::shared_ptr<Mesh> mesh_{};
+  // points into the asset data, only valid between load() and create()
+  std::unique_ptr<MeshView> mesh_view_{};
+  std::shared_ptr<Mesh>     mesh_{};
 };
 
 std::shared_ptr<AssetHandle>
@@ -1,26 +1,29 @@
 #include "mesh_asset_importer.hpp"
 #include "defer.hpp"
 #include "engine.hpp"
-#include "image.hpp"
 #include "importer.hpp"
 #include "log.hpp"
 #include "material.hpp"
 #include "math.hpp"
 #include "mesh.hpp"
+#include "mesh_optimizer.hpp"
 #include "serialization.hpp"
+#include "util.hpp"
 
+#include <assimp/DefaultIOSystem.h>
 #include <assimp/GltfMaterial.h>
 #include <assimp/Importer.hpp>
 #include <assimp/material.h>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
-#include <stb_image.h>
-#include <stb_image_write.h>
 
+#include <algorithm>
 #include <cctype>
 #include <cstdint>
 #include <cstdio>
 #include <filesystem>
+#include <memory>
+#include <set>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
@@ -67,41 +70,18 @@ std::string import_texture(aiMaterial     *ai_material,
       std::filesystem::path{"textures"} /
       (import_data.mesh_name_ + "_" + file_path.stem().string() + ".dctex"));
 
-  if (import_data.textures_.find(imported_file_path.string()) !=
-      import_data.textures_.end())
-  {
-    // texture was already imported
-    return imported_file_path.string();
-  }
+  // normal maps only keep two channels, the shader reconstructs z
+  const auto usage =
+      ai_texture_type == aiTextureType_NORMALS      ? TextureUsage::Normal
+      : ai_texture_type == aiTextureType_BASE_COLOR ? TextureUsage::Albedo
+      : ai_texture_type == aiTextureType_EMISSIVE   ? TextureUsage::Albedo
+                                                    : TextureUsage::Data;
 
-  TextureDescription texture_description{};
   try
   {
-    // load image and make sure it gets saved as png
-    Image                     image{file_path};
-    std::vector<std::uint8_t> png_data;
-    stbi_write_png_to_func(
-        [](void *context, void *data, int size)
-        {
-          const auto png_data = static_cast<std::vector<uint8_t> *>(context);
-          png_data->resize(size);
-          std::memcpy(png_data->data(), data, size);
-        },
-        &png_data,
-        image.width(),
-        image.height(),
-        image.channels_count(),
-        static_cast<const void *>(image.data()),
-        0);
-    texture_description.data_ = std::move(png_data);
-
-    AssetDescription asset_description{};
-    asset_description.original_file_ = normalize_path(file_path).string();
-    texture_description.save(Engine::instance()->base_directory() /
-                                 imported_file_path,
-                             asset_description);
-
-    import_data.textures_[imported_file_path.string()] = std::move(texture_description);
+    return import_data.texture_import_queue_->push(file_path,
+                                                   imported_file_path,
+                                                   usage);
   }
   catch (const std::runtime_error &error)
   {
@@ -238,14 +218,130 @@ std::string import_material(const aiScene  *ai_scene,
   //   material_description.roughness_ = {tmp, tmp, tmp, tmp};
   // }
 
-  AssetDescription asset_description{};
   material_description.save(Engine::instance()->base_directory() /
                                 material_import_file_path,
-                            asset_description);
+                            import_data.asset_description_);
+  import_data.manifest_->add_output(material_import_file_path,
+                                    import_data.asset_description_);
 
   return material_import_file_path.string();
 }
 
+struct MeshLodSettings
+{
+  int   lods_count_{4};
+  float triangle_ratio_{0.5f};
+  float max_error_{0.05f};
+};
+
+MeshLodSettings mesh_lod_settings()
+{
+  const auto config = Engine::instance()->config();
+
+  MeshLodSettings settings{};
+  settings.lods_count_ =
+      config->config_value_int("MeshImport", "lods_count", 4);
+  settings.triangle_ratio_ =
+      config->config_value_float("MeshImport", "lod_triangle_ratio", 0.5f);
+  settings.max_error_ =
+      config->config_value_float("MeshImport", "lod_max_error", 0.05f);
+  return settings;
+}
+
+/**
+ * Remembers the files assimp reads. These are the sources of an import,
+ * together with the textures.
+ */
+class RecordingIoSystem : public Assimp::DefaultIOSystem
+{
+public:
+  Assimp::IOStream *Open(const char *file_path, const char *mode) override
+  {
+    const auto stream = Assimp::DefaultIOSystem::Open(file_path, mode);
+    if (stream)
+    {
+      file_paths_.insert(file_path);
+    }
+    return stream;
+  }
+
+  const std::set<std::string> &file_paths() const { return file_paths_; }
+
+private:
+  std::set<std::string> file_paths_;
+};
+
+/**
+ * Appends simplified levels of detail to the indices. Every level gets
+ * simplified from the full detail level and targets a fraction of the
+ * triangles of the previous level. Stops early if a level would exceed the
+ * max error or saves too little.
+ */
+std::vector<MeshLod> build_mesh_lods(const std::vector<Vertex>  &vertices,
+                                     std::vector<std::uint32_t> &indices)
+{
+  const auto settings       = mesh_lod_settings();
+  const auto lods_count     = settings.lods_count_;
+  const auto triangle_ratio = settings.triangle_ratio_;
+  const auto max_error      = settings.max_error_;
+
+  std::vector<MeshLod> lods(1);
+  lods[0].indices_count_ = static_cast<std::uint32_t>(indices.size());
+  if (vertices.empty() || indices.empty())
+  {
+    return lods;
+  }
+
+  // the max error is relative to the size of the sub mesh
+  glm::vec3 min{vertices[0].position};
+  glm::vec3 max{vertices[0].position};
+  for (const auto &vertex : vertices)
+  {
+    min = glm::min(min, vertex.position);
+    max = glm::max(max, vertex.position);
+  }
+  const auto target_error = max_error * glm::length(max - min) * 0.5f;
+
+  const auto                 full_indices_count = indices.size();
+  std::vector<std::uint32_t> lod_indices(full_indices_count);
+  for (int level{1}; level < lods_count; ++level)
+  {
+    const auto &previous = lods.back();
+    const auto  target_indices_count =
+        static_cast<std::size_t>(previous.indices_count_ * triangle_ratio) /
+        3 * 3;
+
+    float      error{0.0f};
+    const auto indices_count = simplify_mesh(lod_indices.data(),
+                                             indices.data(),
+                                             full_indices_count,
+                                             &vertices[0].position.x,
+                                             sizeof(Vertex),
+                                             vertices.size(),
+                                             target_indices_count,
+                                             target_error,
+                                             error);
+    // levels that save less than a tenth are not worth the memory
+    if (indices_count == 0 || indices_count * 10 > previous.indices_count_ * 9)
+    {
+      break;
+    }
+    optimize_vertex_cache(lod_indices.data(), indices_count, vertices.size());
+
+    MeshLod lod{};
+    lod.first_index_   = static_cast<std::uint32_t>(indices.size());
+    lod.indices_count_ = static_cast<std::uint32_t>(indices_count);
+    // selection expects the error to grow with the level
+    lod.error_ = std::max(error, previous.error_);
+    indices.insert(indices.end(),
+                   lod_indices.begin(),
+                   lod_indices.begin() + indices_count);
+    lods.push_back(lod);
+  }
+
+  return lods;
+}
+
 } // namespace
 
 namespace dc
@@ -320,27 +416,32 @@ void do_import_mesh(const aiScene  *ai_scene,
     indices.push_back(ai_face.mIndices[2]);
   }
 
-  auto material = import_material(ai_scene, ai_mesh, import_data);
-
-  auto vertex_array  = std::make_unique<GlVertexArray>();
-
-  GlVertexBufferLayout layout;
-  layout.push_float(3); // position
-  layout.push_float(3); // normal
-  layout.push_float(3); // tangent
-  layout.push_float(3); // bitanget
-  layout.push_float(2); // tex coords
-  auto vertex_buffer = std::make_shared<GlVertexBuffer>(vertices, layout);
-
-  auto index_buffer = std::make_shared<GlIndexBuffer>(indices);
+  // Reorder for the post transform cache, overdraw and vertex fetch
+  const auto statistics = optimize_mesh(vertices, indices);
+  DC_LOG_INFO("Optimized mesh {}: ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}",
+              mesh_name,
+              statistics.before_.acmr_,
+              statistics.after_.acmr_,
+              statistics.before_.atvr_,
+              statistics.after_.atvr_);
+
+  auto lods = build_mesh_lods(vertices, indices);
+  for (std::size_t i{1}; i < lods.size(); ++i)
+  {
+    DC_LOG_INFO("Mesh {} lod {}: {} triangles, error {}",
+                mesh_name,
+                i,
+                lods[i].indices_count_ / 3,
+                lods[i].error_);
+  }
 
-  vertex_array->add_vertex_buffer(vertex_buffer);
-  vertex_array->set_index_buffer(index_buffer);
+  auto material = import_material(ai_scene, ai_mesh, import_data);
 
   SubMeshDescription sub_mesh_description{};
   sub_mesh_description.indices_       = std::move(indices);
   sub_mesh_description.vertices_      = std::move(vertices);
   sub_mesh_description.material_name_ = std::move(material);
+  sub_mesh_description.lods_          = std::move(lods);
   import_data.mesh_.sub_meshes_.emplace_back(std::move(sub_mesh_description));
 }
 
@@ -374,29 +475,24 @@ void import_mesh(const aiScene *ai_scene, MeshImportData &import_data)
   do_import_meshes(ai_scene, ai_scene->mRootNode, transform, import_data);
 
   // save imported data
-  AssetDescription asset_description{};
-  const auto       mesh_file_path = sanitize_file_path(
+  const auto mesh_file_path = sanitize_file_path(
       std::filesystem::path{"meshes"} / (import_data.mesh_name_ + ".dcmesh"));
   import_data.mesh_.save(Engine::instance()->base_directory() / mesh_file_path,
-                         asset_description);
+                         import_data.asset_description_);
+  import_data.manifest_->add_output(mesh_file_path,
+                                    import_data.asset_description_);
 }
 
-void import_mesh_asset(const std::filesystem::path &file_path,
-                       const std::string           &name)
+const aiScene *read_model(Assimp::Importer            &importer,
+                          const std::filesystem::path &file_path,
+                          unsigned                     flags,
+                          ImportManifest              &manifest)
 {
-  DC_LOG_DEBUG("Import mesh from file {}", file_path.string());
-
-  Assimp::Importer importer;
-  const auto       ai_scene = importer.ReadFile(
-      file_path.string().c_str(),
-      aiProcess_JoinIdenticalVertices | aiProcess_Triangulate |
-          aiProcess_GenSmoothNormals | aiProcess_PreTransformVertices |
-          aiProcess_LimitBoneWeights | aiProcess_ImproveCacheLocality |
-          aiProcess_GenUVCoords | aiProcess_RemoveRedundantMaterials |
-          aiProcess_FindDegenerates | aiProcess_FindInvalidData |
-          aiProcess_FindInstances | aiProcess_OptimizeMeshes |
-          aiProcess_CalcTangentSpace);
+  // the importer takes ownership
+  const auto io_system = new RecordingIoSystem{};
+  importer.SetIOHandler(io_system);
 
+  const auto ai_scene = importer.ReadFile(file_path.string().c_str(), flags);
   if (!ai_scene || ai_scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE ||
       !ai_scene->mRootNode)
   {
@@ -404,17 +500,101 @@ void import_mesh_asset(const std::filesystem::path &file_path,
                              importer.GetErrorString());
   }
 
+  for (const auto &source_file_path : io_system->file_paths())
+  {
+    manifest.add_source(source_file_path, hash_file(source_file_path));
+  }
+  return ai_scene;
+}
+
+bool is_model_file(const std::filesystem::path &file_path)
+{
+  Assimp::Importer importer;
+  return importer.IsExtensionSupported(file_path.extension().string());
+}
+
+std::uint64_t mesh_import_settings_hash(VertexFormat vertex_format)
+{
+  const auto settings = mesh_lod_settings();
+
+  auto hash = hash_bytes(&vertex_format, sizeof(vertex_format));
+  hash = hash_bytes(&settings.lods_count_, sizeof(settings.lods_count_), hash);
+  hash = hash_bytes(&settings.triangle_ratio_,
+                    sizeof(settings.triangle_ratio_),
+                    hash);
+  hash = hash_bytes(&settings.max_error_, sizeof(settings.max_error_), hash);
+
+  const auto compression_codec = asset_compression_codec();
+  hash = hash_bytes(&compression_codec, sizeof(compression_codec), hash);
+
+  const auto texture_settings_hash = texture_import_settings_hash();
+  return hash_bytes(&texture_settings_hash,
+                    sizeof(texture_settings_hash),
+                    hash);
+}
+
+bool import_mesh_asset(const std::filesystem::path &file_path,
+                       const std::string           &name,
+                       VertexFormat                 vertex_format,
+                       bool                         is_forced)
+{
+  const auto mesh_file_path = sanitize_file_path(
+      std::filesystem::path{"meshes"} / (name + ".dcmesh"));
+  const auto manifest_file_path = import_manifest_file_path(mesh_file_path);
+  const auto settings_hash      = mesh_import_settings_hash(vertex_format);
+  if (!is_forced && is_import_up_to_date(manifest_file_path,
+                                         mesh_importer_version,
+                                         settings_hash))
+  {
+    DC_LOG_INFO("Mesh {} is up to date", name);
+    return false;
+  }
+
+  DC_LOG_DEBUG("Import mesh from file {}", file_path.string());
+
+  const auto       manifest = std::make_shared<ImportManifest>();
+  Assimp::Importer importer;
+  const auto       ai_scene = read_model(
+      importer,
+      file_path,
+      aiProcess_JoinIdenticalVertices | aiProcess_Triangulate |
+          aiProcess_GenSmoothNormals | aiProcess_PreTransformVertices |
+          aiProcess_LimitBoneWeights | aiProcess_GenUVCoords |
+          aiProcess_RemoveRedundantMaterials | aiProcess_FindDegenerates |
+          aiProcess_FindInvalidData | aiProcess_FindInstances |
+          aiProcess_OptimizeMeshes | aiProcess_CalcTangentSpace,
+      *manifest);
+
   // create neeeded directories
   // TODO: Don't hardcode paths
   const auto base_directory = Engine::instance()->base_directory();
   std::filesystem::create_directories(base_directory / "textures");
   std::filesystem::create_directories(base_directory / "materials");
   std::filesystem::create_directories(base_directory / "meshes");
+  std::filesystem::create_directories(manifest_file_path.parent_path());
 
   MeshImportData import_data{};
-  import_data.mesh_name_ = name;
-  import_data.base_path_ = file_path.parent_path();
+  import_data.mesh_name_           = name;
+  import_data.base_path_           = file_path.parent_path();
+  import_data.mesh_.vertex_format_ = vertex_format;
+  import_data.manifest_            = manifest;
+
+  auto &asset_description              = import_data.asset_description_;
+  asset_description.original_file_     = normalize_path(file_path).string();
+  asset_description.source_hash_       = manifest->source_hash();
+  asset_description.settings_hash_     = settings_hash;
+  asset_description.importer_version_  = mesh_importer_version;
+  asset_description.compression_codec_ = asset_compression_codec();
+
+  import_data.texture_import_queue_ =
+      std::make_shared<TextureImportQueue>(manifest);
   import_mesh(ai_scene, import_data);
+  import_data.texture_import_queue_->wait();
+
+  manifest->importer_version_ = mesh_importer_version;
+  manifest->settings_hash_    = settings_hash;
+  manifest->save(manifest_file_path);
+  return true;
 }
 
 } // namespace dc
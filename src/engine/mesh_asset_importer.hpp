@@ -1,23 +1,34 @@
 #pragma once
 
 #include "asset_importer_manager.hpp"
+#include "import_manifest.hpp"
+#include "importer.hpp"
 #include "serialization.hpp"
 
+#include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 
+#include <cstdint>
+#include <memory>
 #include <set>
 
 namespace dc
 {
 
+/// Increment if imported meshes or materials change
+constexpr std::uint32_t mesh_importer_version{1};
+
 struct MeshImportData
 {
   std::filesystem::path base_path_;
   std::string           mesh_name_;
+  // build info of all outputs except textures
+  AssetDescription asset_description_;
 
-  MeshDescription                                      mesh_;
-  std::set<std::string>                                materials_;
-  std::unordered_map<std::string, TextureDescription>  textures_;
+  MeshDescription                     mesh_;
+  std::set<std::string>               materials_;
+  std::shared_ptr<ImportManifest>     manifest_;
+  std::shared_ptr<TextureImportQueue> texture_import_queue_;
 };
 
 void do_import_mesh(const aiScene  *ai_scene,
@@ -25,7 +36,28 @@ void do_import_mesh(const aiScene  *ai_scene,
                     aiMatrix4x4    &transform,
                     MeshImportData &import_data);
 
-void import_mesh_asset(const std::filesystem::path &file_path,
-                       const std::string           &name);
+/**
+ * Reads a model and adds every file assimp opened, like external buffers,
+ * as source to the manifest. Throws if the model can not be read.
+ */
+const aiScene *read_model(Assimp::Importer            &importer,
+                          const std::filesystem::path &file_path,
+                          unsigned                     flags,
+                          ImportManifest              &manifest);
+
+bool is_model_file(const std::filesystem::path &file_path);
+
+/// Hash of all settings that change how a mesh and its textures get imported
+std::uint64_t mesh_import_settings_hash(VertexFormat vertex_format);
+
+/**
+ * Imports the mesh with its materials and textures. Returns false if the
+ * import got skipped because the last import of the file is up to date.
+ * Forcing the import never skips.
+ */
+bool import_mesh_asset(const std::filesystem::path &file_path,
+                       const std::string           &name,
+                       VertexFormat vertex_format = VertexFormat::Float,
+                       bool         is_forced     = false);
 
 } // namespace dc
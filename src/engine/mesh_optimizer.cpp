@@ -0,0 +1,829 @@
+#include "mesh_optimizer.hpp"
+#include "assert.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+
+// Tuning values from Forsyth's paper. The cache size is the size of the
+// simulated LRU cache, not of the hardware FIFO.
+constexpr std::size_t forsyth_cache_size{32};
+constexpr float       cache_decay_power{1.5f};
+constexpr float       last_triangle_score{0.75f};
+constexpr float       valence_boost_scale{2.0f};
+constexpr float       valence_boost_power{0.5f};
+
+// Cache used to find cluster boundaries for the overdraw optimization
+constexpr std::size_t overdraw_cache_size{16};
+
+constexpr std::uint32_t invalid_triangle{UINT32_MAX};
+
+using Float3 = std::array<float, 3>;
+
+float vertex_score(int cache_position, std::uint32_t remaining_triangles)
+{
+  if (remaining_triangles == 0)
+  {
+    // Vertex is not used by any triangle anymore
+    return -1.0f;
+  }
+
+  float score{0.0f};
+  if (cache_position >= 0)
+  {
+    if (cache_position < 3)
+    {
+      // Vertex was used in the last triangle. Give it a fixed score, so
+      // that strips and fans are not preferred over other shapes.
+      score = last_triangle_score;
+    }
+    else
+    {
+      constexpr float scaler{1.0f / (forsyth_cache_size - 3)};
+      score = std::pow(1.0f - (cache_position - 3) * scaler,
+                       cache_decay_power);
+    }
+  }
+
+  // Prefer vertices with few triangles left, so that they do not stay around
+  // as lonely triangles
+  score += valence_boost_scale *
+           std::pow(static_cast<float>(remaining_triangles),
+                    -valence_boost_power);
+  return score;
+}
+
+Float3 read_position(const float *positions,
+                     std::size_t  positions_stride,
+                     std::uint32_t index)
+{
+  const auto position = reinterpret_cast<const float *>(
+      reinterpret_cast<const std::uint8_t *>(positions) +
+      index * positions_stride);
+  return {position[0], position[1], position[2]};
+}
+
+Float3 subtract(const Float3 &a, const Float3 &b)
+{
+  return {a[0] - b[0], a[1] - b[1], a[2] - b[2]};
+}
+
+Float3 cross(const Float3 &a, const Float3 &b)
+{
+  return {a[1] * b[2] - a[2] * b[1],
+          a[2] * b[0] - a[0] * b[2],
+          a[0] * b[1] - a[1] * b[0]};
+}
+
+float dot(const Float3 &a, const Float3 &b)
+{
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+/** Sum of squared distances to planes, weighted by the plane areas */
+struct Quadric
+{
+  // upper triangle of the symmetric plane matrix
+  double a00_{0.0};
+  double a01_{0.0};
+  double a02_{0.0};
+  double a11_{0.0};
+  double a12_{0.0};
+  double a22_{0.0};
+  double b0_{0.0};
+  double b1_{0.0};
+  double b2_{0.0};
+  double c_{0.0};
+  double weight_{0.0};
+};
+
+Quadric plane_quadric(const Float3 &normal, float distance, double weight)
+{
+  const double x = normal[0];
+  const double y = normal[1];
+  const double z = normal[2];
+  const double d = distance;
+
+  Quadric quadric{};
+  quadric.a00_    = x * x * weight;
+  quadric.a01_    = x * y * weight;
+  quadric.a02_    = x * z * weight;
+  quadric.a11_    = y * y * weight;
+  quadric.a12_    = y * z * weight;
+  quadric.a22_    = z * z * weight;
+  quadric.b0_     = x * d * weight;
+  quadric.b1_     = y * d * weight;
+  quadric.b2_     = z * d * weight;
+  quadric.c_      = d * d * weight;
+  quadric.weight_ = weight;
+  return quadric;
+}
+
+Quadric add(const Quadric &a, const Quadric &b)
+{
+  Quadric quadric{};
+  quadric.a00_    = a.a00_ + b.a00_;
+  quadric.a01_    = a.a01_ + b.a01_;
+  quadric.a02_    = a.a02_ + b.a02_;
+  quadric.a11_    = a.a11_ + b.a11_;
+  quadric.a12_    = a.a12_ + b.a12_;
+  quadric.a22_    = a.a22_ + b.a22_;
+  quadric.b0_     = a.b0_ + b.b0_;
+  quadric.b1_     = a.b1_ + b.b1_;
+  quadric.b2_     = a.b2_ + b.b2_;
+  quadric.c_      = a.c_ + b.c_;
+  quadric.weight_ = a.weight_ + b.weight_;
+  return quadric;
+}
+
+/** Mean squared distance of the position to the planes of the quadric */
+double quadric_error(const Quadric &quadric, const Float3 &position)
+{
+  if (quadric.weight_ <= 0.0)
+  {
+    return 0.0;
+  }
+
+  const double x = position[0];
+  const double y = position[1];
+  const double z = position[2];
+
+  const auto error =
+      quadric.a00_ * x * x + quadric.a11_ * y * y + quadric.a22_ * z * z +
+      2.0 * (quadric.a01_ * x * y + quadric.a02_ * x * z +
+             quadric.a12_ * y * z) +
+      2.0 * (quadric.b0_ * x + quadric.b1_ * y + quadric.b2_ * z) +
+      quadric.c_;
+  return std::abs(error) / quadric.weight_;
+}
+
+struct Collapse
+{
+  double        error_{0.0};
+  std::uint32_t from_{0};
+  std::uint32_t to_{0};
+};
+
+/**
+ * Marks vertices of edges with only one triangle (borders and attribute
+ * seams) and of edges with more than two triangles
+ */
+std::vector<bool> find_locked_vertices(const std::uint32_t *indices,
+                                       std::size_t          indices_count,
+                                       std::size_t          vertices_count)
+{
+  std::vector<std::uint64_t> edges;
+  edges.reserve(indices_count);
+  for (std::size_t i{0}; i + 2 < indices_count; i += 3)
+  {
+    for (std::size_t j{0}; j < 3; ++j)
+    {
+      const std::uint64_t a = indices[i + j];
+      const std::uint64_t b = indices[i + (j + 1) % 3];
+      if (a != b)
+      {
+        edges.push_back(std::min(a, b) << 32 | std::max(a, b));
+      }
+    }
+  }
+  std::sort(edges.begin(), edges.end());
+
+  std::vector<bool> is_locked(vertices_count, false);
+  for (std::size_t i{0}; i < edges.size();)
+  {
+    auto end = i + 1;
+    while (end < edges.size() && edges[end] == edges[i])
+    {
+      ++end;
+    }
+    if (end - i != 2)
+    {
+      is_locked[edges[i] >> 32]        = true;
+      is_locked[edges[i] & UINT32_MAX] = true;
+    }
+    i = end;
+  }
+  return is_locked;
+}
+
+} // namespace
+
+namespace dc
+{
+
+VertexCacheStatistics analyze_vertex_cache(const std::uint32_t *indices,
+                                           std::size_t          indices_count,
+                                           std::size_t          vertices_count,
+                                           std::size_t          cache_size)
+{
+  VertexCacheStatistics statistics{};
+  if (indices_count < 3 || vertices_count == 0)
+  {
+    return statistics;
+  }
+
+  // A vertex is in the FIFO as long as less than cache size vertices got
+  // inserted after it
+  std::vector<std::size_t> cache_timestamps(vertices_count, 0);
+  std::vector<bool>        is_referenced(vertices_count, false);
+  std::size_t              timestamp{cache_size + 1};
+  std::size_t              misses_count{0};
+  std::size_t              referenced_count{0};
+
+  for (std::size_t i{0}; i < indices_count; ++i)
+  {
+    const auto index = indices[i];
+    DC_ASSERT(index < vertices_count, "Vertex index out of range");
+
+    if (timestamp - cache_timestamps[index] > cache_size)
+    {
+      cache_timestamps[index] = timestamp++;
+      ++misses_count;
+    }
+
+    if (!is_referenced[index])
+    {
+      is_referenced[index] = true;
+      ++referenced_count;
+    }
+  }
+
+  statistics.acmr_ = static_cast<float>(misses_count) /
+                     static_cast<float>(indices_count / 3);
+  statistics.atvr_ = static_cast<float>(misses_count) /
+                     static_cast<float>(referenced_count);
+  return statistics;
+}
+
+void optimize_vertex_cache(std::uint32_t *indices,
+                           std::size_t    indices_count,
+                           std::size_t    vertices_count)
+{
+  const auto triangles_count = indices_count / 3;
+  if (triangles_count == 0 || vertices_count == 0)
+  {
+    return;
+  }
+
+  // Build the vertex to triangle adjacency. The first remaining_triangles
+  // entries of a vertex are the triangles which are not emitted yet.
+  std::vector<std::uint32_t> remaining_triangles(vertices_count, 0);
+  for (std::size_t i{0}; i < triangles_count * 3; ++i)
+  {
+    DC_ASSERT(indices[i] < vertices_count, "Vertex index out of range");
+    ++remaining_triangles[indices[i]];
+  }
+
+  std::vector<std::uint32_t> triangle_offsets(vertices_count + 1, 0);
+  for (std::size_t i{0}; i < vertices_count; ++i)
+  {
+    triangle_offsets[i + 1] = triangle_offsets[i] + remaining_triangles[i];
+  }
+
+  std::vector<std::uint32_t> vertex_triangles(triangles_count * 3);
+  {
+    std::vector<std::uint32_t> fill_counts(vertices_count, 0);
+    for (std::size_t i{0}; i < triangles_count * 3; ++i)
+    {
+      const auto index = indices[i];
+      vertex_triangles[triangle_offsets[index] + fill_counts[index]++] =
+          static_cast<std::uint32_t>(i / 3);
+    }
+  }
+
+  std::vector<int>   cache_positions(vertices_count, -1);
+  std::vector<float> vertex_scores(vertices_count);
+  for (std::size_t i{0}; i < vertices_count; ++i)
+  {
+    vertex_scores[i] = vertex_score(-1, remaining_triangles[i]);
+  }
+
+  std::vector<float> triangle_scores(triangles_count);
+  std::vector<bool>  is_emitted(triangles_count, false);
+  std::uint32_t      best_triangle{0};
+  for (std::size_t i{0}; i < triangles_count; ++i)
+  {
+    triangle_scores[i] = vertex_scores[indices[i * 3 + 0]] +
+                         vertex_scores[indices[i * 3 + 1]] +
+                         vertex_scores[indices[i * 3 + 2]];
+    if (triangle_scores[i] > triangle_scores[best_triangle])
+    {
+      best_triangle = static_cast<std::uint32_t>(i);
+    }
+  }
+
+  std::vector<std::uint32_t> output(triangles_count * 3);
+  std::vector<std::uint32_t> cache;
+  std::vector<std::uint32_t> new_cache;
+  cache.reserve(forsyth_cache_size + 3);
+  new_cache.reserve(forsyth_cache_size + 3);
+  std::size_t input_cursor{0};
+
+  for (std::size_t emitted_count{0}; emitted_count < triangles_count;
+       ++emitted_count)
+  {
+    if (best_triangle == invalid_triangle)
+    {
+      // No triangle touches the cache. Continue with the next triangle in
+      // input order.
+      while (is_emitted[input_cursor])
+      {
+        ++input_cursor;
+      }
+      best_triangle = static_cast<std::uint32_t>(input_cursor);
+    }
+
+    const std::uint32_t *triangle = &indices[best_triangle * 3];
+    std::copy(triangle, triangle + 3, &output[emitted_count * 3]);
+    is_emitted[best_triangle] = true;
+
+    // Remove the triangle from the remaining triangles of its vertices
+    for (std::size_t i{0}; i < 3; ++i)
+    {
+      const auto index   = triangle[i];
+      auto       begin   = vertex_triangles.begin() + triangle_offsets[index];
+      auto       end     = begin + remaining_triangles[index];
+      auto       emitted = std::find(begin, end, best_triangle);
+      DC_ASSERT(emitted != end, "Triangle not found in adjacency");
+      std::iter_swap(emitted, end - 1);
+      --remaining_triangles[index];
+    }
+
+    // Put the vertices of the triangle at the front of the LRU cache
+    new_cache.clear();
+    for (std::size_t i{0}; i < 3; ++i)
+    {
+      if (std::find(new_cache.begin(), new_cache.end(), triangle[i]) ==
+          new_cache.end())
+      {
+        new_cache.push_back(triangle[i]);
+      }
+    }
+    for (const auto index : cache)
+    {
+      if (std::find(new_cache.begin(), new_cache.end(), index) ==
+          new_cache.end())
+      {
+        new_cache.push_back(index);
+      }
+    }
+
+    // Vertices which fell out of the cache lose their cache score
+    if (new_cache.size() > forsyth_cache_size)
+    {
+      for (std::size_t i{forsyth_cache_size}; i < new_cache.size(); ++i)
+      {
+        const auto index       = new_cache[i];
+        cache_positions[index] = -1;
+
+        const auto new_score = vertex_score(-1, remaining_triangles[index]);
+        const auto delta     = new_score - vertex_scores[index];
+        vertex_scores[index] = new_score;
+
+        const auto offset = triangle_offsets[index];
+        for (std::size_t j{0}; j < remaining_triangles[index]; ++j)
+        {
+          triangle_scores[vertex_triangles[offset + j]] += delta;
+        }
+      }
+      new_cache.resize(forsyth_cache_size);
+    }
+
+    // Update the scores of all vertices in the cache and pick the best
+    // triangle among the triangles they touch
+    best_triangle = invalid_triangle;
+    float best_score{-1.0f};
+    for (std::size_t i{0}; i < new_cache.size(); ++i)
+    {
+      const auto index       = new_cache[i];
+      cache_positions[index] = static_cast<int>(i);
+
+      const auto new_score =
+          vertex_score(cache_positions[index], remaining_triangles[index]);
+      const auto delta     = new_score - vertex_scores[index];
+      vertex_scores[index] = new_score;
+
+      const auto offset = triangle_offsets[index];
+      for (std::size_t j{0}; j < remaining_triangles[index]; ++j)
+      {
+        triangle_scores[vertex_triangles[offset + j]] += delta;
+      }
+    }
+    for (const auto index : new_cache)
+    {
+      const auto offset = triangle_offsets[index];
+      for (std::size_t j{0}; j < remaining_triangles[index]; ++j)
+      {
+        const auto candidate = vertex_triangles[offset + j];
+        if (triangle_scores[candidate] > best_score)
+        {
+          best_score    = triangle_scores[candidate];
+          best_triangle = candidate;
+        }
+      }
+    }
+
+    std::swap(cache, new_cache);
+  }
+
+  std::copy(output.begin(), output.end(), indices);
+}
+
+void optimize_overdraw(std::uint32_t *indices,
+                       std::size_t    indices_count,
+                       const float   *positions,
+                       std::size_t    positions_stride,
+                       std::size_t    vertices_count)
+{
+  const auto triangles_count = indices_count / 3;
+  if (triangles_count == 0 || vertices_count == 0)
+  {
+    return;
+  }
+
+  // Split the triangles into clusters at the points where the cache
+  // restarts, i.e. all vertices of a triangle miss the cache. Reordering
+  // whole clusters keeps most of the cache efficiency.
+  std::vector<std::uint32_t> cluster_offsets;
+  {
+    std::vector<std::size_t> cache_timestamps(vertices_count, 0);
+    std::size_t              timestamp{overdraw_cache_size + 1};
+    for (std::size_t i{0}; i < triangles_count; ++i)
+    {
+      std::size_t misses_count{0};
+      for (std::size_t j{0}; j < 3; ++j)
+      {
+        const auto index = indices[i * 3 + j];
+        if (timestamp - cache_timestamps[index] > overdraw_cache_size)
+        {
+          cache_timestamps[index] = timestamp++;
+          ++misses_count;
+        }
+      }
+      if (i == 0 || misses_count == 3)
+      {
+        cluster_offsets.push_back(static_cast<std::uint32_t>(i));
+      }
+    }
+  }
+  const auto clusters_count = cluster_offsets.size();
+  cluster_offsets.push_back(static_cast<std::uint32_t>(triangles_count));
+  if (clusters_count < 2)
+  {
+    return;
+  }
+
+  // Area weighted centroids and normals of the clusters
+  std::vector<Float3> cluster_centroids(clusters_count, Float3{});
+  std::vector<Float3> cluster_normals(clusters_count, Float3{});
+  std::vector<float>  cluster_areas(clusters_count, 0.0f);
+  Float3              mesh_centroid{};
+  float               mesh_area{0.0f};
+
+  for (std::size_t i{0}; i < clusters_count; ++i)
+  {
+    for (auto t = cluster_offsets[i]; t < cluster_offsets[i + 1]; ++t)
+    {
+      const auto p0 =
+          read_position(positions, positions_stride, indices[t * 3 + 0]);
+      const auto p1 =
+          read_position(positions, positions_stride, indices[t * 3 + 1]);
+      const auto p2 =
+          read_position(positions, positions_stride, indices[t * 3 + 2]);
+
+      const auto normal = cross(subtract(p1, p0), subtract(p2, p0));
+      const auto area   = std::sqrt(dot(normal, normal)) * 0.5f;
+
+      for (std::size_t k{0}; k < 3; ++k)
+      {
+        const auto centroid = (p0[k] + p1[k] + p2[k]) / 3.0f;
+        cluster_centroids[i][k] += centroid * area;
+        cluster_normals[i][k] += normal[k];
+        mesh_centroid[k] += centroid * area;
+      }
+      cluster_areas[i] += area;
+      mesh_area += area;
+    }
+  }
+
+  if (mesh_area <= 0.0f)
+  {
+    return;
+  }
+  for (auto &value : mesh_centroid)
+  {
+    value /= mesh_area;
+  }
+
+  // Clusters which face away from the center are likely in front of the
+  // clusters which face towards it, so they get drawn first
+  std::vector<float> cluster_sort_keys(clusters_count, 0.0f);
+  for (std::size_t i{0}; i < clusters_count; ++i)
+  {
+    const auto normal_length =
+        std::sqrt(dot(cluster_normals[i], cluster_normals[i]));
+    if (cluster_areas[i] <= 0.0f || normal_length <= 0.0f)
+    {
+      continue;
+    }
+
+    Float3 centroid{};
+    for (std::size_t k{0}; k < 3; ++k)
+    {
+      centroid[k] = cluster_centroids[i][k] / cluster_areas[i];
+    }
+    cluster_sort_keys[i] =
+        dot(subtract(centroid, mesh_centroid), cluster_normals[i]) /
+        normal_length;
+  }
+
+  std::vector<std::uint32_t> cluster_order(clusters_count);
+  for (std::size_t i{0}; i < clusters_count; ++i)
+  {
+    cluster_order[i] = static_cast<std::uint32_t>(i);
+  }
+  std::stable_sort(cluster_order.begin(),
+                   cluster_order.end(),
+                   [&cluster_sort_keys](std::uint32_t a, std::uint32_t b)
+                   { return cluster_sort_keys[a] > cluster_sort_keys[b]; });
+
+  std::vector<std::uint32_t> output;
+  output.reserve(triangles_count * 3);
+  for (const auto cluster : cluster_order)
+  {
+    output.insert(output.end(),
+                  indices + cluster_offsets[cluster] * 3,
+                  indices + cluster_offsets[cluster + 1] * 3);
+  }
+  std::copy(output.begin(), output.end(), indices);
+}
+
+std::vector<std::uint32_t> optimize_vertex_fetch(std::uint32_t *indices,
+                                                 std::size_t    indices_count,
+                                                 std::size_t vertices_count,
+                                                 std::size_t &used_count)
+{
+  std::vector<std::uint32_t> remap(vertices_count, UINT32_MAX);
+  used_count = 0;
+
+  for (std::size_t i{0}; i < indices_count; ++i)
+  {
+    auto &index = indices[i];
+    DC_ASSERT(index < vertices_count, "Vertex index out of range");
+
+    if (remap[index] == UINT32_MAX)
+    {
+      remap[index] = static_cast<std::uint32_t>(used_count++);
+    }
+    index = remap[index];
+  }
+
+  return remap;
+}
+
+std::size_t simplify_mesh(std::uint32_t       *destination,
+                          const std::uint32_t *indices,
+                          std::size_t          indices_count,
+                          const float         *positions,
+                          std::size_t          positions_stride,
+                          std::size_t          vertices_count,
+                          std::size_t          target_indices_count,
+                          float                target_error,
+                          float               &result_error)
+{
+  result_error = 0.0f;
+
+  std::vector<std::uint32_t> current(indices,
+                                     indices + indices_count / 3 * 3);
+  if (current.empty() || vertices_count == 0)
+  {
+    std::copy(current.begin(), current.end(), destination);
+    return current.size();
+  }
+
+  std::vector<Float3> vertex_positions(vertices_count);
+  for (std::size_t i{0}; i < vertices_count; ++i)
+  {
+    vertex_positions[i] = read_position(positions,
+                                        positions_stride,
+                                        static_cast<std::uint32_t>(i));
+  }
+
+  // every vertex starts with the planes of its triangles
+  std::vector<Quadric> quadrics(vertices_count);
+  for (std::size_t i{0}; i < current.size(); i += 3)
+  {
+    const auto &p0 = vertex_positions[current[i + 0]];
+    const auto &p1 = vertex_positions[current[i + 1]];
+    const auto &p2 = vertex_positions[current[i + 2]];
+
+    auto       normal = cross(subtract(p1, p0), subtract(p2, p0));
+    const auto length = std::sqrt(dot(normal, normal));
+    if (length <= 0.0f)
+    {
+      continue;
+    }
+    for (auto &value : normal)
+    {
+      value /= length;
+    }
+
+    const auto quadric =
+        plane_quadric(normal, -dot(normal, p0), length * 0.5f);
+    for (std::size_t j{0}; j < 3; ++j)
+    {
+      quadrics[current[i + j]] = add(quadrics[current[i + j]], quadric);
+    }
+  }
+
+  const auto is_locked =
+      find_locked_vertices(current.data(), current.size(), vertices_count);
+  const auto max_error =
+      static_cast<double>(target_error) * static_cast<double>(target_error);
+
+  std::vector<std::uint32_t> remap(vertices_count);
+  std::vector<std::uint32_t> triangle_offsets(vertices_count + 1);
+  std::vector<std::uint32_t> vertex_triangles;
+  std::vector<Collapse>      collapses;
+  std::vector<bool>          is_touched(vertices_count);
+
+  // Every pass collapses a set of independent edges, so that the error of a
+  // collapse does not depend on the other collapses of the pass
+  while (current.size() > target_indices_count)
+  {
+    const auto triangles_count = current.size() / 3;
+
+    std::fill(triangle_offsets.begin(), triangle_offsets.end(), 0);
+    for (const auto index : current)
+    {
+      ++triangle_offsets[index + 1];
+    }
+    for (std::size_t i{0}; i < vertices_count; ++i)
+    {
+      triangle_offsets[i + 1] += triangle_offsets[i];
+    }
+    vertex_triangles.resize(current.size());
+    {
+      auto fill_offsets = triangle_offsets;
+      for (std::size_t i{0}; i < current.size(); ++i)
+      {
+        vertex_triangles[fill_offsets[current[i]]++] =
+            static_cast<std::uint32_t>(i / 3);
+      }
+    }
+
+    // all collapses of every vertex onto its neighbors. If the cheapest
+    // collapse of a vertex flips a triangle, the next one gets tried.
+    collapses.clear();
+    for (std::uint32_t from{0}; from < vertices_count; ++from)
+    {
+      if (is_locked[from])
+      {
+        continue;
+      }
+
+      const auto first_collapse = collapses.size();
+      for (auto i = triangle_offsets[from]; i < triangle_offsets[from + 1];
+           ++i)
+      {
+        const auto triangle = vertex_triangles[i];
+        for (std::size_t j{0}; j < 3; ++j)
+        {
+          const auto to = current[triangle * 3 + j];
+          if (to == from ||
+              std::any_of(collapses.begin() + first_collapse,
+                          collapses.end(),
+                          [to](const Collapse &collapse)
+                          { return collapse.to_ == to; }))
+          {
+            continue;
+          }
+          const auto error = quadric_error(add(quadrics[from], quadrics[to]),
+                                           vertex_positions[to]);
+          if (error <= max_error)
+          {
+            collapses.push_back({error, from, to});
+          }
+        }
+      }
+    }
+    std::sort(collapses.begin(),
+              collapses.end(),
+              [](const Collapse &a, const Collapse &b)
+              {
+                if (a.error_ != b.error_)
+                {
+                  return a.error_ < b.error_;
+                }
+                return a.from_ < b.from_ ||
+                       (a.from_ == b.from_ && a.to_ < b.to_);
+              });
+
+    for (std::size_t i{0}; i < vertices_count; ++i)
+    {
+      remap[i] = static_cast<std::uint32_t>(i);
+    }
+    std::fill(is_touched.begin(), is_touched.end(), false);
+
+    auto        remaining_triangles = triangles_count;
+    std::size_t collapses_count{0};
+    for (const auto &collapse : collapses)
+    {
+      if (remaining_triangles * 3 <= target_indices_count)
+      {
+        break;
+      }
+      if (is_touched[collapse.from_] || is_touched[collapse.to_])
+      {
+        continue;
+      }
+
+      // reject collapses that flip a remaining triangle
+      std::size_t removed_triangles{0};
+      bool        is_flipping{false};
+      for (auto i = triangle_offsets[collapse.from_];
+           i < triangle_offsets[collapse.from_ + 1] && !is_flipping;
+           ++i)
+      {
+        const auto triangle = &current[vertex_triangles[i] * 3];
+        if (std::find(triangle, triangle + 3, collapse.to_) != triangle + 3)
+        {
+          ++removed_triangles;
+          continue;
+        }
+
+        std::array<Float3, 3> moved{};
+        for (std::size_t j{0}; j < 3; ++j)
+        {
+          moved[j] = vertex_positions[triangle[j] == collapse.from_
+                                          ? collapse.to_
+                                          : triangle[j]];
+        }
+        const auto &p0 = vertex_positions[triangle[0]];
+        const auto &p1 = vertex_positions[triangle[1]];
+        const auto &p2 = vertex_positions[triangle[2]];
+
+        const auto old_normal = cross(subtract(p1, p0), subtract(p2, p0));
+        const auto new_normal = cross(subtract(moved[1], moved[0]),
+                                      subtract(moved[2], moved[0]));
+        is_flipping           = dot(old_normal, new_normal) <= 0.0f;
+      }
+      if (is_flipping)
+      {
+        continue;
+      }
+
+      remap[collapse.from_] = collapse.to_;
+      quadrics[collapse.to_] =
+          add(quadrics[collapse.to_], quadrics[collapse.from_]);
+      result_error = std::max(result_error,
+                              static_cast<float>(std::sqrt(collapse.error_)));
+      remaining_triangles -= std::min(removed_triangles, remaining_triangles);
+      ++collapses_count;
+
+      // the neighborhood changed, its collapses need to be evaluated again
+      for (auto i = triangle_offsets[collapse.from_];
+           i < triangle_offsets[collapse.from_ + 1];
+           ++i)
+      {
+        const auto triangle = &current[vertex_triangles[i] * 3];
+        for (std::size_t j{0}; j < 3; ++j)
+        {
+          is_touched[triangle[j]] = true;
+        }
+      }
+    }
+
+    if (collapses_count == 0)
+    {
+      break;
+    }
+
+    // apply the collapses and drop the triangles that degenerated
+    std::size_t write_index{0};
+    for (std::size_t i{0}; i < current.size(); i += 3)
+    {
+      const auto a = remap[current[i + 0]];
+      const auto b = remap[current[i + 1]];
+      const auto c = remap[current[i + 2]];
+      if (a != b && b != c && a != c)
+      {
+        current[write_index++] = a;
+        current[write_index++] = b;
+        current[write_index++] = c;
+      }
+    }
+    current.resize(write_index);
+  }
+
+  std::copy(current.begin(), current.end(), destination);
+  return current.size();
+}
+
+} // namespace dc
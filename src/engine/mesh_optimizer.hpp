@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace dc
+{
+
+/**
+ * Efficiency of an index buffer for a FIFO post transform vertex cache.
+ * ACMR are the transformed vertices per triangle, ATVR the transformed
+ * vertices per referenced vertex. Both are best at low values, ATVR can not
+ * get below 1.
+ */
+struct VertexCacheStatistics
+{
+  float acmr_{0.0f};
+  float atvr_{0.0f};
+};
+
+struct MeshOptimizationStatistics
+{
+  VertexCacheStatistics before_{};
+  VertexCacheStatistics after_{};
+};
+
+VertexCacheStatistics analyze_vertex_cache(const std::uint32_t *indices,
+                                           std::size_t          indices_count,
+                                           std::size_t          vertices_count,
+                                           std::size_t cache_size = 16);
+
+/**
+ * Reorders the triangles for the post transform vertex cache. Uses the
+ * algorithm of Tom Forsyth, "Linear-Speed Vertex Cache Optimisation".
+ */
+void optimize_vertex_cache(std::uint32_t *indices,
+                           std::size_t    indices_count,
+                           std::size_t    vertices_count);
+
+/**
+ * Reorders clusters of a cache optimized index buffer, so that clusters
+ * facing away from the mesh center get drawn first. This reduces overdraw
+ * without losing much of the cache efficiency. Positions are three floats,
+ * stride is the distance between two positions in bytes.
+ */
+void optimize_overdraw(std::uint32_t *indices,
+                       std::size_t    indices_count,
+                       const float   *positions,
+                       std::size_t    positions_stride,
+                       std::size_t    vertices_count);
+
+/**
+ * Renumbers the vertices in the order they get used by the index buffer. The
+ * returned remap table maps old to new vertex indices. Unused vertices get
+ * dropped and map to UINT32_MAX.
+ */
+std::vector<std::uint32_t> optimize_vertex_fetch(std::uint32_t *indices,
+                                                 std::size_t    indices_count,
+                                                 std::size_t vertices_count,
+                                                 std::size_t &used_count);
+
+/**
+ * Simplifies a triangle list by collapsing vertices onto neighbors, cheapest
+ * collapse by quadric error first (Garland and Heckbert, "Surface
+ * Simplification Using Quadric Error Metrics"). No vertices get created, so
+ * the result can share the vertex buffer with the input. Vertices on borders
+ * and attribute seams stay in place. Stops at the target indices count or
+ * when the next collapse would exceed the target error. Returns the new
+ * indices count. The error of the result is the object space distance to
+ * the input.
+ */
+std::size_t simplify_mesh(std::uint32_t       *destination,
+                          const std::uint32_t *indices,
+                          std::size_t          indices_count,
+                          const float         *positions,
+                          std::size_t          positions_stride,
+                          std::size_t          vertices_count,
+                          std::size_t          target_indices_count,
+                          float                target_error,
+                          float               &result_error);
+
+/**
+ * Runs all optimizations on a triangle list. The vertex type needs a
+ * glm::vec3 position member. The result does not depend on anything but the
+ * input.
+ */
+template <typename T>
+MeshOptimizationStatistics optimize_mesh(std::vector<T>             &vertices,
+                                         std::vector<std::uint32_t> &indices)
+{
+  MeshOptimizationStatistics statistics{};
+  if (vertices.empty() || indices.empty())
+  {
+    return statistics;
+  }
+
+  statistics.before_ =
+      analyze_vertex_cache(indices.data(), indices.size(), vertices.size());
+
+  optimize_vertex_cache(indices.data(), indices.size(), vertices.size());
+  optimize_overdraw(indices.data(),
+                    indices.size(),
+                    &vertices[0].position.x,
+                    sizeof(T),
+                    vertices.size());
+
+  std::size_t used_count{0};
+  const auto  remap = optimize_vertex_fetch(indices.data(),
+                                           indices.size(),
+                                           vertices.size(),
+                                           used_count);
+  std::vector<T> fetch_ordered_vertices(used_count);
+  for (std::size_t i{0}; i < vertices.size(); ++i)
+  {
+    if (remap[i] != UINT32_MAX)
+    {
+      fetch_ordered_vertices[remap[i]] = vertices[i];
+    }
+  }
+  vertices = std::move(fetch_ordered_vertices);
+
+  statistics.after_ =
+      analyze_vertex_cache(indices.data(), indices.size(), vertices.size());
+  return statistics;
+}
+
+} // namespace dc
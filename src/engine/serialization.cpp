@@ -2,6 +2,7 @@
 #include "environment_map.hpp"
 #include "skeleton.hpp"
 
+#include <algorithm>
 #include <cstdint>
 
 namespace dc
@@ -13,17 +14,6 @@ std::filesystem::path normalize_path(const std::filesystem::path &path)
   return path;
 }
 
-void write_string(FILE *file, const std::string &str)
-{
-  assert(file);
-  const auto length = str.size();
-  std::fwrite(&length, sizeof(std::uint32_t), 1, file);
-  if (length > 0)
-  {
-    std::fwrite(str.c_str(), sizeof(char), length, file);
-  }
-}
-
 void read_string(FILE *file, std::string &str)
 {
   assert(file);
@@ -42,17 +32,6 @@ void read_string(FILE *file, std::string &str)
   }
 }
 
-void write_string(std::ofstream &file, const std::string &str)
-{
-  const auto length = str.size();
-  file.write(reinterpret_cast<const char *>(&length), sizeof(std::uint32_t));
-  if (length > 0)
-  {
-    file.write(reinterpret_cast<const char *>(str.data()),
-               sizeof(char) * length);
-  }
-}
-
 void read_string(std::ifstream &file, std::string &str)
 {
   std::uint32_t length{};
@@ -73,31 +52,56 @@ void read_string(std::ifstream &file, std::string &str)
 void TextureDescription::save(const std::filesystem::path &file_path,
                               const AssetDescription &asset_description) const
 {
-  const auto file = std::fopen(file_path.string().c_str(), "wb");
-  if (!file)
+  BinaryWriter writer{};
+
+  if (levels_.empty())
   {
-    throw std::runtime_error{"Could not open file " + file_path.string()};
+    asset_description.write(writer);
+    write_vector(writer, data_);
+    writer.save(file_path);
+    return;
   }
-  defer(std::fclose(file));
 
-  asset_description.write(file);
-  write_vector(file, data_);
-}
+  auto versioned_asset_description     = asset_description;
+  versioned_asset_description.version_ = 1;
+  versioned_asset_description.write(writer);
 
-AssetDescription
-TextureDescription::read(const std::filesystem::path &file_path)
-{
-  const auto file = std::fopen(file_path.string().c_str(), "rb");
-  if (!file)
+  write_value(writer, format_);
+  write_value(writer, width_);
+  write_value(writer, height_);
+  write_value(writer, static_cast<std::uint64_t>(levels_.size()));
+  for (const auto &level : levels_)
   {
-    throw std::runtime_error{"Could not open file " + file_path.string()};
+    write_vector(writer, level);
   }
-  defer(std::fclose(file));
+  writer.save(file_path);
+}
 
+AssetDescription TextureDescription::read(BinaryReader &reader)
+{
   AssetDescription asset_description;
-  asset_description.read(file);
+  asset_description.read(reader);
+
+  if (asset_description.version_ == 0)
+  {
+    read_vector(reader, data_);
+    return asset_description;
+  }
 
-  read_vector(file, data_);
+  read_value(reader, format_);
+  read_value(reader, width_);
+  read_value(reader, height_);
+  std::uint64_t levels_count{};
+  read_value(reader, levels_count);
+  if (levels_count > 32)
+  {
+    throw std::runtime_error{"Texture has too many levels"};
+  }
+  levels_.resize(levels_count);
+  for (auto &level : levels_)
+  {
+    read_vector(reader, level);
+  }
 
   return asset_description;
 }
@@ -105,112 +109,125 @@ TextureDescription::read(const std::filesystem::path &file_path)
 void MaterialDescription::save(const std::filesystem::path &file_path,
                                const AssetDescription &asset_description) const
 {
-  const auto file = std::fopen(file_path.string().c_str(), "wb");
-  if (!file)
-  {
-    throw std::runtime_error{"Could not open file " + file_path.string()};
-  }
-  defer(std::fclose(file));
-
-  asset_description.write(file);
-  write_string(file, albedo_texture_name_);
-  write_value(file, albedo_color_);
-  write_string(file, roughness_texture_name_);
-  write_value(file, roughness_);
-  write_string(file, ambient_occlusion_texture_name_);
-  write_string(file, emissive_texture_name_);
-  write_value(file, emissive_color_);
-  write_string(file, normal_texture_name_);
-  write_value(file, transparency_factor_);
-  write_value(file, alpha_test_);
-  write_value(file, metallic_factor_);
+  BinaryWriter writer{};
+
+  asset_description.write(writer);
+  write_string(writer, albedo_texture_name_);
+  write_value(writer, albedo_color_);
+  write_string(writer, roughness_texture_name_);
+  write_value(writer, roughness_);
+  write_string(writer, ambient_occlusion_texture_name_);
+  write_string(writer, emissive_texture_name_);
+  write_value(writer, emissive_color_);
+  write_string(writer, normal_texture_name_);
+  write_value(writer, transparency_factor_);
+  write_value(writer, alpha_test_);
+  write_value(writer, metallic_factor_);
+  writer.save(file_path);
 }
 
-AssetDescription
-MaterialDescription::read(const std::filesystem::path &file_path)
+AssetDescription MaterialDescription::read(BinaryReader &reader)
 {
-  const auto file = std::fopen(file_path.string().c_str(), "rb");
-  if (!file)
-  {
-    throw std::runtime_error{"Could not open file " + file_path.string()};
-  }
-  defer(std::fclose(file));
-
   AssetDescription asset_description;
-  asset_description.read(file);
-
-  read_string(file, albedo_texture_name_);
-  read_value(file, albedo_color_);
-  read_string(file, roughness_texture_name_);
-  read_value(file, roughness_);
-  read_string(file, ambient_occlusion_texture_name_);
-  read_string(file, emissive_texture_name_);
-  read_value(file, emissive_color_);
-  read_string(file, normal_texture_name_);
-  read_value(file, transparency_factor_);
-  read_value(file, alpha_test_);
-  read_value(file, metallic_factor_);
+  asset_description.read(reader);
+
+  read_string(reader, albedo_texture_name_);
+  read_value(reader, albedo_color_);
+  read_string(reader, roughness_texture_name_);
+  read_value(reader, roughness_);
+  read_string(reader, ambient_occlusion_texture_name_);
+  read_string(reader, emissive_texture_name_);
+  read_value(reader, emissive_color_);
+  read_string(reader, normal_texture_name_);
+  read_value(reader, transparency_factor_);
+  read_value(reader, alpha_test_);
+  read_value(reader, metallic_factor_);
 
   return asset_description;
 }
 
-void SkinnedSubMeshDescription::save(FILE *file) const
+void SkinnedSubMeshDescription::save(BinaryWriter &writer,
+                                     VertexFormat  vertex_format) const
 {
-  write_vector(file, vertices_);
-  write_vector(file, indices_);
-  write_string(file, material_name_);
+  if (vertex_format == VertexFormat::Packed)
+  {
+    std::vector<PackedSkinnedVertex> packed_vertices(vertices_.size());
+    std::transform(vertices_.begin(),
+                   vertices_.end(),
+                   packed_vertices.begin(),
+                   pack_skinned_vertex);
+    write_vector(writer, packed_vertices);
+  }
+  else
+  {
+    write_vector(writer, vertices_);
+  }
+  write_vector(writer, indices_);
+  write_string(writer, material_name_);
 }
 
-void SkinnedSubMeshDescription::read(FILE *file)
+void SkinnedSubMeshDescription::read(BinaryReader &reader,
+                                     VertexFormat  vertex_format)
 {
-  read_vector(file, vertices_);
-  read_vector(file, indices_);
-  read_string(file, material_name_);
+  if (vertex_format == VertexFormat::Packed)
+  {
+    read_vector(reader, packed_vertices_);
+  }
+  else
+  {
+    read_vector(reader, vertices_);
+  }
+  read_vector(reader, indices_);
+  read_string(reader, material_name_);
 }
 
 void SkinnedMeshDescription::save(
     const std::filesystem::path &file_path,
     const AssetDescription      &asset_description) const
 {
-  const auto file = std::fopen(file_path.string().c_str(), "wb");
-  if (!file)
-  {
-    throw std::runtime_error{"Could not open file " + file_path.string()};
-  }
-  defer(std::fclose(file));
+  BinaryWriter writer{};
 
-  asset_description.write(file);
+  auto versioned_asset_description     = asset_description;
+  versioned_asset_description.version_ = 1;
+  versioned_asset_description.write(writer);
+  const auto payload_offset = writer.size();
+  write_value(writer, vertex_format_);
 
-  write_value(file, static_cast<std::uint64_t>(sub_meshes_.size()));
+  write_value(writer, static_cast<std::uint64_t>(sub_meshes_.size()));
   for (const auto &sub_mesh : sub_meshes_)
   {
-    sub_mesh.save(file);
+    sub_mesh.save(writer, vertex_format_);
   }
-  skeleton_->save(file);
+  skeleton_->save(writer);
+  writer.compress(payload_offset, asset_description.compression_codec_);
+  writer.save(file_path);
 }
 
-AssetDescription
-SkinnedMeshDescription::read(const std::filesystem::path &file_path)
+AssetDescription SkinnedMeshDescription::read(BinaryReader &reader)
 {
-  const auto file = std::fopen(file_path.string().c_str(), "rb");
-  if (!file)
+  AssetDescription asset_description;
+  asset_description.read(reader);
+
+  vertex_format_ = VertexFormat::Float;
+  if (asset_description.version_ >= 1)
   {
-    throw std::runtime_error{"Could not open file " + file_path.string()};
+    read_value(reader, vertex_format_);
+    if (vertex_format_ != VertexFormat::Float &&
+        vertex_format_ != VertexFormat::Packed)
+    {
+      throw std::runtime_error{"Unsupported vertex format"};
+    }
   }
-  defer(std::fclose(file));
-
-  AssetDescription asset_description;
-  asset_description.read(file);
 
   std::uint64_t sub_meshes_count{};
-  read_value(file, sub_meshes_count);
+  read_value(reader, sub_meshes_count);
   for (std::uint64_t i = 0; i < sub_meshes_count; ++i)
   {
     SkinnedSubMeshDescription sub_mesh_description{};
-    sub_mesh_description.read(file);
+    sub_mesh_description.read(reader, vertex_format_);
     sub_meshes_.push_back(std::move(sub_mesh_description));
   }
-  skeleton_->read(file);
+  skeleton_->read(reader);
 
   return asset_description;
 }
@@ -219,32 +236,22 @@ void EnvironmentMapDescription::save(
     const std::filesystem::path &file_path,
     const AssetDescription      &asset_description) const
 {
-  const auto file = std::fopen(file_path.string().c_str(), "wb");
-  if (!file)
-  {
-    throw std::runtime_error{"Could not open file " + file_path.string()};
-  }
-  defer(std::fclose(file));
+  BinaryWriter writer{};
 
-  asset_description.write(file);
+  asset_description.write(writer);
+  const auto payload_offset = writer.size();
 
-  write_vector(file, env_map_data_);
+  write_vector(writer, env_map_data_);
+  writer.compress(payload_offset, asset_description.compression_codec_);
+  writer.save(file_path);
 }
 
-AssetDescription
-EnvironmentMapDescription::read(const std::filesystem::path &file_path)
+AssetDescription EnvironmentMapDescription::read(BinaryReader &reader)
 {
-  const auto file = std::fopen(file_path.string().c_str(), "rb");
-  if (!file)
-  {
-    throw std::runtime_error{"Could not open file " + file_path.string()};
-  }
-  defer(std::fclose(file));
-
   AssetDescription asset_description;
-  asset_description.read(file);
+  asset_description.read(reader);
 
-  read_vector(file, env_map_data_);
+  read_vector(reader, env_map_data_);
 
   return asset_description;
 }
@@ -1,10 +1,13 @@
 #pragma once
 
 #include "asset_description.hpp"
+#include "binary_reader.hpp"
+#include "binary_writer.hpp"
 #include "defer.hpp"
 #include "mesh.hpp"
 #include "skeleton.hpp"
 #include "skinned_mesh.hpp"
+#include "texture_compression.hpp"
 
 #include <cstdlib>
 #include <filesystem>
@@ -19,23 +22,9 @@ namespace dc
 
 std::filesystem::path normalize_path(const std::filesystem::path &path);
 
-void write_string(FILE *file, const std::string &str);
 void read_string(FILE *file, std::string &str);
-
-void write_string(std::ofstream &file, const std::string &str);
 void read_string(std::ifstream &file, std::string &str);
 
-template <typename T> void write_value(FILE *file, const T &value)
-{
-  assert(file);
-  std::fwrite(&value, sizeof(T), 1, file);
-}
-
-template <typename T> void write_value(std::ofstream &file, const T &value)
-{
-  file.write(reinterpret_cast<const char *>(&value), sizeof(T));
-}
-
 template <typename T> void read_value(FILE *file, T &value)
 {
   assert(file);
@@ -47,71 +36,20 @@ template <typename T> void read_value(std::ifstream &file, T &value)
   file.read(reinterpret_cast<char *>(&value), sizeof(T));
 }
 
-template <typename T> void write_vector(FILE *file, const std::vector<T> &value)
-{
-  assert(file);
-  const auto count = value.size();
-  std::fwrite(&count, sizeof(std::uint64_t), 1, file);
-  std::fwrite(value.data(), sizeof(T), value.size(), file);
-}
-
-template <typename T>
-void write_vector_complex(FILE *file, const std::vector<T> &value)
-{
-  assert(file);
-  const auto count = value.size();
-  std::fwrite(&count, sizeof(std::uint64_t), 1, file);
-  for (std::size_t i = 0; i < value.size(); ++i)
-  {
-    value[i].save(file);
-  }
-}
-
-template <typename T> void read_vector(FILE *file, std::vector<T> &value)
-{
-  assert(file);
-  std::uint64_t count{};
-  std::fread(&count, sizeof(std::uint64_t), 1, file);
-  if (count > 0)
-  {
-    value.resize(count);
-    std::fread(value.data(), sizeof(T), count, file);
-  }
-  else
-  {
-    value = {};
-  }
-}
-
-template <typename T>
-void read_vector_complex(FILE *file, std::vector<T> &value)
-{
-  assert(file);
-  std::uint64_t count{};
-  std::fread(&count, sizeof(std::uint64_t), 1, file);
-  if (count > 0)
-  {
-    value.resize(count);
-    for (std::uint64_t i = 0; i < value.size(); ++i)
-    {
-      T v{};
-      v.read(file);
-      value[i] = std::move(v);
-    }
-  }
-  else
-  {
-    value = {};
-  }
-}
-
 struct TextureDescription
 {
+  // version 0 stores an encoded image file
   std::vector<std::uint8_t> data_;
 
+  // version 1 stores the GPU ready mip chain, starting with the largest level
+  TextureFormat                          format_{TextureFormat::Rgba8};
+  std::int32_t                           width_{0};
+  std::int32_t                           height_{0};
+  std::vector<std::vector<std::uint8_t>> levels_;
+
   void             save(const std::filesystem::path &file_path,
                         const AssetDescription      &asset_description) const;
-  AssetDescription read(const std::filesystem::path &file_path);
+  AssetDescription read(BinaryReader &reader);
 };
 
 struct MaterialDescription
@@ -137,27 +75,31 @@ struct MaterialDescription
   void save(const std::filesystem::path &file_path,
             const AssetDescription      &asset_description) const;
 
-  AssetDescription read(const std::filesystem::path &file_path);
+  AssetDescription read(BinaryReader &reader);
 };
 
 struct SkinnedSubMeshDescription
 {
   std::vector<SkinnedVertex> vertices_;
-  std::vector<std::uint32_t> indices_;
-  std::string                material_name_;
+  // only filled when reading packed vertices
+  std::vector<PackedSkinnedVertex> packed_vertices_;
+  std::vector<std::uint32_t>       indices_;
+  std::string                      material_name_;
 
-  void save(FILE *file) const;
-  void read(FILE *file);
+  void save(BinaryWriter &writer, VertexFormat vertex_format) const;
+  void read(BinaryReader &reader, VertexFormat vertex_format);
 };
 
+/** Version 1 stores the vertex format after the asset description */
 struct SkinnedMeshDescription
 {
   std::vector<SkinnedSubMeshDescription> sub_meshes_;
   std::shared_ptr<Skeleton> skeleton_{std::make_shared<Skeleton>()};
+  VertexFormat              vertex_format_{VertexFormat::Float};
 
   void             save(const std::filesystem::path &file_path,
                         const AssetDescription      &asset_description) const;
-  AssetDescription read(const std::filesystem::path &file_path);
+  AssetDescription read(BinaryReader &reader);
 };
 
 struct EnvironmentMapDescription
@@ -166,7 +108,7 @@ struct EnvironmentMapDescription
 
   void             save(const std::filesystem::path &file_path,
                         const AssetDescription      &asset_description) const;
-  AssetDescription read(const std::filesystem::path &file_path);
+  AssetDescription read(BinaryReader &reader);
 };
 
 } // namespace dc
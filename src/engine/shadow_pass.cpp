@@ -112,7 +112,11 @@ void ShadowPass::generate_point_light_shadows(
                 "model",
                 mesh_info.model_matrix_);
 
-            draw(*mesh_info.mesh_->vertex_array(), GL_TRIANGLES);
+            const auto lod = mesh_info.mesh_->lod(mesh_info.shadow_lod_);
+            draw_range(*mesh_info.mesh_->vertex_array(),
+                       GL_TRIANGLES,
+                       lod.first_index_,
+                       lod.indices_count_);
         }
         point_light_shadow_map_shader_->unbind();
 
@@ -207,7 +211,11 @@ void ShadowPass::execute(const SceneRenderInfo &scene_render_info,
         shadow_map_shader_->set_uniform("model_matrix",
                                         mesh_info.model_matrix_);
 
-        draw(*mesh_info.mesh_->vertex_array(), GL_TRIANGLES);
+        const auto lod = mesh_info.mesh_->lod(mesh_info.shadow_lod_);
+        draw_range(*mesh_info.mesh_->vertex_array(),
+                   GL_TRIANGLES,
+                   lod.first_index_,
+                   lod.indices_count_);
     }
 
     shadow_map_shader_->unbind();
@@ -254,7 +262,11 @@ void ShadowPass::execute(const SceneRenderInfo &scene_render_info,
         shadow_map_transparent_shader_->set_uniform("model_matrix",
                                                     mesh_info.model_matrix_);
 
-        draw(*mesh_info.mesh_->vertex_array(), GL_TRIANGLES);
+        const auto lod = mesh_info.mesh_->lod(mesh_info.shadow_lod_);
+        draw_range(*mesh_info.mesh_->vertex_array(),
+                   GL_TRIANGLES,
+                   lod.first_index_,
+                   lod.indices_count_);
     }
 
     shadow_map_transparent_shader_->unbind();
@@ -6,20 +6,20 @@
 namespace dc
 {
 
-void Bone::save(FILE *file) const
+void Bone::save(BinaryWriter &writer) const
 {
-  write_string(file, name_);
-  write_value(file, parent_index_);
-  write_value(file, local_bind_pose_);
-  write_value(file, global_inv_bind_pose_);
+  write_string(writer, name_);
+  write_value(writer, parent_index_);
+  write_value(writer, local_bind_pose_);
+  write_value(writer, global_inv_bind_pose_);
 }
 
-void Bone::read(FILE *file)
+void Bone::read(BinaryReader &reader)
 {
-  read_string(file, name_);
-  read_value(file, parent_index_);
-  read_value(file, local_bind_pose_);
-  read_value(file, global_inv_bind_pose_);
+  read_string(reader, name_);
+  read_value(reader, parent_index_);
+  read_value(reader, local_bind_pose_);
+  read_value(reader, global_inv_bind_pose_);
 }
 
 Skeleton::Skeleton(std::vector<Bone> bones) : bones_{std::move(bones)} {}
@@ -129,16 +129,16 @@ std::string Skeleton::animation_name_by_index(int animation_index) const
   return animations_[animation_index].name();
 }
 
-void Skeleton::save(FILE *file) const
+void Skeleton::save(BinaryWriter &writer) const
 {
-  write_vector_complex(file, bones_);
-  write_vector_complex(file, animations_);
+  write_vector_complex(writer, bones_);
+  write_vector_complex(writer, animations_);
 }
 
-void Skeleton::read(FILE *file)
+void Skeleton::read(BinaryReader &reader)
 {
-  read_vector_complex(file, bones_);
-  read_vector_complex(file, animations_);
+  read_vector_complex(reader, bones_);
+  read_vector_complex(reader, animations_);
 }
 
 } // namespace dc
@@ -9,6 +9,9 @@
 namespace dc
 {
 
+class BinaryReader;
+class BinaryWriter;
+
 struct Bone
 {
   std::string name_;
@@ -16,8 +19,8 @@ struct Bone
   glm::mat4   local_bind_pose_{1.0f};
   glm::mat4   global_inv_bind_pose_{1.0f};
 
-  void save(FILE *file) const;
-  void read(FILE *file);
+  void save(BinaryWriter &writer) const;
+  void read(BinaryReader &reader);
 };
 
 class Skeleton
@@ -41,8 +44,8 @@ public:
   int         index_of_animation_by_name(const std::string &name) const;
   std::string animation_name_by_index(int animation_index) const;
 
-  void save(FILE *file) const;
-  void read(FILE *file);
+  void save(BinaryWriter &writer) const;
+  void read(BinaryReader &reader);
 
 private:
   std::vector<Bone> bones_;
@@ -1,19 +1,74 @@
 #include "skinned_mesh.hpp"
 #include "skeleton.hpp"
 
+#include <algorithm>
+
 namespace dc
 {
 
+std::size_t skinned_vertex_size(VertexFormat vertex_format)
+{
+  return vertex_format == VertexFormat::Packed ? sizeof(PackedSkinnedVertex)
+                                               : sizeof(SkinnedVertex);
+}
+
+GlVertexBufferLayout skinned_vertex_buffer_layout(VertexFormat vertex_format)
+{
+  GlVertexBufferLayout layout;
+  if (vertex_format == VertexFormat::Packed)
+  {
+    layout.push_float(3);                              // position
+    layout.push_converted(GL_SHORT, 2, true);          // octahedral normal
+    layout.push_converted(GL_SHORT, 2, true);          // octahedral tangent
+    layout.push_converted(GL_BYTE, 4, true);           // bitangent sign
+    layout.push_integer(GL_UNSIGNED_BYTE, 4);          // bones
+    layout.push_converted(GL_UNSIGNED_SHORT, 4, true); // bone weights
+    layout.push_converted(GL_HALF_FLOAT, 2, false);    // tex coords
+    return layout;
+  }
+
+  layout.push_float(3); // position
+  layout.push_float(3); // normal
+  layout.push_float(3); // tangent
+  layout.push_float(3); // bitanget
+  layout.push_int(4);   // bones
+  layout.push_float(4); // bone weights
+  layout.push_float(2); // tex coords
+  return layout;
+}
+
+PackedSkinnedVertex pack_skinned_vertex(const SkinnedVertex &vertex)
+{
+  PackedSkinnedVertex packed_vertex{};
+  packed_vertex.position = vertex.position;
+  packed_vertex.normal   = encode_octahedral(vertex.normal);
+  packed_vertex.tangent  = encode_octahedral(vertex.tangent);
+  packed_vertex.bitangent_sign[0] =
+      bitangent_sign(vertex.normal, vertex.tangent, vertex.bitangent);
+  for (int i{0}; i < 4; ++i)
+  {
+    packed_vertex.skin_bones[i] =
+        static_cast<std::uint8_t>(std::clamp(vertex.skin_bones[i], 0, 255));
+    packed_vertex.bone_weights[i] = float_to_unorm16(vertex.bone_weights[i]);
+  }
+  packed_vertex.tex_coords = {float_to_half(vertex.tex_coords.x),
+                              float_to_half(vertex.tex_coords.y)};
+  return packed_vertex;
+}
+
 SkinnedSubMesh::SkinnedSubMesh(std::unique_ptr<GlVertexArray> vertex_array,
-                               std::shared_ptr<MaterialAssetHandle> material)
+                               std::shared_ptr<MaterialAssetHandle> material,
+                               VertexFormat vertex_format)
     : vertex_array_{std::move(vertex_array)},
-      material_{material}
+      material_{material},
+      vertex_format_{vertex_format}
 {
 }
 
 SkinnedSubMesh::SkinnedSubMesh(SkinnedSubMesh &&other)
     : vertex_array_{std::move(other.vertex_array_)},
-      material_{std::move(other.material_)}
+      material_{std::move(other.material_)},
+      vertex_format_{other.vertex_format_}
 {
   other.vertex_array_ = nullptr;
   other.material_     = nullptr;
@@ -25,6 +80,7 @@ void SkinnedSubMesh::operator=(SkinnedSubMesh &&other)
   other.vertex_array_ = nullptr;
   material_           = std::move(other.material_);
   other.material_     = nullptr;
+  vertex_format_      = other.vertex_format_;
 }
 
 GlVertexArray *SkinnedSubMesh::vertex_array() const
@@ -32,6 +88,8 @@ GlVertexArray *SkinnedSubMesh::vertex_array() const
   return vertex_array_.get();
 }
 
+VertexFormat SkinnedSubMesh::vertex_format() const { return vertex_format_; }
+
 Material *SkinnedSubMesh::material() const
 {
 
@@ -1,10 +1,14 @@
 #pragma once
 
 #include "gl_vertex_array.hpp"
+#include "gl_vertex_buffer.hpp"
 #include "material.hpp"
 #include "material_asset.hpp"
 #include "mesh.hpp"
 #include "skeleton.hpp"
+#include "vertex_format.hpp"
+
+#include <cstddef>
 #include <memory>
 
 namespace dc
@@ -21,21 +25,29 @@ struct SkinnedVertex
   glm::vec2  tex_coords;
 };
 
+std::size_t          skinned_vertex_size(VertexFormat vertex_format);
+GlVertexBufferLayout skinned_vertex_buffer_layout(VertexFormat vertex_format);
+
+PackedSkinnedVertex pack_skinned_vertex(const SkinnedVertex &vertex);
+
 class SkinnedSubMesh
 {
 public:
   SkinnedSubMesh(std::unique_ptr<GlVertexArray>       vertex_array,
-                 std::shared_ptr<MaterialAssetHandle> material);
+                 std::shared_ptr<MaterialAssetHandle> material,
+                 VertexFormat vertex_format = VertexFormat::Float);
 
   SkinnedSubMesh(SkinnedSubMesh &&other);
   void operator=(SkinnedSubMesh &&other);
 
   GlVertexArray *vertex_array() const;
   Material      *material() const;
+  VertexFormat   vertex_format() const;
 
 private:
   std::unique_ptr<GlVertexArray>       vertex_array_;
   std::shared_ptr<MaterialAssetHandle> material_;
+  VertexFormat                         vertex_format_{VertexFormat::Float};
 
   SkinnedSubMesh(const SkinnedSubMesh &) = delete;
   void operator=(const SkinnedSubMesh &) = delete;
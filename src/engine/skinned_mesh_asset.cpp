@@ -1,6 +1,8 @@
 #include "skinned_mesh_asset.hpp"
 #include "asset_handle.hpp"
+#include "binary_reader.hpp"
 #include "engine.hpp"
+#include "gpu_upload_queue.hpp"
 #include "log.hpp"
 #include "serialization.hpp"
 #include "skeleton.hpp"
@@ -12,58 +14,104 @@
 namespace dc
 {
 
-SkinnedMeshAssetHandle::SkinnedMeshAssetHandle(
-    const std::filesystem::path &file_path,
-    const Asset                 &asset)
+SkinnedMeshAssetHandle::SkinnedMeshAssetHandle(const Asset &asset)
     : AssetHandle{asset}
 {
-  try
-  {
-    SkinnedMeshDescription skinned_mesh_desc{};
-    skinned_mesh_desc.read(file_path);
+}
 
-    std::vector<std::unique_ptr<SkinnedSubMesh>> sub_meshes;
-    for (const auto &sub_mesh : skinned_mesh_desc.sub_meshes_)
-    {
-      const auto asset_cache = Engine::instance()->asset_cache();
-      const auto material    = std::dynamic_pointer_cast<MaterialAssetHandle>(
-          asset_cache->load_asset(Asset{sub_mesh.material_name_}));
-
-      const auto index_buffer =
-          std::make_shared<GlIndexBuffer>(sub_mesh.indices_);
-
-      GlVertexBufferLayout layout;
-      layout.push_float(3); // position
-      layout.push_float(3); // normal
-      layout.push_float(3); // tangent
-      layout.push_float(3); // bitanget
-      layout.push_int(4);   // bones
-      layout.push_float(4); // bone weights
-      layout.push_float(2); // tex coords
-      const auto vertex_buffer =
-          std::make_shared<GlVertexBuffer>(sub_mesh.vertices_, layout);
-
-      auto vertex_array = std::make_unique<GlVertexArray>();
-      vertex_array->add_vertex_buffer(vertex_buffer);
-      vertex_array->set_index_buffer(index_buffer);
-
-      auto mesh =
-          std::make_unique<SkinnedSubMesh>(std::move(vertex_array), material);
-      sub_meshes.push_back(std::move(mesh));
-    }
+SkinnedMeshAssetHandle::~SkinnedMeshAssetHandle() = default;
 
-    skinned_mesh_ =
-        std::make_shared<SkinnedMesh>(std::move(skinned_mesh_desc.skeleton_),
-                                      std::move(sub_meshes));
+void SkinnedMeshAssetHandle::load(const AssetData &asset_data)
+{
+  try
+  {
+    auto skinned_mesh_desc = std::make_unique<SkinnedMeshDescription>();
+    BinaryReader reader{asset_data.data_, asset_data.size_};
+    skinned_mesh_desc->read(reader);
+    skinned_mesh_description_ = std::move(skinned_mesh_desc);
   }
   catch (const std::runtime_error &error)
   {
     DC_LOG_WARN("Could not load skinned mesh asset {}: {}",
-                file_path.string(),
+                asset().id(),
                 error.what());
   }
 }
 
+void SkinnedMeshAssetHandle::create()
+{
+  if (!skinned_mesh_description_)
+  {
+    return;
+  }
+  // shared with the upload tasks until the upload is done
+  const std::shared_ptr<SkinnedMeshDescription> skinned_mesh_desc{
+      std::move(skinned_mesh_description_)};
+
+  const auto asset_cache  = Engine::instance()->asset_cache();
+  const auto upload_queue = Engine::instance()->gpu_upload_queue();
+
+  const auto vertex_format = skinned_mesh_desc->vertex_format_;
+  const auto vertex_size   = skinned_vertex_size(vertex_format);
+
+  std::size_t                                  buffers_size{0};
+  std::vector<std::unique_ptr<SkinnedSubMesh>> sub_meshes;
+  for (const auto &sub_mesh : skinned_mesh_desc->sub_meshes_)
+  {
+    const auto material = std::dynamic_pointer_cast<MaterialAssetHandle>(
+        asset_cache->load_asset(Asset{sub_mesh.material_name_}));
+
+    const auto index_buffer =
+        std::make_shared<GlIndexBuffer>(sub_mesh.indices_.size());
+    upload_queue->push(make_buffer_upload_task(
+        index_buffer->id(),
+        sub_mesh.indices_.data(),
+        sub_mesh.indices_.size() * sizeof(std::uint32_t)));
+
+    const void *vertices       = sub_mesh.vertices_.data();
+    auto        vertices_count = sub_mesh.vertices_.size();
+    if (vertex_format == VertexFormat::Packed)
+    {
+      vertices       = sub_mesh.packed_vertices_.data();
+      vertices_count = sub_mesh.packed_vertices_.size();
+    }
+    const auto vertices_size = vertices_count * vertex_size;
+    const auto vertex_buffer = std::make_shared<GlVertexBuffer>(
+        vertices_size,
+        skinned_vertex_buffer_layout(vertex_format),
+        0);
+    upload_queue->push(
+        make_buffer_upload_task(vertex_buffer->id(), vertices, vertices_size));
+    buffers_size +=
+        vertices_size + sub_mesh.indices_.size() * sizeof(std::uint32_t);
+
+    auto vertex_array = std::make_unique<GlVertexArray>();
+    vertex_array->add_vertex_buffer(vertex_buffer);
+    vertex_array->set_index_buffer(index_buffer);
+
+    auto mesh = std::make_unique<SkinnedSubMesh>(std::move(vertex_array),
+                                                 material,
+                                                 vertex_format);
+    sub_meshes.push_back(std::move(mesh));
+  }
+
+  auto new_skinned_mesh =
+      std::make_shared<SkinnedMesh>(std::move(skinned_mesh_desc->skeleton_),
+                                    std::move(sub_meshes));
+
+  // skinned mesh becomes ready after all buffers got uploaded
+  const auto self =
+      std::static_pointer_cast<SkinnedMeshAssetHandle>(shared_from_this());
+  upload_queue->push(
+      [self, new_skinned_mesh, skinned_mesh_desc, buffers_size](
+          GpuUploadQueue & /*upload_queue*/)
+      {
+        self->set_memory_usage(0, buffers_size);
+        self->skinned_mesh_ = new_skinned_mesh;
+        return true;
+      });
+}
+
 bool SkinnedMeshAssetHandle::is_ready() const
 {
   return skinned_mesh_ != nullptr;
@@ -75,10 +123,10 @@ std::shared_ptr<SkinnedMesh> SkinnedMeshAssetHandle::get() const
 }
 
 std::shared_ptr<AssetHandle>
-skinned_mesh_asset_loader(const std::filesystem::path &file_path,
-                          const Asset                 &asset)
+skinned_mesh_asset_loader(const std::filesystem::path & /*file_path*/,
+                          const Asset &asset)
 {
-  return std::make_shared<SkinnedMeshAssetHandle>(file_path, asset);
+  return std::make_shared<SkinnedMeshAssetHandle>(asset);
 }
 
 } // namespace dc
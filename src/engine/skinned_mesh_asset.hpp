@@ -7,18 +7,24 @@
 namespace dc
 {
 
+struct SkinnedMeshDescription;
+
 class SkinnedMeshAssetHandle : public AssetHandle
 {
 public:
-  SkinnedMeshAssetHandle(const std::filesystem::path &file_path,
-                         const Asset                 &asset);
+  SkinnedMeshAssetHandle(const Asset &asset);
+  ~SkinnedMeshAssetHandle() override;
 
   bool is_ready() const override;
 
+  void load(const AssetData &asset_data) override;
+  void create() override;
+
   std::shared_ptr<SkinnedMesh> get() const;
 
 private:
-  std::shared_ptr<SkinnedMesh> skinned_mesh_{};
+  std::unique_ptr<SkinnedMeshDescription> skinned_mesh_description_{};
+  std::shared_ptr<SkinnedMesh>            skinned_mesh_{};
 };
 
 std::shared_ptr<AssetHandle>
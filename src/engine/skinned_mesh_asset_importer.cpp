@@ -2,28 +2,29 @@
 #include "assimp/vector3.h"
 #include "defer.hpp"
 #include "engine.hpp"
-#include "image.hpp"
 #include "importer.hpp"
 #include "log.hpp"
 #include "material.hpp"
 #include "math.hpp"
 #include "mesh.hpp"
+#include "mesh_asset_importer.hpp"
+#include "mesh_optimizer.hpp"
 #include "serialization.hpp"
 #include "skeleton.hpp"
 #include "skinned_mesh.hpp"
+#include "util.hpp"
 
 #include <assimp/GltfMaterial.h>
 #include <assimp/Importer.hpp>
 #include <assimp/material.h>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
-#include <stb_image.h>
-#include <stb_image_write.h>
 
 #include <cctype>
 #include <cstdint>
 #include <cstdio>
 #include <filesystem>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
@@ -431,42 +432,18 @@ std::string import_texture(aiMaterial            *ai_material,
                          (import_data.skinned_mesh_name_ + "_" +
                           file_path.stem().string() + ".dctex"));
 
-  if (import_data.textures_.find(imported_file_path.string()) !=
-      import_data.textures_.end())
-  {
-    // texture was already imported
-    return imported_file_path.string();
-  }
+  // normal maps only keep two channels, the shader reconstructs z
+  const auto usage =
+      ai_texture_type == aiTextureType_NORMALS      ? TextureUsage::Normal
+      : ai_texture_type == aiTextureType_BASE_COLOR ? TextureUsage::Albedo
+      : ai_texture_type == aiTextureType_EMISSIVE   ? TextureUsage::Albedo
+                                                    : TextureUsage::Data;
 
-  TextureDescription texture_description{};
   try
   {
-    // load image and make sure it gets saved as png
-    Image                     image{file_path};
-    std::vector<std::uint8_t> png_data;
-    stbi_write_png_to_func(
-        [](void *context, void *data, int size)
-        {
-          const auto png_data = static_cast<std::vector<uint8_t> *>(context);
-          png_data->resize(size);
-          std::memcpy(png_data->data(), data, size);
-        },
-        &png_data,
-        image.width(),
-        image.height(),
-        image.channels_count(),
-        static_cast<const void *>(image.data()),
-        0);
-    texture_description.data_ = std::move(png_data);
-
-    AssetDescription asset_description{};
-    asset_description.original_file_ = normalize_path(file_path).string();
-    texture_description.save(Engine::instance()->base_directory() /
-                                 imported_file_path,
-                             asset_description);
-
-    import_data.textures_[imported_file_path.string()] =
-        std::move(texture_description);
+    return import_data.texture_import_queue_->push(file_path,
+                                                   imported_file_path,
+                                                   usage);
   }
   catch (const std::runtime_error &error)
   {
@@ -603,10 +580,11 @@ std::string import_material(const aiScene         *ai_scene,
   //   material_description.roughness_ = {tmp, tmp, tmp, tmp};
   // }
 
-  AssetDescription asset_description{};
   material_description.save(Engine::instance()->base_directory() /
                                 material_import_file_path,
-                            asset_description);
+                            import_data.asset_description_);
+  import_data.manifest_->add_output(material_import_file_path,
+                                    import_data.asset_description_);
 
   return material_import_file_path.string();
 }
@@ -774,24 +752,16 @@ void do_import_skinned_mesh(const aiScene         *ai_scene,
     indices.push_back(ai_face.mIndices[2]);
   }
 
-  auto material = import_material(ai_scene, ai_mesh, import_data);
-
-  auto vertex_array = std::make_unique<GlVertexArray>();
+  // Reorder for the post transform cache, overdraw and vertex fetch
+  const auto statistics = optimize_mesh(vertices, indices);
+  DC_LOG_INFO("Optimized mesh {}: ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}",
+              mesh_name,
+              statistics.before_.acmr_,
+              statistics.after_.acmr_,
+              statistics.before_.atvr_,
+              statistics.after_.atvr_);
 
-  GlVertexBufferLayout layout;
-  layout.push_float(3); // position
-  layout.push_float(3); // normal
-  layout.push_float(3); // tangent
-  layout.push_float(3); // bitanget
-  layout.push_int(4);   // bones
-  layout.push_float(4); // bone weights
-  layout.push_float(2); // tex coords
-  auto vertex_buffer = std::make_shared<GlVertexBuffer>(vertices, layout);
-
-  auto index_buffer = std::make_shared<GlIndexBuffer>(indices);
-
-  vertex_array->add_vertex_buffer(vertex_buffer);
-  vertex_array->set_index_buffer(index_buffer);
+  auto material = import_material(ai_scene, ai_mesh, import_data);
 
   SkinnedSubMeshDescription skinned_sub_mesh_description{};
   skinned_sub_mesh_description.indices_       = std::move(indices);
@@ -870,36 +840,60 @@ void import_skinned_mesh(const aiScene         *ai_scene,
                            import_data);
 
   // save imported data
-  AssetDescription asset_description{};
-  const auto       mesh_file_path =
+  const auto mesh_file_path =
       sanitize_file_path(std::filesystem::path{"meshes"} /
                          (import_data.skinned_mesh_name_ + ".dcskinmesh"));
   import_data.skinned_mesh_.save(Engine::instance()->base_directory() /
                                      mesh_file_path,
-                                 asset_description);
+                                 import_data.asset_description_);
+  import_data.manifest_->add_output(mesh_file_path,
+                                    import_data.asset_description_);
+}
+
+std::uint64_t skinned_mesh_import_settings_hash(VertexFormat vertex_format)
+{
+  auto hash = hash_bytes(&vertex_format, sizeof(vertex_format));
+
+  const auto compression_codec = asset_compression_codec();
+  hash = hash_bytes(&compression_codec, sizeof(compression_codec), hash);
+
+  const auto texture_settings_hash = texture_import_settings_hash();
+  return hash_bytes(&texture_settings_hash,
+                    sizeof(texture_settings_hash),
+                    hash);
 }
 
-void import_skinned_mesh_asset(const std::filesystem::path &file_path,
-                               const std::string           &name)
+bool import_skinned_mesh_asset(const std::filesystem::path &file_path,
+                               const std::string           &name,
+                               VertexFormat                 vertex_format,
+                               bool                         is_forced)
 {
+  const auto mesh_file_path = sanitize_file_path(
+      std::filesystem::path{"meshes"} / (name + ".dcskinmesh"));
+  const auto manifest_file_path = import_manifest_file_path(mesh_file_path);
+  const auto settings_hash = skinned_mesh_import_settings_hash(vertex_format);
+  if (!is_forced && is_import_up_to_date(manifest_file_path,
+                                         skinned_mesh_importer_version,
+                                         settings_hash))
+  {
+    DC_LOG_INFO("Skinned mesh {} is up to date", name);
+    return false;
+  }
+
   DC_LOG_DEBUG("Import skinned mesh from file {}", file_path.string());
 
+  const auto       manifest = std::make_shared<ImportManifest>();
   Assimp::Importer importer;
-  const auto       ai_scene = importer.ReadFile(
-      file_path.string().c_str(),
+  const auto       ai_scene = read_model(
+      importer,
+      file_path,
       aiProcess_JoinIdenticalVertices | aiProcess_Triangulate |
           aiProcess_GenSmoothNormals | aiProcess_LimitBoneWeights |
-          aiProcess_ImproveCacheLocality | aiProcess_GenUVCoords |
-          aiProcess_RemoveRedundantMaterials | aiProcess_FindDegenerates |
-          aiProcess_FindInvalidData | aiProcess_FindInstances |
-          aiProcess_OptimizeMeshes | aiProcess_CalcTangentSpace);
-
-  if (!ai_scene || ai_scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE ||
-      !ai_scene->mRootNode)
-  {
-    throw std::runtime_error(std::string("Assimp could not load model: ") +
-                             importer.GetErrorString());
-  }
+          aiProcess_GenUVCoords | aiProcess_RemoveRedundantMaterials |
+          aiProcess_FindDegenerates | aiProcess_FindInvalidData |
+          aiProcess_FindInstances | aiProcess_OptimizeMeshes |
+          aiProcess_CalcTangentSpace,
+      *manifest);
 
   // create neeeded directories
   // TODO: Don't hardcode paths
@@ -907,11 +901,30 @@ void import_skinned_mesh_asset(const std::filesystem::path &file_path,
   std::filesystem::create_directories(base_directory / "textures");
   std::filesystem::create_directories(base_directory / "materials");
   std::filesystem::create_directories(base_directory / "meshes");
+  std::filesystem::create_directories(manifest_file_path.parent_path());
 
   SkinnedMeshImportData import_data{};
-  import_data.skinned_mesh_name_ = name;
-  import_data.base_path_         = file_path.parent_path();
+  import_data.skinned_mesh_name_           = name;
+  import_data.base_path_                   = file_path.parent_path();
+  import_data.skinned_mesh_.vertex_format_ = vertex_format;
+  import_data.manifest_                    = manifest;
+
+  auto &asset_description              = import_data.asset_description_;
+  asset_description.original_file_     = normalize_path(file_path).string();
+  asset_description.source_hash_       = manifest->source_hash();
+  asset_description.settings_hash_     = settings_hash;
+  asset_description.importer_version_  = skinned_mesh_importer_version;
+  asset_description.compression_codec_ = asset_compression_codec();
+
+  import_data.texture_import_queue_ =
+      std::make_shared<TextureImportQueue>(manifest);
   import_skinned_mesh(ai_scene, import_data);
+  import_data.texture_import_queue_->wait();
+
+  manifest->importer_version_ = skinned_mesh_importer_version;
+  manifest->settings_hash_    = settings_hash;
+  manifest->save(manifest_file_path);
+  return true;
 }
 
 } // namespace dc
@@ -1,23 +1,33 @@
 #pragma once
 
 #include "asset_importer_manager.hpp"
+#include "import_manifest.hpp"
+#include "importer.hpp"
 #include "serialization.hpp"
 
 #include <assimp/scene.h>
 
+#include <cstdint>
+#include <memory>
 #include <set>
 
 namespace dc
 {
 
+/// Increment if imported skinned meshes or materials change
+constexpr std::uint32_t skinned_mesh_importer_version{1};
+
 struct SkinnedMeshImportData
 {
   std::filesystem::path base_path_;
   std::string           skinned_mesh_name_;
+  // build info of all outputs except textures
+  AssetDescription asset_description_;
 
-  SkinnedMeshDescription                              skinned_mesh_;
-  std::set<std::string>                               materials_;
-  std::unordered_map<std::string, TextureDescription> textures_;
+  SkinnedMeshDescription              skinned_mesh_;
+  std::set<std::string>               materials_;
+  std::shared_ptr<ImportManifest>     manifest_;
+  std::shared_ptr<TextureImportQueue> texture_import_queue_;
 };
 
 void do_import_skinned_mesh(const aiScene         *ai_scene,
@@ -25,7 +35,17 @@ void do_import_skinned_mesh(const aiScene         *ai_scene,
                             aiMatrix4x4           &transform,
                             SkinnedMeshImportData &import_data);
 
-void import_skinned_mesh_asset(const std::filesystem::path &file_path,
-                               const std::string           &name);
+std::uint64_t skinned_mesh_import_settings_hash(VertexFormat vertex_format);
+
+/**
+ * Imports the skinned mesh with its skeleton, animations, materials and
+ * textures. Returns false if the import got skipped because the last import
+ * of the file is up to date. Forcing the import never skips.
+ */
+bool import_skinned_mesh_asset(
+    const std::filesystem::path &file_path,
+    const std::string           &name,
+    VertexFormat                 vertex_format = VertexFormat::Float,
+    bool                         is_forced     = false);
 
 } // namespace dc
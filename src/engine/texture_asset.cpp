@@ -1,85 +1,294 @@
 #include "texture_asset.hpp"
 #include "asset.hpp"
 #include "asset_handle.hpp"
-#include "defer.hpp"
+#include "binary_reader.hpp"
+#include "engine.hpp"
 #include "gl_texture.hpp"
+#include "gpu_upload_queue.hpp"
 #include "log.hpp"
+#include "math.hpp"
 #include "serialization.hpp"
 #include "stb_image.h"
+#include "texture_compression.hpp"
+
+#include <algorithm>
 #include <filesystem>
 #include <stdexcept>
 
+namespace
+{
+
+GLenum to_gl_sized_format(dc::TextureFormat format)
+{
+  switch (format)
+  {
+  case dc::TextureFormat::Rgba8:
+    return GL_RGBA8;
+  case dc::TextureFormat::Bc1:
+    return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+  case dc::TextureFormat::Bc3:
+    return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+  case dc::TextureFormat::Bc5:
+    return GL_COMPRESSED_RG_RGTC2;
+  case dc::TextureFormat::Bc7:
+    return GL_COMPRESSED_RGBA_BPTC_UNORM;
+  }
+  throw std::runtime_error("Unknown texture format");
+}
+
+} // namespace
+
 namespace dc
 {
 
-TextureAssetHandle::TextureAssetHandle(const std::filesystem::path &file_path,
-                                       const Asset                 &asset)
-    : AssetHandle(asset)
+TextureAssetHandle::TextureAssetHandle(const Asset &asset)
+    : AssetHandle(asset),
+      pixels_{nullptr, stbi_image_free}
+{
+}
+
+TextureAssetHandle::~TextureAssetHandle() = default;
+
+void TextureAssetHandle::load(const AssetData &asset_data)
 {
   try
   {
-    TextureDescription texture_description{};
-    texture_description.read(file_path);
-
-    int        width{};
-    int        height{};
-    int        channels_count{};
-    const auto loaded_data =
-        stbi_load_from_memory(texture_description.data_.data(),
-                              texture_description.data_.size(),
+    auto         texture_description = std::make_unique<TextureDescription>();
+    BinaryReader reader{asset_data.data_, asset_data.size_};
+    texture_description->read(reader);
+
+    if (!texture_description->levels_.empty())
+    {
+      auto width  = texture_description->width_;
+      auto height = texture_description->height_;
+      // would only fail later in the texture storage allocation
+      if (width <= 0 || height <= 0)
+      {
+        throw std::runtime_error("Texture has no size");
+      }
+      if (texture_description->levels_.size() >
+          static_cast<std::size_t>(math::calc_mipmap_levels_2d(width, height)))
+      {
+        throw std::runtime_error("Texture has more levels than its size");
+      }
+      for (const auto &level : texture_description->levels_)
+      {
+        if (level.size() !=
+            texture_level_size(texture_description->format_, width, height))
+        {
+          throw std::runtime_error("Level size does not match");
+        }
+        width  = std::max(width / 2, 1);
+        height = std::max(height / 2, 1);
+      }
+      texture_description_ = std::move(texture_description);
+      return;
+    }
+
+    int  width{};
+    int  height{};
+    int  channels_count{};
+    auto loaded_data =
+        stbi_load_from_memory(texture_description->data_.data(),
+                              texture_description->data_.size(),
                               &width,
                               &height,
                               &channels_count,
                               0);
     if (!loaded_data)
     {
-      throw std::runtime_error("Could not load texture " + file_path.string());
-    }
-    defer(stbi_image_free(loaded_data));
-
-    GlTextureConfig config{};
-    config.data_   = loaded_data;
-    config.width_  = width;
-    config.height_ = height;
-
-    if (channels_count == 1)
-    {
-      config.format_       = GL_RED;
-      config.sized_format_ = GL_R8;
+      throw std::runtime_error("Could not load texture " + asset().id());
     }
-    else if (channels_count == 3)
-    {
-      config.format_       = GL_RGB;
-      config.sized_format_ = GL_RGB8;
-    }
-    else if (channels_count == 4)
-    {
-      config.format_       = GL_RGBA;
-      config.sized_format_ = GL_RGBA8;
-    }
-    else
+    if (channels_count != 1 && channels_count != 3 && channels_count != 4)
     {
+      stbi_image_free(loaded_data);
       throw std::runtime_error(fmt::format("Can not handle {} channels in {}",
                                            channels_count,
-                                           file_path.string()));
+                                           asset().id()));
     }
 
-    texture_ = std::make_shared<GlTexture>(config);
+    pixels_.reset(loaded_data);
+    width_          = width;
+    height_         = height;
+    channels_count_ = channels_count;
   }
   catch (const std::runtime_error &error)
   {
     DC_LOG_WARN("Could not load texture asset {}: {}",
-                file_path.string(),
+                asset().id(),
                 error.what());
   }
 }
 
+void TextureAssetHandle::create()
+{
+  if (texture_description_)
+  {
+    create_from_levels();
+    return;
+  }
+  if (!pixels_)
+  {
+    return;
+  }
+
+  GlTextureConfig config{};
+  config.data_   = nullptr;
+  config.width_  = width_;
+  config.height_ = height_;
+
+  if (channels_count_ == 1)
+  {
+    config.format_       = GL_RED;
+    config.sized_format_ = GL_R8;
+  }
+  else if (channels_count_ == 3)
+  {
+    config.format_       = GL_RGB;
+    config.sized_format_ = GL_RGB8;
+  }
+  else
+  {
+    config.format_       = GL_RGBA;
+    config.sized_format_ = GL_RGBA8;
+  }
+
+  const auto new_texture = std::make_shared<GlTexture>(config);
+
+  // shared with the upload task until the upload is done
+  const std::shared_ptr<std::uint8_t> pixels{pixels_.release(),
+                                             stbi_image_free};
+  const auto row_size = static_cast<std::size_t>(width_) * channels_count_;
+  const auto self =
+      std::static_pointer_cast<TextureAssetHandle>(shared_from_this());
+
+  Engine::instance()->gpu_upload_queue()->push(
+      [self,
+       new_texture,
+       pixels,
+       row_size,
+       format    = config.format_,
+       first_row = GLint{0}](GpuUploadQueue &upload_queue) mutable
+      {
+        const auto height = new_texture->height();
+        first_row += upload_queue.upload_texture_rows(
+            new_texture->id(),
+            0,
+            new_texture->width(),
+            first_row,
+            height - first_row,
+            format,
+            GL_UNSIGNED_BYTE,
+            row_size,
+            pixels.get() + first_row * row_size);
+        if (first_row < height)
+        {
+          return false;
+        }
+
+        // texture becomes ready after all rows got uploaded
+        new_texture->generate_mipmaps();
+        // the mip chain adds about a third
+        self->set_memory_usage(0, row_size * height * 4 / 3);
+        self->texture_ = new_texture;
+        return true;
+      });
+}
+
+void TextureAssetHandle::create_from_levels()
+{
+  // shared with the upload task until the upload is done
+  const std::shared_ptr<TextureDescription> texture_description{
+      std::move(texture_description_)};
+
+  GlTextureConfig config{};
+  config.data_             = nullptr;
+  config.width_            = texture_description->width_;
+  config.height_           = texture_description->height_;
+  config.sized_format_     = to_gl_sized_format(texture_description->format_);
+  config.format_           = GL_RGBA;
+  config.generate_mipmaps_ = false;
+  config.mipmap_levels_ =
+      static_cast<GLuint>(texture_description->levels_.size());
+
+  const auto new_texture = std::make_shared<GlTexture>(config);
+  const auto self =
+      std::static_pointer_cast<TextureAssetHandle>(shared_from_this());
+
+  Engine::instance()->gpu_upload_queue()->push(
+      [self,
+       new_texture,
+       texture_description,
+       level     = std::size_t{0},
+       first_row = GLint{0}](GpuUploadQueue &upload_queue) mutable
+      {
+        const auto format = texture_description->format_;
+        const auto &levels = texture_description->levels_;
+        for (; level < levels.size(); ++level, first_row = 0)
+        {
+          const auto width =
+              std::max(texture_description->width_ >> level, 1);
+          const auto height =
+              std::max(texture_description->height_ >> level, 1);
+
+          // rows of 4x4 blocks for compressed formats, else rows of pixels
+          const auto is_compressed = is_texture_format_compressed(format);
+          const auto rows_count  = is_compressed ? (height + 3) / 4 : height;
+          const auto row_size    = levels[level].size() / rows_count;
+          const auto rows        = levels[level].data() + first_row * row_size;
+
+          if (is_compressed)
+          {
+            first_row += upload_queue.upload_compressed_texture_rows(
+                new_texture->id(),
+                static_cast<GLint>(level),
+                width,
+                height,
+                first_row,
+                rows_count - first_row,
+                new_texture->sized_format(),
+                row_size,
+                rows);
+          }
+          else
+          {
+            first_row +=
+                upload_queue.upload_texture_rows(new_texture->id(),
+                                                 static_cast<GLint>(level),
+                                                 width,
+                                                 first_row,
+                                                 rows_count - first_row,
+                                                 GL_RGBA,
+                                                 GL_UNSIGNED_BYTE,
+                                                 row_size,
+                                                 rows);
+          }
+
+          if (first_row < rows_count)
+          {
+            // staging memory of this frame is used up
+            return false;
+          }
+        }
+
+        std::size_t gpu_size{0};
+        for (const auto &level_data : levels)
+        {
+          gpu_size += level_data.size();
+        }
+        self->set_memory_usage(0, gpu_size);
+        self->texture_ = new_texture;
+        return true;
+      });
+}
+
 bool TextureAssetHandle::is_ready() const { return texture_ != nullptr; }
 
 std::shared_ptr<AssetHandle>
-texture_asset_loader(const std::filesystem::path &file_path, const Asset &asset)
+texture_asset_loader(const std::filesystem::path & /*file_path*/,
+                     const Asset &asset)
 {
-  return std::make_shared<TextureAssetHandle>(file_path, asset);
+  return std::make_shared<TextureAssetHandle>(asset);
 }
 
 std::shared_ptr<GlTexture> TextureAssetHandle::get() const { return texture_; }
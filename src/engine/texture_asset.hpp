@@ -4,24 +4,42 @@
 #include "asset_handle.hpp"
 #include "gl_texture.hpp"
 
+#include <cstdint>
 #include <filesystem>
 #include <memory>
 
 namespace dc
 {
 
+struct TextureDescription;
+
 class TextureAssetHandle : public AssetHandle
 {
 public:
-  TextureAssetHandle(const std::filesystem::path &file_path,
-                     const Asset                 &asset);
+  TextureAssetHandle(const Asset &asset);
+  ~TextureAssetHandle() override;
 
   bool is_ready() const override;
 
+  void load(const AssetData &asset_data) override;
+  void create() override;
+
   std::shared_ptr<GlTexture> get() const;
 
 private:
+  // GPU ready levels, only valid between load() and create()
+  std::unique_ptr<TextureDescription> texture_description_;
+
+  // decoded pixels of textures that store an image file, only valid between
+  // load() and create()
+  std::unique_ptr<std::uint8_t, void (*)(void *)> pixels_;
+  int                                             width_{};
+  int                                             height_{};
+  int                                             channels_count_{};
+
   std::shared_ptr<GlTexture> texture_{};
+
+  void create_from_levels();
 };
 
 std::shared_ptr<AssetHandle>
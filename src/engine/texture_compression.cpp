@@ -0,0 +1,553 @@
+#include "texture_compression.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+
+using namespace dc;
+
+constexpr int block_pixels_count = 16;
+
+/**
+ * Finds the axis along which the colors vary the most and returns the two
+ * extreme colors on that axis. Only the first channels_count channels of the
+ * pixels get considered.
+ */
+template <int channels_count>
+void find_endpoints(const std::uint8_t                      *block,
+                    std::array<float, channels_count>       &endpoint0,
+                    std::array<float, channels_count>       &endpoint1)
+{
+  std::array<float, channels_count> mean{};
+  for (int i = 0; i < block_pixels_count; ++i)
+  {
+    for (int c = 0; c < channels_count; ++c)
+    {
+      mean[c] += block[i * 4 + c];
+    }
+  }
+  for (auto &value : mean)
+  {
+    value /= block_pixels_count;
+  }
+
+  std::array<std::array<float, channels_count>, channels_count> covariance{};
+  for (int i = 0; i < block_pixels_count; ++i)
+  {
+    for (int r = 0; r < channels_count; ++r)
+    {
+      const auto dr = block[i * 4 + r] - mean[r];
+      for (int c = 0; c < channels_count; ++c)
+      {
+        covariance[r][c] += dr * (block[i * 4 + c] - mean[c]);
+      }
+    }
+  }
+
+  // the power iteration starts at the channel that varies the most. A fixed
+  // start could be orthogonal to the principal axis, e.g. (1, 1, 1) for two
+  // colors whose difference sums up to zero, and would never leave it
+  int max_channel{0};
+  for (int c = 1; c < channels_count; ++c)
+  {
+    if (covariance[c][c] > covariance[max_channel][max_channel])
+    {
+      max_channel = c;
+    }
+  }
+  if (covariance[max_channel][max_channel] <
+      std::numeric_limits<float>::epsilon())
+  {
+    // all pixels have the same color
+    endpoint0 = mean;
+    endpoint1 = mean;
+    return;
+  }
+
+  // power iteration converges to the principal axis
+  auto axis = covariance[max_channel];
+  for (int iteration = 0; iteration < 8; ++iteration)
+  {
+    std::array<float, channels_count> next_axis{};
+    for (int r = 0; r < channels_count; ++r)
+    {
+      for (int c = 0; c < channels_count; ++c)
+      {
+        next_axis[r] += covariance[r][c] * axis[c];
+      }
+    }
+    float length{0.0f};
+    for (const auto value : next_axis)
+    {
+      length = std::max(length, std::abs(value));
+    }
+    if (length < std::numeric_limits<float>::epsilon())
+    {
+      break;
+    }
+    for (int c = 0; c < channels_count; ++c)
+    {
+      axis[c] = next_axis[c] / length;
+    }
+  }
+
+  float axis_length{0.0f};
+  for (const auto value : axis)
+  {
+    axis_length += value * value;
+  }
+
+  float min_t{0.0f};
+  float max_t{0.0f};
+  for (int i = 0; i < block_pixels_count; ++i)
+  {
+    float t{0.0f};
+    for (int c = 0; c < channels_count; ++c)
+    {
+      t += (block[i * 4 + c] - mean[c]) * axis[c];
+    }
+    t /= axis_length;
+    min_t = std::min(min_t, t);
+    max_t = std::max(max_t, t);
+  }
+
+  // move the endpoints a bit inwards, which reduces the average error
+  const auto inset = (max_t - min_t) / 16.0f;
+  min_t += inset;
+  max_t -= inset;
+
+  for (int c = 0; c < channels_count; ++c)
+  {
+    endpoint0[c] = std::clamp(mean[c] + max_t * axis[c], 0.0f, 255.0f);
+    endpoint1[c] = std::clamp(mean[c] + min_t * axis[c], 0.0f, 255.0f);
+  }
+}
+
+std::uint16_t to_rgb565(const std::array<float, 3> &color)
+{
+  const auto r = static_cast<std::uint16_t>(std::lround(color[0] * 31 / 255));
+  const auto g = static_cast<std::uint16_t>(std::lround(color[1] * 63 / 255));
+  const auto b = static_cast<std::uint16_t>(std::lround(color[2] * 31 / 255));
+  return static_cast<std::uint16_t>((r << 11) | (g << 5) | b);
+}
+
+std::array<int, 3> from_rgb565(std::uint16_t color)
+{
+  const auto r = (color >> 11) & 31;
+  const auto g = (color >> 5) & 63;
+  const auto b = color & 31;
+  return {(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)};
+}
+
+void write_uint16(std::uint8_t *output, std::uint16_t value)
+{
+  output[0] = static_cast<std::uint8_t>(value & 0xff);
+  output[1] = static_cast<std::uint8_t>(value >> 8);
+}
+
+/// Compresses a single channel of the block into 8 bytes
+void compress_bc4_block(const std::uint8_t *block,
+                        int                 channel,
+                        std::uint8_t       *output)
+{
+  int min_value{255};
+  int max_value{0};
+  for (int i = 0; i < block_pixels_count; ++i)
+  {
+    min_value = std::min<int>(min_value, block[i * 4 + channel]);
+    max_value = std::max<int>(max_value, block[i * 4 + channel]);
+  }
+
+  output[0] = static_cast<std::uint8_t>(max_value);
+  output[1] = static_cast<std::uint8_t>(min_value);
+
+  // max > min selects the mode with six interpolated values
+  std::array<int, 8> palette{max_value, min_value};
+  for (int i = 1; i < 7; ++i)
+  {
+    palette[i + 1] = ((7 - i) * max_value + i * min_value) / 7;
+  }
+
+  std::uint64_t indices{0};
+  if (max_value != min_value)
+  {
+    for (int i = 0; i < block_pixels_count; ++i)
+    {
+      const int value = block[i * 4 + channel];
+      int       best_index{0};
+      int       best_error{std::numeric_limits<int>::max()};
+      for (int p = 0; p < 8; ++p)
+      {
+        const auto error = std::abs(palette[p] - value);
+        if (error < best_error)
+        {
+          best_error = error;
+          best_index = p;
+        }
+      }
+      indices |= static_cast<std::uint64_t>(best_index) << (i * 3);
+    }
+  }
+
+  for (int i = 0; i < 6; ++i)
+  {
+    output[2 + i] = static_cast<std::uint8_t>((indices >> (i * 8)) & 0xff);
+  }
+}
+
+/// Writes bits starting with the least significant one
+class BitWriter
+{
+public:
+  explicit BitWriter(std::uint8_t *output) : output_{output}
+  {
+    std::memset(output_, 0, 16);
+  }
+
+  void write(std::uint32_t value, int bits_count)
+  {
+    for (int i = 0; i < bits_count; ++i, ++position_)
+    {
+      if ((value >> i) & 1)
+      {
+        output_[position_ / 8] |=
+            static_cast<std::uint8_t>(1 << (position_ % 8));
+      }
+    }
+  }
+
+private:
+  std::uint8_t *output_;
+  int           position_{0};
+};
+
+/**
+ * Quantizes an endpoint to 7 bits per channel plus a shared p-bit, which
+ * gets picked to minimize the error.
+ */
+void quantize_bc7_mode6_endpoint(const std::array<float, 4> &endpoint,
+                                 std::array<int, 4>         &quantized,
+                                 int                        &p_bit)
+{
+  float best_error{std::numeric_limits<float>::max()};
+  for (int p = 0; p < 2; ++p)
+  {
+    std::array<int, 4> candidate{};
+    float              error{0.0f};
+    for (int c = 0; c < 4; ++c)
+    {
+      candidate[c] =
+          std::clamp(static_cast<int>(std::lround((endpoint[c] - p) / 2.0f)),
+                     0,
+                     127);
+      const auto diff = static_cast<float>((candidate[c] << 1) | p) -
+                        endpoint[c];
+      error += diff * diff;
+    }
+    if (error < best_error)
+    {
+      best_error = error;
+      quantized  = candidate;
+      p_bit      = p;
+    }
+  }
+}
+
+} // namespace
+
+namespace dc
+{
+
+std::size_t texture_block_size(TextureFormat format)
+{
+  switch (format)
+  {
+  case TextureFormat::Rgba8:
+    return 4;
+  case TextureFormat::Bc1:
+    return 8;
+  case TextureFormat::Bc3:
+  case TextureFormat::Bc5:
+  case TextureFormat::Bc7:
+    return 16;
+  }
+  return 0;
+}
+
+bool is_texture_format_compressed(TextureFormat format)
+{
+  return format != TextureFormat::Rgba8;
+}
+
+std::size_t texture_level_size(TextureFormat format, int width, int height)
+{
+  if (!is_texture_format_compressed(format))
+  {
+    return static_cast<std::size_t>(width) * height *
+           texture_block_size(format);
+  }
+  const auto blocks_x = static_cast<std::size_t>((width + 3) / 4);
+  const auto blocks_y = static_cast<std::size_t>((height + 3) / 4);
+  return blocks_x * blocks_y * texture_block_size(format);
+}
+
+void compress_bc1_block(const std::uint8_t *block, std::uint8_t *output)
+{
+  std::array<float, 3> endpoint0{};
+  std::array<float, 3> endpoint1{};
+  find_endpoints<3>(block, endpoint0, endpoint1);
+
+  auto color0 = to_rgb565(endpoint0);
+  auto color1 = to_rgb565(endpoint1);
+  // color0 > color1 selects the four color mode
+  if (color0 < color1)
+  {
+    std::swap(color0, color1);
+  }
+
+  write_uint16(output, color0);
+  write_uint16(output + 2, color1);
+
+  std::uint32_t indices{0};
+  if (color0 != color1)
+  {
+    const auto c0 = from_rgb565(color0);
+    const auto c1 = from_rgb565(color1);
+
+    std::array<std::array<int, 3>, 4> palette{c0, c1};
+    for (int c = 0; c < 3; ++c)
+    {
+      palette[2][c] = (2 * c0[c] + c1[c]) / 3;
+      palette[3][c] = (c0[c] + 2 * c1[c]) / 3;
+    }
+
+    for (int i = 0; i < block_pixels_count; ++i)
+    {
+      int best_index{0};
+      int best_error{std::numeric_limits<int>::max()};
+      for (int p = 0; p < 4; ++p)
+      {
+        int error{0};
+        for (int c = 0; c < 3; ++c)
+        {
+          const auto diff = palette[p][c] - block[i * 4 + c];
+          error += diff * diff;
+        }
+        if (error < best_error)
+        {
+          best_error = error;
+          best_index = p;
+        }
+      }
+      indices |= static_cast<std::uint32_t>(best_index) << (i * 2);
+    }
+  }
+
+  for (int i = 0; i < 4; ++i)
+  {
+    output[4 + i] = static_cast<std::uint8_t>((indices >> (i * 8)) & 0xff);
+  }
+}
+
+void compress_bc3_block(const std::uint8_t *block, std::uint8_t *output)
+{
+  compress_bc4_block(block, 3, output);
+  compress_bc1_block(block, output + 8);
+}
+
+void compress_bc5_block(const std::uint8_t *block, std::uint8_t *output)
+{
+  compress_bc4_block(block, 0, output);
+  compress_bc4_block(block, 1, output + 8);
+}
+
+void compress_bc7_block(const std::uint8_t *block, std::uint8_t *output)
+{
+  // mode 6: one subset, 7 bit rgba endpoints with p-bits, 4 bit indices
+  static constexpr std::array<int, 16> weights{
+      0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+  std::array<float, 4> endpoint0{};
+  std::array<float, 4> endpoint1{};
+  find_endpoints<4>(block, endpoint0, endpoint1);
+
+  std::array<std::array<int, 4>, 2> quantized{};
+  std::array<int, 2>                p_bits{};
+  quantize_bc7_mode6_endpoint(endpoint0, quantized[0], p_bits[0]);
+  quantize_bc7_mode6_endpoint(endpoint1, quantized[1], p_bits[1]);
+
+  std::array<std::array<int, 4>, 16> palette{};
+  for (int c = 0; c < 4; ++c)
+  {
+    const auto e0 = (quantized[0][c] << 1) | p_bits[0];
+    const auto e1 = (quantized[1][c] << 1) | p_bits[1];
+    for (int p = 0; p < 16; ++p)
+    {
+      palette[p][c] = ((64 - weights[p]) * e0 + weights[p] * e1 + 32) >> 6;
+    }
+  }
+
+  std::array<int, block_pixels_count> indices{};
+  for (int i = 0; i < block_pixels_count; ++i)
+  {
+    int best_error{std::numeric_limits<int>::max()};
+    for (int p = 0; p < 16; ++p)
+    {
+      int error{0};
+      for (int c = 0; c < 4; ++c)
+      {
+        const auto diff = palette[p][c] - block[i * 4 + c];
+        error += diff * diff;
+      }
+      if (error < best_error)
+      {
+        best_error = error;
+        indices[i] = p;
+      }
+    }
+  }
+
+  // the most significant bit of the first index is implicitly zero
+  if (indices[0] >= 8)
+  {
+    std::swap(quantized[0], quantized[1]);
+    std::swap(p_bits[0], p_bits[1]);
+    for (auto &index : indices)
+    {
+      index = 15 - index;
+    }
+  }
+
+  BitWriter writer{output};
+  writer.write(1 << 6, 7);
+  for (int c = 0; c < 4; ++c)
+  {
+    writer.write(quantized[0][c], 7);
+    writer.write(quantized[1][c], 7);
+  }
+  writer.write(p_bits[0], 1);
+  writer.write(p_bits[1], 1);
+  writer.write(indices[0], 3);
+  for (int i = 1; i < block_pixels_count; ++i)
+  {
+    writer.write(indices[i], 4);
+  }
+}
+
+std::vector<std::uint8_t> compress_texture_level(const std::uint8_t *pixels,
+                                                 int                 width,
+                                                 int                 height,
+                                                 TextureFormat       format)
+{
+  if (!is_texture_format_compressed(format))
+  {
+    return {pixels, pixels + texture_level_size(format, width, height)};
+  }
+
+  const auto block_size = texture_block_size(format);
+  std::vector<std::uint8_t> output(texture_level_size(format, width, height));
+
+  auto output_block = output.data();
+  for (int block_y = 0; block_y < height; block_y += 4)
+  {
+    for (int block_x = 0; block_x < width; block_x += 4)
+    {
+      // pad blocks at the border by repeating the last row and column
+      std::array<std::uint8_t, block_pixels_count * 4> block{};
+      for (int y = 0; y < 4; ++y)
+      {
+        for (int x = 0; x < 4; ++x)
+        {
+          const auto pixel_x = std::min(block_x + x, width - 1);
+          const auto pixel_y = std::min(block_y + y, height - 1);
+          std::memcpy(block.data() + (y * 4 + x) * 4,
+                      pixels + (static_cast<std::size_t>(pixel_y) * width +
+                                pixel_x) *
+                                   4,
+                      4);
+        }
+      }
+
+      switch (format)
+      {
+      case TextureFormat::Bc1:
+        compress_bc1_block(block.data(), output_block);
+        break;
+      case TextureFormat::Bc3:
+        compress_bc3_block(block.data(), output_block);
+        break;
+      case TextureFormat::Bc5:
+        compress_bc5_block(block.data(), output_block);
+        break;
+      case TextureFormat::Bc7:
+        compress_bc7_block(block.data(), output_block);
+        break;
+      case TextureFormat::Rgba8:
+        break;
+      }
+      output_block += block_size;
+    }
+  }
+
+  return output;
+}
+
+std::vector<std::uint8_t>
+downsample_texture_level(const std::uint8_t *pixels, int width, int height)
+{
+  const auto next_width  = std::max(width / 2, 1);
+  const auto next_height = std::max(height / 2, 1);
+
+  std::vector<std::uint8_t> output(static_cast<std::size_t>(next_width) *
+                                   next_height * 4);
+  for (int y = 0; y < next_height; ++y)
+  {
+    const auto y0 = std::min(y * 2, height - 1);
+    const auto y1 = std::min(y * 2 + 1, height - 1);
+    for (int x = 0; x < next_width; ++x)
+    {
+      const auto x0 = std::min(x * 2, width - 1);
+      const auto x1 = std::min(x * 2 + 1, width - 1);
+      for (int c = 0; c < 4; ++c)
+      {
+        const auto sum = pixels[(y0 * width + x0) * 4 + c] +
+                         pixels[(y0 * width + x1) * 4 + c] +
+                         pixels[(y1 * width + x0) * 4 + c] +
+                         pixels[(y1 * width + x1) * 4 + c];
+        output[(y * next_width + x) * 4 + c] =
+            static_cast<std::uint8_t>((sum + 2) / 4);
+      }
+    }
+  }
+
+  return output;
+}
+
+std::vector<std::vector<std::uint8_t>> encode_texture_levels(
+    const std::uint8_t *pixels, int width, int height, TextureFormat format)
+{
+  std::vector<std::vector<std::uint8_t>> levels;
+  levels.push_back(compress_texture_level(pixels, width, height, format));
+
+  std::vector<std::uint8_t> level_pixels;
+  while (width > 1 || height > 1)
+  {
+    level_pixels = downsample_texture_level(
+        level_pixels.empty() ? pixels : level_pixels.data(),
+        width,
+        height);
+    width  = std::max(width / 2, 1);
+    height = std::max(height / 2, 1);
+    levels.push_back(
+        compress_texture_level(level_pixels.data(), width, height, format));
+  }
+
+  return levels;
+}
+
+} // namespace dc
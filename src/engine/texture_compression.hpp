@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dc
+{
+
+enum class TextureFormat : std::uint32_t
+{
+  Rgba8,
+  Bc1,
+  Bc3,
+  Bc5,
+  Bc7,
+};
+
+/// Bytes of one level of a texture with the given size
+std::size_t texture_level_size(TextureFormat format, int width, int height);
+
+/// Bytes of a 4x4 block, or of a pixel for uncompressed formats
+std::size_t texture_block_size(TextureFormat format);
+
+bool is_texture_format_compressed(TextureFormat format);
+
+/**
+ * Block encoders. A block are 4x4 RGBA8 pixels in row order. Bc1 and Bc7
+ * blocks use the rgb respectively rgba channels, Bc3 stores alpha in an extra
+ * block, Bc5 only stores the red and green channel.
+ */
+void compress_bc1_block(const std::uint8_t *block, std::uint8_t *output);
+void compress_bc3_block(const std::uint8_t *block, std::uint8_t *output);
+void compress_bc5_block(const std::uint8_t *block, std::uint8_t *output);
+void compress_bc7_block(const std::uint8_t *block, std::uint8_t *output);
+
+/// Compresses a RGBA8 image. Blocks at the border get padded
+std::vector<std::uint8_t> compress_texture_level(const std::uint8_t *pixels,
+                                                 int                 width,
+                                                 int                 height,
+                                                 TextureFormat       format);
+
+/// Halves the size of a RGBA8 image with a box filter
+std::vector<std::uint8_t>
+downsample_texture_level(const std::uint8_t *pixels, int width, int height);
+
+/**
+ * Generates the full mip chain of a RGBA8 image and encodes every level in
+ * the format.
+ */
+std::vector<std::vector<std::uint8_t>> encode_texture_levels(
+    const std::uint8_t *pixels, int width, int height, TextureFormat format);
+
+} // namespace dc
@@ -0,0 +1,87 @@
+#include "thread_pool.hpp"
+#include "log.hpp"
+#include "profiling.hpp"
+
+#include <algorithm>
+#include <exception>
+
+namespace dc
+{
+
+ThreadPool::ThreadPool(std::size_t threads_count, const std::string &name)
+    : name_{name}
+{
+  threads_count = std::max(threads_count, std::size_t{1});
+  threads_.reserve(threads_count);
+  for (std::size_t i{0}; i < threads_count; ++i)
+  {
+    threads_.emplace_back([this]() { worker_loop(); });
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard lock{mutex_};
+    is_stopped_ = true;
+    // pending tasks get dropped. Tasks that are already running get finished
+    tasks_.clear();
+  }
+  condition_.notify_all();
+
+  for (auto &thread : threads_)
+  {
+    thread.join();
+  }
+}
+
+void ThreadPool::submit(ThreadPoolTask task)
+{
+  {
+    std::lock_guard lock{mutex_};
+    if (is_stopped_)
+    {
+      return;
+    }
+    tasks_.push_back(std::move(task));
+  }
+  condition_.notify_one();
+}
+
+std::size_t ThreadPool::threads_count() const { return threads_.size(); }
+
+void ThreadPool::worker_loop()
+{
+  DC_PROFILE_THREAD(name_.c_str());
+
+  while (true)
+  {
+    ThreadPoolTask task;
+    {
+      std::unique_lock lock{mutex_};
+      condition_.wait(lock, [this]() { return is_stopped_ || !tasks_.empty(); });
+      if (is_stopped_)
+      {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+
+    try
+    {
+      task();
+    }
+    // anything escaping would terminate the program
+    catch (const std::exception &error)
+    {
+      DC_LOG_ERROR("Unhandled exception in worker thread: {}", error.what());
+    }
+    catch (...)
+    {
+      DC_LOG_ERROR("Unhandled unknown exception in worker thread");
+    }
+  }
+}
+
+} // namespace dc
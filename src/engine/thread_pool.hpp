@@ -0,0 +1,44 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dc
+{
+
+using ThreadPoolTask = std::function<void()>;
+
+class ThreadPool
+{
+public:
+  ThreadPool(std::size_t threads_count, const std::string &name);
+  ~ThreadPool();
+
+  void submit(ThreadPoolTask task);
+
+  std::size_t threads_count() const;
+
+private:
+  std::string              name_;
+  std::vector<std::thread> threads_;
+
+  std::mutex                 mutex_;
+  std::condition_variable    condition_;
+  std::deque<ThreadPoolTask> tasks_;
+  bool                       is_stopped_{false};
+
+  void worker_loop();
+
+  ThreadPool(const ThreadPool &)            = delete;
+  ThreadPool(ThreadPool &&)                 = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  ThreadPool &operator=(ThreadPool &&)      = delete;
+};
+
+} // namespace dc
@@ -56,10 +56,19 @@ void PerformanceProfiler::set_per_frame_timing(const std::string &name,
   per_frame_data_[name] += time;
 }
 
+void PerformanceProfiler::set_per_frame_counter(const std::string &name,
+                                                std::uint64_t      value)
+{
+  per_frame_counters_[name] = value;
+}
+
 void PerformanceProfiler::clear()
 {
   last_per_frame_data_ = std::move(per_frame_data_);
   per_frame_data_      = {};
+
+  last_per_frame_counters_ = std::move(per_frame_counters_);
+  per_frame_counters_      = {};
 }
 
 void PerformanceProfiler::for_each(
@@ -71,6 +80,16 @@ void PerformanceProfiler::for_each(
   }
 }
 
+void PerformanceProfiler::for_each_counter(
+    const std::function<void(const std::string &name, std::uint64_t value)>
+        process)
+{
+  for (const auto &[name, value] : last_per_frame_counters_)
+  {
+    process(name, value);
+  }
+}
+
 ScopedPerformanceTimer::ScopedPerformanceTimer(const std::string   &name,
                                                PerformanceProfiler &profiler)
     : name_{name},
@@ -38,14 +38,22 @@ class PerformanceProfiler
 {
 public:
   void set_per_frame_timing(const std::string &name, float time);
+  void set_per_frame_counter(const std::string &name, std::uint64_t value);
   void clear();
 
   void for_each(const std::function<void(const std::string &name,
                                          float              time_ms)> process);
 
+  void for_each_counter(
+      const std::function<void(const std::string &name, std::uint64_t value)>
+          process);
+
 private:
   std::unordered_map<std::string, float> per_frame_data_;
   std::unordered_map<std::string, float> last_per_frame_data_;
+
+  std::unordered_map<std::string, std::uint64_t> per_frame_counters_;
+  std::unordered_map<std::string, std::uint64_t> last_per_frame_counters_;
 };
 
 class ScopedPerformanceTimer
@@ -28,4 +28,16 @@ std::filesystem::path executable_path()
 #endif
 }
 
+std::uint64_t hash_bytes(const void *data, std::size_t size, std::uint64_t seed)
+{
+  const auto    bytes = static_cast<const std::uint8_t *>(data);
+  std::uint64_t hash{seed};
+  for (std::size_t i{0}; i < size; ++i)
+  {
+    hash ^= bytes[i];
+    hash *= 0x100000001b3;
+  }
+  return hash;
+}
+
 } // namespace dc
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <type_traits>
 
@@ -13,4 +15,11 @@ template <typename T> constexpr auto to_underlying(T r) noexcept
 
 std::filesystem::path executable_path();
 
+constexpr std::uint64_t hash_seed{0xcbf29ce484222325};
+
+/** FNV-1a hash of the bytes. Pass a previous hash as seed to chain hashes */
+std::uint64_t hash_bytes(const void   *data,
+                         std::size_t   size,
+                         std::uint64_t seed = hash_seed);
+
 } // namespace dc
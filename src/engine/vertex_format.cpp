@@ -0,0 +1,147 @@
+#include "vertex_format.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+
+// the vertex layouts depend on tightly packed vertices
+static_assert(sizeof(dc::PackedVertex) == 28);
+static_assert(sizeof(dc::PackedSkinnedVertex) == 40);
+
+float sign_not_zero(float value) { return value >= 0.0f ? 1.0f : -1.0f; }
+
+std::int16_t float_to_snorm16(float value)
+{
+  return static_cast<std::int16_t>(
+      std::round(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+}
+
+} // namespace
+
+namespace dc
+{
+
+std::array<std::int16_t, 2> encode_octahedral(const glm::vec3 &value)
+{
+  const auto length = std::abs(value.x) + std::abs(value.y) + std::abs(value.z);
+  if (length == 0.0f)
+  {
+    return {0, 0};
+  }
+
+  // project on the octahedron and fold the lower half over the upper half
+  auto x = value.x / length;
+  auto y = value.y / length;
+  if (value.z < 0.0f)
+  {
+    const auto folded_x = (1.0f - std::abs(y)) * sign_not_zero(x);
+    const auto folded_y = (1.0f - std::abs(x)) * sign_not_zero(y);
+    x                   = folded_x;
+    y                   = folded_y;
+  }
+  return {float_to_snorm16(x), float_to_snorm16(y)};
+}
+
+glm::vec3 decode_octahedral(const std::array<std::int16_t, 2> &value)
+{
+  const auto x = std::max(value[0] / 32767.0f, -1.0f);
+  const auto y = std::max(value[1] / 32767.0f, -1.0f);
+
+  glm::vec3  result{x, y, 1.0f - std::abs(x) - std::abs(y)};
+  const auto t = std::max(-result.z, 0.0f);
+  result.x += result.x >= 0.0f ? -t : t;
+  result.y += result.y >= 0.0f ? -t : t;
+  return glm::normalize(result);
+}
+
+std::uint16_t float_to_half(float value)
+{
+  std::uint32_t bits{};
+  std::memcpy(&bits, &value, sizeof(bits));
+
+  const auto sign     = static_cast<std::uint16_t>((bits >> 16) & 0x8000);
+  const auto exponent = static_cast<int>((bits >> 23) & 0xff) - 127 + 15;
+  auto       mantissa = bits & 0x7fffff;
+
+  if (exponent >= 31)
+  {
+    // overflow becomes infinity, nan stays nan
+    const auto is_nan = ((bits >> 23) & 0xff) == 0xff && mantissa != 0;
+    return sign | 0x7c00 | (is_nan ? 0x200 : 0);
+  }
+  if (exponent <= 0)
+  {
+    if (exponent < -10)
+    {
+      return sign;
+    }
+    // denormal, round to nearest
+    mantissa |= 0x800000;
+    const auto shift = static_cast<std::uint32_t>(14 - exponent);
+    return sign | static_cast<std::uint16_t>(
+                      (mantissa + (1u << (shift - 1))) >> shift);
+  }
+
+  // round to nearest, a carry into the exponent is fine
+  return sign | static_cast<std::uint16_t>(
+                    ((static_cast<std::uint32_t>(exponent) << 10) |
+                     (mantissa >> 13)) +
+                    ((mantissa >> 12) & 1));
+}
+
+float half_to_float(std::uint16_t value)
+{
+  const auto sign     = static_cast<std::uint32_t>(value & 0x8000) << 16;
+  auto       exponent = static_cast<std::uint32_t>((value >> 10) & 0x1f);
+  auto       mantissa = static_cast<std::uint32_t>(value & 0x3ff);
+
+  std::uint32_t bits{};
+  if (exponent == 0x1f)
+  {
+    bits = sign | 0x7f800000 | (mantissa << 13);
+  }
+  else if (exponent == 0)
+  {
+    if (mantissa == 0)
+    {
+      bits = sign;
+    }
+    else
+    {
+      // normalize the denormal
+      exponent = 127 - 15 + 1;
+      while ((mantissa & 0x400) == 0)
+      {
+        mantissa <<= 1;
+        --exponent;
+      }
+      bits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+    }
+  }
+  else
+  {
+    bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+  }
+
+  float result{};
+  std::memcpy(&result, &bits, sizeof(result));
+  return result;
+}
+
+std::uint16_t float_to_unorm16(float value)
+{
+  return static_cast<std::uint16_t>(
+      std::round(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+}
+
+std::int8_t bitangent_sign(const glm::vec3 &normal,
+                           const glm::vec3 &tangent,
+                           const glm::vec3 &bitangent)
+{
+  return glm::dot(glm::cross(normal, tangent), bitangent) < 0.0f ? -127 : 127;
+}
+
+} // namespace dc
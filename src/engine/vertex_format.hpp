@@ -0,0 +1,63 @@
+#pragma once
+
+#include "math.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace dc
+{
+
+/**
+ * Layout of the vertices of a mesh. Gets chosen at import time and is stored
+ * in the mesh files.
+ */
+enum class VertexFormat : std::uint32_t
+{
+  // full floats, see Vertex and SkinnedVertex
+  Float,
+  // see PackedVertex and PackedSkinnedVertex
+  Packed,
+};
+
+/**
+ * Normal and tangent are octahedral encoded snorm16 vectors. The bitangent is
+ * only stored as sign in the first component. Texture coordinates are half
+ * floats.
+ */
+struct PackedVertex
+{
+  glm::vec3                    position;
+  std::array<std::int16_t, 2>  normal;
+  std::array<std::int16_t, 2>  tangent;
+  std::array<std::int8_t, 4>   bitangent_sign;
+  std::array<std::uint16_t, 2> tex_coords;
+};
+
+/** Like PackedVertex, bone weights are unorm16 */
+struct PackedSkinnedVertex
+{
+  glm::vec3                    position;
+  std::array<std::int16_t, 2>  normal;
+  std::array<std::int16_t, 2>  tangent;
+  std::array<std::int8_t, 4>   bitangent_sign;
+  std::array<std::uint8_t, 4>  skin_bones;
+  std::array<std::uint16_t, 4> bone_weights;
+  std::array<std::uint16_t, 2> tex_coords;
+};
+
+std::array<std::int16_t, 2> encode_octahedral(const glm::vec3 &value);
+glm::vec3 decode_octahedral(const std::array<std::int16_t, 2> &value);
+
+std::uint16_t float_to_half(float value);
+float         half_to_float(std::uint16_t value);
+
+std::uint16_t float_to_unorm16(float value);
+
+/// Sign of the bitangent relative to the cross product of normal and tangent
+std::int8_t bitangent_sign(const glm::vec3 &normal,
+                           const glm::vec3 &tangent,
+                           const glm::vec3 &bitangent);
+
+} // namespace dc
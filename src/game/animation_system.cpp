@@ -5,6 +5,17 @@
 #include "profiling.hpp"
 #include "skinned_mesh_component.hpp"
 
+#include <cstddef>
+
+namespace
+{
+
+// fewer skinned meshes get animated on the calling thread
+constexpr std::size_t parallel_entities_count{64};
+constexpr std::size_t chunk_size{16};
+
+} // namespace
+
 namespace dc
 {
 
@@ -32,17 +43,28 @@ void AnimationSystem::update(float delta_time)
   }
 
   auto view = scene->all_entities_with<SkinnedMeshComponent>();
-  for (const auto entity : view)
+
+  const auto animate_entity = [&](entt::entity entity)
   {
     auto &skinned_mesh_component = view.get<SkinnedMeshComponent>(entity);
 
     const auto &animation_state = skinned_mesh_component.animation_state();
-    if (!animation_state)
+    if (animation_state)
     {
-      continue;
+      animation_state->compute_bone_transforms(delta_time);
     }
+  };
 
-    animation_state->compute_bone_transforms(delta_time);
+  // every skinned mesh has its own animation state
+  const auto job_system = Engine::instance()->job_system();
+  if (job_system && view.size() >= parallel_entities_count)
+  {
+    job_system->parallel_for_each(view, chunk_size, animate_entity);
+    return;
+  }
+  for (const auto entity : view)
+  {
+    animate_entity(entity);
   }
 }
 
@@ -51,6 +73,17 @@ void AnimationSystem::render(SceneRenderInfo & /*scene_render_info*/,
 {
 }
 
+const char *AnimationSystem::name() const { return "AnimationSystem"; }
+
+SystemAccess AnimationSystem::access(SystemPhase phase) const
+{
+  if (phase == SystemPhase::Update)
+  {
+    return SystemAccess{}.writes<SkinnedMeshComponent>();
+  }
+  return {};
+}
+
 bool AnimationSystem::on_event(const Event &event)
 {
   const auto event_id = event.id();
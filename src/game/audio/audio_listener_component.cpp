@@ -4,11 +4,14 @@
 namespace dc
 {
 
-void AudioListenerComponent::save(FILE *file) const
+void AudioListenerComponent::save(BinaryWriter &writer) const
 {
-  write_value(file, active_);
+  write_value(writer, active_);
 }
 
-void AudioListenerComponent::read(FILE *file) { read_value(file, active_); }
+void AudioListenerComponent::read(BinaryReader &reader)
+{
+  read_value(reader, active_);
+}
 
 } // namespace dc
@@ -1,16 +1,17 @@
 #pragma once
 
-#include <cstdio>
-
 namespace dc
 {
 
+class BinaryReader;
+class BinaryWriter;
+
 struct AudioListenerComponent
 {
   bool active_{false};
 
-  void save(FILE *file) const;
-  void read(FILE *file);
+  void save(BinaryWriter &writer) const;
+  void read(BinaryReader &reader);
 };
 
 } // namespace dc
@@ -5,32 +5,32 @@
 namespace dc
 {
 
-void AudioSourceComponent::save(FILE *file) const
+void AudioSourceComponent::save(BinaryWriter &writer) const
 {
-  write_value(file, pitch_);
-  write_value(file, gain_);
-  write_value(file, velocity_);
-  write_value(file, looping_);
-  write_value(file, start_on_create_);
+  write_value(writer, pitch_);
+  write_value(writer, gain_);
+  write_value(writer, velocity_);
+  write_value(writer, looping_);
+  write_value(writer, start_on_create_);
 
   std::string audio_asset_name;
   if (audio_asset_)
   {
     audio_asset_name = audio_asset_->asset().id();
   }
-  write_string(file, audio_asset_name);
+  write_string(writer, audio_asset_name);
 }
 
-void AudioSourceComponent::read(FILE *file)
+void AudioSourceComponent::read(BinaryReader &reader)
 {
-  read_value(file, pitch_);
-  read_value(file, gain_);
-  read_value(file, velocity_);
-  read_value(file, looping_);
-  read_value(file, start_on_create_);
+  read_value(reader, pitch_);
+  read_value(reader, gain_);
+  read_value(reader, velocity_);
+  read_value(reader, looping_);
+  read_value(reader, start_on_create_);
 
   std::string audio_asset_name;
-  read_string(file, audio_asset_name);
+  read_string(reader, audio_asset_name);
   if (!audio_asset_name.empty())
   {
     audio_asset_ = std::dynamic_pointer_cast<AudioAssetHandle>(
@@ -9,6 +9,9 @@
 namespace dc
 {
 
+class BinaryReader;
+class BinaryWriter;
+
 struct AudioSourceComponent
 {
   float     pitch_{1.0f};
@@ -22,8 +25,8 @@ struct AudioSourceComponent
   std::shared_ptr<AudioAssetHandle> audio_asset_{};
   AudioSource                      *audio_source_{};
 
-  void save(FILE *file) const;
-  void read(FILE *file);
+  void save(BinaryWriter &writer) const;
+  void read(BinaryReader &reader);
 };
 
 } // namespace dc
@@ -6,6 +6,7 @@
 #include "component_types.hpp"
 #include "entity.hpp"
 #include "scene_events.hpp"
+#include "transform_component.hpp"
 #include <memory>
 
 namespace dc
@@ -45,6 +46,20 @@ void AudioSystem::render(SceneRenderInfo & /*scene_render_info*/,
   }
 }
 
+const char *AudioSystem::name() const { return "AudioSystem"; }
+
+SystemAccess AudioSystem::access(SystemPhase phase) const
+{
+  if (phase == SystemPhase::Render)
+  {
+    return SystemAccess{}
+        .reads<AudioListenerComponent, AudioSourceComponent>()
+        .reads<TransformComponent>()
+        .on_main_thread();
+  }
+  return {};
+}
+
 bool AudioSystem::on_event(const Event &event)
 {
   const auto event_id = event.id();
@@ -25,6 +25,9 @@ public:
 
   bool on_event(const Event &event) override;
 
+  const char  *name() const override;
+  SystemAccess access(SystemPhase phase) const override;
+
 private:
   std::weak_ptr<Scene> scene_{};
 
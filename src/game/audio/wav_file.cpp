@@ -1,5 +1,4 @@
 #include "wav_file.hpp"
-#include "defer.hpp"
 #include "serialization.hpp"
 
 #include <cstring>
@@ -170,16 +169,13 @@ void WavFile::save(const std::filesystem::path &file_path,
 {
   DC_ASSERT(!original_wav_data_.empty(), "Can not save empty wave data");
 
-  const auto file = std::fopen(file_path.string().c_str(), "wb");
-  if (!file)
-  {
-    throw std::runtime_error{"Could not open file " + file_path.string()};
-  }
-  defer(std::fclose(file));
+  BinaryWriter writer{};
+
+  asset_description.write(writer);
 
-  asset_description.write(file);
+  write_vector(writer, original_wav_data_);
 
-  write_vector(file, original_wav_data_);
+  writer.save(file_path);
 }
 
 AssetDescription WavFile::read(const std::filesystem::path &file_path)
@@ -5,26 +5,26 @@
 namespace dc
 {
 
-void CameraComponent::save(FILE *file) const
+void CameraComponent::save(BinaryWriter &writer) const
 {
-  write_value(file, primary_);
-  write_value(file, projection_type_);
-  write_value(file, fov_degree_);
-  write_value(file, perspective_near_);
-  write_value(file, perspective_far_);
-  write_value(file, orthographic_near_);
-  write_value(file, orthographic_far_);
+  write_value(writer, primary_);
+  write_value(writer, projection_type_);
+  write_value(writer, fov_degree_);
+  write_value(writer, perspective_near_);
+  write_value(writer, perspective_far_);
+  write_value(writer, orthographic_near_);
+  write_value(writer, orthographic_far_);
 }
 
-void CameraComponent::read(FILE *file)
+void CameraComponent::read(BinaryReader &reader)
 {
-  read_value(file, primary_);
-  read_value(file, projection_type_);
-  read_value(file, fov_degree_);
-  read_value(file, perspective_near_);
-  read_value(file, perspective_far_);
-  read_value(file, orthographic_near_);
-  read_value(file, orthographic_far_);
+  read_value(reader, primary_);
+  read_value(reader, projection_type_);
+  read_value(reader, fov_degree_);
+  read_value(reader, perspective_near_);
+  read_value(reader, perspective_far_);
+  read_value(reader, orthographic_near_);
+  read_value(reader, orthographic_far_);
 }
 
 } // namespace dc
@@ -8,6 +8,9 @@
 namespace dc
 {
 
+class BinaryReader;
+class BinaryWriter;
+
 struct CameraComponent
 {
   bool primary_{true};
@@ -21,8 +24,8 @@ struct CameraComponent
   float orthographic_near_{-1.0f};
   float orthographic_far_{1.0f};
 
-  void save(FILE *file) const;
-  void read(FILE *file);
+  void save(BinaryWriter &writer) const;
+  void read(BinaryReader &reader);
 };
 
 } // namespace dc
@@ -52,8 +52,7 @@ void CameraSystem::render(SceneRenderInfo & /*scene_render_info*/,
       continue;
     }
 
-    const auto &view_matrix =
-        glm::inverse(transform_component.transform_matrix());
+    const auto &view_matrix = glm::inverse(scene->world_matrix(entity));
     view_render_info.set_fov(camera_component.fov_degree_);
     if (camera_component.projection_type_ == ProjectionType::Perspective)
     {
@@ -82,6 +81,19 @@ void CameraSystem::render(SceneRenderInfo & /*scene_render_info*/,
   }
 }
 
+const char *CameraSystem::name() const { return "CameraSystem"; }
+
+SystemAccess CameraSystem::access(SystemPhase phase) const
+{
+  if (phase == SystemPhase::Render)
+  {
+    return SystemAccess{}
+        .reads<CameraComponent, TransformComponent>()
+        .writes<ViewRenderInfo>();
+  }
+  return {};
+}
+
 bool CameraSystem::on_event(const Event &event)
 {
   const auto event_id = event.id();
@@ -4,18 +4,18 @@
 namespace dc
 {
 
-void DirectionalLightComponent::save(FILE *file) const
+void DirectionalLightComponent::save(BinaryWriter &writer) const
 {
-  write_value(file, color_);
-  write_value(file, multiplier_);
-  write_value(file, cast_shadow_);
+  write_value(writer, color_);
+  write_value(writer, multiplier_);
+  write_value(writer, cast_shadow_);
 }
 
-void DirectionalLightComponent::read(FILE *file)
+void DirectionalLightComponent::read(BinaryReader &reader)
 {
-  read_value(file, color_);
-  read_value(file, multiplier_);
-  read_value(file, cast_shadow_);
+  read_value(reader, color_);
+  read_value(reader, multiplier_);
+  read_value(reader, cast_shadow_);
 }
 
 } // namespace dc
@@ -5,14 +5,17 @@
 namespace dc
 {
 
+class BinaryReader;
+class BinaryWriter;
+
 struct DirectionalLightComponent
 {
   glm::vec3 color_{1.0f};
   float     multiplier_{1.0f};
   bool      cast_shadow_{true};
 
-  void save(FILE *file) const;
-  void read(FILE *file);
+  void save(BinaryWriter &writer) const;
+  void read(BinaryReader &reader);
 };
 
 } // namespace dc
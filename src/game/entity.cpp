@@ -5,29 +5,47 @@
 #include "relationship_component.hpp"
 #include "transform_component.hpp"
 
+#include <utility>
+
 namespace
 {
-using namespace dc;
 
-void update_transform_matrix(Entity entity, const glm::mat4 &parent_transform)
+/**
+ * World matrix including changes since the last update of the transform
+ * system. Returns true as second value if the world matrix of the scene is
+ * stale.
+ */
+std::pair<glm::mat4, bool>
+world_transform_matrix(const dc::Scene      &scene,
+                       const entt::registry &registry,
+                       entt::entity          entity)
 {
-  while (true)
-  {
-    if (!entity.valid())
-    {
-      break;
-    }
+  const auto &transform_component =
+      registry.get<dc::TransformComponent>(entity);
 
-    // update entity transform and transform of childrens
-    auto &transform_component = entity.component<TransformComponent>();
-    transform_component.set_parent_transform_matrix(parent_transform);
-    auto &relationship_component = entity.component<RelationshipComponent>();
-    auto  entity_child           = relationship_component.first_child_;
-    update_transform_matrix(entity_child, entity.transform_matrix());
+  entt::entity parent{entt::null};
+  if (const auto relationship_component =
+          registry.try_get<dc::RelationshipComponent>(entity))
+  {
+    parent = relationship_component->parent_.entity_handle();
+  }
+  if (parent == entt::null || !registry.valid(parent))
+  {
+    return {transform_component.is_dirty()
+                ? transform_component.local_transform_matrix()
+                : scene.world_matrix(entity),
+            transform_component.is_dirty()};
+  }
 
-    // update next siblings
-    entity = relationship_component.next_sibling_;
+  const auto [parent_transform_matrix, is_parent_stale] =
+      world_transform_matrix(scene, registry, parent);
+  if (!is_parent_stale && !transform_component.is_dirty())
+  {
+    return {scene.world_matrix(entity), false};
   }
+  return {parent_transform_matrix *
+              transform_component.local_transform_matrix(),
+          true};
 }
 
 } // namespace
@@ -96,6 +114,18 @@ void Entity::set_name(const std::string &name)
 
 entt::entity Entity::entity_handle() const { return entity_handle_; }
 
+EntityRef Entity::ref() const
+{
+  const auto scene = scene_.lock();
+  if (!scene)
+  {
+    return {};
+  }
+  return scene->entity_ref(entity_handle_);
+}
+
+std::shared_ptr<Scene> Entity::scene() const { return scene_.lock(); }
+
 glm::mat4 Entity::transform_matrix() const
 {
   const auto scene = scene_.lock();
@@ -104,9 +134,8 @@ glm::mat4 Entity::transform_matrix() const
     return glm::mat4{1.0f};
   }
 
-  const auto &transform_component =
-      scene->registry_.get<TransformComponent>(entity_handle_);
-  return transform_component.transform_matrix();
+  return world_transform_matrix(*scene, scene->registry_, entity_handle_)
+      .first;
 }
 
 glm::mat4 Entity::local_transform_matrix() const
@@ -156,11 +185,6 @@ void Entity::set_position(const glm::vec3 &positon)
   auto &transform_component =
       scene->registry_.get<TransformComponent>(entity_handle_);
   transform_component.set_position(positon);
-
-  auto &relationship_component =
-      scene->registry_.get<RelationshipComponent>(entity_handle_);
-  update_transform_matrix(relationship_component.first_child_,
-                          transform_component.transform_matrix());
 }
 
 glm::vec3 Entity::position() const
@@ -186,11 +210,6 @@ void Entity::set_rotation(const glm::vec3 &rotation)
   auto &transform_component =
       scene->registry_.get<TransformComponent>(entity_handle_);
   transform_component.set_rotation(rotation);
-
-  auto &relationship_component =
-      scene->registry_.get<RelationshipComponent>(entity_handle_);
-  update_transform_matrix(relationship_component.first_child_,
-                          transform_component.transform_matrix());
 }
 
 glm::vec3 Entity::rotation() const
@@ -216,11 +235,6 @@ void Entity::set_scale(const glm::vec3 &scale)
   auto &transform_component =
       scene->registry_.get<TransformComponent>(entity_handle_);
   transform_component.set_scale(scale);
-
-  auto &relationship_component =
-      scene->registry_.get<RelationshipComponent>(entity_handle_);
-  update_transform_matrix(relationship_component.first_child_,
-                          transform_component.transform_matrix());
 }
 
 glm::vec3 Entity::scale() const
@@ -299,8 +313,7 @@ void Entity::add_child(Entity child)
       child_relationship_component.previous_sibling_ = {};
       child_relationship_component.next_sibling_     = {};
 
-      // update transforms
-      update_transform_matrix(child, transform_matrix());
+      on_child_added(child);
       return;
     }
 
@@ -315,8 +328,7 @@ void Entity::add_child(Entity child)
         sibling_relationship_component.next_sibling_   = child;
         child_relationship_component.previous_sibling_ = sibling;
 
-        // update transforms
-        update_transform_matrix(child, transform_matrix());
+        on_child_added(child);
         return;
       }
 
@@ -328,6 +340,16 @@ void Entity::add_child(Entity child)
   assert(0);
 }
 
+void Entity::on_child_added(Entity child)
+{
+  // the world matrix of the child changes with the new parent
+  child.component<TransformComponent>().set_dirty();
+  if (const auto scene = scene_.lock())
+  {
+    scene->set_hierarchy_changed();
+  }
+}
+
 void Entity::set_parent(Entity parent) { parent.add_child(*this); }
 
 Entity Entity::parent() const
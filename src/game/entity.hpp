@@ -82,9 +82,22 @@ public:
 
   entt::entity entity_handle() const;
 
+  /**
+   * Locks the scene once and returns a reference that accesses the
+   * components without locking. Returns an invalid reference if the scene
+   * is gone.
+   */
+  EntityRef ref() const;
+  /// Scene of the entity, nullptr if it is gone
+  std::shared_ptr<Scene> scene() const;
+
   void        set_name(const std::string &name);
   std::string name() const;
 
+  /**
+   * World matrix of the entity. Includes changes that the transform system
+   * has not applied yet.
+   */
   glm::mat4 transform_matrix() const;
 
   void      set_local_transform_matrix(const glm::mat4 &transform);
@@ -113,6 +126,8 @@ public:
 private:
   entt::entity         entity_handle_{entt::null};
   std::weak_ptr<Scene> scene_;
+
+  void on_child_added(Entity child);
 };
 
 } // namespace dc
@@ -0,0 +1,71 @@
+#include "entity_ref.hpp"
+#include "relationship_component.hpp"
+#include "scene.hpp"
+#include "transform_component.hpp"
+
+namespace dc
+{
+
+EntityRef::EntityRef(const Scene    &scene,
+                     entt::registry &registry,
+                     entt::entity    entity_handle)
+    : scene_{&scene},
+      registry_{&registry},
+      entity_handle_{entity_handle}
+{
+}
+
+bool EntityRef::valid() const
+{
+  return registry_ && entity_handle_ != entt::null &&
+         registry_->valid(entity_handle_);
+}
+
+entt::entity EntityRef::entity_handle() const { return entity_handle_; }
+
+void EntityRef::set_position(const glm::vec3 &position)
+{
+  component<TransformComponent>().set_position(position);
+}
+
+glm::vec3 EntityRef::position() const
+{
+  return component<TransformComponent>().position();
+}
+
+void EntityRef::set_rotation(const glm::vec3 &rotation)
+{
+  component<TransformComponent>().set_rotation(rotation);
+}
+
+glm::vec3 EntityRef::rotation() const
+{
+  return component<TransformComponent>().rotation();
+}
+
+void EntityRef::set_scale(const glm::vec3 &scale)
+{
+  component<TransformComponent>().set_scale(scale);
+}
+
+glm::vec3 EntityRef::scale() const
+{
+  return component<TransformComponent>().scale();
+}
+
+glm::mat4 EntityRef::transform_matrix() const
+{
+  return scene_->world_matrix(entity_handle_);
+}
+
+glm::mat4 EntityRef::parent_transform_matrix() const
+{
+  const auto relationship_component = try_component<RelationshipComponent>();
+  if (!relationship_component)
+  {
+    return glm::mat4{1.0f};
+  }
+  return scene_->world_matrix(relationship_component->parent_.entity_handle());
+}
+
+} // namespace dc
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "math.hpp"
+
+#include <entt/entt.hpp>
+
+namespace dc
+{
+
+class Scene;
+
+/**
+ * Reference to an entity that holds the registry of its scene. Unlike Entity
+ * it does not lock the scene on every access, so it is meant for hot loops.
+ * Only use it within a frame: it does not keep the scene alive and entities
+ * get removed at the end of a frame.
+ */
+class EntityRef
+{
+public:
+  EntityRef() = default;
+  EntityRef(const Scene    &scene,
+            entt::registry &registry,
+            entt::entity    entity_handle);
+
+  bool valid() const;
+
+  entt::entity entity_handle() const;
+
+  template <typename TComponent> bool has_component() const
+  {
+    return registry_->all_of<TComponent>(entity_handle_);
+  }
+
+  template <typename TComponent> TComponent &component() const
+  {
+    return registry_->get<TComponent>(entity_handle_);
+  }
+
+  /// Returns nullptr if the entity does not have the component
+  template <typename TComponent> TComponent *try_component() const
+  {
+    return registry_->try_get<TComponent>(entity_handle_);
+  }
+
+  void      set_position(const glm::vec3 &position);
+  glm::vec3 position() const;
+
+  void      set_rotation(const glm::vec3 &rotation);
+  glm::vec3 rotation() const;
+
+  void      set_scale(const glm::vec3 &scale);
+  glm::vec3 scale() const;
+
+  /// World matrices as of the last update of the transform system
+  glm::mat4 transform_matrix() const;
+  /// Identity matrix if the entity has no parent
+  glm::mat4 parent_transform_matrix() const;
+
+private:
+  const Scene    *scene_{};
+  entt::registry *registry_{};
+  entt::entity    entity_handle_{entt::null};
+};
+
+} // namespace dc
@@ -10,12 +10,15 @@
 #include "entity.hpp"
 #include "glm/ext/matrix_clip_space.hpp"
 #include "physic/physic_system.hpp"
+#include "prefab_asset.hpp"
 #include "profiling.hpp"
 #include "render_system.hpp"
+#include "scene_streaming_system.hpp"
 #include "script/script_system.hpp"
 #include "sky_component.hpp"
 #include "systems_context.hpp"
 #include "transform_component.hpp"
+#include "transform_system.hpp"
 
 #include <memory>
 
@@ -26,7 +29,10 @@ void add_systems(dc::SystemsContext &system_context)
 {
   // add systems, order matters
   system_context.add_system<dc::ScriptSystem>();
+  // before everything that reads world matrices
+  system_context.add_system<dc::TransformSystem>();
   system_context.add_system<dc::CameraSystem>();
+  system_context.add_system<dc::SceneStreamingSystem>();
   system_context.add_system<dc::PhysicSystem>();
   system_context.add_system<dc::AnimationSystem>();
   system_context.add_system<dc::AudioSystem>();
@@ -46,6 +52,8 @@ void GameLayer::register_asset_loaders()
                                                            scene_asset_loader);
   Engine::instance()->asset_cache()->register_asset_loader(".dcaud",
                                                            audio_asset_loader);
+  Engine::instance()->asset_cache()->register_asset_loader(".dcprefab",
+                                                           prefab_asset_loader);
 }
 
 void GameLayer::init()
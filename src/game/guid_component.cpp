@@ -20,8 +20,11 @@ GuidComponent::GuidComponent(Uuid uuid)
   }
 }
 
-void GuidComponent::save(FILE *file) const { write_value(file, id_); }
+void GuidComponent::save(BinaryWriter &writer) const
+{
+  write_value(writer, id_);
+}
 
-void GuidComponent::read(FILE *file) { read_value(file, id_); }
+void GuidComponent::read(BinaryReader &reader) { read_value(reader, id_); }
 
 } // namespace dc
@@ -3,11 +3,13 @@
 #include "uuid.hpp"
 
 #include <cstdint>
-#include <stdio.h>
 
 namespace dc
 {
 
+class BinaryReader;
+class BinaryWriter;
+
 struct GuidComponent
 {
   GuidComponent();
@@ -15,8 +17,8 @@ struct GuidComponent
 
   Uuid id_{};
 
-  void save(FILE *file) const;
-  void read(FILE *file);
+  void save(BinaryWriter &writer) const;
+  void read(BinaryReader &reader);
 };
 
 } // namespace dc
@@ -8,20 +8,20 @@
 namespace dc
 {
 
-void MeshComponent::save(FILE *file) const
+void MeshComponent::save(BinaryWriter &writer) const
 {
   std::string mesh_asset_name;
   if (model_)
   {
     mesh_asset_name = model_->asset().id();
   }
-  write_string(file, mesh_asset_name);
+  write_string(writer, mesh_asset_name);
 }
 
-void MeshComponent::read(FILE *file)
+void MeshComponent::read(BinaryReader &reader)
 {
   std::string mesh_asset_name;
-  read_string(file, mesh_asset_name);
+  read_string(reader, mesh_asset_name);
   if (!mesh_asset_name.empty())
   {
     model_ = std::dynamic_pointer_cast<MeshAssetHandle>(
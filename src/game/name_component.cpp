@@ -4,8 +4,11 @@
 namespace dc
 {
 
-void NameComponent::save(FILE *file) const { write_string(file, name_); }
+void NameComponent::save(BinaryWriter &writer) const
+{
+  write_string(writer, name_);
+}
 
-void NameComponent::read(FILE *file) { read_string(file, name_); }
+void NameComponent::read(BinaryReader &reader) { read_string(reader, name_); }
 
 } // namespace dc
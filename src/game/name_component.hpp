@@ -5,12 +5,15 @@
 namespace dc
 {
 
+class BinaryReader;
+class BinaryWriter;
+
 struct NameComponent
 {
   std::string name_;
 
-  void save(FILE *file) const;
-  void read(FILE *file);
+  void save(BinaryWriter &writer) const;
+  void read(BinaryReader &reader);
 };
 
 } // namespace dc
@@ -4,20 +4,20 @@
 namespace dc
 {
 
-void BoxColliderComponent::save(FILE *file) const
+void BoxColliderComponent::save(BinaryWriter &writer) const
 {
-  write_value(file, size_);
-  write_value(file, offset_);
-  write_value(file, is_trigger_);
-  write_value(file, physic_material_);
+  write_value(writer, size_);
+  write_value(writer, offset_);
+  write_value(writer, is_trigger_);
+  write_value(writer, physic_material_);
 }
 
-void BoxColliderComponent::read(FILE *file)
+void BoxColliderComponent::read(BinaryReader &reader)
 {
-  read_value(file, size_);
-  read_value(file, offset_);
-  read_value(file, is_trigger_);
-  read_value(file, physic_material_);
+  read_value(reader, size_);
+  read_value(reader, offset_);
+  read_value(reader, is_trigger_);
+  read_value(reader, physic_material_);
 }
 
 } // namespace dc
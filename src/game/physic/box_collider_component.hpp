@@ -7,6 +7,9 @@
 namespace dc
 {
 
+class BinaryReader;
+class BinaryWriter;
+
 class BoxCollider;
 
 struct BoxColliderComponent
@@ -21,8 +24,8 @@ struct BoxColliderComponent
   BoxCollider         *box_collider_{};
   CharacterController *character_controller_{};
 
-  void save(FILE *file) const;
-  void read(FILE *file);
+  void save(BinaryWriter &writer) const;
+  void read(BinaryReader &reader);
 };
 
 } // namespace dc
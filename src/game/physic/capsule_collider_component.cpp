@@ -4,20 +4,20 @@
 namespace dc
 {
 
-void CapsuleColliderComponent::save(FILE *file) const
+void CapsuleColliderComponent::save(BinaryWriter &writer) const
 {
-  write_value(file, radius_);
-  write_value(file, height_);
-  write_value(file, offset_);
-  write_value(file, physic_material_);
+  write_value(writer, radius_);
+  write_value(writer, height_);
+  write_value(writer, offset_);
+  write_value(writer, physic_material_);
 }
 
-void CapsuleColliderComponent::read(FILE *file)
+void CapsuleColliderComponent::read(BinaryReader &reader)
 {
-  read_value(file, radius_);
-  read_value(file, height_);
-  read_value(file, offset_);
-  read_value(file, physic_material_);
+  read_value(reader, radius_);
+  read_value(reader, height_);
+  read_value(reader, offset_);
+  read_value(reader, physic_material_);
 }
 
 } // namespace dc
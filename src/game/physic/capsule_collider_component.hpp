@@ -7,6 +7,9 @@
 namespace dc
 {
 
+class BinaryReader;
+class BinaryWriter;
+
 class CapsuleCollider;
 
 struct CapsuleColliderComponent
@@ -22,8 +25,8 @@ struct CapsuleColliderComponent
   CapsuleCollider     *capsule_collider_{};
   CharacterController *character_controller_{};
 
-  void save(FILE *file) const;
-  void read(FILE *file);
+  void save(BinaryWriter &writer) const;
+  void read(BinaryReader &reader);
 };
 
 } // namespace dc
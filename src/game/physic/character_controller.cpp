@@ -93,9 +93,15 @@ CharacterController::~CharacterController()
 
 void CharacterController::sync_transform()
 {
-  auto &component = get_entity().component<TransformComponent>();
+  sync_transform(get_entity().ref());
+}
+
+void CharacterController::sync_transform(const EntityRef &entity)
+{
+  auto &component = entity.component<TransformComponent>();
 
-  component.set_absolute_position(get_position());
+  component.set_absolute_position(get_position(),
+                                  entity.parent_transform_matrix());
 }
 
 void CharacterController::set_has_gravity(bool value)
@@ -149,7 +155,10 @@ void CharacterController::set_position(const glm::vec3 &value)
     DC_FAIL("Unknown shape type");
   }
 
-  get_entity().component<TransformComponent>().set_absolute_position(value);
+  const auto entity = get_entity().ref();
+  entity.component<TransformComponent>().set_absolute_position(
+      value,
+      entity.parent_transform_matrix());
 }
 
 void CharacterController::set_offset(const glm::vec3 &value)
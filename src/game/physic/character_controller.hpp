@@ -20,6 +20,8 @@ public:
   ~CharacterController();
 
   void sync_transform();
+  /// Same as sync_transform() with the entity of the actor already resolved
+  void sync_transform(const EntityRef &entity);
 
   void set_has_gravity(bool value);
   void set_slope_limit(float slope_limit_degree);
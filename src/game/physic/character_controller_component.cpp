@@ -4,18 +4,18 @@
 namespace dc
 {
 
-void CharacterControllerComponent::save(FILE *file) const
+void CharacterControllerComponent::save(BinaryWriter &writer) const
 {
-  write_value(file, slope_limit_degree_);
-  write_value(file, step_offset_);
-  write_value(file, disable_gravity_);
+  write_value(writer, slope_limit_degree_);
+  write_value(writer, step_offset_);
+  write_value(writer, disable_gravity_);
 }
 
-void CharacterControllerComponent::read(FILE *file)
+void CharacterControllerComponent::read(BinaryReader &reader)
 {
-  read_value(file, slope_limit_degree_);
-  read_value(file, step_offset_);
-  read_value(file, disable_gravity_);
+  read_value(reader, slope_limit_degree_);
+  read_value(reader, step_offset_);
+  read_value(reader, disable_gravity_);
 }
 
 } // namespace dc
@@ -5,6 +5,9 @@
 namespace dc
 {
 
+class BinaryReader;
+class BinaryWriter;
+
 struct CharacterControllerComponent
 {
   float slope_limit_degree_;
@@ -14,8 +17,8 @@ struct CharacterControllerComponent
 
   CharacterController *controller_{};
 
-  void save(FILE *file) const;
-  void read(FILE *file);
+  void save(BinaryWriter &writer) const;
+  void read(BinaryReader &reader);
 };
 
 } // namespace dc
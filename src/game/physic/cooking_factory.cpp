@@ -77,16 +77,29 @@ CookingFactory::cook_mesh(const MeshAssetHandle &mesh,
     return collider_data;
   }
 
+  if (!mesh.is_ready())
+  {
+    // cooking needs the geometry now, finish a pending load
+    Engine::instance()->asset_cache()->load_asset(mesh.asset(),
+                                                  AssetLoadMode::Sync);
+  }
   DC_ASSERT(mesh.is_ready() && mesh.get(), "Mesh not ready");
 
+  // shared with the mesh, no copy of the geometry gets made
+  const auto geometry = mesh.geometry();
+  if (!geometry)
+  {
+    throw std::runtime_error("Mesh has no geometry " + mesh.asset().id());
+  }
+
   std::shared_ptr<MeshColliderData> collider_data{};
   if (mesh_collider_type == MeshColliderType::Convex)
   {
-    collider_data = cook_convex_mesh(*mesh.get());
+    collider_data = cook_convex_mesh(*geometry);
   }
   else
   {
-    collider_data = cook_triangle_mesh(*mesh.get());
+    collider_data = cook_triangle_mesh(*geometry);
   }
 
   std::filesystem::create_directories(base_directory / "meshes");
@@ -99,22 +112,21 @@ CookingFactory::cook_mesh(const MeshAssetHandle &mesh,
 }
 
 std::shared_ptr<MeshColliderData>
-CookingFactory::cook_triangle_mesh(const Mesh &mesh)
+CookingFactory::cook_triangle_mesh(const MeshView &geometry)
 {
   const auto collider_data      = std::make_shared<MeshColliderData>();
   collider_data->collider_type_ = MeshColliderType::Triangle;
 
-  const auto &mesh_desc = mesh.get_description();
-  for (const auto &sub_mesh_desc : mesh_desc.sub_meshes_)
+  for (const auto &sub_mesh : geometry.sub_meshes_)
   {
 
     physx::PxTriangleMeshDesc px_mesh_desc{};
-    px_mesh_desc.points.data      = sub_mesh_desc.vertices_.data();
-    px_mesh_desc.points.count     = sub_mesh_desc.vertices_.size();
-    px_mesh_desc.points.stride    = sizeof(Vertex);
+    px_mesh_desc.points.data      = sub_mesh.vertices_;
+    px_mesh_desc.points.count     = sub_mesh.vertices_count_;
+    px_mesh_desc.points.stride    = mesh_vertex_size(geometry.vertex_format_);
 
-    px_mesh_desc.triangles.data   = sub_mesh_desc.indices_.data();
-    px_mesh_desc.triangles.count  = sub_mesh_desc.indices_.size() / 3;
+    px_mesh_desc.triangles.data   = sub_mesh.indices_;
+    px_mesh_desc.triangles.count  = sub_mesh.indices_count_ / 3;
     px_mesh_desc.triangles.stride = sizeof(std::uint32_t) * 3;
 
     DC_ASSERT(px_mesh_desc.isValid(),
@@ -141,22 +153,21 @@ CookingFactory::cook_triangle_mesh(const Mesh &mesh)
 }
 
 std::shared_ptr<MeshColliderData>
-CookingFactory::cook_convex_mesh(const Mesh &mesh)
+CookingFactory::cook_convex_mesh(const MeshView &geometry)
 {
   const auto collider_data      = std::make_shared<MeshColliderData>();
   collider_data->collider_type_ = MeshColliderType::Convex;
 
-  const auto &mesh_desc = mesh.get_description();
-  for (const auto &sub_mesh_desc : mesh_desc.sub_meshes_)
+  for (const auto &sub_mesh : geometry.sub_meshes_)
   {
     physx::PxConvexMeshDesc px_mesh_desc{};
 
-    px_mesh_desc.points.data   = sub_mesh_desc.vertices_.data();
-    px_mesh_desc.points.count  = sub_mesh_desc.vertices_.size();
-    px_mesh_desc.points.stride = sizeof(Vertex);
+    px_mesh_desc.points.data   = sub_mesh.vertices_;
+    px_mesh_desc.points.count  = sub_mesh.vertices_count_;
+    px_mesh_desc.points.stride = mesh_vertex_size(geometry.vertex_format_);
 
-    px_mesh_desc.indices.data   = sub_mesh_desc.indices_.data();
-    px_mesh_desc.indices.count  = sub_mesh_desc.indices_.size() / 3;
+    px_mesh_desc.indices.data   = sub_mesh.indices_;
+    px_mesh_desc.indices.count  = sub_mesh.indices_count_ / 3;
     px_mesh_desc.indices.stride = sizeof(std::uint32_t) * 3;
 
     px_mesh_desc.flags = physx::PxConvexFlag::eCOMPUTE_CONVEX |
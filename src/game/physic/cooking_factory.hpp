@@ -37,8 +37,9 @@ private:
 
   CookingFactory() = default;
 
-  std::shared_ptr<MeshColliderData> cook_triangle_mesh(const Mesh &mesh);
-  std::shared_ptr<MeshColliderData> cook_convex_mesh(const Mesh &mesh);
+  std::shared_ptr<MeshColliderData>
+  cook_triangle_mesh(const MeshView &geometry);
+  std::shared_ptr<MeshColliderData> cook_convex_mesh(const MeshView &geometry);
 };
 
 } // namespace dc
@@ -4,18 +4,18 @@
 namespace dc
 {
 
-void MeshColliderComponent::save(FILE *file) const
+void MeshColliderComponent::save(BinaryWriter &writer) const
 {
-  write_value(file, is_trigger_);
-  write_value(file, is_convex_);
-  write_value(file, physic_material_);
+  write_value(writer, is_trigger_);
+  write_value(writer, is_convex_);
+  write_value(writer, physic_material_);
 }
 
-void MeshColliderComponent::read(FILE *file)
+void MeshColliderComponent::read(BinaryReader &reader)
 {
-  read_value(file, is_trigger_);
-  read_value(file, is_convex_);
-  read_value(file, physic_material_);
+  read_value(reader, is_trigger_);
+  read_value(reader, is_convex_);
+  read_value(reader, physic_material_);
 }
 
 } // namespace dc
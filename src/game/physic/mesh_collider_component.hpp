@@ -6,6 +6,9 @@
 namespace dc
 {
 
+class BinaryReader;
+class BinaryWriter;
+
 struct MeshColliderComponent
 {
   bool is_trigger_{false};
@@ -15,8 +18,8 @@ struct MeshColliderComponent
 
   MeshCollider *mesh_collider_{};
 
-  void save(FILE *file) const;
-  void read(FILE *file);
+  void save(BinaryWriter &writer) const;
+  void read(BinaryReader &reader);
 };
 
 } // namespace dc
@@ -1,57 +1,51 @@
 #include "mesh_collider_data.hpp"
-#include "defer.hpp"
+#include "binary_reader.hpp"
+#include "filesystem.hpp"
 #include "serialization.hpp"
 
 namespace dc
 {
 
-void SubmeshColliderData::save(FILE *file) const
+void SubmeshColliderData::save(BinaryWriter &writer) const
 {
-  write_vector(file, data_);
-  write_value(file, transform_);
+  write_vector(writer, data_);
+  write_value(writer, transform_);
 }
 
-void SubmeshColliderData::read(FILE *file)
+void SubmeshColliderData::read(BinaryReader &reader)
 {
-  read_vector(file, data_);
-  read_value(file, transform_);
+  read_vector(reader, data_);
+  read_value(reader, transform_);
 }
 
 void MeshColliderData::save(const std::filesystem::path &file_path,
                             const AssetDescription &asset_description) const
 {
-  const auto file = std::fopen(file_path.string().c_str(), "wb");
-  if (!file)
-  {
-    throw std::runtime_error{"Could not open file " + file_path.string()};
-  }
-  defer(std::fclose(file));
+  BinaryWriter writer{};
 
-  asset_description.write(file);
-  write_value(file,
+  asset_description.write(writer);
+  write_value(writer,
               static_cast<std::uint8_t>(
                   collider_type_ == MeshColliderType::Convex ? 1 : 0));
-  write_value(file, static_cast<std::uint64_t>(sub_meshes_.size()));
+  write_value(writer, static_cast<std::uint64_t>(sub_meshes_.size()));
   for (const auto &sub_mesh : sub_meshes_)
   {
-    sub_mesh.save(file);
+    sub_mesh.save(writer);
   }
+
+  writer.save(file_path);
 }
 
 AssetDescription MeshColliderData::read(const std::filesystem::path &file_path)
 {
-  const auto file = std::fopen(file_path.string().c_str(), "rb");
-  if (!file)
-  {
-    throw std::runtime_error{"Could not open file " + file_path.string()};
-  }
-  defer(std::fclose(file));
+  const auto   data = read_binary_file(file_path);
+  BinaryReader reader{data.data(), data.size()};
 
   AssetDescription asset_description;
-  asset_description.read(file);
+  asset_description.read(reader);
 
   std::uint8_t collider_type{};
-  read_value(file, collider_type);
+  read_value(reader, collider_type);
   if (collider_type == 0)
   {
     collider_type_ = MeshColliderType::Triangle;
@@ -62,11 +56,11 @@ AssetDescription MeshColliderData::read(const std::filesystem::path &file_path)
   }
 
   std::uint64_t sub_meshes_count{};
-  read_value(file, sub_meshes_count);
+  read_value(reader, sub_meshes_count);
   for (std::uint64_t i = 0; i < sub_meshes_count; ++i)
   {
     SubmeshColliderData sub_mesh{};
-    sub_mesh.read(file);
+    sub_mesh.read(reader);
     sub_meshes_.push_back(std::move(sub_mesh));
   }
 
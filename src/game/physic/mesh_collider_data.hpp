@@ -10,6 +10,9 @@
 namespace dc
 {
 
+class BinaryReader;
+class BinaryWriter;
+
 enum class MeshColliderType
 {
   Triangle,
@@ -21,8 +24,8 @@ struct SubmeshColliderData
   std::vector<std::uint8_t> data_;
   glm::mat4                 transform_;
 
-  void save(FILE *file) const;
-  void read(FILE *file);
+  void save(BinaryWriter &writer) const;
+  void read(BinaryReader &reader);
 };
 
 struct MeshColliderData
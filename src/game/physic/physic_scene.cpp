@@ -23,6 +23,7 @@
 
 #include <functional>
 #include <memory>
+#include <vector>
 
 namespace
 {
@@ -289,23 +290,44 @@ void PhysicScene::process_active_actors()
 {
   unsigned   active_actors_count{};
   const auto active_actors = scene_->getActiveActors(active_actors_count);
+  if (active_actors_count == 0)
+  {
+    return;
+  }
+
+  std::vector<PhysicActor *> actors(active_actors_count);
+  std::vector<entt::entity>  entity_handles(active_actors_count);
+  for (unsigned i = 0; i < active_actors_count; ++i)
+  {
+    actors[i] = static_cast<PhysicActor *>(active_actors[i]->userData);
+    DC_ASSERT(actors[i], "Actor can't be nullptr");
+    entity_handles[i] = actors[i]->get_entity().entity_handle();
+  }
+
+  // all actors belong to the same scene, so it gets locked only once
+  const auto scene = actors.front()->get_entity().scene();
+  if (!scene)
+  {
+    return;
+  }
+  const auto entities = scene->entity_refs(entity_handles);
+
   for (unsigned i = 0; i < active_actors_count; ++i)
   {
-    const auto actor = static_cast<PhysicActor *>(active_actors[i]->userData);
-    DC_ASSERT(actor, "Actor can't be nullptr");
+    const auto actor = actors[i];
     if (actor->physic_actor_type() == PhysicActorType::RigidBody)
     {
       const auto rigid_body = static_cast<RigidBody *>(actor);
       if (!rigid_body->is_sleeping())
       {
-        rigid_body->sync_transform();
+        rigid_body->sync_transform(entities[i]);
       }
     }
     else if (actor->physic_actor_type() == PhysicActorType::CharacterController)
     {
       const auto character_controller =
           static_cast<CharacterController *>(actor);
-      character_controller->sync_transform();
+      character_controller->sync_transform(entities[i]);
     }
     else
     {
@@ -2,6 +2,7 @@
 
 #include "character_controller.hpp"
 #include "entity.hpp"
+#include "flat_hash_map.hpp"
 #include "math.hpp"
 #include "physic_actor.hpp"
 #include "physic_types.hpp"
@@ -45,8 +46,8 @@ public:
 private:
   bool is_debug_draw_{false};
 
-  std::unordered_map<Uuid, std::unique_ptr<RigidBody>>           actors_;
-  std::unordered_map<Uuid, std::unique_ptr<CharacterController>> controllers_;
+  FlatHashMap<Uuid, std::unique_ptr<RigidBody>>           actors_;
+  FlatHashMap<Uuid, std::unique_ptr<CharacterController>> controllers_;
 
   physx::PxScene             *scene_{};
   physx::PxControllerManager *controller_manager_{};
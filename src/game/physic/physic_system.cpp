@@ -46,6 +46,18 @@ void PhysicSystem::render(SceneRenderInfo &scene_render_info,
   }
 }
 
+const char *PhysicSystem::name() const { return "PhysicSystem"; }
+
+SystemAccess PhysicSystem::access(SystemPhase phase) const
+{
+  // the simulation fires collision events, which run scripts
+  if (phase == SystemPhase::Update)
+  {
+    return SystemAccess::exclusive();
+  }
+  return SystemAccess{}.writes<SceneRenderInfo>();
+}
+
 bool PhysicSystem::on_event(const Event &event)
 {
   const auto event_id = event.id();
@@ -128,6 +140,10 @@ void PhysicSystem::on_component_destroy(const ComponentDestroyEvent &event)
   {
     physic_scene_->remove_rigid_body(event.entity_);
   }
+  else if (event.component_type_ == ComponentType::CharacterController)
+  {
+    physic_scene_->remove_controller(event.entity_);
+  }
 }
 
 void PhysicSystem::create_physic_actors()
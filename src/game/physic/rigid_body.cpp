@@ -108,14 +108,21 @@ RigidBody::~RigidBody()
   rigid_actor_ = nullptr;
 }
 
-void RigidBody::sync_transform()
+void RigidBody::sync_transform() { sync_transform(get_entity().ref()); }
+
+void RigidBody::sync_transform(const EntityRef &entity)
 {
   DC_ASSERT(rigid_actor_, "No rigid actor set");
 
-  auto &transform_component = get_entity().component<TransformComponent>();
+  auto       &transform_component = entity.component<TransformComponent>();
   const auto &actor_pose          = rigid_actor_->getGlobalPose();
-  transform_component.set_absolute_position(to_glm(actor_pose.p));
-  transform_component.set_absolute_rotation(to_glm(actor_pose.q));
+
+  // the pose is in world space
+  const auto parent_transform_matrix = entity.parent_transform_matrix();
+  transform_component.set_absolute_position(to_glm(actor_pose.p),
+                                            parent_transform_matrix);
+  transform_component.set_absolute_rotation(to_glm(actor_pose.q),
+                                            parent_transform_matrix);
 }
 
 void RigidBody::set_translation(const glm::vec3 &value, bool autowake)
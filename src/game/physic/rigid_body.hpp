@@ -43,6 +43,8 @@ public:
   ~RigidBody();
 
   void sync_transform();
+  /// Same as sync_transform() with the entity of the actor already resolved
+  void sync_transform(const EntityRef &entity);
 
   void      set_translation(const glm::vec3 &value, bool autowake = true);
   glm::vec3 get_translation() const;
@@ -7,34 +7,34 @@
 namespace dc
 {
 
-void RigidBodyComponent::save(FILE *file) const
+void RigidBodyComponent::save(BinaryWriter &writer) const
 {
 
   if (body_type_ == RigidBodyType::Dynamic)
   {
-    write_value(file, static_cast<std::uint8_t>(0));
+    write_value(writer, static_cast<std::uint8_t>(0));
   }
   else if (body_type_ == RigidBodyType::Static)
   {
-    write_value(file, static_cast<std::uint8_t>(1));
+    write_value(writer, static_cast<std::uint8_t>(1));
   }
   else
   {
     DC_FAIL("No such rigid body type");
   }
 
-  write_value(file, mass_);
-  write_value(file, linear_drag_);
-  write_value(file, angular_drag_);
-  write_value(file, is_kinematic_);
-  write_value(file, is_gravity_disabled_);
+  write_value(writer, mass_);
+  write_value(writer, linear_drag_);
+  write_value(writer, angular_drag_);
+  write_value(writer, is_kinematic_);
+  write_value(writer, is_gravity_disabled_);
 }
 
-void RigidBodyComponent::read(FILE *file)
+void RigidBodyComponent::read(BinaryReader &reader)
 {
 
   std::uint8_t rigid_body_type{0};
-  read_value(file, rigid_body_type);
+  read_value(reader, rigid_body_type);
   if (rigid_body_type == 0)
   {
     body_type_ = RigidBodyType::Dynamic;
@@ -48,11 +48,11 @@ void RigidBodyComponent::read(FILE *file)
     DC_FAIL("No such rigid body type");
   }
 
-  read_value(file, mass_);
-  read_value(file, linear_drag_);
-  read_value(file, angular_drag_);
-  read_value(file, is_kinematic_);
-  read_value(file, is_gravity_disabled_);
+  read_value(reader, mass_);
+  read_value(reader, linear_drag_);
+  read_value(reader, angular_drag_);
+  read_value(reader, is_kinematic_);
+  read_value(reader, is_gravity_disabled_);
 }
 
 } // namespace dc
@@ -6,6 +6,9 @@
 namespace dc
 {
 
+class BinaryReader;
+class BinaryWriter;
+
 struct RigidBodyComponent
 {
   RigidBodyType body_type_{RigidBodyType::Dynamic};
@@ -20,8 +23,8 @@ struct RigidBodyComponent
 
   RigidBody *physic_actor_{};
 
-  void save(FILE *file) const;
-  void read(FILE *file);
+  void save(BinaryWriter &writer) const;
+  void read(BinaryReader &reader);
 };
 
 } // namespace dc
@@ -4,20 +4,20 @@
 namespace dc
 {
 
-void SphereColliderComponent::save(FILE *file) const
+void SphereColliderComponent::save(BinaryWriter &writer) const
 {
-  write_value(file, radius_);
-  write_value(file, offset_);
-  write_value(file, is_trigger_);
-  write_value(file, physic_material_);
+  write_value(writer, radius_);
+  write_value(writer, offset_);
+  write_value(writer, is_trigger_);
+  write_value(writer, physic_material_);
 }
 
-void SphereColliderComponent::read(FILE *file)
+void SphereColliderComponent::read(BinaryReader &reader)
 {
-  read_value(file, radius_);
-  read_value(file, offset_);
-  read_value(file, is_trigger_);
-  read_value(file, physic_material_);
+  read_value(reader, radius_);
+  read_value(reader, offset_);
+  read_value(reader, is_trigger_);
+  read_value(reader, physic_material_);
 }
 
 } // namespace dc
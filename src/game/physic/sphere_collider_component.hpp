@@ -6,6 +6,9 @@
 namespace dc
 {
 
+class BinaryReader;
+class BinaryWriter;
+
 class SphereCollider;
 
 struct SphereColliderComponent
@@ -19,8 +22,8 @@ struct SphereColliderComponent
 
   SphereCollider *sphere_collider_{};
 
-  void save(FILE *file) const;
-  void read(FILE *file);
+  void save(BinaryWriter &writer) const;
+  void read(BinaryReader &reader);
 };
 
 } // namespace dc
@@ -5,23 +5,23 @@
 namespace dc
 {
 
-void PointLightComponent::save(FILE *file) const
+void PointLightComponent::save(BinaryWriter &writer) const
 {
-  write_value(file, color_);
-  write_value(file, multiplier_);
-  write_value(file, radius_);
-  write_value(file, falloff_);
-  write_value(file, cast_shadow_);
+  write_value(writer, color_);
+  write_value(writer, multiplier_);
+  write_value(writer, radius_);
+  write_value(writer, falloff_);
+  write_value(writer, cast_shadow_);
 }
 
-void PointLightComponent::read(FILE *file)
+void PointLightComponent::read(BinaryReader &reader)
 {
-  read_value(file, color_);
-  read_value(file, multiplier_);
-  read_value(file, radius_);
-  read_value(file, falloff_);
+  read_value(reader, color_);
+  read_value(reader, multiplier_);
+  read_value(reader, radius_);
+  read_value(reader, falloff_);
   bool is_cast_shadow{false};
-  read_value(file, is_cast_shadow);
+  read_value(reader, is_cast_shadow);
   set_cast_shadow(is_cast_shadow);
 }
 
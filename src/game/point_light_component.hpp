@@ -6,6 +6,9 @@
 namespace dc
 {
 
+class BinaryReader;
+class BinaryWriter;
+
 struct PointLightComponent
 {
   glm::vec3 color_{1.0f};
@@ -22,8 +25,8 @@ struct PointLightComponent
   bool                           cast_shadow_{false};
   std::shared_ptr<GlCubeTexture> shadow_tex_{};
 
-  void save(FILE *file) const;
-  void read(FILE *file);
+  void save(BinaryWriter &writer) const;
+  void read(BinaryReader &reader);
 };
 
 } // namespace dc
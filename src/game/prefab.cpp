@@ -0,0 +1,109 @@
+#include "prefab.hpp"
+#include "name_component.hpp"
+#include "scene_columns.hpp"
+#include "serialization.hpp"
+#include "transform_component.hpp"
+#include "uuid.hpp"
+
+#include <stdexcept>
+#include <unordered_map>
+
+namespace dc
+{
+
+AssetDescription Prefab::read(BinaryReader &reader)
+{
+  AssetDescription asset_description{};
+  asset_description.read(reader);
+  if (asset_description.version_ < scene_columns_version)
+  {
+    throw std::runtime_error{"Prefabs need to be stored as columns"};
+  }
+
+  std::vector<Uuid> uuids;
+  read_vector(reader, uuids);
+
+  std::unordered_map<Uuid, std::int32_t> uuid_to_index;
+  uuid_to_index.reserve(uuids.size());
+  for (std::size_t i{0}; i < uuids.size(); ++i)
+  {
+    if (uuids[i] == 0 ||
+        !uuid_to_index.emplace(uuids[i], static_cast<std::int32_t>(i)).second)
+    {
+      throw std::runtime_error{"Invalid or duplicated entity id in prefab"};
+    }
+  }
+
+  entities_.resize(uuids.size());
+  registry_.create(entities_.begin(), entities_.end());
+
+  insert_components<NameComponent>(reader, registry_, entities_);
+  insert_transform_components(reader,
+                              registry_,
+                              entities_,
+                              asset_description.version_);
+
+  // same layout as the relationship component, links that point out of the
+  // prefab get dropped
+  const auto read_link = [&]()
+  {
+    Uuid uuid{0};
+    read_value(reader, uuid);
+    const auto iter = uuid_to_index.find(uuid);
+    return iter != uuid_to_index.end() ? iter->second : -1;
+  };
+  links_.resize(uuids.size());
+  for (auto &links : links_)
+  {
+    links.parent_           = read_link();
+    links.first_child_      = read_link();
+    links.next_sibling_     = read_link();
+    links.previous_sibling_ = read_link();
+  }
+
+  read_component_columns(reader, registry_, entities_);
+
+  std::vector<std::uint32_t> roots;
+  for (std::size_t i{0}; i < links_.size(); ++i)
+  {
+    if (links_[i].parent_ < 0)
+    {
+      roots.push_back(static_cast<std::uint32_t>(i));
+    }
+  }
+  if (roots.size() != 1)
+  {
+    throw std::runtime_error{"Prefab needs a single root entity"};
+  }
+  root_index_ = roots.front();
+
+  hierarchy_order_.clear();
+  hierarchy_order_.reserve(links_.size());
+  hierarchy_order_.push_back(root_index_);
+  std::vector<bool> is_visited(links_.size(), false);
+  is_visited[root_index_] = true;
+  for (std::size_t i{0}; i < hierarchy_order_.size(); ++i)
+  {
+    auto child = links_[hierarchy_order_[i]].first_child_;
+    while (child >= 0)
+    {
+      if (is_visited[child])
+      {
+        throw std::runtime_error{"Invalid hierarchy in prefab"};
+      }
+      is_visited[child] = true;
+      hierarchy_order_.push_back(static_cast<std::uint32_t>(child));
+      child = links_[child].next_sibling_;
+    }
+  }
+  if (hierarchy_order_.size() != links_.size())
+  {
+    throw std::runtime_error{"Invalid hierarchy in prefab"};
+  }
+
+  return asset_description;
+}
+
+std::size_t Prefab::entity_count() const { return entities_.size(); }
+
+} // namespace dc
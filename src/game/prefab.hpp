@@ -0,0 +1,51 @@
+#pragma once
+
+#include "asset_description.hpp"
+
+#include <entt/entt.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dc
+{
+
+class BinaryReader;
+class Scene;
+
+/**
+ * Entity hierarchy that can be spawned many times. A prefab is stored like a
+ * scene with a single root entity. Its components live in a registry of
+ * their own that fires no signals, so no physic actors or scripts get
+ * created for the template. Scene::instantiate() copies the components from
+ * here.
+ */
+class Prefab
+{
+public:
+  AssetDescription read(BinaryReader &reader);
+
+  std::size_t entity_count() const;
+
+private:
+  friend Scene;
+
+  // index of the linked entity in the prefab, -1 if there is none
+  struct Links
+  {
+    std::int32_t parent_{-1};
+    std::int32_t first_child_{-1};
+    std::int32_t next_sibling_{-1};
+    std::int32_t previous_sibling_{-1};
+  };
+
+  entt::registry            registry_;
+  std::vector<entt::entity> entities_;
+  std::vector<Links>        links_;
+  // parents come before their children
+  std::vector<std::uint32_t> hierarchy_order_;
+  std::uint32_t              root_index_{0};
+};
+
+} // namespace dc
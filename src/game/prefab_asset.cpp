@@ -0,0 +1,49 @@
+#include "prefab_asset.hpp"
+#include "binary_reader.hpp"
+#include "log.hpp"
+
+#include <stdexcept>
+
+namespace dc
+{
+
+PrefabAssetHandle::PrefabAssetHandle(const Asset &asset) : AssetHandle{asset}
+{
+}
+
+bool PrefabAssetHandle::is_ready() const { return prefab_ != nullptr; }
+
+void PrefabAssetHandle::load(const AssetData &asset_data)
+{
+  data_.assign(asset_data.data_, asset_data.data_ + asset_data.size_);
+}
+
+void PrefabAssetHandle::create()
+{
+  try
+  {
+    auto         prefab = std::make_shared<Prefab>();
+    BinaryReader reader{data_.data(), data_.size()};
+    prefab->read(reader);
+    set_memory_usage(data_.size(), 0);
+    prefab_ = std::move(prefab);
+  }
+  catch (const std::runtime_error &error)
+  {
+    DC_LOG_WARN("Could not load prefab asset {}: {}",
+                asset().id(),
+                error.what());
+  }
+  data_ = {};
+}
+
+std::shared_ptr<Prefab> PrefabAssetHandle::get() const { return prefab_; }
+
+std::shared_ptr<AssetHandle>
+prefab_asset_loader(const std::filesystem::path & /*file_path*/,
+                    const Asset &asset)
+{
+  return std::make_shared<PrefabAssetHandle>(asset);
+}
+
+} // namespace dc
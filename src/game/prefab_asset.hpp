@@ -0,0 +1,37 @@
+#pragma once
+
+#include "asset.hpp"
+#include "asset_handle.hpp"
+#include "prefab.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace dc
+{
+
+class PrefabAssetHandle : public AssetHandle
+{
+public:
+  PrefabAssetHandle(const Asset &asset);
+
+  bool is_ready() const override;
+
+  void load(const AssetData &asset_data) override;
+  void create() override;
+
+  std::shared_ptr<Prefab> get() const;
+
+private:
+  // the components load their assets synchronously, so the prefab gets read
+  // on the main thread in create()
+  std::vector<std::uint8_t> data_;
+  std::shared_ptr<Prefab>   prefab_{};
+};
+
+std::shared_ptr<AssetHandle>
+prefab_asset_loader(const std::filesystem::path &file_path, const Asset &asset);
+
+} // namespace dc
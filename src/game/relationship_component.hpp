@@ -6,6 +6,9 @@
 namespace dc
 {
 
+class BinaryReader;
+class BinaryWriter;
+
 class Scene;
 
 struct RelationshipComponent
@@ -16,8 +19,8 @@ struct RelationshipComponent
   Entity next_sibling_;
   Entity previous_sibling_;
 
-  void save(FILE *file) const;
-  void read(FILE *file, Scene &active_scene);
+  void save(BinaryWriter &writer) const;
+  void read(BinaryReader &reader, Scene &active_scene);
 };
 
 } // namespace dc
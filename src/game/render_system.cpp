@@ -22,6 +22,14 @@ namespace dc
 
 void RenderSystem::init()
 {
+  const auto config = Engine::instance()->config();
+  lod_settings_.max_pixel_error_ =
+      config->config_value_float("Renderer", "lod_max_pixel_error", 1.0f);
+  lod_settings_.quality_bias_ =
+      config->config_value_float("Renderer", "lod_quality_bias", 1.0f);
+  lod_settings_.shadow_bias_ =
+      config->config_value_float("Renderer", "shadow_lod_bias", 4.0f);
+
   const auto game_layer = Engine::instance()->layer_stack()->layer<GameLayer>();
   if (game_layer)
   {
@@ -36,7 +44,7 @@ void RenderSystem::init()
 void RenderSystem::update(float /*delta_time*/) {}
 
 void RenderSystem::render(SceneRenderInfo &scene_render_info,
-                          ViewRenderInfo & /*view_render_info*/)
+                          ViewRenderInfo  &view_render_info)
 {
   DC_PROFILE_SCOPE("RenderSystem::render()");
 
@@ -53,8 +61,7 @@ void RenderSystem::render(SceneRenderInfo &scene_render_info,
     auto view = scene->all_entities_with<TransformComponent, MeshComponent>();
     for (const auto entity : view)
     {
-      const auto &transform_component = view.get<TransformComponent>(entity);
-      const auto &model_component     = view.get<MeshComponent>(entity);
+      const auto &model_component = view.get<MeshComponent>(entity);
 
       const auto &model = model_component.model_;
       if (!model || !model->is_ready())
@@ -62,16 +69,35 @@ void RenderSystem::render(SceneRenderInfo &scene_render_info,
         continue;
       }
 
+      const auto model_matrix = scene->world_matrix(entity);
       for (const auto &mesh : model->get()->meshes())
       {
         MeshInfo mesh_info{};
         mesh_info.mesh_         = mesh;
-        mesh_info.model_matrix_ = transform_component.transform_matrix();
+        mesh_info.model_matrix_ = model_matrix;
         scene_render_info.add_mesh(std::move(mesh_info));
       }
     }
   }
 
+  // select levels of detail
+  {
+    DC_PROFILE_SCOPE("RenderSystem::render() - Select levels of detail");
+
+    // the viewport gets set after the systems ran, until then the view
+    // covers the window
+    auto lod_view_render_info = view_render_info;
+    if (lod_view_render_info.viewport_info().height_ <= 0)
+    {
+      const auto window = Engine::instance()->window();
+      lod_view_render_info.set_viewport_info(
+          {0, 0, window->width(), window->height()});
+    }
+
+    scene_render_info.set_lod_settings(lod_settings_);
+    scene_render_info.select_lods(lod_view_render_info);
+  }
+
   // add skinned meshes
   {
     DC_PROFILE_SCOPE("RenderSystem::render() - Process skinned meshes");
@@ -80,7 +106,6 @@ void RenderSystem::render(SceneRenderInfo &scene_render_info,
         scene->all_entities_with<TransformComponent, SkinnedMeshComponent>();
     for (const auto entity : view)
     {
-      const auto &transform_component = view.get<TransformComponent>(entity);
       const auto &skinned_mesh_component =
           view.get<SkinnedMeshComponent>(entity);
 
@@ -93,12 +118,12 @@ void RenderSystem::render(SceneRenderInfo &scene_render_info,
       }
       const auto skinned_mesh = skinned_mesh_asset->get();
 
+      const auto model_matrix = scene->world_matrix(entity);
       for (const auto &sub_mesh : skinned_mesh_asset->get()->sub_meshes())
       {
         SkinnedMeshInfo skinned_mesh_info{};
         skinned_mesh_info.skinned_sub_mesh_ = sub_mesh;
-        skinned_mesh_info.model_matrix_ =
-            transform_component.transform_matrix();
+        skinned_mesh_info.model_matrix_     = model_matrix;
         skinned_mesh_info.bones_ = animation_state->bone_transforms();
 
         scene_render_info.add_skinned_mesh(std::move(skinned_mesh_info));
@@ -196,6 +221,21 @@ void RenderSystem::render(SceneRenderInfo &scene_render_info,
   }
 }
 
+const char *RenderSystem::name() const { return "RenderSystem"; }
+
+SystemAccess RenderSystem::access(SystemPhase phase) const
+{
+  if (phase == SystemPhase::Render)
+  {
+    return SystemAccess{}
+        .reads<TransformComponent, MeshComponent, SkinnedMeshComponent>()
+        .reads<PointLightComponent, DirectionalLightComponent, SkyComponent>()
+        .reads<ViewRenderInfo>()
+        .writes<SceneRenderInfo>();
+  }
+  return {};
+}
+
 bool RenderSystem::on_event(const Event &event)
 {
   const auto event_id = event.id();
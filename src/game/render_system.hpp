@@ -21,8 +21,12 @@ public:
 
   bool on_event(const Event &event) override;
 
+  const char  *name() const override;
+  SystemAccess access(SystemPhase phase) const override;
+
 private:
   std::weak_ptr<Scene> scene_{};
+  LodSettings          lod_settings_{};
 
   void on_scene_loaded(const SceneLoadedEvent &event);
 };
@@ -1,12 +1,14 @@
 #include "scene.hpp"
 #include "audio/audio_listener_component.hpp"
 #include "audio/audio_source_component.hpp"
+#include "binary_reader.hpp"
 #include "camera_component.hpp"
 #include "component_types.hpp"
 #include "directional_light_component.hpp"
 #include "engine.hpp"
 #include "entity.hpp"
 #include "event.hpp"
+#include "filesystem.hpp"
 #include "guid_component.hpp"
 #include "log.hpp"
 #include "mesh.hpp"
@@ -20,10 +22,13 @@
 #include "physic/rigid_body_component.hpp"
 #include "physic/sphere_collider_component.hpp"
 #include "point_light_component.hpp"
+#include "prefab.hpp"
 #include "profiling.hpp"
 #include "relationship_component.hpp"
 #include "render_system.hpp"
+#include "scene_columns.hpp"
 #include "scene_events.hpp"
+#include "scene_stream.hpp"
 #include "script/script_component.hpp"
 #include "serialization.hpp"
 #include "skinned_mesh_component.hpp"
@@ -31,9 +36,36 @@
 #include "transform_component.hpp"
 #include "uuid.hpp"
 
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <memory>
-#include <type_traits>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+
+// patching the hierarchy order with more entities is slower than rebuilding
+// it
+constexpr std::size_t max_pending_transforms{4096};
+
+bool is_linked(const entt::registry            &registry,
+               const dc::RelationshipComponent &relationship_component)
+{
+  const auto is_valid = [&registry](const dc::Entity &entity)
+  {
+    const auto entity_handle = entity.entity_handle();
+    return entity_handle != entt::null && registry.valid(entity_handle);
+  };
+  return is_valid(relationship_component.parent_) ||
+         is_valid(relationship_component.first_child_) ||
+         is_valid(relationship_component.next_sibling_) ||
+         is_valid(relationship_component.previous_sibling_);
+}
+
+} // namespace
 
 namespace dc
 {
@@ -45,6 +77,16 @@ std::shared_ptr<Scene> Scene::create()
 
 Scene::Scene()
 {
+  registry_.on_construct<TransformComponent>()
+      .connect<&Scene::on_transform_component_construct>(this);
+  registry_.on_destroy<TransformComponent>()
+      .connect<&Scene::on_transform_component_destroy>(this);
+
+  registry_.on_construct<RelationshipComponent>()
+      .connect<&Scene::on_relationship_component_construct>(this);
+  registry_.on_destroy<RelationshipComponent>()
+      .connect<&Scene::on_relationship_component_destroy>(this);
+
   registry_.on_construct<ScriptComponent>()
       .connect<&Scene::on_script_component_construct>(this);
   registry_.on_destroy<ScriptComponent>()
@@ -84,6 +126,17 @@ Scene::Scene()
       .connect<&Scene::on_audio_source_component_construct>(this);
   registry_.on_destroy<AudioSourceComponent>()
       .connect<&Scene::on_audio_source_component_destroy>(this);
+
+  // systems view the scene concurrently and views create missing storages,
+  // so the storages of the components they read get created up front
+  registry_.storage<TransformComponent>();
+  registry_.storage<CameraComponent>();
+  registry_.storage<MeshComponent>();
+  registry_.storage<SkinnedMeshComponent>();
+  registry_.storage<PointLightComponent>();
+  registry_.storage<DirectionalLightComponent>();
+  registry_.storage<SkyComponent>();
+  registry_.storage<AudioListenerComponent>();
 }
 
 Entity Scene::create_entity(const std::string &name)
@@ -127,6 +180,8 @@ void Scene::remove_entities()
     {
       const auto e = entity(id);
       registry_.destroy(e.entity_handle());
+      // streamed cells remove their entities by id later on
+      uuid_to_entity_map_.erase(id);
     }
     entities_to_remove.clear();
   }
@@ -170,263 +225,590 @@ bool Scene::exists(Uuid uuid) const
   return iter != uuid_to_entity_map_.end();
 }
 
-void Scene::save(const std::filesystem::path &file_path,
-                 const AssetDescription &     asset_description)
+EntityRef Scene::entity_ref(Uuid uuid)
 {
-  DC_PROFILE_SCOPE("Scene::save()");
-
-  const auto file = std::fopen(file_path.string().c_str(), "wb");
-  if (!file)
+  const auto iter = uuid_to_entity_map_.find(uuid);
+  if (iter == uuid_to_entity_map_.end())
   {
-    throw std::runtime_error{"Could not open file " + file_path.string()};
+    return {};
   }
-  defer(std::fclose(file));
+  return EntityRef{*this, registry_, iter->second};
+}
 
-  asset_description.write(file);
+EntityRef Scene::entity_ref(entt::entity entity_handle)
+{
+  return EntityRef{*this, registry_, entity_handle};
+}
 
-  const auto &view = registry_.view<GuidComponent>();
-  write_value(file, static_cast<std::uint64_t>(view.size()));
-  for (const auto &e : view)
+std::vector<EntityRef>
+Scene::entity_refs(const std::vector<entt::entity> &entity_handles)
+{
+  std::vector<EntityRef> entities;
+  entities.reserve(entity_handles.size());
+  for (const auto entity_handle : entity_handles)
   {
-    Entity entity{e, shared_from_this()};
-    entity.component<GuidComponent>().save(file);
-    entity.component<NameComponent>().save(file);
-    entity.component<TransformComponent>().save(file);
-    entity.component<RelationshipComponent>().save(file);
-
-    if (entity.has_component<MeshComponent>())
-    {
-      write_string(file, "*model*");
-      entity.component<MeshComponent>().save(file);
-    }
-
-    if (entity.has_component<SkinnedMeshComponent>())
-    {
-      write_string(file, "*skinnedmesh*");
-      entity.component<SkinnedMeshComponent>().save(file);
-    }
+    entities.emplace_back(*this, registry_, entity_handle);
+  }
+  return entities;
+}
 
-    if (entity.has_component<SkyComponent>())
-    {
-      write_string(file, "*sky*");
-      entity.component<SkyComponent>().save(file);
-    }
+void Scene::save(const std::filesystem::path &file_path,
+                 const AssetDescription &     asset_description)
+{
+  DC_PROFILE_SCOPE("Scene::save()");
 
-    if (entity.has_component<PointLightComponent>())
-    {
-      write_string(file, "*pointlight*");
-      entity.component<PointLightComponent>().save(file);
-    }
+  BinaryWriter writer{};
 
-    if (entity.has_component<DirectionalLightComponent>())
-    {
-      write_string(file, "*directionallight*");
-      entity.component<DirectionalLightComponent>().save(file);
-    }
+  auto versioned_asset_description     = asset_description;
+  versioned_asset_description.version_ = scene_version;
+  versioned_asset_description.write(writer);
 
-    if (entity.has_component<CameraComponent>())
-    {
-      write_string(file, "*camera*");
-      entity.component<CameraComponent>().save(file);
-    }
-
-    if (entity.has_component<ScriptComponent>())
-    {
-      write_string(file, "*script*");
-      entity.component<ScriptComponent>().save(file);
-    }
+  write_entities(writer, saved_entities());
 
-    if (entity.has_component<BoxColliderComponent>())
-    {
-      write_string(file, "*boxcollider*");
-      entity.component<BoxColliderComponent>().save(file);
-    }
+  writer.save(file_path);
+}
 
-    if (entity.has_component<SphereColliderComponent>())
-    {
-      write_string(file, "*spherecollider*");
-      entity.component<SphereColliderComponent>().save(file);
-    }
+std::vector<std::uint8_t> Scene::snapshot()
+{
+  DC_PROFILE_SCOPE("Scene::snapshot()");
 
-    if (entity.has_component<CapsuleColliderComponent>())
-    {
-      write_string(file, "*capsulecollider*");
-      entity.component<CapsuleColliderComponent>().save(file);
-    }
+  BinaryWriter writer{};
+  write_entities(writer, saved_entities());
+  return writer.release();
+}
 
-    if (entity.has_component<MeshColliderComponent>())
-    {
-      write_string(file, "*meshcollider*");
-      entity.component<MeshColliderComponent>().save(file);
-    }
+void Scene::restore(const std::vector<std::uint8_t> &snapshot)
+{
+  DC_PROFILE_SCOPE("Scene::restore()");
 
-    if (entity.has_component<RigidBodyComponent>())
-    {
-      write_string(file, "*rigidbody*");
-      entity.component<RigidBodyComponent>().save(file);
-    }
+  // the destroy signals remove the physic actors, scripts and audio sources
+  const auto entities = saved_entities();
+  for (const auto entity : entities)
+  {
+    uuid_to_entity_map_.erase(registry_.get<GuidComponent>(entity).id_);
+  }
+  registry_.destroy(entities.begin(), entities.end());
+  entities_to_remove.clear();
 
-    if (entity.has_component<CharacterControllerComponent>())
-    {
-      write_string(file, "*charactercontroller*");
-      entity.component<CharacterControllerComponent>().save(file);
-    }
+  BinaryReader reader{snapshot.data(), snapshot.size()};
+  read_entity_columns(reader, scene_version);
+}
 
-    if (entity.has_component<AudioSourceComponent>())
-    {
-      write_string(file, "*audiosource*");
-      entity.component<AudioSourceComponent>().save(file);
-    }
+std::vector<entt::entity> Scene::saved_entities()
+{
+  // streamed entities are saved in their cells
+  const auto &view =
+      registry_.view<GuidComponent>(entt::exclude<StreamedComponent>);
+  return {view.begin(), view.end()};
+}
 
-    if (entity.has_component<AudioListenerComponent>())
-    {
-      write_string(file, "*audiolistener*");
-      entity.component<AudioListenerComponent>().save(file);
-    }
+void Scene::write_entities(BinaryWriter                    &writer,
+                           const std::vector<entt::entity> &entities)
+{
+  // the columns refer to entities by their index in the id column
+  std::unordered_map<entt::entity, std::uint32_t> entity_indices;
+  entity_indices.reserve(entities.size());
+  std::vector<Uuid> uuids;
+  uuids.reserve(entities.size());
+  for (const auto entity : entities)
+  {
+    entity_indices.emplace(entity,
+                           static_cast<std::uint32_t>(entity_indices.size()));
+    uuids.push_back(registry_.get<GuidComponent>(entity).id_);
+  }
 
-    write_string(file, "*end*");
+  // every entity has these components, so they are stored without indices
+  write_vector(writer, uuids);
+  for (const auto entity : entities)
+  {
+    registry_.get<NameComponent>(entity).save(writer);
+  }
+  for (const auto entity : entities)
+  {
+    registry_.get<TransformComponent>(entity).save(writer);
+  }
+  for (const auto entity : entities)
+  {
+    registry_.get<RelationshipComponent>(entity).save(writer);
   }
+
+  write_component_columns(writer, registry_, entity_indices);
 }
 
 AssetDescription Scene::read(const std::filesystem::path &file_path)
 {
   DC_PROFILE_SCOPE("Scene::read()");
 
-  const auto file = std::fopen(file_path.string().c_str(), "rb");
-  if (!file)
+  // one read for the whole file, the bounds checked reader throws on
+  // truncated scenes
+  const auto data = read_binary_file(file_path);
+  if (data.empty())
   {
-    throw std::runtime_error{"Could not open file " + file_path.string()};
+    throw std::runtime_error{"File is empty: " + file_path.string()};
   }
-  defer(std::fclose(file));
+  BinaryReader reader{data.data(), data.size()};
 
-  if (std::feof(file))
+  AssetDescription asset_description{};
+  asset_description.read(reader);
+
+  if (asset_description.version_ >= scene_columns_version)
   {
-    throw std::runtime_error{"File is empty: " + file_path.string()};
+    read_entity_columns(reader, asset_description.version_);
+  }
+  else
+  {
+    read_tagged_entities(reader);
   }
 
-  AssetDescription asset_description{};
-  asset_description.read(file);
+  return asset_description;
+}
+
+void Scene::read_tagged_entities(BinaryReader &reader)
+{
+  DC_PROFILE_SCOPE("Scene::read_tagged_entities()");
 
   std::uint64_t entity_count{};
-  read_value(file, entity_count);
+  read_value(reader, entity_count);
   for (std::uint64_t i{0}; i < entity_count; ++i)
   {
     GuidComponent uuid_component;
-    uuid_component.read(file);
+    uuid_component.read(reader);
 
     auto entity = get_or_create_entity(uuid_component.id_);
     entity.set_id(uuid_component.id_);
 
     auto &name_component = entity.component<NameComponent>();
-    name_component.read(file);
+    name_component.read(reader);
 
     auto &transform_component = entity.component<TransformComponent>();
-    transform_component.read(file);
+    transform_component.read(reader);
+    skip_world_matrices(reader);
 
     auto &relationship_component = entity.component<RelationshipComponent>();
-    relationship_component.read(file, *this);
+    relationship_component.read(reader, *this);
 
     std::string marker;
-    read_string(file, marker);
+    read_string(reader, marker);
 
     while (marker != "*end*")
     {
       if (marker == "*model*")
       {
         MeshComponent component{};
-        component.read(file);
+        component.read(reader);
         entity.add_component<MeshComponent>(std::move(component));
       }
       else if (marker == "*skinnedmesh*")
       {
         SkinnedMeshComponent component{};
-        component.read(file);
+        component.read(reader);
         entity.add_component<SkinnedMeshComponent>(component);
       }
       else if (marker == "*pointlight*")
       {
         PointLightComponent component{};
-        component.read(file);
+        component.read(reader);
         entity.add_component<PointLightComponent>(std::move(component));
       }
       else if (marker == "*directionallight*")
       {
         DirectionalLightComponent component{};
-        component.read(file);
+        component.read(reader);
         entity.add_component<DirectionalLightComponent>(std::move(component));
       }
       else if (marker == "*camera*")
       {
         CameraComponent component{};
-        component.read(file);
+        component.read(reader);
         entity.add_component<CameraComponent>(std::move(component));
       }
       else if (marker == "*sky*")
       {
         SkyComponent component{};
-        component.read(file);
+        component.read(reader);
         entity.add_component<SkyComponent>(std::move(component));
       }
       else if (marker == "*script*")
       {
         ScriptComponent component{};
-        component.read(file);
+        component.read(reader);
         entity.add_component<ScriptComponent>(std::move(component));
       }
       else if (marker == "*boxcollider*")
       {
         BoxColliderComponent component{};
-        component.read(file);
+        component.read(reader);
         entity.add_component<BoxColliderComponent>(std::move(component));
       }
       else if (marker == "*spherecollider*")
       {
         SphereColliderComponent component{};
-        component.read(file);
+        component.read(reader);
         entity.add_component<SphereColliderComponent>(std::move(component));
       }
       else if (marker == "*capsulecollider*")
       {
         CapsuleColliderComponent component{};
-        component.read(file);
+        component.read(reader);
         entity.add_component<CapsuleColliderComponent>(std::move(component));
       }
       else if (marker == "*meshcollider*")
       {
         MeshColliderComponent component{};
-        component.read(file);
+        component.read(reader);
         entity.add_component<MeshColliderComponent>(std::move(component));
       }
       else if (marker == "*rigidbody*")
       {
         RigidBodyComponent component{};
-        component.read(file);
+        component.read(reader);
         entity.add_component<RigidBodyComponent>(std::move(component));
       }
       else if (marker == "*charactercontroller*")
       {
         CharacterControllerComponent component{};
-        component.read(file);
+        component.read(reader);
         entity.add_component<CharacterControllerComponent>(
             std::move(component));
       }
       else if (marker == "*audiosource*")
       {
         AudioSourceComponent component{};
-        component.read(file);
+        component.read(reader);
         entity.add_component<AudioSourceComponent>(std::move(component));
       }
       else if (marker == "*audiolistener*")
       {
         AudioListenerComponent component{};
-        component.read(file);
+        component.read(reader);
         entity.add_component<AudioListenerComponent>(std::move(component));
       }
-      read_string(file, marker);
+      read_string(reader, marker);
     }
   }
 
-  return asset_description;
+  // the links got read into existing components
+  set_hierarchy_changed();
+}
+
+std::vector<Uuid> Scene::read_entity_columns(BinaryReader &reader,
+                                             std::uint32_t version)
+{
+  DC_PROFILE_SCOPE("Scene::read_entity_columns()");
+
+  std::vector<Uuid> uuids;
+  read_vector(reader, uuids);
+
+  std::vector<entt::entity> entities(uuids.size());
+  registry_.create(entities.begin(), entities.end());
+  uuid_to_entity_map_.reserve(uuid_to_entity_map_.size() + uuids.size());
+  for (std::size_t i{0}; i < uuids.size(); ++i)
+  {
+    if (uuids[i] == 0 ||
+        !uuid_to_entity_map_.emplace(uuids[i], entities[i]).second)
+    {
+      throw std::runtime_error{"Invalid or duplicated entity id in scene"};
+    }
+  }
+
+  std::vector<GuidComponent> guid_components;
+  guid_components.reserve(uuids.size());
+  for (const auto uuid : uuids)
+  {
+    guid_components.emplace_back(uuid);
+  }
+  registry_.insert<GuidComponent>(entities.begin(),
+                                  entities.end(),
+                                  std::make_move_iterator(
+                                      guid_components.begin()));
+
+  insert_components<NameComponent>(reader, registry_, entities);
+  insert_transform_components(reader, registry_, entities, version);
+
+  // all entities exist at this point, so the relationships can be resolved
+  std::vector<RelationshipComponent> relationship_components(entities.size());
+  for (auto &relationship_component : relationship_components)
+  {
+    relationship_component.read(reader, *this);
+  }
+  registry_.insert<RelationshipComponent>(
+      entities.begin(),
+      entities.end(),
+      std::make_move_iterator(relationship_components.begin()));
+
+  read_component_columns(reader, registry_, entities);
+
+  return uuids;
+}
+
+std::vector<Uuid> Scene::add_streamed_entities(BinaryReader &reader)
+{
+  DC_PROFILE_SCOPE("Scene::add_streamed_entities()");
+
+  AssetDescription asset_description{};
+  asset_description.read(reader);
+  if (asset_description.version_ < scene_columns_version)
+  {
+    throw std::runtime_error{"Can only stream scenes stored as columns"};
+  }
+
+  const auto uuids = read_entity_columns(reader, asset_description.version_);
+
+  std::vector<entt::entity> entities;
+  entities.reserve(uuids.size());
+  for (const auto uuid : uuids)
+  {
+    entities.push_back(uuid_to_entity_map_.at(uuid));
+  }
+  registry_.insert<StreamedComponent>(entities.begin(), entities.end());
+
+  return uuids;
+}
+
+void Scene::remove_streamed_entities(const std::vector<Uuid> &uuids)
+{
+  DC_PROFILE_SCOPE("Scene::remove_streamed_entities()");
+
+  std::vector<entt::entity> entities;
+  entities.reserve(uuids.size());
+  for (const auto uuid : uuids)
+  {
+    const auto iter = uuid_to_entity_map_.find(uuid);
+    if (iter == uuid_to_entity_map_.end())
+    {
+      continue;
+    }
+    entities.push_back(iter->second);
+    uuid_to_entity_map_.erase(iter);
+  }
+  registry_.destroy(entities.begin(), entities.end());
+}
+
+void Scene::save_prefab(Entity                       root,
+                        const std::filesystem::path &file_path,
+                        const AssetDescription      &asset_description)
+{
+  DC_PROFILE_SCOPE("Scene::save_prefab()");
+
+  // the root comes first, followed by all of its descendants
+  std::vector<entt::entity> entities{root.entity_handle()};
+  for (std::size_t i{0}; i < entities.size(); ++i)
+  {
+    auto child = registry_.get<RelationshipComponent>(entities[i]).first_child_;
+    while (child.valid())
+    {
+      entities.push_back(child.entity_handle());
+      child = child.component<RelationshipComponent>().next_sibling_;
+    }
+  }
+
+  BinaryWriter writer{};
+
+  auto versioned_asset_description     = asset_description;
+  versioned_asset_description.version_ = scene_version;
+  versioned_asset_description.write(writer);
+
+  write_entities(writer, entities);
+
+  writer.save(file_path);
+}
+
+std::vector<Uuid> Scene::instantiate(const Prefab                 &prefab,
+                                     const std::vector<glm::mat4> &transforms)
+{
+  DC_PROFILE_SCOPE("Scene::instantiate()");
+
+  const auto prefab_count = prefab.entities_.size();
+  const auto count        = transforms.size();
+  if (prefab_count == 0 || count == 0)
+  {
+    return {};
+  }
+
+  // the copies of prefab entity i are stored at [i * count, (i + 1) * count)
+  std::vector<entt::entity> entities(prefab_count * count);
+  registry_.create(entities.begin(), entities.end());
+
+  // every copy gets a new id
+  std::vector<GuidComponent> guid_components(entities.size());
+  uuid_to_entity_map_.reserve(uuid_to_entity_map_.size() + entities.size());
+  for (std::size_t i{0}; i < entities.size(); ++i)
+  {
+    uuid_to_entity_map_.emplace(guid_components[i].id_, entities[i]);
+  }
+  registry_.insert<GuidComponent>(entities.begin(),
+                                  entities.end(),
+                                  guid_components.begin());
+
+  for (std::size_t i{0}; i < prefab_count; ++i)
+  {
+    const auto prefab_entity = prefab.entities_[i];
+    const auto first         = entities.begin() + i * count;
+    registry_.insert<NameComponent>(
+        first,
+        first + count,
+        prefab.registry_.get<NameComponent>(prefab_entity));
+    registry_.insert<TransformComponent>(
+        first,
+        first + count,
+        prefab.registry_.get<TransformComponent>(prefab_entity));
+  }
+
+  // links point to the copies of the same instance
+  const std::weak_ptr<Scene> scene = weak_from_this();
+  const auto entity_at = [&](std::int32_t index, std::size_t instance)
+  {
+    return index < 0 ? Entity{}
+                     : Entity{entities[static_cast<std::size_t>(index) * count +
+                                       instance],
+                              scene};
+  };
+  std::vector<RelationshipComponent> relationship_components(entities.size());
+  for (std::size_t i{0}; i < prefab_count; ++i)
+  {
+    const auto &links = prefab.links_[i];
+    for (std::size_t j{0}; j < count; ++j)
+    {
+      auto &relationship_component = relationship_components[i * count + j];
+      relationship_component.parent_      = entity_at(links.parent_, j);
+      relationship_component.first_child_ = entity_at(links.first_child_, j);
+      relationship_component.next_sibling_ =
+          entity_at(links.next_sibling_, j);
+      relationship_component.previous_sibling_ =
+          entity_at(links.previous_sibling_, j);
+    }
+  }
+  registry_.insert<RelationshipComponent>(
+      entities.begin(),
+      entities.end(),
+      std::make_move_iterator(relationship_components.begin()));
+
+  // the transforms need to be final before the physic actors get created,
+  // so the world matrices of the copies get updated right away
+  for (std::size_t j{0}; j < count; ++j)
+  {
+    for (const auto i : prefab.hierarchy_order_)
+    {
+      const auto entity    = entities[i * count + j];
+      auto      &transform = registry_.get<TransformComponent>(entity);
+      if (i != prefab.root_index_)
+      {
+        const auto parent =
+            static_cast<std::size_t>(prefab.links_[i].parent_);
+        set_world_matrix(entity,
+                         world_matrix(entities[parent * count + j]) *
+                             transform.local_transform_matrix());
+        transform.clear_dirty();
+        continue;
+      }
+
+      glm::vec3 position{};
+      glm::vec3 rotation{};
+      glm::vec3 scale{};
+      if (math::decompose_transform(transforms[j] *
+                                        transform.local_transform_matrix(),
+                                    position,
+                                    rotation,
+                                    scale))
+      {
+        transform.set_position(position);
+        transform.set_rotation(rotation);
+        transform.set_scale(scale);
+      }
+      set_world_matrix(entity, transform.local_transform_matrix());
+      transform.clear_dirty();
+    }
+  }
+
+  copy_component_columns(prefab.registry_,
+                         prefab.entities_,
+                         registry_,
+                         entities);
+
+  std::vector<Uuid> root_uuids(count);
+  for (std::size_t j{0}; j < count; ++j)
+  {
+    root_uuids[j] = guid_components[prefab.root_index_ * count + j].id_;
+  }
+  return root_uuids;
+}
+
+std::uint64_t Scene::hierarchy_version() const { return hierarchy_version_; }
+
+void Scene::set_hierarchy_changed()
+{
+  ++hierarchy_version_;
+  // the rebuilt order contains them
+  added_transforms_.clear();
+  removed_transforms_.clear();
+}
+
+glm::mat4 Scene::world_matrix(entt::entity entity_handle) const
+{
+  const auto &storage = registry_.storage<TransformComponent>();
+  if (!storage.contains(entity_handle))
+  {
+    return glm::mat4{1.0f};
+  }
+  return world_matrices_.get(storage.index(entity_handle));
+}
+
+void Scene::set_world_matrix(entt::entity     entity_handle,
+                             const glm::mat4 &value)
+{
+  world_matrices_.set(
+      registry_.storage<TransformComponent>().index(entity_handle),
+      value);
+}
+
+void Scene::on_transform_component_construct(entt::registry &registry,
+                                             entt::entity    entity)
+{
+  // inserted ranges signal after all components got added. Copied
+  // components need the world matrix of their own parent
+  const auto &storage = registry.storage<TransformComponent>();
+  world_matrices_.resize(storage.size());
+  world_matrices_.set(storage.index(entity), glm::mat4{1.0f});
+  registry.get<TransformComponent>(entity).set_dirty();
+}
+
+void Scene::on_transform_component_destroy(entt::registry &registry,
+                                           entt::entity    entity)
+{
+  // the storage removes one component after the other, each signal comes
+  // before the last component gets swapped into the removed one
+  const auto &storage = registry.storage<TransformComponent>();
+  const auto  index   = storage.index(entity);
+  const auto  last    = storage.size() - 1;
+  world_matrices_.set(index, world_matrices_.get(last));
+  world_matrices_.resize(last);
+}
+
+void Scene::on_relationship_component_construct(entt::registry &registry,
+                                                entt::entity    entity)
+{
+  // linked entities, like the copies of a prefab, need a new order. Entities
+  // without links get appended to it
+  if (is_linked(registry, registry.get<RelationshipComponent>(entity)) ||
+      added_transforms_.size() >= max_pending_transforms)
+  {
+    set_hierarchy_changed();
+    return;
+  }
+  added_transforms_.push_back(entity);
+}
+
+void Scene::on_relationship_component_destroy(entt::registry &registry,
+                                              entt::entity    entity)
+{
+  // removing a linked entity changes the links of its relatives
+  if (is_linked(registry, registry.get<RelationshipComponent>(entity)) ||
+      removed_transforms_.size() >= max_pending_transforms)
+  {
+    set_hierarchy_changed();
+    return;
+  }
+  removed_transforms_.push_back(entity);
 }
 
 void Scene::fire_component_destroy_event(entt::entity      entity,
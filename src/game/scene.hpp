@@ -1,22 +1,28 @@
 #pragma once
 
 #include "component_types.hpp"
+#include "entity_ref.hpp"
 #include "entt/entity/fwd.hpp"
 #include "event.hpp"
+#include "flat_hash_map.hpp"
+#include "math.hpp"
 #include "serialization.hpp"
 #include "system.hpp"
 #include "uuid.hpp"
 
 #include <entt/entt.hpp>
 
+#include <cstdint>
 #include <filesystem>
 #include <memory>
-#include <unordered_map>
+#include <vector>
 
 namespace dc
 {
 
 class Entity;
+class Prefab;
+class TransformSystem;
 
 class Scene : public std::enable_shared_from_this<Scene>
 {
@@ -37,25 +43,107 @@ public:
   Entity entity(Uuid uuid);
   bool   exists(Uuid uuid) const;
 
+  /// Returns an invalid reference if no entity has the id
+  EntityRef entity_ref(Uuid uuid);
+  EntityRef entity_ref(entt::entity entity_handle);
+  /// References to many entities for hot loops, see EntityRef
+  std::vector<EntityRef>
+  entity_refs(const std::vector<entt::entity> &entity_handles);
+
   void remove_entities();
 
+  /**
+   * Adds the entities of a streamed scene cell. Only scenes that are stored
+   * as columns can be added. Streamed entities do not get saved with the
+   * scene. Returns the ids of the added entities.
+   */
+  std::vector<Uuid> add_streamed_entities(BinaryReader &reader);
+  /// Destroys the entities of a cell with a single registry call
+  void remove_streamed_entities(const std::vector<Uuid> &uuids);
+
   void             save(const std::filesystem::path &file_path,
                         const AssetDescription      &asset_description);
   AssetDescription read(const std::filesystem::path &file_path);
 
+  /**
+   * Writes all entities except the streamed ones into a memory buffer.
+   * Restoring the snapshot replaces these entities. Physic actors, scripts
+   * and audio sources get rebuilt through the component signals.
+   */
+  std::vector<std::uint8_t> snapshot();
+  void                      restore(const std::vector<std::uint8_t> &snapshot);
+
+  /// Saves the entity and all of its descendants as a prefab
+  void save_prefab(Entity                       root,
+                   const std::filesystem::path &file_path,
+                   const AssetDescription      &asset_description);
+
+  /**
+   * Spawns one copy of the prefab per transform, which gets applied to the
+   * root of the copy. All copies are created with one insert per component
+   * and prefab entity. Returns the ids of the copied roots.
+   */
+  std::vector<Uuid> instantiate(const Prefab                 &prefab,
+                                const std::vector<glm::mat4> &transforms);
+
+  /**
+   * Changes whenever parent links change, so that the hierarchy order of the
+   * transform system gets rebuilt. Entities without links that get created
+   * or destroyed in between are collected instead, so that the order only
+   * needs to be patched.
+   */
+  std::uint64_t hierarchy_version() const;
+  void          set_hierarchy_changed();
+
+  /**
+   * World matrix of an entity as of the last update of the transform system.
+   * Returns the identity matrix for entities without transform.
+   */
+  glm::mat4 world_matrix(entt::entity entity_handle) const;
+
 private:
   // TODO: Consider creating a proper API for entities
   friend Entity;
+  // updates the world matrices directly on the registry and the buffer
+  friend TransformSystem;
 
   std::vector<Uuid> entities_to_remove;
 
-  std::unordered_map<Uuid, entt::entity> uuid_to_entity_map_;
-  entt::registry                         registry_;
+  FlatHashMap<Uuid, entt::entity> uuid_to_entity_map_;
+  // entities without links since the last hierarchy change. Declared before
+  // the registry, whose signals write them
+  std::vector<entt::entity> added_transforms_;
+  std::vector<entt::entity> removed_transforms_;
+  // world matrices indexed like the transform storage, the transform system
+  // writes them. Kept in order by the transform signals
+  math::AffineMatrixBuffer world_matrices_;
+  entt::registry           registry_;
+  std::uint64_t            hierarchy_version_{0};
 
   Scene();
 
   void init_systems();
 
+  std::vector<entt::entity> saved_entities();
+  void write_entities(BinaryWriter                    &writer,
+                      const std::vector<entt::entity> &entities);
+
+  void set_world_matrix(entt::entity entity_handle, const glm::mat4 &value);
+
+  void read_tagged_entities(BinaryReader &reader);
+  std::vector<Uuid> read_entity_columns(BinaryReader &reader,
+                                        std::uint32_t version);
+
+  void on_transform_component_construct(entt::registry &registry,
+                                        entt::entity    entity);
+  void on_transform_component_destroy(entt::registry &registry,
+                                      entt::entity    entity);
+
+  void on_relationship_component_construct(entt::registry &registry,
+                                           entt::entity    entity);
+  void on_relationship_component_destroy(entt::registry &registry,
+                                         entt::entity    entity);
+
   void fire_component_construct_event(entt::entity  entity,
                                       ComponentType component_type);
   void fire_component_destroy_event(entt::entity  entity,
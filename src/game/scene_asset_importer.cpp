@@ -1,13 +1,16 @@
 #include "scene_asset_importer.hpp"
 #include "engine.hpp"
 #include "entity.hpp"
+#include "import_manifest.hpp"
 #include "importer.hpp"
 #include "log.hpp"
 #include "mesh_asset.hpp"
 #include "mesh_asset_importer.hpp"
 #include "mesh_component.hpp"
 #include "scene.hpp"
+#include "scene_stream.hpp"
 #include "serialization.hpp"
+#include "util.hpp"
 
 #include <assimp/GltfMaterial.h>
 #include <assimp/Importer.hpp>
@@ -15,9 +18,16 @@
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 
+#include <cmath>
+#include <cstdint>
 #include <filesystem>
+#include <map>
 #include <memory>
 #include <set>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
 
 namespace
 {
@@ -29,54 +39,101 @@ glm::mat4 to_glm(const aiMatrix4x4 &matrix)
   return glm::transpose(glm::make_mat4(&matrix.a1));
 }
 
+/** Mesh entity that gets streamed with the cell that contains it */
+struct StreamedMesh
+{
+  std::string       name_;
+  glm::mat4         transform_{1.0f};
+  math::BoundingBox bounds_;
+  std::string       mesh_asset_name_;
+};
+
 struct SceneImportData
 {
   std::filesystem::path base_path_;
   std::string           scene_name_;
+  // build info of all outputs except textures
+  AssetDescription asset_description_;
 
   std::shared_ptr<Scene>   scene_;
 
-  std::set<std::string>                                materials_;
-  std::unordered_map<std::string, TextureDescription>  textures_;
+  std::set<std::string>               materials_;
+  std::shared_ptr<ImportManifest>     manifest_;
+  std::shared_ptr<TextureImportQueue> texture_import_queue_;
+
+  // mesh assets can only be loaded after their textures got imported
+  std::vector<std::pair<Entity, std::string>> mesh_entities_;
+
+  // the mesh entities are split into cells if the cell size is set
+  float                     cell_size_{0.0f};
+  std::vector<StreamedMesh> streamed_meshes_;
 };
 
 std::string load_mesh(const aiScene   *ai_scene,
                       Entity           parent_entity,
+                      const glm::mat4 &parent_transform,
                       aiMesh          *ai_mesh,
                       SceneImportData &import_data)
 {
-  auto entity = import_data.scene_->create_entity(ai_mesh->mName.C_Str());
-  parent_entity.add_child(entity);
-
   MeshImportData mesh_import_data{};
-  mesh_import_data.mesh_name_ = import_data.scene_name_;
-  mesh_import_data.base_path_ = import_data.base_path_;
-  mesh_import_data.materials_ = std::move(import_data.materials_);
-  mesh_import_data.textures_  = std::move(import_data.textures_);
+  mesh_import_data.mesh_name_            = import_data.scene_name_;
+  mesh_import_data.base_path_            = import_data.base_path_;
+  mesh_import_data.asset_description_    = import_data.asset_description_;
+  mesh_import_data.materials_            = std::move(import_data.materials_);
+  mesh_import_data.manifest_             = import_data.manifest_;
+  mesh_import_data.texture_import_queue_ = import_data.texture_import_queue_;
 
   aiMatrix4x4 transform{};
   assert(transform.IsIdentity());
   do_import_mesh(ai_scene, ai_mesh, transform, mesh_import_data);
 
   import_data.materials_ = std::move(mesh_import_data.materials_);
-  import_data.textures_  = std::move(mesh_import_data.textures_);
 
   const auto mesh_asset_name = sanitize_file_path(
       import_data.scene_name_ + "_" + ai_mesh->mName.C_Str() + ".dcmesh");
 
-  AssetDescription asset_description{};
-  mesh_import_data.mesh_.save(Engine::instance()->base_directory() /
-                                  std::filesystem::path{"meshes"} /
-                                  mesh_asset_name,
-                              asset_description);
-
   auto mesh_asset_handle_name =
       std::filesystem::path{"meshes"} / mesh_asset_name;
+  mesh_import_data.mesh_.save(Engine::instance()->base_directory() /
+                                  mesh_asset_handle_name,
+                              import_data.asset_description_);
+  import_data.manifest_->add_output(mesh_asset_handle_name,
+                                    import_data.asset_description_);
+
+  if (import_data.cell_size_ > 0.0f)
+  {
+    StreamedMesh streamed_mesh{};
+    streamed_mesh.name_      = ai_mesh->mName.C_Str();
+    streamed_mesh.transform_ = parent_transform;
+    // empty meshes keep a point at the origin
+    auto &bounds = streamed_mesh.bounds_;
+    bounds.min_  = glm::vec3{0.0f};
+    bounds.max_  = glm::vec3{0.0f};
+    bool is_empty{true};
+    for (const auto &sub_mesh : mesh_import_data.mesh_.sub_meshes_)
+    {
+      for (const auto &vertex : sub_mesh.vertices_)
+      {
+        if (is_empty)
+        {
+          bounds.min_ = vertex.position;
+          bounds.max_ = vertex.position;
+          is_empty    = false;
+        }
+        bounds.combine_point(vertex.position);
+      }
+    }
+    bounds.transform(parent_transform);
+    streamed_mesh.mesh_asset_name_ = mesh_asset_handle_name.generic_string();
+    import_data.streamed_meshes_.push_back(std::move(streamed_mesh));
 
-  auto mesh_asset_handle = std::dynamic_pointer_cast<MeshAssetHandle>(
-      Engine::instance()->asset_cache()->load_asset(
-          Asset{mesh_asset_handle_name.string()}));
-  entity.add_component<MeshComponent>(mesh_asset_handle);
+    return mesh_asset_handle_name.string();
+  }
+
+  auto entity = import_data.scene_->create_entity(ai_mesh->mName.C_Str());
+  parent_entity.add_child(entity);
+  import_data.mesh_entities_.emplace_back(entity,
+                                          mesh_asset_handle_name.string());
 
   return mesh_asset_handle_name.string();
 }
@@ -84,6 +141,7 @@ std::string load_mesh(const aiScene   *ai_scene,
 void import_node(const aiScene        *ai_scene,
                  aiNode               *ai_node,
                  std::optional<Entity> parent_entity,
+                 const glm::mat4      &parent_transform,
                  SceneImportData      &import_data)
 {
   auto entity = import_data.scene_->create_entity(ai_node->mName.C_Str());
@@ -91,60 +149,190 @@ void import_node(const aiScene        *ai_scene,
   {
     parent_entity.value().add_child(entity);
   }
-  entity.set_local_transform_matrix(to_glm(ai_node->mTransformation));
+  const auto local_transform = to_glm(ai_node->mTransformation);
+  entity.set_local_transform_matrix(local_transform);
+  const auto transform = parent_transform * local_transform;
 
   for (unsigned i = 0; i < ai_node->mNumMeshes; ++i)
   {
     load_mesh(ai_scene,
               entity,
+              transform,
               ai_scene->mMeshes[ai_node->mMeshes[i]],
               import_data);
   }
 
   for (unsigned i = 0; i < ai_node->mNumChildren; ++i)
   {
-    import_node(ai_scene, ai_node->mChildren[i], entity, import_data);
+    import_node(ai_scene,
+                ai_node->mChildren[i],
+                entity,
+                transform,
+                import_data);
+  }
+}
+
+/**
+ * Sorts the mesh entities into cells on the XZ plane by the center of their
+ * bounds. Every cell gets its own scene, which lists the meshes as
+ * dependencies. Entities keep their world transform, because the node
+ * hierarchy stays in the main scene.
+ */
+void save_cells(const std::filesystem::path &scene_file_path,
+                SceneImportData             &import_data)
+{
+  const auto base_directory = Engine::instance()->base_directory();
+  const auto cells_directory =
+      sanitize_file_path(std::filesystem::path{"scenes"} /
+                         (import_data.scene_name_ + "_cells"));
+  // cells of the last import might not exist anymore
+  std::error_code error_code{};
+  std::filesystem::remove_all(base_directory / cells_directory, error_code);
+  std::filesystem::create_directories(base_directory / cells_directory);
+
+  const auto cell_size = import_data.cell_size_;
+  std::map<std::pair<std::int32_t, std::int32_t>,
+           std::vector<const StreamedMesh *>>
+      cell_meshes;
+  for (const auto &streamed_mesh : import_data.streamed_meshes_)
+  {
+    const auto center = streamed_mesh.bounds_.center();
+    const auto x = static_cast<std::int32_t>(std::floor(center.x / cell_size));
+    const auto z = static_cast<std::int32_t>(std::floor(center.z / cell_size));
+    cell_meshes[{x, z}].push_back(&streamed_mesh);
+  }
+
+  const auto asset_cache = Engine::instance()->asset_cache();
+
+  SceneStreamDescription stream_description{};
+  stream_description.cell_size_ = cell_size;
+  for (const auto &[coordinates, streamed_meshes] : cell_meshes)
+  {
+    SceneCellDescription cell{};
+    cell.x_      = coordinates.first;
+    cell.z_      = coordinates.second;
+    cell.bounds_ = streamed_meshes.front()->bounds_;
+
+    const auto            cell_scene = Scene::create();
+    std::set<std::string> dependencies;
+    for (const auto streamed_mesh : streamed_meshes)
+    {
+      auto entity = cell_scene->create_entity(streamed_mesh->name_);
+      entity.set_local_transform_matrix(streamed_mesh->transform_);
+      entity.add_component<MeshComponent>(
+          std::dynamic_pointer_cast<MeshAssetHandle>(asset_cache->load_asset(
+              Asset{streamed_mesh->mesh_asset_name_})));
+
+      cell.bounds_.combine_point(streamed_mesh->bounds_.min_);
+      cell.bounds_.combine_point(streamed_mesh->bounds_.max_);
+      dependencies.insert(streamed_mesh->mesh_asset_name_);
+    }
+
+    cell.scene_name_ = (cells_directory / fmt::format("{}_{}.dcscn",
+                                                      cell.x_,
+                                                      cell.z_))
+                           .generic_string();
+    cell_scene->save(base_directory / cell.scene_name_,
+                     import_data.asset_description_);
+    import_data.manifest_->add_output(cell.scene_name_,
+                                      import_data.asset_description_);
+
+    cell.size_ = std::filesystem::file_size(base_directory / cell.scene_name_);
+    for (const auto &dependency : dependencies)
+    {
+      cell.size_ += std::filesystem::file_size(base_directory / dependency);
+    }
+    cell.dependencies_.assign(dependencies.begin(), dependencies.end());
+
+    stream_description.cells_.push_back(std::move(cell));
   }
+
+  const auto stream_name = scene_stream_name(scene_file_path.generic_string());
+  stream_description.save(base_directory / stream_name,
+                          import_data.asset_description_);
+  import_data.manifest_->add_output(stream_name,
+                                    import_data.asset_description_);
+
+  DC_LOG_INFO("Split scene {} into {} cells",
+              import_data.scene_name_,
+              stream_description.cells_.size());
 }
 
 void import_scene(const aiScene *ai_scene, SceneImportData &import_data)
 {
-  import_node(ai_scene, ai_scene->mRootNode, {}, import_data);
+  import_node(ai_scene, ai_scene->mRootNode, {}, glm::mat4{1.0f}, import_data);
+
+  import_data.texture_import_queue_->wait();
+  for (auto &[entity, mesh_asset_handle_name] : import_data.mesh_entities_)
+  {
+    auto mesh_asset_handle = std::dynamic_pointer_cast<MeshAssetHandle>(
+        Engine::instance()->asset_cache()->load_asset(
+            Asset{mesh_asset_handle_name}));
+    entity.add_component<MeshComponent>(mesh_asset_handle);
+  }
 
   // save imported data
   const auto scene_file_path = sanitize_file_path(
       std::filesystem::path{"scenes"} / (import_data.scene_name_ + ".dcscn"));
-  AssetDescription asset_description{};
+  if (import_data.cell_size_ > 0.0f)
+  {
+    save_cells(scene_file_path, import_data);
+  }
+  else
+  {
+    // the scene is not streamed anymore if it got split up before
+    std::error_code error_code{};
+    std::filesystem::remove(
+        Engine::instance()->base_directory() /
+            scene_stream_name(scene_file_path.generic_string()),
+        error_code);
+  }
   import_data.scene_->save(Engine::instance()->base_directory() /
                                scene_file_path,
-                           asset_description);
+                           import_data.asset_description_);
+  import_data.manifest_->add_output(scene_file_path,
+                                    import_data.asset_description_);
 }
 } // namespace
 
 namespace dc
 {
 
-void import_scene_asset(const std::filesystem::path &file_path,
-                        const std::string           &name)
+bool import_scene_asset(const std::filesystem::path &file_path,
+                        const std::string           &name,
+                        bool                         is_forced,
+                        float                        cell_size)
 {
+  const auto scene_file_path = sanitize_file_path(
+      std::filesystem::path{"scenes"} / (name + ".dcscn"));
+  const auto manifest_file_path = import_manifest_file_path(scene_file_path);
+  // scene meshes are imported with full precision vertices
+  const auto settings_hash =
+      hash_bytes(&cell_size,
+                 sizeof(cell_size),
+                 mesh_import_settings_hash(VertexFormat::Float));
+  if (!is_forced && is_import_up_to_date(manifest_file_path,
+                                         scene_importer_version,
+                                         settings_hash))
+  {
+    DC_LOG_INFO("Scene {} is up to date", name);
+    return false;
+  }
+
   DC_LOG_DEBUG("Import scene from file {}", file_path.string());
 
+  const auto       manifest = std::make_shared<ImportManifest>();
   Assimp::Importer importer;
-  const auto       ai_scene = importer.ReadFile(
-      file_path.string().c_str(),
+  const auto       ai_scene = read_model(
+      importer,
+      file_path,
       aiProcess_JoinIdenticalVertices | aiProcess_Triangulate |
           aiProcess_GenSmoothNormals | aiProcess_LimitBoneWeights |
           aiProcess_ImproveCacheLocality | aiProcess_GenUVCoords |
           aiProcess_RemoveRedundantMaterials | aiProcess_FindDegenerates |
           aiProcess_FindInvalidData | aiProcess_FindInstances |
-          aiProcess_OptimizeMeshes | aiProcess_CalcTangentSpace);
-
-  if (!ai_scene || ai_scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE ||
-      !ai_scene->mRootNode)
-  {
-    throw std::runtime_error(std::string("Assimp could not load model: ") +
-                             importer.GetErrorString());
-  }
+          aiProcess_OptimizeMeshes | aiProcess_CalcTangentSpace,
+      *manifest);
 
   // create neeeded directories
   // TODO: Don't hardcode paths
@@ -153,12 +341,29 @@ void import_scene_asset(const std::filesystem::path &file_path,
   std::filesystem::create_directories(base_directory / "materials");
   std::filesystem::create_directories(base_directory / "textures");
   std::filesystem::create_directories(base_directory / "meshes");
+  std::filesystem::create_directories(manifest_file_path.parent_path());
 
   SceneImportData import_data{};
   import_data.scene_name_ = name;
-  import_data.scene_     = Scene::create();
-  import_data.base_path_ = file_path.parent_path();
+  import_data.scene_      = Scene::create();
+  import_data.base_path_  = file_path.parent_path();
+  import_data.manifest_   = manifest;
+  import_data.cell_size_  = cell_size;
+
+  auto &asset_description             = import_data.asset_description_;
+  asset_description.original_file_    = normalize_path(file_path).string();
+  asset_description.source_hash_      = manifest->source_hash();
+  asset_description.settings_hash_    = settings_hash;
+  asset_description.importer_version_ = scene_importer_version;
+
+  import_data.texture_import_queue_ =
+      std::make_shared<TextureImportQueue>(manifest);
   import_scene(ai_scene, import_data);
+
+  manifest->importer_version_ = scene_importer_version;
+  manifest->settings_hash_    = settings_hash;
+  manifest->save(manifest_file_path);
+  return true;
 }
 
 } // namespace dc
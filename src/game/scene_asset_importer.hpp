@@ -2,9 +2,22 @@
 
 #include "asset_importer_manager.hpp"
 
+#include <cstdint>
+
 namespace dc
 {
 
-void import_scene_asset(const std::filesystem::path &file_path,
-                        const std::string           &name);
+/// Increment if imported scenes, meshes or materials change
+constexpr std::uint32_t scene_importer_version{1};
+
+/**
+ * Imports the scene with its meshes, materials and textures. Returns false if
+ * the import got skipped because the last import of the file is up to date.
+ * Forcing the import never skips. With a cell size above zero the mesh
+ * entities get split into cells, which are streamed around the camera.
+ */
+bool import_scene_asset(const std::filesystem::path &file_path,
+                        const std::string           &name,
+                        bool                         is_forced = false,
+                        float                        cell_size = 0.0f);
 } // namespace dc
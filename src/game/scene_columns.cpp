@@ -0,0 +1,425 @@
+#include "scene_columns.hpp"
+#include "audio/audio_listener_component.hpp"
+#include "audio/audio_source_component.hpp"
+#include "camera_component.hpp"
+#include "directional_light_component.hpp"
+#include "mesh_component.hpp"
+#include "physic/box_collider_component.hpp"
+#include "physic/capsule_collider_component.hpp"
+#include "physic/character_controller_component.hpp"
+#include "physic/mesh_collider_component.hpp"
+#include "physic/rigid_body_component.hpp"
+#include "physic/sphere_collider_component.hpp"
+#include "point_light_component.hpp"
+#include "script/script_component.hpp"
+#include "serialization.hpp"
+#include "skinned_mesh_component.hpp"
+#include "sky_component.hpp"
+#include "transform_component.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+
+namespace
+{
+
+/** Ids of the component columns. They get stored, so only append */
+enum class SceneColumn : std::uint32_t
+{
+  End,
+  Mesh,
+  SkinnedMesh,
+  Sky,
+  PointLight,
+  DirectionalLight,
+  Camera,
+  Script,
+  BoxCollider,
+  SphereCollider,
+  CapsuleCollider,
+  MeshCollider,
+  RigidBody,
+  CharacterController,
+  AudioSource,
+  AudioListener,
+};
+
+/**
+ * Writes the indices of all entities with the component, followed by the
+ * components in the same order. Columns without entities are left out.
+ */
+template <typename TComponent>
+void write_column(
+    dc::BinaryWriter                                      &writer,
+    entt::registry                                        &registry,
+    const std::unordered_map<entt::entity, std::uint32_t> &entity_indices,
+    SceneColumn                                            column)
+{
+  const auto view = registry.view<TComponent>();
+
+  std::vector<std::uint32_t> indices;
+  std::vector<entt::entity>  entities;
+  indices.reserve(view.size());
+  entities.reserve(view.size());
+  for (const auto entity : view)
+  {
+    const auto iter = entity_indices.find(entity);
+    if (iter != entity_indices.end())
+    {
+      indices.push_back(iter->second);
+      entities.push_back(entity);
+    }
+  }
+  if (entities.empty())
+  {
+    return;
+  }
+
+  dc::write_value(writer, column);
+  dc::write_vector(writer, indices);
+  for (const auto entity : entities)
+  {
+    view.template get<TComponent>(entity).save(writer);
+  }
+}
+
+template <typename TComponent>
+void read_column(dc::BinaryReader                &reader,
+                 entt::registry                  &registry,
+                 const std::vector<entt::entity> &entities)
+{
+  std::vector<std::uint32_t> indices;
+  dc::read_vector(reader, indices);
+
+  std::vector<entt::entity> column_entities(indices.size());
+  for (std::size_t i{0}; i < indices.size(); ++i)
+  {
+    if (indices[i] >= entities.size())
+    {
+      throw std::runtime_error{"Invalid entity index in scene column"};
+    }
+    column_entities[i] = entities[indices[i]];
+  }
+
+  dc::insert_components<TComponent>(reader, registry, column_entities);
+}
+
+/** Copies a component with one insert per source entity */
+template <typename TComponent>
+void copy_column(const entt::registry            &source_registry,
+                 const std::vector<entt::entity> &source_entities,
+                 entt::registry                  &registry,
+                 const std::vector<entt::entity> &entities)
+{
+  const auto count = entities.size() / source_entities.size();
+  for (std::size_t i{0}; i < source_entities.size(); ++i)
+  {
+    const auto component =
+        source_registry.try_get<TComponent>(source_entities[i]);
+    if (!component)
+    {
+      continue;
+    }
+    const auto first = entities.begin() + i * count;
+    registry.insert<TComponent>(first, first + count, *component);
+  }
+}
+
+dc::ScriptComponent clone_component(const dc::ScriptComponent &component)
+{
+  // the script instance gets created for every copy on construction
+  dc::ScriptComponent clone{};
+  clone.module_name_ = component.module_name_;
+  return clone;
+}
+
+dc::SkinnedMeshComponent
+clone_component(const dc::SkinnedMeshComponent &component)
+{
+  // every copy needs its own animation state
+  dc::SkinnedMeshComponent clone{};
+  if (const auto skinned_mesh_asset = component.skinned_mesh_asset())
+  {
+    clone.set_skinned_mesh_asset(skinned_mesh_asset);
+  }
+  return clone;
+}
+
+dc::PointLightComponent
+clone_component(const dc::PointLightComponent &component)
+{
+  // every copy renders into its own shadow map
+  dc::PointLightComponent clone{};
+  clone.color_      = component.color_;
+  clone.multiplier_ = component.multiplier_;
+  clone.radius_     = component.radius_;
+  clone.falloff_    = component.falloff_;
+  clone.set_cast_shadow(component.cast_shadow());
+  return clone;
+}
+
+/** Copies components that keep per entity state through clone_component() */
+template <typename TComponent>
+void clone_column(const entt::registry            &source_registry,
+                  const std::vector<entt::entity> &source_entities,
+                  entt::registry                  &registry,
+                  const std::vector<entt::entity> &entities)
+{
+  const auto count = entities.size() / source_entities.size();
+  for (std::size_t i{0}; i < source_entities.size(); ++i)
+  {
+    const auto component =
+        source_registry.try_get<TComponent>(source_entities[i]);
+    if (!component)
+    {
+      continue;
+    }
+    std::vector<TComponent> components;
+    components.reserve(count);
+    for (std::size_t j{0}; j < count; ++j)
+    {
+      components.push_back(clone_component(*component));
+    }
+    const auto first = entities.begin() + i * count;
+    registry.insert<TComponent>(first,
+                                first + count,
+                                std::make_move_iterator(components.begin()));
+  }
+}
+
+} // namespace
+
+namespace dc
+{
+
+void skip_world_matrices(BinaryReader &reader)
+{
+  // the parent and the own world matrix
+  reader.read_bytes(2 * sizeof(glm::mat4));
+}
+
+void insert_transform_components(BinaryReader                    &reader,
+                                 entt::registry                  &registry,
+                                 const std::vector<entt::entity> &entities,
+                                 std::uint32_t                    version)
+{
+  std::vector<TransformComponent> components(entities.size());
+  for (auto &component : components)
+  {
+    component.read(reader);
+    if (version < scene_local_transforms_version)
+    {
+      skip_world_matrices(reader);
+    }
+  }
+  registry.insert<TransformComponent>(entities.begin(),
+                                      entities.end(),
+                                      components.begin());
+}
+
+void write_component_columns(
+    BinaryWriter                                          &writer,
+    entt::registry                                        &registry,
+    const std::unordered_map<entt::entity, std::uint32_t> &entity_indices)
+{
+  // same order as the tagged format, colliders need to exist before the
+  // rigid bodies get created
+  write_column<MeshComponent>(writer,
+                              registry,
+                              entity_indices,
+                              SceneColumn::Mesh);
+  write_column<SkinnedMeshComponent>(writer,
+                                     registry,
+                                     entity_indices,
+                                     SceneColumn::SkinnedMesh);
+  write_column<SkyComponent>(writer,
+                             registry,
+                             entity_indices,
+                             SceneColumn::Sky);
+  write_column<PointLightComponent>(writer,
+                                    registry,
+                                    entity_indices,
+                                    SceneColumn::PointLight);
+  write_column<DirectionalLightComponent>(writer,
+                                          registry,
+                                          entity_indices,
+                                          SceneColumn::DirectionalLight);
+  write_column<CameraComponent>(writer,
+                                registry,
+                                entity_indices,
+                                SceneColumn::Camera);
+  write_column<ScriptComponent>(writer,
+                                registry,
+                                entity_indices,
+                                SceneColumn::Script);
+  write_column<BoxColliderComponent>(writer,
+                                     registry,
+                                     entity_indices,
+                                     SceneColumn::BoxCollider);
+  write_column<SphereColliderComponent>(writer,
+                                        registry,
+                                        entity_indices,
+                                        SceneColumn::SphereCollider);
+  write_column<CapsuleColliderComponent>(writer,
+                                         registry,
+                                         entity_indices,
+                                         SceneColumn::CapsuleCollider);
+  write_column<MeshColliderComponent>(writer,
+                                      registry,
+                                      entity_indices,
+                                      SceneColumn::MeshCollider);
+  write_column<RigidBodyComponent>(writer,
+                                   registry,
+                                   entity_indices,
+                                   SceneColumn::RigidBody);
+  write_column<CharacterControllerComponent>(writer,
+                                             registry,
+                                             entity_indices,
+                                             SceneColumn::CharacterController);
+  write_column<AudioSourceComponent>(writer,
+                                     registry,
+                                     entity_indices,
+                                     SceneColumn::AudioSource);
+  write_column<AudioListenerComponent>(writer,
+                                       registry,
+                                       entity_indices,
+                                       SceneColumn::AudioListener);
+  write_value(writer, SceneColumn::End);
+}
+
+void read_component_columns(BinaryReader                    &reader,
+                            entt::registry                  &registry,
+                            const std::vector<entt::entity> &entities)
+{
+  SceneColumn column{};
+  read_value(reader, column);
+  while (column != SceneColumn::End)
+  {
+    switch (column)
+    {
+    case SceneColumn::Mesh:
+      read_column<MeshComponent>(reader, registry, entities);
+      break;
+    case SceneColumn::SkinnedMesh:
+      read_column<SkinnedMeshComponent>(reader, registry, entities);
+      break;
+    case SceneColumn::Sky:
+      read_column<SkyComponent>(reader, registry, entities);
+      break;
+    case SceneColumn::PointLight:
+      read_column<PointLightComponent>(reader, registry, entities);
+      break;
+    case SceneColumn::DirectionalLight:
+      read_column<DirectionalLightComponent>(reader, registry, entities);
+      break;
+    case SceneColumn::Camera:
+      read_column<CameraComponent>(reader, registry, entities);
+      break;
+    case SceneColumn::Script:
+      read_column<ScriptComponent>(reader, registry, entities);
+      break;
+    case SceneColumn::BoxCollider:
+      read_column<BoxColliderComponent>(reader, registry, entities);
+      break;
+    case SceneColumn::SphereCollider:
+      read_column<SphereColliderComponent>(reader, registry, entities);
+      break;
+    case SceneColumn::CapsuleCollider:
+      read_column<CapsuleColliderComponent>(reader, registry, entities);
+      break;
+    case SceneColumn::MeshCollider:
+      read_column<MeshColliderComponent>(reader, registry, entities);
+      break;
+    case SceneColumn::RigidBody:
+      read_column<RigidBodyComponent>(reader, registry, entities);
+      break;
+    case SceneColumn::CharacterController:
+      read_column<CharacterControllerComponent>(reader, registry, entities);
+      break;
+    case SceneColumn::AudioSource:
+      read_column<AudioSourceComponent>(reader, registry, entities);
+      break;
+    case SceneColumn::AudioListener:
+      read_column<AudioListenerComponent>(reader, registry, entities);
+      break;
+    default:
+      throw std::runtime_error{"Unknown component column in scene"};
+    }
+    read_value(reader, column);
+  }
+}
+
+void copy_component_columns(const entt::registry            &source_registry,
+                            const std::vector<entt::entity> &source_entities,
+                            entt::registry                  &registry,
+                            const std::vector<entt::entity> &entities)
+{
+  if (source_entities.empty())
+  {
+    return;
+  }
+
+  // same order as the columns get read
+  copy_column<MeshComponent>(source_registry,
+                             source_entities,
+                             registry,
+                             entities);
+  clone_column<SkinnedMeshComponent>(source_registry,
+                                     source_entities,
+                                     registry,
+                                     entities);
+  copy_column<SkyComponent>(source_registry,
+                            source_entities,
+                            registry,
+                            entities);
+  clone_column<PointLightComponent>(source_registry,
+                                    source_entities,
+                                    registry,
+                                    entities);
+  copy_column<DirectionalLightComponent>(source_registry,
+                                         source_entities,
+                                         registry,
+                                         entities);
+  copy_column<CameraComponent>(source_registry,
+                               source_entities,
+                               registry,
+                               entities);
+  clone_column<ScriptComponent>(source_registry,
+                                source_entities,
+                                registry,
+                                entities);
+  copy_column<BoxColliderComponent>(source_registry,
+                                    source_entities,
+                                    registry,
+                                    entities);
+  copy_column<SphereColliderComponent>(source_registry,
+                                       source_entities,
+                                       registry,
+                                       entities);
+  copy_column<CapsuleColliderComponent>(source_registry,
+                                        source_entities,
+                                        registry,
+                                        entities);
+  copy_column<MeshColliderComponent>(source_registry,
+                                     source_entities,
+                                     registry,
+                                     entities);
+  copy_column<RigidBodyComponent>(source_registry,
+                                  source_entities,
+                                  registry,
+                                  entities);
+  copy_column<CharacterControllerComponent>(source_registry,
+                                            source_entities,
+                                            registry,
+                                            entities);
+  copy_column<AudioSourceComponent>(source_registry,
+                                    source_entities,
+                                    registry,
+                                    entities);
+  copy_column<AudioListenerComponent>(source_registry,
+                                      source_entities,
+                                      registry,
+                                      entities);
+}
+
+} // namespace dc
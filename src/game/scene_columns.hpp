@@ -0,0 +1,77 @@
+#pragma once
+
+#include "binary_reader.hpp"
+#include "binary_writer.hpp"
+
+#include <entt/entt.hpp>
+
+#include <cstdint>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
+namespace dc
+{
+
+/** Scenes from this version on store one column per component type */
+constexpr std::uint32_t scene_columns_version{1};
+/** Scenes before this version store two world matrices after each transform */
+constexpr std::uint32_t scene_local_transforms_version{2};
+/** Version of the scenes and prefabs that get saved */
+constexpr std::uint32_t scene_version{scene_local_transforms_version};
+
+/** Reads one component per entity and adds them all with one insert */
+template <typename TComponent>
+void insert_components(BinaryReader                    &reader,
+                       entt::registry                  &registry,
+                       const std::vector<entt::entity> &entities)
+{
+  std::vector<TComponent> components(entities.size());
+  for (auto &component : components)
+  {
+    component.read(reader);
+  }
+  registry.insert<TComponent>(entities.begin(),
+                              entities.end(),
+                              std::make_move_iterator(components.begin()));
+}
+
+/// Skips the world matrices that older scenes store after a transform
+void skip_world_matrices(BinaryReader &reader);
+
+/**
+ * Reads the transform of every entity and adds them all with one insert.
+ * The world matrices of older scenes get skipped, the transform system
+ * updates them.
+ */
+void insert_transform_components(BinaryReader                    &reader,
+                                 entt::registry                  &registry,
+                                 const std::vector<entt::entity> &entities,
+                                 std::uint32_t                    version);
+
+/**
+ * Writes one column for each optional component type. Columns refer to
+ * entities by their index, entities without index are left out. The columns
+ * are terminated by an end marker.
+ */
+void write_component_columns(
+    BinaryWriter                                          &writer,
+    entt::registry                                        &registry,
+    const std::unordered_map<entt::entity, std::uint32_t> &entity_indices);
+
+/** Reads the columns up to the end marker and inserts them in bulk */
+void read_component_columns(BinaryReader                    &reader,
+                            entt::registry                  &registry,
+                            const std::vector<entt::entity> &entities);
+
+/**
+ * Copies the optional components of every source entity to a run of entities
+ * in the target registry. The copies of source entity i are stored at
+ * [i * count, (i + 1) * count) with count = entities / source entities.
+ */
+void copy_component_columns(const entt::registry            &source_registry,
+                            const std::vector<entt::entity> &source_entities,
+                            entt::registry                  &registry,
+                            const std::vector<entt::entity> &entities);
+
+} // namespace dc
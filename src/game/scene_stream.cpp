@@ -0,0 +1,71 @@
+#include "scene_stream.hpp"
+#include "serialization.hpp"
+
+namespace dc
+{
+
+void SceneCellDescription::save(BinaryWriter &writer) const
+{
+  write_value(writer, x_);
+  write_value(writer, z_);
+  write_value(writer, bounds_.min_);
+  write_value(writer, bounds_.max_);
+  write_string(writer, scene_name_);
+  write_value(writer, static_cast<std::uint64_t>(dependencies_.size()));
+  for (const auto &dependency : dependencies_)
+  {
+    write_string(writer, dependency);
+  }
+  write_value(writer, size_);
+}
+
+void SceneCellDescription::read(BinaryReader &reader)
+{
+  read_value(reader, x_);
+  read_value(reader, z_);
+  read_value(reader, bounds_.min_);
+  read_value(reader, bounds_.max_);
+  read_string(reader, scene_name_);
+  std::uint64_t dependencies_count{};
+  read_value(reader, dependencies_count);
+  dependencies_.clear();
+  for (std::uint64_t i{0}; i < dependencies_count; ++i)
+  {
+    std::string dependency;
+    read_string(reader, dependency);
+    dependencies_.push_back(std::move(dependency));
+  }
+  read_value(reader, size_);
+}
+
+void SceneStreamDescription::save(
+    const std::filesystem::path &file_path,
+    const AssetDescription      &asset_description) const
+{
+  BinaryWriter writer{};
+
+  asset_description.write(writer);
+  write_value(writer, cell_size_);
+  write_vector_complex(writer, cells_);
+
+  writer.save(file_path);
+}
+
+AssetDescription SceneStreamDescription::read(BinaryReader &reader)
+{
+  AssetDescription asset_description{};
+  asset_description.read(reader);
+  read_value(reader, cell_size_);
+  read_vector_complex(reader, cells_);
+
+  return asset_description;
+}
+
+std::string scene_stream_name(const std::string &scene_name)
+{
+  return std::filesystem::path{scene_name}
+      .replace_extension(".dcstrm")
+      .generic_string();
+}
+
+} // namespace dc
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "asset_description.hpp"
+#include "math.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace dc
+{
+
+class BinaryReader;
+class BinaryWriter;
+
+/**
+ * Spatial cell of a streamed scene. The entities of the cell are stored in
+ * their own scene file.
+ */
+struct SceneCellDescription
+{
+  std::int32_t x_{0};
+  std::int32_t z_{0};
+
+  // world space bounds of the entities in the cell
+  math::BoundingBox bounds_{glm::vec3{0.0f}, glm::vec3{0.0f}};
+
+  std::string scene_name_;
+  // assets the entities of the cell reference
+  std::vector<std::string> dependencies_;
+  // bytes of the cell scene and its dependencies on disk
+  std::uint64_t size_{0};
+
+  void save(BinaryWriter &writer) const;
+  void read(BinaryReader &reader);
+};
+
+/**
+ * Cells of a scene that got split up by the scene importer. Lives next to the
+ * scene file, which keeps all entities that do not get streamed.
+ */
+struct SceneStreamDescription
+{
+  float                             cell_size_{0.0f};
+  std::vector<SceneCellDescription> cells_;
+
+  void             save(const std::filesystem::path &file_path,
+                        const AssetDescription      &asset_description) const;
+  AssetDescription read(BinaryReader &reader);
+};
+
+/// Tags entities that got added by streaming a cell
+struct StreamedComponent
+{
+};
+
+/// Asset id of the stream description that belongs to a scene
+std::string scene_stream_name(const std::string &scene_name);
+
+} // namespace dc
@@ -0,0 +1,374 @@
+#include "scene_streaming_system.hpp"
+#include "binary_reader.hpp"
+#include "camera_component.hpp"
+#include "engine.hpp"
+#include "game_layer.hpp"
+#include "log.hpp"
+#include "profiling.hpp"
+#include "transform_component.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+namespace
+{
+
+float distance_to_bounds(const glm::vec3             &position,
+                         const dc::math::BoundingBox &bounds)
+{
+  return glm::distance(position,
+                       glm::clamp(position, bounds.min_, bounds.max_));
+}
+
+} // namespace
+
+namespace dc
+{
+
+void SceneStreamingSystem::init()
+{
+  const auto config = Engine::instance()->config();
+  load_distance_ =
+      config->config_value_float("Streaming", "load_distance", 150.0f);
+  unload_distance_ = std::max(
+      config->config_value_float("Streaming", "unload_distance", 200.0f),
+      load_distance_);
+  memory_budget_ = static_cast<std::size_t>(std::max(
+                       config->config_value_int("Streaming",
+                                                "memory_budget_mb",
+                                                1024),
+                       0)) *
+                   1024 * 1024;
+  cells_per_frame_ = static_cast<std::size_t>(std::max(
+      config->config_value_int("Streaming", "cells_per_frame", 2),
+      1));
+
+  thread_pool_ = std::make_unique<ThreadPool>(1, "Scene streaming");
+
+  const auto game_layer = Engine::instance()->layer_stack()->layer<GameLayer>();
+  if (game_layer)
+  {
+    const auto scene = game_layer->scene();
+    if (scene && scene->get())
+    {
+      open_stream(scene->get());
+    }
+  }
+}
+
+void SceneStreamingSystem::shutdown()
+{
+  thread_pool_ = nullptr;
+  close_stream();
+}
+
+void SceneStreamingSystem::update(float /*delta_time*/)
+{
+  DC_PROFILE_SCOPE("SceneStreamingSystem::update()");
+
+  const auto scene = scene_.lock();
+  if (!scene || cells_.empty())
+  {
+    return;
+  }
+
+  add_cells(*scene);
+
+  bool      is_camera_found{false};
+  glm::vec3 camera_position{0.0f};
+  auto view = scene->all_entities_with<CameraComponent, TransformComponent>();
+  for (const auto &entity : view)
+  {
+    if (view.get<CameraComponent>(entity).primary_)
+    {
+      camera_position = glm::vec3{scene->world_matrix(entity)[3]};
+      is_camera_found = true;
+      break;
+    }
+  }
+  if (!is_camera_found)
+  {
+    return;
+  }
+
+  std::vector<std::pair<float, std::shared_ptr<Cell>>> cells_by_distance;
+  cells_by_distance.reserve(cells_.size());
+  for (const auto &cell : cells_)
+  {
+    cells_by_distance.emplace_back(
+        distance_to_bounds(camera_position, cell->description_.bounds_),
+        cell);
+  }
+  std::sort(cells_by_distance.begin(),
+            cells_by_distance.end(),
+            [](const auto &a, const auto &b) { return a.first < b.first; });
+
+  // remove far cells first, so that near cells can use their memory
+  for (const auto &[distance, cell] : cells_by_distance)
+  {
+    if (cell->state_ == CellState::Loaded && distance > unload_distance_)
+    {
+      remove_cell(*scene, *cell);
+    }
+  }
+
+  auto farthest_cell = cells_by_distance.size();
+  for (std::size_t i{0}; i < cells_by_distance.size(); ++i)
+  {
+    const auto &[distance, cell] = cells_by_distance[i];
+    if (distance > load_distance_)
+    {
+      break;
+    }
+    if (cell->state_ != CellState::Unloaded)
+    {
+      continue;
+    }
+
+    // make room by removing loaded cells that are farther away
+    const auto size = cell->description_.size_;
+    while (memory_budget_ > 0 && resident_size_ + size > memory_budget_ &&
+           farthest_cell > i + 1)
+    {
+      --farthest_cell;
+      auto &farthest = *cells_by_distance[farthest_cell].second;
+      if (farthest.state_ == CellState::Loaded)
+      {
+        remove_cell(*scene, farthest);
+      }
+    }
+    if (memory_budget_ > 0 && resident_size_ + size > memory_budget_)
+    {
+      break;
+    }
+
+    load_cell(cell);
+  }
+}
+
+void SceneStreamingSystem::render(SceneRenderInfo & /*scene_render_info*/,
+                                  ViewRenderInfo & /*view_render_info*/)
+{
+}
+
+const char *SceneStreamingSystem::name() const
+{
+  return "SceneStreamingSystem";
+}
+
+SystemAccess SceneStreamingSystem::access(SystemPhase phase) const
+{
+  // adds and removes entities
+  if (phase == SystemPhase::Update)
+  {
+    return SystemAccess::exclusive();
+  }
+  return {};
+}
+
+bool SceneStreamingSystem::on_event(const Event &event)
+{
+  const auto event_id = event.id();
+  if (event_id == SceneLoadedEvent::id)
+  {
+    on_scene_loaded(dynamic_cast<const SceneLoadedEvent &>(event));
+  }
+  else if (event_id == SceneUnloadedEvent::id)
+  {
+    on_scene_unloaded(dynamic_cast<const SceneUnloadedEvent &>(event));
+  }
+
+  return false;
+}
+
+void SceneStreamingSystem::open_stream(std::shared_ptr<Scene> scene)
+{
+  close_stream();
+  scene_ = scene;
+
+  // the stream description is found by the name of the scene asset
+  const auto game_layer = Engine::instance()->layer_stack()->layer<GameLayer>();
+  const auto scene_asset = game_layer ? game_layer->scene() : nullptr;
+  if (!scene_asset || scene_asset->get() != scene)
+  {
+    return;
+  }
+  const auto stream_name = scene_stream_name(scene_asset->asset().id());
+  const auto stream_file_path =
+      Engine::instance()->base_directory() / stream_name;
+  std::error_code error_code{};
+  if (!std::filesystem::exists(stream_file_path, error_code))
+  {
+    // most scenes are not split into cells
+    return;
+  }
+
+  SceneStreamDescription stream_description{};
+  try
+  {
+    const auto asset_data =
+        Engine::instance()->asset_cache()->read_asset_data(stream_name);
+    BinaryReader reader{asset_data.data_, asset_data.size_};
+    stream_description.read(reader);
+  }
+  catch (const std::runtime_error &error)
+  {
+    DC_LOG_WARN("Could not read scene stream {}: {}",
+                stream_name,
+                error.what());
+    return;
+  }
+
+  for (auto &cell_description : stream_description.cells_)
+  {
+    auto cell                = std::make_shared<Cell>();
+    cell->description_       = std::move(cell_description);
+    cell->stream_generation_ = stream_generation_;
+    cells_.push_back(std::move(cell));
+  }
+  DC_LOG_DEBUG("Stream {} cells of scene {}",
+               cells_.size(),
+               scene_asset->asset().id());
+}
+
+void SceneStreamingSystem::close_stream()
+{
+  // cells that are still read belong to the old stream and get dropped
+  ++stream_generation_;
+  cells_.clear();
+  pending_cells_.clear();
+  {
+    std::lock_guard lock{read_cells_mutex_};
+    read_cells_.clear();
+  }
+  resident_size_ = 0;
+  scene_         = {};
+}
+
+void SceneStreamingSystem::load_cell(std::shared_ptr<Cell> cell)
+{
+  cell->state_ = CellState::Loading;
+  resident_size_ += cell->description_.size_;
+
+  thread_pool_->submit(
+      [this, cell]()
+      {
+        DC_PROFILE_SCOPE("SceneStreamingSystem::load_cell()");
+
+        const auto asset_cache = Engine::instance()->asset_cache();
+        try
+        {
+          cell->data_ =
+              asset_cache->read_asset_data(cell->description_.scene_name_);
+          // loads off the main thread are asynchronous, the cell gets added
+          // when all dependencies are ready
+          for (const auto &dependency : cell->description_.dependencies_)
+          {
+            if (auto asset_handle = asset_cache->load_asset(Asset{dependency}))
+            {
+              cell->dependencies_.push_back(std::move(asset_handle));
+            }
+          }
+        }
+        catch (const std::exception &error)
+        {
+          DC_LOG_WARN("Could not read scene cell {}: {}",
+                      cell->description_.scene_name_,
+                      error.what());
+          cell->data_ = {};
+        }
+
+        std::lock_guard lock{read_cells_mutex_};
+        read_cells_.push_back(cell);
+      });
+}
+
+void SceneStreamingSystem::add_cells(Scene &scene)
+{
+  {
+    std::lock_guard lock{read_cells_mutex_};
+    pending_cells_.insert(pending_cells_.end(),
+                          read_cells_.begin(),
+                          read_cells_.end());
+    read_cells_.clear();
+  }
+
+  // adding cells creates entities and physic actors, so only a few cells get
+  // added each frame
+  std::size_t added_count{0};
+  for (auto iter = pending_cells_.begin(); iter != pending_cells_.end();)
+  {
+    auto &cell = **iter;
+    if (cell.stream_generation_ != stream_generation_)
+    {
+      iter = pending_cells_.erase(iter);
+      continue;
+    }
+
+    const auto is_ready = std::all_of(cell.dependencies_.begin(),
+                                      cell.dependencies_.end(),
+                                      [](const auto &dependency)
+                                      { return dependency->is_ready(); });
+    if (cell.data_.data_ && (!is_ready || added_count >= cells_per_frame_))
+    {
+      ++iter;
+      continue;
+    }
+
+    if (cell.data_.data_)
+    {
+      try
+      {
+        BinaryReader reader{cell.data_.data_, cell.data_.size_};
+        cell.entities_ = scene.add_streamed_entities(reader);
+        cell.state_    = CellState::Loaded;
+        ++added_count;
+      }
+      catch (const std::runtime_error &error)
+      {
+        DC_LOG_WARN("Could not add scene cell {}: {}",
+                    cell.description_.scene_name_,
+                    error.what());
+        cell.state_ = CellState::Failed;
+      }
+    }
+    else
+    {
+      cell.state_ = CellState::Failed;
+    }
+
+    cell.data_ = {};
+    if (cell.state_ == CellState::Failed)
+    {
+      cell.dependencies_.clear();
+      resident_size_ -= cell.description_.size_;
+    }
+    iter = pending_cells_.erase(iter);
+  }
+}
+
+void SceneStreamingSystem::remove_cell(Scene &scene, Cell &cell)
+{
+  scene.remove_streamed_entities(cell.entities_);
+  cell.entities_.clear();
+  cell.dependencies_.clear();
+  cell.state_ = CellState::Unloaded;
+  resident_size_ -= cell.description_.size_;
+}
+
+void SceneStreamingSystem::on_scene_loaded(const SceneLoadedEvent &event)
+{
+  open_stream(event.scene_);
+}
+
+void SceneStreamingSystem::on_scene_unloaded(
+    const SceneUnloadedEvent & /*event*/)
+{
+  close_stream();
+}
+
+} // namespace dc
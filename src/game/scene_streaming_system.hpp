@@ -0,0 +1,94 @@
+#pragma once
+
+#include "asset_data.hpp"
+#include "asset_handle.hpp"
+#include "scene.hpp"
+#include "scene_events.hpp"
+#include "scene_stream.hpp"
+#include "system.hpp"
+#include "thread_pool.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace dc
+{
+
+/**
+ * Streams the cells of a split up scene around the primary camera. Cells get
+ * read on a background thread together with their dependencies and are
+ * added to the scene once everything is ready. Cells that get too far away,
+ * or that do not fit into the memory budget anymore, get removed again.
+ */
+class SceneStreamingSystem : public System
+{
+public:
+  void init() override;
+  void shutdown() override;
+  void update(float delta_time) override;
+  void render(SceneRenderInfo &scene_render_info,
+              ViewRenderInfo  &view_render_info) override;
+
+  bool on_event(const Event &event) override;
+
+  const char  *name() const override;
+  SystemAccess access(SystemPhase phase) const override;
+
+private:
+  enum class CellState
+  {
+    Unloaded,
+    Loading,
+    Loaded,
+    // cells that could not be read are not tried again
+    Failed,
+  };
+
+  struct Cell
+  {
+    SceneCellDescription description_;
+    CellState            state_{CellState::Unloaded};
+    // stream the cell belongs to, results of old streams get dropped
+    std::uint64_t stream_generation_{0};
+
+    // written by the streaming thread while the cell is loading
+    AssetData                                 data_{};
+    std::vector<std::shared_ptr<AssetHandle>> dependencies_;
+
+    std::vector<Uuid> entities_;
+  };
+
+  std::weak_ptr<Scene>               scene_{};
+  std::vector<std::shared_ptr<Cell>> cells_;
+  std::uint64_t                      stream_generation_{0};
+
+  float       load_distance_{0.0f};
+  float       unload_distance_{0.0f};
+  std::size_t memory_budget_{0};
+  std::size_t cells_per_frame_{0};
+  // size of the cells that are loading or loaded
+  std::size_t resident_size_{0};
+
+  std::mutex                         read_cells_mutex_;
+  std::vector<std::shared_ptr<Cell>> read_cells_;
+  // read cells that wait for their dependencies
+  std::vector<std::shared_ptr<Cell>> pending_cells_;
+
+  // last member, so that the streaming thread stops first
+  std::unique_ptr<ThreadPool> thread_pool_{};
+
+  void open_stream(std::shared_ptr<Scene> scene);
+  void close_stream();
+
+  void load_cell(std::shared_ptr<Cell> cell);
+  void add_cells(Scene &scene);
+  void remove_cell(Scene &scene, Cell &cell);
+
+  void on_scene_loaded(const SceneLoadedEvent &event);
+  void on_scene_unloaded(const SceneUnloadedEvent &event);
+};
+
+} // namespace dc
@@ -4,11 +4,14 @@
 namespace dc
 {
 
-void ScriptComponent::save(FILE *file) const
+void ScriptComponent::save(BinaryWriter &writer) const
 {
-  write_string(file, module_name_);
+  write_string(writer, module_name_);
 }
 
-void ScriptComponent::read(FILE *file) { read_string(file, module_name_); }
+void ScriptComponent::read(BinaryReader &reader)
+{
+  read_string(reader, module_name_);
+}
 
 } // namespace dc
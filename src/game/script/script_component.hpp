@@ -8,14 +8,17 @@
 namespace dc
 {
 
+class BinaryReader;
+class BinaryWriter;
+
 struct ScriptComponent
 {
   std::string module_name_;
 
   std::unique_ptr<EntityScriptInstance> entity_script_{};
 
-  void save(FILE *file) const;
-  void read(FILE *file);
+  void save(BinaryWriter &writer) const;
+  void read(BinaryReader &reader);
 };
 
 } // namespace dc
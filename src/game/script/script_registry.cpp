@@ -80,6 +80,7 @@ void register_all(MonoImage *core_image)
   // scene
   REGISTER_FUNCTION(Scene, CreateEntity);
   REGISTER_FUNCTION(Scene, RemoveEntity);
+  REGISTER_FUNCTION(Scene, Instantiate);
 
   // entity
   REGISTER_FUNCTION(Entity, CreateComponent);
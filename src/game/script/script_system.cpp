@@ -8,6 +8,7 @@
 #include "scene_events.hpp"
 #include "script_component.hpp"
 #include "script_engine.hpp"
+#include "script_wrapper.hpp"
 #include "window.hpp"
 
 #include <filesystem>
@@ -49,6 +50,9 @@ void ScriptSystem::update(float delta_time)
     return;
   }
 
+  // the wrapper calls of the scripts find their entities in this scene
+  script_wrapper::ScopedScene scoped_scene{scene.get()};
+
   const auto &view = scene->all_entities_with<ScriptComponent>();
   for (const auto &entity : view)
   {
@@ -65,6 +69,18 @@ void ScriptSystem::render(SceneRenderInfo & /*scene_render_info*/,
 {
 }
 
+const char *ScriptSystem::name() const { return "ScriptSystem"; }
+
+SystemAccess ScriptSystem::access(SystemPhase phase) const
+{
+  // scripts can access every entity and component
+  if (phase == SystemPhase::Update)
+  {
+    return SystemAccess::exclusive();
+  }
+  return {};
+}
+
 bool ScriptSystem::on_event(const Event &event)
 {
   const auto event_id = event.id();
@@ -135,6 +151,8 @@ void ScriptSystem::on_component_construct(const ComponentConstructEvent &event)
       script_engine_->construct_entity(event.entity_, module_name);
   if (script_entity)
   {
+    const auto                  scene = event.entity_.scene();
+    script_wrapper::ScopedScene scoped_scene{scene.get()};
     script_entity->on_create();
     script_component.entity_script_ = std::move(script_entity);
   }
@@ -152,6 +170,9 @@ void ScriptSystem::on_entity_collision_begin(
     return;
   }
   auto &component = event.collider_.component<ScriptComponent>();
+
+  const auto                  scene = event.collider_.scene();
+  script_wrapper::ScopedScene scoped_scene{scene.get()};
   component.entity_script_->on_collison_begin(event.collidee_);
 }
 
@@ -162,6 +183,9 @@ void ScriptSystem::on_entity_collision_end(const EntityCollisionEndEvent &event)
     return;
   }
   auto &component = event.collider_.component<ScriptComponent>();
+
+  const auto                  scene = event.collider_.scene();
+  script_wrapper::ScopedScene scoped_scene{scene.get()};
   component.entity_script_->on_collison_end(event.collidee_);
 }
 
@@ -172,6 +196,9 @@ void ScriptSystem::on_entity_trigger_begin(const EntityTriggerBeginEvent &event)
     return;
   }
   auto &component = event.trigger_.component<ScriptComponent>();
+
+  const auto                  scene = event.trigger_.scene();
+  script_wrapper::ScopedScene scoped_scene{scene.get()};
   component.entity_script_->on_trigger_begin(event.other_);
 }
 
@@ -182,6 +209,9 @@ void ScriptSystem::on_entity_trigger_end(const EntityTriggerEndEvent &event)
     return;
   }
   auto &component = event.trigger_.component<ScriptComponent>();
+
+  const auto                  scene = event.trigger_.scene();
+  script_wrapper::ScopedScene scoped_scene{scene.get()};
   component.entity_script_->on_trigger_end(event.other_);
 }
 
@@ -193,6 +223,8 @@ void ScriptSystem::on_key(const KeyEvent &event)
     return;
   }
 
+  script_wrapper::ScopedScene scoped_scene{scene.get()};
+
   auto view = scene->all_entities_with<ScriptComponent>();
   for (const auto &entity : view)
   {
@@ -12,6 +12,7 @@
 #include "physic/rigid_body_component.hpp"
 #include "physic/sphere_collider.hpp"
 #include "physic/sphere_collider_component.hpp"
+#include "prefab_asset.hpp"
 #include "profiling.hpp"
 #include "scene_events.hpp"
 #include "script/script_component.hpp"
@@ -20,8 +21,10 @@
 
 #include <mono/metadata/reflection.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 extern std::unordered_map<MonoType *, std::function<bool(dc::Entity &)>>
     has_component_funcs;
@@ -31,7 +34,10 @@ extern std::unordered_map<MonoType *, std::function<void(dc::Entity &)>>
 namespace
 {
 
-dc::Entity get_entity(std::uint64_t entity_id)
+/// Set by ScopedScene, only used from the thread that runs the scripts
+dc::Scene *current_scene{nullptr};
+
+std::shared_ptr<dc::Scene> get_scene()
 {
   const auto game_layer =
       dc::Engine::instance()->layer_stack()->layer<dc::GameLayer>();
@@ -41,22 +47,60 @@ dc::Entity get_entity(std::uint64_t entity_id)
     return {};
   }
 
-  const auto scene = game_layer->scene()->get();
+  // no scene asset while the game layer switches scenes
+  const auto scene_asset = game_layer->scene();
+  const auto scene       = scene_asset ? scene_asset->get() : nullptr;
   if (!scene)
   {
     DC_LOG_WARN("Can not get entity withoug active scene");
     return {};
   }
+  return scene;
+}
+
+/**
+ * Resolves the entity with a single lookup. The reference does not lock the
+ * scene on every access and is only used during the call.
+ */
+dc::EntityRef get_entity(std::uint64_t entity_id)
+{
+  if (current_scene)
+  {
+    return current_scene->entity_ref(entity_id);
+  }
+
+  const auto scene = get_scene();
+  if (!scene)
+  {
+    return {};
+  }
+
+  return scene->entity_ref(entity_id);
+}
+
+/// The scene the script system runs the scripts in, else the active scene
+std::shared_ptr<dc::Scene> get_current_scene()
+{
+  return current_scene ? current_scene->shared_from_this() : get_scene();
+}
+
+/// For the calls that need an entity that keeps track of its scene
+dc::Entity get_scene_entity(std::uint64_t entity_id)
+{
+  const auto scene = get_current_scene();
+  if (!scene || !scene->exists(entity_id))
+  {
+    return {};
+  }
 
   return scene->entity(entity_id);
 }
 
-dc::RigidBody *get_rigid_body(dc::Entity entity)
+dc::RigidBody *get_rigid_body(const dc::EntityRef &entity)
 {
-  if (entity.has_component<dc::RigidBodyComponent>())
+  if (const auto component = entity.try_component<dc::RigidBodyComponent>())
   {
-    const auto &component = entity.component<dc::RigidBodyComponent>();
-    return component.physic_actor_;
+    return component->physic_actor_;
   }
 
   DC_LOG_WARN("Can not find rigid body on entity");
@@ -68,6 +112,14 @@ dc::RigidBody *get_rigid_body(dc::Entity entity)
 namespace dc::script_wrapper
 {
 
+ScopedScene::ScopedScene(Scene *scene)
+    : previous_scene_{current_scene}
+{
+  current_scene = scene;
+}
+
+ScopedScene::~ScopedScene() { current_scene = previous_scene_; }
+
 void Dc_Log_LogMessage(LogLevel level, MonoString *message)
 {
   DC_PROFILE_SCOPE("Dc_Log_LogMessage");
@@ -92,7 +144,7 @@ void Dc_Log_LogMessage(LogLevel level, MonoString *message)
 
 bool Dc_Entity_HasComponent(std::uint64_t entity_id, void *type)
 {
-  auto entity = get_entity(entity_id);
+  auto entity = get_scene_entity(entity_id);
   if (!entity.valid())
   {
     DC_LOG_WARN("Can not get entity from {}", entity_id);
@@ -116,7 +168,7 @@ bool Dc_Entity_HasComponent(std::uint64_t entity_id, void *type)
 
 void Dc_Entity_CreateComponent(std::uint64_t entity_id, void *type)
 {
-  auto entity = get_entity(entity_id);
+  auto entity = get_scene_entity(entity_id);
   if (!entity.valid())
   {
     DC_LOG_WARN("Can not get entity from {}", entity_id);
@@ -279,8 +331,11 @@ bool Dc_Input_IsMouseButtonPressed(MouseButton button)
 
 std::uint64_t Dc_Scene_CreateEntity(MonoString *name)
 {
-  const auto scene =
-      Engine::instance()->layer_stack()->layer<GameLayer>()->scene()->get();
+  const auto scene = get_current_scene();
+  if (!scene)
+  {
+    return 0;
+  }
 
   const auto entity = scene->create_entity(mono_string_to_string(name));
   return entity.id();
@@ -288,16 +343,69 @@ std::uint64_t Dc_Scene_CreateEntity(MonoString *name)
 
 void Dc_Scene_RemoveEntity(std::uint64_t entity_id)
 {
-  const auto scene =
-      Engine::instance()->layer_stack()->layer<GameLayer>()->scene()->get();
+  const auto scene = get_current_scene();
+  if (!scene)
+  {
+    return;
+  }
 
   scene->remove_entity(entity_id);
 }
 
+std::int32_t Dc_Scene_Instantiate(MonoString  *prefab_name,
+                                  std::int32_t count,
+                                  MonoArray   *transforms,
+                                  MonoArray   *out_entity_ids)
+{
+  DC_PROFILE_SCOPE("Dc_Scene_Instantiate");
+
+  if (count <= 0)
+  {
+    return 0;
+  }
+  if (!transforms || !out_entity_ids ||
+      mono_array_length(transforms) < static_cast<std::uintptr_t>(count) ||
+      mono_array_length(out_entity_ids) < static_cast<std::uintptr_t>(count))
+  {
+    DC_LOG_WARN("Need a transform and an entity id for every instance");
+    return 0;
+  }
+
+  const auto prefab_asset = std::dynamic_pointer_cast<PrefabAssetHandle>(
+      Engine::instance()->asset_cache()->load_asset(
+          Asset{mono_string_to_string(prefab_name)},
+          AssetLoadMode::Sync));
+  if (!prefab_asset || !prefab_asset->is_ready())
+  {
+    DC_LOG_WARN("Can not instantiate prefab {}",
+                mono_string_to_string(prefab_name));
+    return 0;
+  }
+
+  const auto scene = get_current_scene();
+  if (!scene)
+  {
+    DC_LOG_WARN("Can not instantiate prefab {} without a scene",
+                mono_string_to_string(prefab_name));
+    return 0;
+  }
+
+  const auto first_transform = mono_array_addr(transforms, glm::mat4, 0);
+  const std::vector<glm::mat4> instance_transforms(first_transform,
+                                                   first_transform + count);
+  const auto entity_ids =
+      scene->instantiate(*prefab_asset->get(), instance_transforms);
+
+  std::copy(entity_ids.begin(),
+            entity_ids.end(),
+            mono_array_addr(out_entity_ids, std::uint64_t, 0));
+  return static_cast<std::int32_t>(entity_ids.size());
+}
+
 void Dc_MeshComponent_SetMesh(std::uint64_t entity_id, MonoString *mesh_name)
 {
   const auto entity = get_entity(entity_id);
-  if (!entity.has_component<MeshComponent>())
+  if (!entity.valid() || !entity.has_component<MeshComponent>())
   {
     DC_LOG_WARN("Can not add mesh to an entity without a MeshComponent");
     return;
@@ -626,7 +734,11 @@ void Dc_SphereColliderComponent_GetOffset(std::uint64_t entity_id,
 void Dc_ScriptComponent_SetScript(std::uint64_t entity_id,
                                   MonoString   *script_name)
 {
-  const auto entity = get_entity(entity_id);
+  const auto entity = get_scene_entity(entity_id);
+  if (!entity.valid())
+  {
+    return;
+  }
 
   auto &component      = entity.component<ScriptComponent>();
   const auto &new_module_name = mono_string_to_string(script_name);
@@ -8,8 +8,31 @@
 
 #include <cstdint>
 
+namespace dc
+{
+class Scene;
+}
+
 namespace dc::script_wrapper
 {
+/**
+ * While it lives the wrapper functions resolve entities in the given scene
+ * instead of looking the active scene up on every call. The script system
+ * holds one while it runs the scripts.
+ */
+class ScopedScene
+{
+public:
+  explicit ScopedScene(Scene *scene);
+  ~ScopedScene();
+
+  ScopedScene(const ScopedScene &)    = delete;
+  void operator=(const ScopedScene &) = delete;
+
+private:
+  Scene *previous_scene_{};
+};
+
 enum class LogLevel : std::int32_t
 {
   Debug = 1 << 0,
@@ -34,6 +57,10 @@ bool Dc_Input_IsMouseButtonPressed(MouseButton button);
 
 std::uint64_t Dc_Scene_CreateEntity(MonoString *name);
 void          Dc_Scene_RemoveEntity(std::uint64_t entity_id);
+std::int32_t  Dc_Scene_Instantiate(MonoString  *prefab_name,
+                                   std::int32_t count,
+                                   MonoArray   *transforms,
+                                   MonoArray   *out_entity_ids);
 
 void Dc_MeshComponent_SetMesh(std::uint64_t entity_id, MonoString *mesh_name);
 
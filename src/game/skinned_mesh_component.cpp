@@ -29,36 +29,37 @@ AnimationState *SkinnedMeshComponent::animation_state() const
   return animation_state_.get();
 }
 
-void SkinnedMeshComponent::save(FILE *file) const
+void SkinnedMeshComponent::save(BinaryWriter &writer) const
 {
   std::string skinned_mesh_asset_name;
   if (skinned_mesh_)
   {
     skinned_mesh_asset_name = skinned_mesh_->asset().id();
   }
-  write_string(file, skinned_mesh_asset_name);
+  write_string(writer, skinned_mesh_asset_name);
   if (animation_state_)
   {
-    animation_state_->save(file);
+    animation_state_->save(writer);
   }
 }
 
-void SkinnedMeshComponent::read(FILE *file)
+void SkinnedMeshComponent::read(BinaryReader &reader)
 {
   std::string skinned_mesh_asset_name;
-  read_string(file, skinned_mesh_asset_name);
+  read_string(reader, skinned_mesh_asset_name);
   if (!skinned_mesh_asset_name.empty())
   {
     skinned_mesh_ = std::dynamic_pointer_cast<SkinnedMeshAssetHandle>(
         Engine::instance()->asset_cache()->load_asset(
-            Asset{skinned_mesh_asset_name}));
+            Asset{skinned_mesh_asset_name},
+            AssetLoadMode::Sync));
 
     DC_ASSERT(skinned_mesh_->is_ready(), "Asset not ready");
     if (skinned_mesh_->is_ready())
     {
       animation_state_ =
           std::make_unique<AnimationState>(skinned_mesh_->get()->skeleton());
-      animation_state_->read(file);
+      animation_state_->read(reader);
     }
   }
   else
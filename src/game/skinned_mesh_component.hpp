@@ -9,6 +9,9 @@
 namespace dc
 {
 
+class BinaryReader;
+class BinaryWriter;
+
 struct SkinnedMeshComponent
 {
 public:
@@ -17,8 +20,8 @@ public:
 
   AnimationState *animation_state() const;
 
-  void                                  save(FILE *file) const;
-  void                                  read(FILE *file);
+  void                                  save(BinaryWriter &writer) const;
+  void                                  read(BinaryReader &reader);
 
 private:
   std::shared_ptr<SkinnedMeshAssetHandle> skinned_mesh_{};
@@ -6,20 +6,20 @@
 namespace dc
 {
 
-void SkyComponent::save(FILE *file) const
+void SkyComponent::save(BinaryWriter &writer) const
 {
   std::string asset_name;
   if (environment_)
   {
     asset_name = environment_->asset().id();
   }
-  write_string(file, asset_name);
+  write_string(writer, asset_name);
 }
 
-void SkyComponent::read(FILE *file)
+void SkyComponent::read(BinaryReader &reader)
 {
   std::string asset_name;
-  read_string(file, asset_name);
+  read_string(reader, asset_name);
   if (!asset_name.empty())
   {
     environment_ = std::dynamic_pointer_cast<EnvMapAssetHandle>(
@@ -5,13 +5,16 @@
 namespace dc
 {
 
+class BinaryReader;
+class BinaryWriter;
+
 struct SkyComponent
 {
 
   std::shared_ptr<EnvMapAssetHandle> environment_{};
 
-  void save(FILE *file) const;
-  void read(FILE *file);
+  void save(BinaryWriter &writer) const;
+  void read(BinaryReader &reader);
 };
 
 } // namespace dc
@@ -2,6 +2,7 @@
 
 #include "event.hpp"
 #include "frame_data.hpp"
+#include "system_access.hpp"
 
 namespace dc
 {
@@ -19,6 +20,18 @@ public:
                       ViewRenderInfo  &view_render_info) = 0;
 
   virtual bool on_event(const Event & /*event*/) { return false; }
+
+  /// Name of the per-frame timings of the system
+  virtual const char *name() const = 0;
+
+  /**
+   * Types the system accesses in a phase. Systems that don't declare their
+   * accesses run alone on the main thread.
+   */
+  virtual SystemAccess access(SystemPhase /*phase*/) const
+  {
+    return SystemAccess::exclusive();
+  }
 };
 
 } // namespace dc
@@ -0,0 +1,55 @@
+#include "system_access.hpp"
+
+#include <algorithm>
+
+namespace
+{
+
+bool contains_any(const std::vector<entt::id_type> &types,
+                  const std::vector<entt::id_type> &other_types)
+{
+  return std::any_of(types.begin(),
+                     types.end(),
+                     [&](const entt::id_type type)
+                     {
+                       return std::find(other_types.begin(),
+                                        other_types.end(),
+                                        type) != other_types.end();
+                     });
+}
+
+} // namespace
+
+namespace dc
+{
+
+SystemAccess SystemAccess::exclusive()
+{
+  SystemAccess access{};
+  access.is_exclusive_   = true;
+  access.is_main_thread_ = true;
+  return access;
+}
+
+SystemAccess &SystemAccess::on_main_thread()
+{
+  is_main_thread_ = true;
+  return *this;
+}
+
+bool SystemAccess::is_exclusive() const { return is_exclusive_; }
+
+bool SystemAccess::is_main_thread() const { return is_main_thread_; }
+
+bool SystemAccess::conflicts_with(const SystemAccess &other) const
+{
+  if (is_exclusive_ || other.is_exclusive_)
+  {
+    return true;
+  }
+  return contains_any(write_types_, other.write_types_) ||
+         contains_any(write_types_, other.read_types_) ||
+         contains_any(read_types_, other.write_types_);
+}
+
+} // namespace dc
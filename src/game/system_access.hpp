@@ -0,0 +1,59 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include <vector>
+
+namespace dc
+{
+
+enum class SystemPhase
+{
+  Update,
+  Render,
+};
+
+/**
+ * Types a system reads and writes in a phase. Components as well as shared
+ * data like SceneRenderInfo can be declared. Systems whose accesses do not
+ * conflict run concurrently. Systems that need the main thread, e.g. because
+ * they call into GL, OpenAL or scripts, can be pinned to it.
+ */
+class SystemAccess
+{
+public:
+  /**
+   * Runs alone on the main thread after all previous systems finished. Used
+   * for systems that create or destroy entities or run scripts.
+   */
+  static SystemAccess exclusive();
+
+  template <typename... T> SystemAccess &reads()
+  {
+    (read_types_.push_back(entt::type_hash<T>::value()), ...);
+    return *this;
+  }
+
+  template <typename... T> SystemAccess &writes()
+  {
+    (write_types_.push_back(entt::type_hash<T>::value()), ...);
+    return *this;
+  }
+
+  SystemAccess &on_main_thread();
+
+  bool is_exclusive() const;
+  bool is_main_thread() const;
+
+  /// Whether one of the systems writes a type the other one accesses
+  bool conflicts_with(const SystemAccess &other) const;
+
+private:
+  bool is_exclusive_{false};
+  bool is_main_thread_{false};
+
+  std::vector<entt::id_type> read_types_;
+  std::vector<entt::id_type> write_types_;
+};
+
+} // namespace dc
@@ -1,5 +1,9 @@
 #include "systems_context.hpp"
+#include "engine.hpp"
 #include "profiling.hpp"
+#include "time.hpp"
+
+#include <algorithm>
 
 namespace dc
 {
@@ -8,8 +12,16 @@ void SystemsContext::init()
 {
   DC_PROFILE_SCOPE("SystemsContext::init()");
 
+  const auto is_parallel = Engine::instance()->config()->config_value_bool(
+      "Systems",
+      "parallel",
+      true);
+  job_system_ = is_parallel ? Engine::instance()->job_system() : nullptr;
+
+  timing_names_.clear();
   for (const auto &system : systems_)
   {
+    timing_names_.push_back(std::string{"System "} + system->name());
     system->init();
   }
 }
@@ -18,6 +30,7 @@ void SystemsContext::shutdown()
 {
   DC_PROFILE_SCOPE("SystemsContext::shutdown()");
 
+  job_system_ = nullptr;
   for (const auto &system : systems_)
   {
     system->shutdown();
@@ -28,10 +41,8 @@ void SystemsContext::update(float delta_time)
 {
   DC_PROFILE_SCOPE("SystemsContext::update()");
 
-  for (const auto &system : systems_)
-  {
-    system->update(delta_time);
-  }
+  run_phase(SystemPhase::Update,
+            [delta_time](System &system) { system.update(delta_time); });
 }
 
 void SystemsContext::render(SceneRenderInfo &scene_render_info,
@@ -39,10 +50,9 @@ void SystemsContext::render(SceneRenderInfo &scene_render_info,
 {
   DC_PROFILE_SCOPE("SystemsContext::render()");
 
-  for (const auto &system : systems_)
-  {
-    system->render(scene_render_info, view_render_info);
-  }
+  run_phase(SystemPhase::Render,
+            [&](System &system)
+            { system.render(scene_render_info, view_render_info); });
 }
 
 bool SystemsContext::on_event(const Event &event)
@@ -57,4 +67,189 @@ bool SystemsContext::on_event(const Event &event)
   return false;
 }
 
+void SystemsContext::run_phase(SystemPhase                          phase,
+                               const std::function<void(System &)> &function)
+{
+  build_dependency_graph(phase);
+
+  std::unique_lock lock{mutex_};
+  run_phase_function_ = &function;
+  finished_count_     = 0;
+  exception_          = nullptr;
+  remaining_dependencies_.resize(systems_.size());
+  for (std::size_t i{0}; i < systems_.size(); ++i)
+  {
+    remaining_dependencies_[i] = dependencies_[i].size();
+    if (remaining_dependencies_[i] == 0)
+    {
+      set_ready(i);
+    }
+  }
+
+  // the calling thread runs the systems that are pinned to it and helps with
+  // the others until all systems finished
+  while (true)
+  {
+    condition_.wait(lock,
+                    [this]()
+                    {
+                      return !main_thread_systems_.empty() ||
+                             !worker_systems_.empty() ||
+                             finished_count_ == systems_.size();
+                    });
+    if (finished_count_ == systems_.size())
+    {
+      break;
+    }
+
+    auto &systems = !main_thread_systems_.empty() ? main_thread_systems_
+                                                  : worker_systems_;
+    const auto index = systems.front();
+    systems.pop_front();
+    lock.unlock();
+    run_system(index);
+    lock.lock();
+  }
+  run_phase_function_ = nullptr;
+
+  if (exception_)
+  {
+    std::rethrow_exception(exception_);
+  }
+  lock.unlock();
+
+  report_times(phase);
+}
+
+void SystemsContext::build_dependency_graph(SystemPhase phase)
+{
+  DC_PROFILE_SCOPE("SystemsContext::build_dependency_graph()");
+
+  const auto systems_count = systems_.size();
+  accesses_.clear();
+  dependencies_.assign(systems_count, {});
+  dependents_.assign(systems_count, {});
+  times_.assign(systems_count, 0.0f);
+
+  // systems that got added later wait for the earlier ones they conflict
+  // with, so conflicting systems keep running in the order they got added
+  for (std::size_t i{0}; i < systems_count; ++i)
+  {
+    accesses_.push_back(systems_[i]->access(phase));
+    for (std::size_t j{0}; j < i; ++j)
+    {
+      if (accesses_[i].conflicts_with(accesses_[j]))
+      {
+        dependencies_[i].push_back(j);
+        dependents_[j].push_back(i);
+      }
+    }
+  }
+}
+
+void SystemsContext::set_ready(std::size_t index)
+{
+  if (!job_system_ || accesses_[index].is_main_thread())
+  {
+    main_thread_systems_.push_back(index);
+  }
+  else
+  {
+    worker_systems_.push_back(index);
+    job_system_->submit([this]() { run_worker_system(); });
+  }
+  condition_.notify_all();
+}
+
+void SystemsContext::run_system(std::size_t index)
+{
+  auto &system = *systems_[index];
+  DC_PROFILE_SCOPE_DYNAMIC(system.name());
+
+  // once a system failed the remaining systems get skipped, like they would
+  // if the systems ran one after another
+  bool is_skipped{false};
+  {
+    std::lock_guard lock{mutex_};
+    is_skipped = exception_ != nullptr;
+  }
+
+  Timer              timer;
+  std::exception_ptr exception{};
+  if (!is_skipped)
+  {
+    try
+    {
+      (*run_phase_function_)(system);
+    }
+    catch (...)
+    {
+      exception = std::current_exception();
+    }
+  }
+  const auto time = timer.elapsed_millis();
+
+  std::lock_guard lock{mutex_};
+  times_[index] = time;
+  if (exception && !exception_)
+  {
+    exception_ = exception;
+  }
+  for (const auto dependent : dependents_[index])
+  {
+    if (--remaining_dependencies_[dependent] == 0)
+    {
+      set_ready(dependent);
+    }
+  }
+  ++finished_count_;
+  condition_.notify_all();
+}
+
+void SystemsContext::run_worker_system()
+{
+  // the calling thread may have taken the system already
+  std::size_t index{0};
+  {
+    std::lock_guard lock{mutex_};
+    if (worker_systems_.empty())
+    {
+      return;
+    }
+    index = worker_systems_.front();
+    worker_systems_.pop_front();
+  }
+  run_system(index);
+}
+
+void SystemsContext::report_times(SystemPhase phase)
+{
+#if defined(DC_ENABLE_TIMING)
+  const auto profiler = Engine::instance()->performance_profiler();
+
+  // dependencies always come before their dependents, so the longest path
+  // to every system can be computed in one pass
+  std::vector<float> path_times(systems_.size(), 0.0f);
+  float              critical_path_time{0.0f};
+  for (std::size_t i{0}; i < systems_.size(); ++i)
+  {
+    float dependencies_time{0.0f};
+    for (const auto dependency : dependencies_[i])
+    {
+      dependencies_time = std::max(dependencies_time, path_times[dependency]);
+    }
+    path_times[i]      = dependencies_time + times_[i];
+    critical_path_time = std::max(critical_path_time, path_times[i]);
+
+    profiler->set_per_frame_timing(timing_names_[i], times_[i]);
+  }
+  profiler->set_per_frame_timing(phase == SystemPhase::Update
+                                     ? "Systems update critical path"
+                                     : "Systems render critical path",
+                                 critical_path_time);
+#else
+  (void)phase;
+#endif
+}
+
 } // namespace dc
@@ -1,13 +1,29 @@
 #pragma once
 
+#include "job_system.hpp"
 #include "system.hpp"
 
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 
 namespace dc
 {
 
+/**
+ * Runs the systems in update() and render(). Every frame the systems get
+ * ordered by a dependency graph that is built from their accesses: a system
+ * waits for all previously added systems it conflicts with. Systems without
+ * conflicts run concurrently as jobs, systems pinned to the main thread run
+ * on the calling thread. The time of every system and the critical path
+ * through the graph get reported to the PerformanceProfiler.
+ */
 class SystemsContext
 {
 public:
@@ -30,5 +46,33 @@ public:
 
 private:
   std::vector<std::unique_ptr<System>> systems_;
+  std::vector<std::string>             timing_names_;
+  // null if the systems run one after another
+  JobSystem *job_system_{};
+
+  // dependency graph of the current phase, indexed like the systems
+  std::vector<SystemAccess>             accesses_;
+  std::vector<std::vector<std::size_t>> dependencies_;
+  std::vector<std::vector<std::size_t>> dependents_;
+  std::vector<float>                    times_;
+
+  // state of the running phase. Guarded by the mutex except for the
+  // function, which is set before and reset after all systems ran
+  std::mutex                           mutex_;
+  std::condition_variable              condition_;
+  const std::function<void(System &)> *run_phase_function_{};
+  std::vector<std::size_t>             remaining_dependencies_;
+  std::deque<std::size_t>              main_thread_systems_;
+  std::deque<std::size_t>              worker_systems_;
+  std::size_t                          finished_count_{0};
+  std::exception_ptr                   exception_{};
+
+  void run_phase(SystemPhase                          phase,
+                 const std::function<void(System &)> &function);
+  void build_dependency_graph(SystemPhase phase);
+  void set_ready(std::size_t index);
+  void run_system(std::size_t index);
+  void run_worker_system();
+  void report_times(SystemPhase phase);
 };
 } // namespace dc
@@ -17,6 +17,16 @@ glm::mat4 calculate_transform_matrix(const glm::vec3 &position,
   return transform_matrix;
 }
 
+glm::quat parent_rotation(const glm::mat4 &parent_transform_matrix)
+{
+  // remove the scale, so that only the rotation is left
+  const glm::mat3 rotation_matrix{
+      glm::normalize(glm::vec3{parent_transform_matrix[0]}),
+      glm::normalize(glm::vec3{parent_transform_matrix[1]}),
+      glm::normalize(glm::vec3{parent_transform_matrix[2]})};
+  return glm::quat_cast(rotation_matrix);
+}
+
 } // namespace
 
 namespace dc
@@ -25,13 +35,15 @@ namespace dc
 void TransformComponent::set_position(const glm::vec3 &value)
 {
   position_ = value;
-  recalculate_transform_matrix();
+  is_dirty_ = true;
 }
 
-void TransformComponent::set_absolute_position(const glm::vec3 &value)
+void TransformComponent::set_absolute_position(
+    const glm::vec3 &value,
+    const glm::mat4 &parent_transform_matrix)
 {
-  position_ = value;
-  recalculate_transform_matrix(false);
+  position_ = glm::inverse(parent_transform_matrix) * glm::vec4{value, 1.0f};
+  is_dirty_ = true;
 }
 
 glm::vec3 TransformComponent::position() const { return position_; }
@@ -39,13 +51,15 @@ glm::vec3 TransformComponent::position() const { return position_; }
 void TransformComponent::set_rotation(const glm::quat &value)
 {
   rotation_ = value;
-  recalculate_transform_matrix();
+  is_dirty_ = true;
 }
 
-void TransformComponent::set_absolute_rotation(const glm::quat &value)
+void TransformComponent::set_absolute_rotation(
+    const glm::quat &value,
+    const glm::mat4 &parent_transform_matrix)
 {
-  rotation_ = value;
-  recalculate_transform_matrix(false);
+  rotation_ = glm::inverse(parent_rotation(parent_transform_matrix)) * value;
+  is_dirty_ = true;
 }
 
 glm::quat TransformComponent::rotation_quat() const { return rotation_; }
@@ -53,7 +67,7 @@ glm::quat TransformComponent::rotation_quat() const { return rotation_; }
 void TransformComponent::set_rotation(const glm::vec3 &value)
 {
   rotation_ = glm::quat(value);
-  recalculate_transform_matrix();
+  is_dirty_ = true;
 }
 
 glm::vec3 TransformComponent::rotation() const
@@ -63,56 +77,36 @@ glm::vec3 TransformComponent::rotation() const
 
 void TransformComponent::set_scale(const glm::vec3 &value)
 {
-  scale_ = value;
-  recalculate_transform_matrix();
+  scale_    = value;
+  is_dirty_ = true;
 }
 
 glm::vec3 TransformComponent::scale() const { return scale_; }
 
-glm::mat4 TransformComponent::transform_matrix() const
+glm::mat4 TransformComponent::local_transform_matrix() const
 {
-  return transform_matrix_;
+  return calculate_transform_matrix(position_, rotation_, scale_);
 }
 
-void TransformComponent::recalculate_transform_matrix(bool use_parent)
-{
-  const auto transform_matrix =
-      calculate_transform_matrix(position_, rotation_, scale_);
-  if (use_parent)
-  {
-    transform_matrix_ = parent_transform_matrix_ * transform_matrix;
-    return;
-  }
-  transform_matrix_ = transform_matrix;
-}
+bool TransformComponent::is_dirty() const { return is_dirty_; }
 
-void TransformComponent::set_parent_transform_matrix(const glm::mat4 &value)
-{
-  parent_transform_matrix_ = value;
-  recalculate_transform_matrix();
-}
+void TransformComponent::set_dirty() { is_dirty_ = true; }
 
-glm::mat4 TransformComponent::local_transform_matrix() const
-{
-  return calculate_transform_matrix(position_, rotation_, scale_);
-}
+void TransformComponent::clear_dirty() { is_dirty_ = false; }
 
-void TransformComponent::save(FILE *file) const
+void TransformComponent::save(BinaryWriter &writer) const
 {
-  write_value(file, position_);
-  write_value(file, rotation_);
-  write_value(file, scale_);
-  write_value(file, parent_transform_matrix_);
-  write_value(file, transform_matrix_);
+  write_value(writer, position_);
+  write_value(writer, rotation_);
+  write_value(writer, scale_);
 }
 
-void TransformComponent::read(FILE *file)
+void TransformComponent::read(BinaryReader &reader)
 {
-  read_value(file, position_);
-  read_value(file, rotation_);
-  read_value(file, scale_);
-  read_value(file, parent_transform_matrix_);
-  read_value(file, transform_matrix_);
+  read_value(reader, position_);
+  read_value(reader, rotation_);
+  read_value(reader, scale_);
+  is_dirty_ = true;
 }
 
 } // namespace dc
@@ -2,20 +2,30 @@
 
 #include "math.hpp"
 
-#include <cstdio>
-
 namespace dc
 {
 
+class BinaryReader;
+class BinaryWriter;
+
+/**
+ * Position, rotation and scale relative to the parent. Setters only write the
+ * local values and mark the component dirty. The TransformSystem updates the
+ * world matrices of all dirty components and their descendants once per
+ * frame. The world matrices are not part of the component, the scene keeps
+ * them in a dense buffer, see Scene::world_matrix().
+ */
 struct TransformComponent
 {
-
+  /// The absolute setters take the world matrix of the parent
   void      set_position(const glm::vec3 &value);
-  void      set_absolute_position(const glm::vec3 &value);
+  void      set_absolute_position(const glm::vec3 &value,
+                                  const glm::mat4 &parent_transform_matrix);
   glm::vec3 position() const;
 
   void      set_rotation(const glm::quat &value);
-  void      set_absolute_rotation(const glm::quat &value);
+  void      set_absolute_rotation(const glm::quat &value,
+                                  const glm::mat4 &parent_transform_matrix);
   glm::quat rotation_quat() const;
 
   void      set_rotation(const glm::vec3 &value);
@@ -24,23 +34,23 @@ struct TransformComponent
   void      set_scale(const glm::vec3 &value);
   glm::vec3 scale() const;
 
-  void set_parent_transform_matrix(const glm::mat4 &value);
-
-  glm::mat4 transform_matrix() const;
   glm::mat4 local_transform_matrix() const;
 
-  void save(FILE *file) const;
-  void read(FILE *file);
+  /// True if the local values changed since the world matrix got updated
+  bool is_dirty() const;
+  void set_dirty();
+  /// Called once the world matrix got updated
+  void clear_dirty();
+
+  void save(BinaryWriter &writer) const;
+  void read(BinaryReader &reader);
 
 private:
   glm::vec3 position_{0.0f};
   glm::quat rotation_{1.0f, 0.0f, 0.0f, 0.0f};
   glm::vec3 scale_{1.0f};
 
-  glm::mat4 parent_transform_matrix_{1.0f};
-  glm::mat4 transform_matrix_{1.0f};
-
-  void recalculate_transform_matrix(bool use_parent = true);
+  bool is_dirty_{true};
 };
 
 } // namespace dc
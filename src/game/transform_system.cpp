@@ -0,0 +1,343 @@
+#include "transform_system.hpp"
+#include "engine.hpp"
+#include "game_layer.hpp"
+#include "profiling.hpp"
+#include "relationship_component.hpp"
+#include "transform_component.hpp"
+
+#include <limits>
+
+namespace
+{
+
+constexpr std::uint32_t no_parent{std::numeric_limits<std::uint32_t>::max()};
+
+// levels with fewer entities get updated on the calling thread
+constexpr std::size_t parallel_level_size{4096};
+constexpr std::size_t chunk_size{1024};
+
+} // namespace
+
+namespace dc
+{
+
+void TransformSystem::init()
+{
+  const auto game_layer = Engine::instance()->layer_stack()->layer<GameLayer>();
+  if (game_layer)
+  {
+    const auto scene = game_layer->scene();
+    if (scene)
+    {
+      scene_ = scene->get();
+    }
+  }
+}
+
+void TransformSystem::update(float /*delta_time*/)
+{
+  DC_PROFILE_SCOPE("TransformSystem::update()");
+
+  update_transforms();
+}
+
+void TransformSystem::render(SceneRenderInfo & /*scene_render_info*/,
+                             ViewRenderInfo & /*view_render_info*/)
+{
+  DC_PROFILE_SCOPE("TransformSystem::render()");
+
+  update_transforms();
+}
+
+const char *TransformSystem::name() const { return "TransformSystem"; }
+
+SystemAccess TransformSystem::access(SystemPhase /*phase*/) const
+{
+  return SystemAccess{}
+      .reads<RelationshipComponent>()
+      .writes<TransformComponent>();
+}
+
+bool TransformSystem::on_event(const Event &event)
+{
+  const auto event_id = event.id();
+
+  if (event_id == SceneLoadedEvent::id)
+  {
+    on_scene_loaded(dynamic_cast<const SceneLoadedEvent &>(event));
+  }
+
+  return false;
+}
+
+void TransformSystem::update_transforms()
+{
+  const auto scene = scene_.lock();
+  if (!scene)
+  {
+    return;
+  }
+
+  if (!is_order_valid_ || hierarchy_version_ != scene->hierarchy_version())
+  {
+    build_hierarchy_order(*scene);
+  }
+  else if (!scene->added_transforms_.empty() ||
+           !scene->removed_transforms_.empty())
+  {
+    patch_hierarchy_order(*scene);
+  }
+
+  // the storage and the buffer do not change size while the jobs run, so
+  // they can be used from them
+  auto &storage        = scene->registry_.storage<TransformComponent>();
+  auto &world_matrices = scene->world_matrices_;
+
+  const auto update_range = [&](std::size_t first, std::size_t last)
+  {
+    for (std::size_t i{first}; i < last; ++i)
+    {
+      if (entities_[i] == entt::null)
+      {
+        is_changed_[i] = 0;
+        continue;
+      }
+      const auto &transform_component = storage.get(entities_[i]);
+      const auto  parent              = parents_[i];
+      is_changed_[i] = transform_component.is_dirty() ||
+                       (parent != no_parent && is_changed_[parent]);
+      if (is_changed_[i])
+      {
+        local_transforms_.set(i,
+                              transform_component.position(),
+                              transform_component.rotation_quat(),
+                              transform_component.scale());
+      }
+    }
+
+    // runs of changed transforms get composed with the vector kernel
+    auto run_first{first};
+    while (run_first < last)
+    {
+      if (!is_changed_[run_first])
+      {
+        ++run_first;
+        continue;
+      }
+      auto run_last{run_first + 1};
+      while (run_last < last && is_changed_[run_last])
+      {
+        ++run_last;
+      }
+      math::compose_transform_matrices(local_transforms_.arrays(run_first),
+                                       run_last - run_first,
+                                       local_matrices_.data() + run_first);
+      run_first = run_last;
+    }
+
+    for (std::size_t i{first}; i < last; ++i)
+    {
+      if (!is_changed_[i])
+      {
+        continue;
+      }
+      // the parents are in a previous level, which is already updated.
+      // Patched entities may not be at their place in the storage, so the
+      // indices are looked up
+      const auto parent = parents_[i];
+      const auto world_matrix =
+          parent == no_parent
+              ? local_matrices_[i]
+              : world_matrices.get(storage.index(entities_[parent])) *
+                    local_matrices_[i];
+      world_matrices.set(storage.index(entities_[i]), world_matrix);
+      storage.get(entities_[i]).clear_dirty();
+    }
+  };
+
+  // the levels depend on each other, the entities of a level do not
+  const auto job_system = Engine::instance()->job_system();
+  for (std::size_t level{0}; level + 1 < levels_.size(); ++level)
+  {
+    const auto first = levels_[level];
+    const auto last  = levels_[level + 1];
+    if (job_system && last - first >= parallel_level_size)
+    {
+      job_system->parallel_for(first, last, chunk_size, update_range);
+      continue;
+    }
+    update_range(first, last);
+  }
+}
+
+void TransformSystem::build_hierarchy_order(Scene &scene)
+{
+  DC_PROFILE_SCOPE("TransformSystem::build_hierarchy_order()");
+
+  auto &registry = scene.registry_;
+  entities_.clear();
+  parents_.clear();
+  indices_.clear();
+  levels_.clear();
+  removed_count_ = 0;
+  // the order gets built from all entities of the registry
+  scene.added_transforms_.clear();
+  scene.removed_transforms_.clear();
+
+  const auto is_transform = [&](entt::entity entity)
+  {
+    return entity != entt::null && registry.valid(entity) &&
+           registry.all_of<TransformComponent, RelationshipComponent>(entity);
+  };
+  const auto add_entity = [&](entt::entity entity, std::uint32_t parent)
+  {
+    // broken links must not add an entity twice
+    const auto index = static_cast<std::uint32_t>(entities_.size());
+    if (!indices_.emplace(entity, index).second)
+    {
+      return false;
+    }
+    entities_.push_back(entity);
+    parents_.push_back(parent);
+    return true;
+  };
+  // adds the children of the last level as new level until no children are
+  // left
+  const auto add_levels = [&](std::size_t level_first)
+  {
+    while (level_first < entities_.size())
+    {
+      const auto level_last = entities_.size();
+      levels_.push_back(level_first);
+      for (auto i{level_first}; i < level_last; ++i)
+      {
+        auto child = registry.get<RelationshipComponent>(entities_[i])
+                         .first_child_.entity_handle();
+        while (is_transform(child) &&
+               add_entity(child, static_cast<std::uint32_t>(i)))
+        {
+          child = registry.get<RelationshipComponent>(child)
+                      .next_sibling_.entity_handle();
+        }
+      }
+      level_first = level_last;
+    }
+  };
+
+  auto view = registry.view<TransformComponent, RelationshipComponent>();
+  for (const auto entity : view)
+  {
+    if (!is_transform(
+            view.get<RelationshipComponent>(entity).parent_.entity_handle()))
+    {
+      add_entity(entity, no_parent);
+    }
+  }
+  add_levels(0);
+
+  // entities that are not linked by their parent are treated as roots
+  const auto unlinked_first = entities_.size();
+  for (const auto entity : view)
+  {
+    if (!indices_.contains(entity))
+    {
+      add_entity(entity, no_parent);
+    }
+  }
+  add_levels(unlinked_first);
+  levels_.push_back(entities_.size());
+
+  // sorting does not signal, so the world matrices get moved along
+  const auto &storage = registry.storage<TransformComponent>();
+  const std::vector<entt::entity> storage_entities(
+      storage.data(),
+      storage.data() + storage.size());
+  const auto world_matrices = scene.world_matrices_;
+
+  // the world matrices get updated in this order, so parents and children
+  // are close to each other in memory
+  registry.sort<TransformComponent>(
+      [&](const entt::entity lhs, const entt::entity rhs)
+      {
+        const auto lhs_iter = indices_.find(lhs);
+        const auto rhs_iter = indices_.find(rhs);
+        const auto lhs_index =
+            lhs_iter != indices_.end() ? lhs_iter->second : no_parent;
+        const auto rhs_index =
+            rhs_iter != indices_.end() ? rhs_iter->second : no_parent;
+        return lhs_index < rhs_index;
+      });
+  for (std::size_t i{0}; i < storage_entities.size(); ++i)
+  {
+    scene.world_matrices_.set(storage.index(storage_entities[i]),
+                              world_matrices.get(i));
+  }
+
+  is_changed_.assign(entities_.size(), 0);
+  local_transforms_.resize(entities_.size());
+  local_matrices_.resize(entities_.size());
+  is_order_valid_    = true;
+  hierarchy_version_ = scene.hierarchy_version();
+}
+
+void TransformSystem::patch_hierarchy_order(Scene &scene)
+{
+  DC_PROFILE_SCOPE("TransformSystem::patch_hierarchy_order()");
+
+  auto &registry = scene.registry_;
+
+  // removed entities had no children, so nothing references their index
+  for (const auto entity : scene.removed_transforms_)
+  {
+    const auto iter = indices_.find(entity);
+    if (iter == indices_.end())
+    {
+      continue;
+    }
+    entities_[iter->second] = entt::null;
+    indices_.erase(iter);
+    ++removed_count_;
+  }
+  scene.removed_transforms_.clear();
+
+  // added entities have no parent, so they can join the last level
+  for (const auto entity : scene.added_transforms_)
+  {
+    if (!registry.valid(entity) ||
+        !registry.all_of<TransformComponent, RelationshipComponent>(entity) ||
+        indices_.contains(entity))
+    {
+      continue;
+    }
+    indices_.emplace(entity, static_cast<std::uint32_t>(entities_.size()));
+    entities_.push_back(entity);
+    parents_.push_back(no_parent);
+    is_changed_.push_back(0);
+  }
+  scene.added_transforms_.clear();
+
+  if (levels_.size() < 2)
+  {
+    levels_.assign({0, entities_.size()});
+  }
+  else
+  {
+    levels_.back() = entities_.size();
+  }
+  local_transforms_.resize(entities_.size());
+  local_matrices_.resize(entities_.size());
+
+  // compact the order once the removed entities take up a noticeable part
+  if (removed_count_ * 4 > entities_.size())
+  {
+    build_hierarchy_order(scene);
+  }
+}
+
+void TransformSystem::on_scene_loaded(const SceneLoadedEvent &event)
+{
+  scene_          = event.scene_;
+  is_order_valid_ = false;
+}
+
+} // namespace dc
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "aligned_allocator.hpp"
+#include "flat_hash_map.hpp"
+#include "math.hpp"
+#include "scene.hpp"
+#include "scene_events.hpp"
+#include "system.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace dc
+{
+
+/**
+ * Updates the world matrices of all transforms that changed since the last
+ * update, together with their descendants. The entities are kept in
+ * hierarchy order, one level of depth after another, and the transform
+ * storage of the scene is sorted the same way. The order only gets rebuilt
+ * when parent links change, entities without links get patched into it.
+ * Local transforms get composed into matrices with
+ * math::compose_transform_matrices() and the world matrices are written to
+ * the dense buffer of the scene, which is indexed like the sorted storage.
+ * Large levels get updated in parallel. Runs in update() before physics and
+ * again in render(), so that the transforms written by physics are applied
+ * before rendering.
+ */
+class TransformSystem : public System
+{
+public:
+  void init() override;
+  void update(float delta_time) override;
+  void render(SceneRenderInfo &scene_render_info,
+              ViewRenderInfo  &view_render_info) override;
+
+  bool on_event(const Event &event) override;
+
+  const char  *name() const override;
+  SystemAccess access(SystemPhase phase) const override;
+
+private:
+  std::weak_ptr<Scene> scene_{};
+
+  // hierarchy version of the scene the order got built for
+  bool          is_order_valid_{false};
+  std::uint64_t hierarchy_version_{0};
+
+  // parents come before their children. Removed entities leave a null
+  // entity behind until the next rebuild
+  std::vector<entt::entity>                entities_;
+  std::vector<std::uint32_t>               parents_;
+  FlatHashMap<entt::entity, std::uint32_t> indices_;
+  std::size_t                              removed_count_{0};
+  // first index of every level, followed by the end of the last level
+  std::vector<std::size_t> levels_;
+  // whether the world matrix changed in the current update
+  std::vector<std::uint8_t> is_changed_;
+
+  // dense copies indexed like the entities. The local transforms of changed
+  // entities get gathered, so that they can be composed as vectors
+  math::TrsBuffer          local_transforms_;
+  AlignedVector<glm::mat4> local_matrices_;
+
+  void update_transforms();
+  void build_hierarchy_order(Scene &scene);
+  void patch_hierarchy_order(Scene &scene);
+
+  void on_scene_loaded(const SceneLoadedEvent &event);
+};
+
+} // namespace dc
@@ -0,0 +1,404 @@
+#include "asset_archive.hpp"
+#include "asset_cache.hpp"
+#include "asset_handle.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+constexpr std::size_t assets_count{64};
+constexpr std::size_t asset_size{1024};
+constexpr std::size_t threads_count{8};
+
+std::string asset_id(std::size_t index)
+{
+  return "asset_" + std::to_string(index) + ".test";
+}
+
+/**
+ * Asset that becomes ready once it got created on the main thread. Checks
+ * that it got the bytes of its own file.
+ */
+class TestAssetHandle : public dc::AssetHandle
+{
+public:
+  using dc::AssetHandle::AssetHandle;
+
+  bool is_ready() const override { return is_ready_; }
+
+  void load(const dc::AssetData &asset_data) override
+  {
+    const auto expected_value =
+        static_cast<std::uint8_t>(std::hash<std::string>{}(asset().id()));
+    is_data_valid_ = asset_data.size_ == asset_size &&
+                     std::all_of(asset_data.data_,
+                                 asset_data.data_ + asset_data.size_,
+                                 [expected_value](std::uint8_t value)
+                                 { return value == expected_value; });
+  }
+
+  void create() override
+  {
+    if (is_data_valid_)
+    {
+      set_memory_usage(asset_size, 0);
+      is_ready_ = true;
+    }
+  }
+
+private:
+  std::atomic<bool> is_data_valid_{false};
+  std::atomic<bool> is_ready_{false};
+};
+
+/**
+ * Asset cache that reads from an archive with the test assets. Counts how
+ * often every asset got constructed.
+ */
+class TestAssetCache
+{
+public:
+  TestAssetCache()
+  {
+    directory_ = std::filesystem::temp_directory_path() /
+                 ("discite_asset_cache_test_" +
+                  std::to_string(std::random_device{}()));
+    std::filesystem::create_directories(directory_);
+    for (std::size_t i{0}; i < assets_count; ++i)
+    {
+      const auto        id = asset_id(i);
+      const std::string data(
+          asset_size,
+          static_cast<char>(std::hash<std::string>{}(id)));
+      std::ofstream file{directory_ / id, std::ios::binary};
+      file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+    const auto archive_path = directory_ / "assets.dcpak";
+    dc::write_asset_archive(directory_, {".test"}, archive_path);
+
+    asset_cache_.init();
+    asset_cache_.open_asset_archive(archive_path);
+    asset_cache_.register_asset_loader(
+        ".test",
+        [this](const std::filesystem::path &, const dc::Asset &asset)
+        {
+          {
+            std::lock_guard lock{mutex_};
+            ++constructed_counts_[asset.id()];
+          }
+          // widen the window in which other threads request the same asset
+          std::this_thread::sleep_for(std::chrono::microseconds{200});
+          return std::make_shared<TestAssetHandle>(asset);
+        });
+    asset_cache_.register_asset_loader(
+        ".fail",
+        [](const std::filesystem::path &,
+           const dc::Asset &) -> std::shared_ptr<dc::AssetHandle>
+        {
+          std::this_thread::sleep_for(std::chrono::microseconds{200});
+          throw std::runtime_error{"Loader failed"};
+        });
+  }
+
+  ~TestAssetCache()
+  {
+    std::error_code error_code{};
+    std::filesystem::remove_all(directory_, error_code);
+  }
+
+  dc::AssetCache &asset_cache() { return asset_cache_; }
+
+  std::map<std::string, std::size_t> constructed_counts()
+  {
+    std::lock_guard lock{mutex_};
+    return constructed_counts_;
+  }
+
+  /// Creates loaded assets until the function returns true
+  template <typename TFunction> bool update_until(TFunction function)
+  {
+    const auto timeout =
+        std::chrono::steady_clock::now() + std::chrono::seconds{10};
+    while (!function())
+    {
+      if (std::chrono::steady_clock::now() > timeout)
+      {
+        return false;
+      }
+      asset_cache_.update();
+      std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    return true;
+  }
+
+private:
+  std::filesystem::path              directory_;
+  dc::AssetCache                     asset_cache_;
+  std::mutex                         mutex_;
+  std::map<std::string, std::size_t> constructed_counts_;
+};
+
+} // namespace
+
+TEST_CASE("AssetCache shares one handle between concurrent loads",
+          "[asset_cache]")
+{
+  TestAssetCache test_asset_cache;
+  auto          &asset_cache = test_asset_cache.asset_cache();
+
+  // every thread requests every asset a few times in its own order
+  std::vector<std::vector<std::shared_ptr<dc::AssetHandle>>> thread_handles(
+      threads_count);
+  std::vector<std::thread> threads;
+  for (std::size_t i{0}; i < threads_count; ++i)
+  {
+    threads.emplace_back(
+        [&, i]()
+        {
+          std::vector<std::size_t> indices;
+          for (std::size_t j{0}; j < assets_count * 4; ++j)
+          {
+            indices.push_back(j % assets_count);
+          }
+          std::shuffle(indices.begin(), indices.end(), std::mt19937{i});
+
+          auto &handles = thread_handles[i];
+          handles.resize(assets_count);
+          for (const auto index : indices)
+          {
+            auto asset_handle =
+                asset_cache.load_asset(dc::Asset{asset_id(index)},
+                                       dc::AssetLoadMode::Async);
+            if (!handles[index])
+            {
+              handles[index] = asset_handle;
+            }
+            else if (handles[index] != asset_handle)
+            {
+              // gets caught by the checks below
+              handles[index] = nullptr;
+            }
+          }
+        });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  const auto constructed_counts = test_asset_cache.constructed_counts();
+  REQUIRE(constructed_counts.size() == assets_count);
+  for (const auto &[id, count] : constructed_counts)
+  {
+    INFO(id);
+    REQUIRE(count == 1);
+  }
+  for (std::size_t i{0}; i < assets_count; ++i)
+  {
+    for (const auto &handles : thread_handles)
+    {
+      REQUIRE(handles[i]);
+      REQUIRE(handles[i] == thread_handles[0][i]);
+    }
+  }
+
+  REQUIRE(test_asset_cache.update_until(
+      [&]()
+      {
+        return std::all_of(thread_handles[0].begin(),
+                           thread_handles[0].end(),
+                           [](const auto &asset_handle)
+                           { return asset_handle->is_ready(); });
+      }));
+
+  const auto stats = asset_cache.stats();
+  REQUIRE(stats.misses_ == assets_count);
+  REQUIRE(stats.hits_ == threads_count * assets_count * 4 - assets_count);
+  REQUIRE(stats.total_.count_ == assets_count);
+}
+
+TEST_CASE("AssetCache lets concurrent loads retry after a failed loader",
+          "[asset_cache]")
+{
+  TestAssetCache test_asset_cache;
+  auto          &asset_cache = test_asset_cache.asset_cache();
+
+  std::atomic<std::size_t> failed_count{0};
+  std::vector<std::thread> threads;
+  for (std::size_t i{0}; i < threads_count; ++i)
+  {
+    threads.emplace_back(
+        [&]()
+        {
+          try
+          {
+            asset_cache.load_asset(dc::Asset{"broken.fail"},
+                                   dc::AssetLoadMode::Async);
+          }
+          catch (const std::runtime_error &)
+          {
+            ++failed_count;
+          }
+        });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  // waiters get the exception of the loader and nothing stays cached
+  REQUIRE(failed_count == threads_count);
+  REQUIRE_THROWS_AS(asset_cache.load_asset(dc::Asset{"broken.fail"},
+                                           dc::AssetLoadMode::Sync),
+                    std::runtime_error);
+  REQUIRE(asset_cache.stats().total_.count_ == 0);
+}
+
+TEST_CASE("AssetCache wakes synchronous loads of unreadable assets",
+          "[asset_cache]")
+{
+  TestAssetCache test_asset_cache;
+  auto          &asset_cache = test_asset_cache.asset_cache();
+
+  // the data gets read on a loader thread, the synchronous load waits for it
+  const dc::Asset asset{"missing.test"};
+  const auto      async_handle =
+      asset_cache.load_asset(asset, dc::AssetLoadMode::Async);
+  const auto sync_handle =
+      asset_cache.load_asset(asset, dc::AssetLoadMode::Sync);
+
+  REQUIRE(sync_handle == async_handle);
+  REQUIRE(!sync_handle->is_ready());
+}
+
+TEST_CASE("AssetCache evicts only assets that are not referenced",
+          "[asset_cache]")
+{
+  TestAssetCache test_asset_cache;
+  auto          &asset_cache = test_asset_cache.asset_cache();
+
+  constexpr std::size_t resident_assets_count{16};
+  constexpr std::size_t held_handles_count{4};
+  asset_cache.set_memory_budget(resident_assets_count * asset_size);
+
+  // the workers keep a few handles alive and check that loading them again
+  // gives the same handle, while the main thread evicts and loads
+  // synchronously
+  std::atomic<std::size_t> finished_count{0};
+  std::atomic<std::size_t> replaced_count{0};
+  std::vector<std::thread> threads;
+  for (std::size_t i{0}; i < threads_count; ++i)
+  {
+    threads.emplace_back(
+        [&, i]()
+        {
+          using HeldHandle =
+              std::pair<std::size_t, std::shared_ptr<dc::AssetHandle>>;
+
+          std::mt19937                               random{i};
+          std::uniform_int_distribution<std::size_t> distribution{
+              0,
+              assets_count - 1};
+          std::vector<HeldHandle> held_handles;
+          for (std::size_t j{0}; j < 2000; ++j)
+          {
+            const auto index = distribution(random);
+            const auto asset_handle =
+                asset_cache.load_asset(dc::Asset{asset_id(index)},
+                                       dc::AssetLoadMode::Async);
+            for (const auto &[held_index, held_handle] : held_handles)
+            {
+              if (held_index == index && held_handle != asset_handle)
+              {
+                ++replaced_count;
+              }
+            }
+
+            held_handles.emplace_back(index, asset_handle);
+            if (held_handles.size() > held_handles_count)
+            {
+              held_handles.erase(held_handles.begin());
+            }
+          }
+          ++finished_count;
+        });
+  }
+
+  std::mt19937                               random{threads_count};
+  std::uniform_int_distribution<std::size_t> distribution{0,
+                                                          assets_count - 1};
+  while (finished_count < threads_count)
+  {
+    const auto asset_handle =
+        asset_cache.load_asset(dc::Asset{asset_id(distribution(random))},
+                               dc::AssetLoadMode::Sync);
+    REQUIRE(asset_handle->is_ready());
+    asset_cache.update();
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  REQUIRE(replaced_count == 0);
+
+  // once nothing references the assets anymore they get evicted down to the
+  // budget
+  REQUIRE(test_asset_cache.update_until(
+      [&]()
+      {
+        const auto stats = asset_cache.stats();
+        return stats.total_.cpu_size_ <= resident_assets_count * asset_size;
+      }));
+  REQUIRE(asset_cache.stats().evictions_ > 0);
+}
+
+TEST_CASE("AssetArchive rejects ids outside of the archive", "[asset_cache]")
+{
+  const auto directory = std::filesystem::temp_directory_path() /
+                         ("discite_asset_archive_test_" +
+                          std::to_string(std::random_device{}()));
+  std::filesystem::create_directories(directory);
+  {
+    std::ofstream file{directory / asset_id(0), std::ios::binary};
+    file << "payload";
+  }
+  const auto archive_path = directory / "assets.dcpak";
+  dc::write_asset_archive(directory, {".test"}, archive_path);
+  REQUIRE(std::make_shared<dc::AssetArchive>(archive_path)->find(asset_id(0)));
+
+  // point the id of the entry past the end of the file
+  {
+    std::fstream file{archive_path,
+                      std::ios::binary | std::ios::in | std::ios::out};
+    dc::AssetArchiveHeader header{};
+    file.read(reinterpret_cast<char *>(&header), sizeof(header));
+    const auto id_offset_position =
+        header.entries_offset_ + offsetof(dc::AssetArchiveEntry, id_offset_);
+    const std::uint64_t id_offset{1024 * 1024};
+    file.seekp(static_cast<std::streamoff>(id_offset_position));
+    file.write(reinterpret_cast<const char *>(&id_offset), sizeof(id_offset));
+  }
+  REQUIRE(!std::make_shared<dc::AssetArchive>(archive_path)->find(
+      asset_id(0)));
+
+  std::error_code error_code{};
+  std::filesystem::remove_all(directory, error_code);
+}
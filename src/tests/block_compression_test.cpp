@@ -0,0 +1,191 @@
+#include "block_compression.hpp"
+#include "job_system.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+constexpr std::size_t header_size{24};
+
+std::vector<std::uint8_t> random_bytes(std::size_t size, std::uint32_t seed)
+{
+  std::mt19937                            random{seed};
+  std::uniform_int_distribution<unsigned> distribution{0, 255};
+  std::vector<std::uint8_t>               data(size);
+  for (auto &value : data)
+  {
+    value = static_cast<std::uint8_t>(distribution(random));
+  }
+  return data;
+}
+
+/// Words from a small vocabulary, compresses about like serialized assets
+std::vector<std::uint8_t> text_bytes(std::size_t size)
+{
+  const std::vector<std::string> words{"entity ",
+                                       "transform ",
+                                       "mesh ",
+                                       "material ",
+                                       "albedo_texture ",
+                                       "0.25 ",
+                                       "1.0 "};
+  std::mt19937                               random{3};
+  std::uniform_int_distribution<std::size_t> distribution{0,
+                                                          words.size() - 1};
+  std::vector<std::uint8_t>                  data;
+  while (data.size() < size)
+  {
+    const auto &word = words[distribution(random)];
+    data.insert(data.end(), word.begin(), word.end());
+  }
+  data.resize(size);
+  return data;
+}
+
+std::vector<std::uint8_t> decompress(const std::vector<std::uint8_t> &data,
+                                     dc::JobSystem *job_system = nullptr)
+{
+  std::vector<std::uint8_t> result(
+      dc::decompressed_size(data.data(), data.size()));
+  dc::decompress_blocks(data.data(),
+                        data.size(),
+                        result.data(),
+                        result.size(),
+                        job_system);
+  return result;
+}
+
+void require_round_trip(const std::vector<std::uint8_t> &data)
+{
+  dc::JobSystem job_system{4, "Test"};
+
+  const auto compressed = dc::compress_blocks(data.data(), data.size());
+  REQUIRE(decompress(compressed) == data);
+  REQUIRE(decompress(compressed, &job_system) == data);
+}
+
+} // namespace
+
+TEST_CASE("Block compression round trips small inputs", "[block_compression]")
+{
+  require_round_trip({});
+  for (std::size_t size{1}; size < 20; ++size)
+  {
+    INFO("size " << size);
+    require_round_trip(random_bytes(size, 1));
+    require_round_trip(std::vector<std::uint8_t>(size, 7));
+  }
+}
+
+TEST_CASE("Block compression stores incompressible blocks",
+          "[block_compression]")
+{
+  const auto data       = random_bytes(dc::compression_block_size, 2);
+  const auto compressed = dc::compress_blocks(data.data(), data.size());
+
+  // header, size and checksum of the block, then the data as it is
+  REQUIRE(compressed.size() == header_size + 8 + data.size());
+  require_round_trip(data);
+}
+
+TEST_CASE("Block compression round trips long runs", "[block_compression]")
+{
+  // overlapping matches, match lengths of many length bytes
+  std::vector<std::uint8_t> data(100000, 0);
+  const auto compressed = dc::compress_blocks(data.data(), data.size());
+  REQUIRE(compressed.size() < data.size() / 100);
+  require_round_trip(data);
+
+  // runs of a short pattern, separated by literals that need length bytes
+  data.clear();
+  for (std::size_t i{0}; i < 20; ++i)
+  {
+    const auto literals = random_bytes(15 + i * 40, static_cast<unsigned>(i));
+    data.insert(data.end(), literals.begin(), literals.end());
+    for (std::size_t j{0}; j < 255 + 15 + i; ++j)
+    {
+      data.push_back(static_cast<std::uint8_t>(j % 3));
+    }
+  }
+  require_round_trip(data);
+}
+
+TEST_CASE("Block compression round trips sizes around the block size",
+          "[block_compression]")
+{
+  for (const auto size : {dc::compression_block_size - 1,
+                          dc::compression_block_size,
+                          dc::compression_block_size + 1,
+                          2 * dc::compression_block_size - 1,
+                          2 * dc::compression_block_size,
+                          2 * dc::compression_block_size + 1})
+  {
+    INFO("size " << size);
+    require_round_trip(text_bytes(size));
+
+    // a stored block next to compressed ones
+    auto       data  = text_bytes(size);
+    const auto noise = random_bytes(dc::compression_block_size, 4);
+    std::copy(noise.begin(), noise.begin() + size / 2, data.begin());
+    require_round_trip(data);
+  }
+}
+
+TEST_CASE("Block compression throws on truncated data", "[block_compression]")
+{
+  const auto data       = text_bytes(dc::compression_block_size + 1000);
+  const auto compressed = dc::compress_blocks(data.data(), data.size());
+
+  for (std::size_t size{0}; size < compressed.size(); ++size)
+  {
+    INFO("size " << size);
+    const std::vector<std::uint8_t> truncated(compressed.begin(),
+                                              compressed.begin() + size);
+    REQUIRE_THROWS_AS(decompress(truncated), std::runtime_error);
+  }
+}
+
+TEST_CASE("Block compression throws on flipped bits", "[block_compression]")
+{
+  dc::JobSystem job_system{4, "Test"};
+
+  // one compressed and one stored block
+  auto       data  = text_bytes(dc::compression_block_size + 1000);
+  const auto noise = random_bytes(1000, 5);
+  std::copy(noise.begin(), noise.end(), data.end() - 1000);
+  const auto compressed = dc::compress_blocks(data.data(), data.size());
+
+  // a flipped match offset can point to the same bytes, so the data may
+  // also come out right, but never different. Every byte of the header and
+  // the block table, then a sample of the blocks
+  std::size_t flipped_count{0};
+  std::size_t thrown_count{0};
+  for (std::size_t i{0}; i < compressed.size(); i += i < 64 ? 1 : 61)
+  {
+    ++flipped_count;
+    INFO("byte " << i);
+    auto corrupt = compressed;
+    corrupt[i] ^= static_cast<std::uint8_t>(1u << (i % 8));
+    std::vector<std::uint8_t> result;
+    try
+    {
+      result = decompress(corrupt, i % 2 ? &job_system : nullptr);
+    }
+    catch (const std::runtime_error &)
+    {
+      ++thrown_count;
+      continue;
+    }
+    REQUIRE(result == data);
+  }
+  REQUIRE(thrown_count > flipped_count * 9 / 10);
+}
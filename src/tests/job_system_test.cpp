@@ -0,0 +1,272 @@
+#include "job_system.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+constexpr std::size_t threads_count{4};
+
+/**
+ * Blocks until count threads arrived or the timeout is over. Returns
+ * whether all threads arrived, so tests that need concurrent jobs fail
+ * instead of hanging.
+ */
+bool arrive_and_wait(std::atomic<std::size_t> &arrived_count,
+                     std::size_t               count)
+{
+  ++arrived_count;
+  const auto timeout =
+      std::chrono::steady_clock::now() + std::chrono::seconds{10};
+  while (arrived_count < count)
+  {
+    if (std::chrono::steady_clock::now() > timeout)
+    {
+      return false;
+    }
+    std::this_thread::yield();
+  }
+  return true;
+}
+
+} // namespace
+
+TEST_CASE("JobSystem runs all submitted jobs of a counter", "[job_system]")
+{
+  dc::JobSystem job_system{threads_count, "Test"};
+
+  std::atomic<std::size_t> run_count{0};
+  dc::JobCounter           counter;
+  for (std::size_t i{0}; i < 1000; ++i)
+  {
+    job_system.submit([&run_count]() { ++run_count; }, &counter);
+  }
+  job_system.wait(counter);
+
+  REQUIRE(counter.is_done());
+  REQUIRE(run_count == 1000);
+}
+
+TEST_CASE("JobSystem jobs can submit jobs and wait for them", "[job_system]")
+{
+  dc::JobSystem job_system{threads_count, "Test"};
+
+  std::atomic<std::size_t> run_count{0};
+  dc::JobCounter           counter;
+  for (std::size_t i{0}; i < 100; ++i)
+  {
+    job_system.submit(
+        [&]()
+        {
+          dc::JobCounter nested_counter;
+          for (std::size_t j{0}; j < 10; ++j)
+          {
+            job_system.submit([&run_count]() { ++run_count; },
+                              &nested_counter);
+          }
+          // waiting on a worker runs jobs in the meantime instead of
+          // blocking it
+          job_system.wait(nested_counter);
+          ++run_count;
+        },
+        &counter);
+  }
+  job_system.wait(counter);
+
+  REQUIRE(run_count == 100 * 11);
+}
+
+TEST_CASE("JobSystem idle workers steal jobs of busy workers", "[job_system]")
+{
+  dc::JobSystem job_system{threads_count, "Test"};
+
+  // the jobs go to the deque of the worker that submits them. They can only
+  // all run at the same time if the other workers steal them
+  std::atomic<std::size_t> arrived_count{0};
+  std::atomic<std::size_t> concurrent_count{0};
+  std::mutex               thread_ids_mutex;
+  std::set<std::thread::id> thread_ids;
+  dc::JobCounter           counter;
+  job_system.submit(
+      [&]()
+      {
+        dc::JobCounter nested_counter;
+        for (std::size_t i{0}; i < threads_count; ++i)
+        {
+          job_system.submit(
+              [&]()
+              {
+                {
+                  std::lock_guard lock{thread_ids_mutex};
+                  thread_ids.insert(std::this_thread::get_id());
+                }
+                if (arrive_and_wait(arrived_count, threads_count))
+                {
+                  ++concurrent_count;
+                }
+              },
+              &nested_counter);
+        }
+        job_system.wait(nested_counter);
+      },
+      &counter);
+  job_system.wait(counter);
+
+  REQUIRE(concurrent_count == threads_count);
+  REQUIRE(thread_ids.size() == threads_count);
+}
+
+TEST_CASE("JobSystem accepts jobs from many threads", "[job_system]")
+{
+  dc::JobSystem job_system{threads_count, "Test"};
+
+  std::atomic<std::size_t> run_count{0};
+  std::vector<std::thread> threads;
+  for (std::size_t i{0}; i < 8; ++i)
+  {
+    threads.emplace_back(
+        [&]()
+        {
+          dc::JobCounter counter;
+          for (std::size_t j{0}; j < 500; ++j)
+          {
+            job_system.submit([&run_count]() { ++run_count; }, &counter);
+          }
+          job_system.wait(counter);
+        });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  REQUIRE(run_count == 8 * 500);
+}
+
+TEST_CASE("JobSystem finishes the counter of a throwing job", "[job_system]")
+{
+  dc::JobSystem job_system{threads_count, "Test"};
+
+  std::atomic<std::size_t> run_count{0};
+  dc::JobCounter           counter;
+  job_system.submit([]() { throw std::runtime_error{"Job failed"}; },
+                    &counter);
+  job_system.submit([]() { throw 42; }, &counter);
+  job_system.submit([&run_count]() { ++run_count; }, &counter);
+  job_system.wait(counter);
+
+  REQUIRE(run_count == 1);
+}
+
+TEST_CASE("JobSystem parallel_for visits every index once", "[job_system]")
+{
+  dc::JobSystem job_system{threads_count, "Test"};
+
+  const auto chunk_size = GENERATE(std::size_t{0},
+                                   std::size_t{1},
+                                   std::size_t{7},
+                                   std::size_t{64},
+                                   std::size_t{5000});
+  const auto first      = GENERATE(std::size_t{0}, std::size_t{13});
+  const std::size_t last{first + 1000};
+
+  // Catch2 assertions are not thread safe, so the jobs only count
+  std::vector<std::atomic<int>> visit_counts(last);
+  std::atomic<std::size_t>      empty_chunks_count{0};
+  job_system.parallel_for(first,
+                          last,
+                          chunk_size,
+                          [&](std::size_t chunk_first, std::size_t chunk_last)
+                          {
+                            if (chunk_first >= chunk_last)
+                            {
+                              ++empty_chunks_count;
+                            }
+                            for (auto i{chunk_first}; i < chunk_last; ++i)
+                            {
+                              ++visit_counts[i];
+                            }
+                          });
+
+  REQUIRE(empty_chunks_count == 0);
+  for (std::size_t i{0}; i < last; ++i)
+  {
+    REQUIRE(visit_counts[i] == (i < first ? 0 : 1));
+  }
+}
+
+TEST_CASE("JobSystem parallel_for with an empty range does nothing",
+          "[job_system]")
+{
+  dc::JobSystem job_system{threads_count, "Test"};
+
+  bool is_called{false};
+  job_system.parallel_for(10,
+                          10,
+                          1,
+                          [&](std::size_t, std::size_t) { is_called = true; });
+
+  REQUIRE(!is_called);
+}
+
+TEST_CASE("JobSystem parallel_for can be nested", "[job_system]")
+{
+  dc::JobSystem job_system{threads_count, "Test"};
+
+  std::atomic<std::size_t> sum{0};
+  job_system.parallel_for(
+      0,
+      64,
+      1,
+      [&](std::size_t first, std::size_t last)
+      {
+        for (auto i{first}; i < last; ++i)
+        {
+          job_system.parallel_for(
+              0,
+              1000,
+              10,
+              [&](std::size_t nested_first, std::size_t nested_last)
+              {
+                for (auto j{nested_first}; j < nested_last; ++j)
+                {
+                  sum += j;
+                }
+              });
+        }
+      });
+
+  REQUIRE(sum == 64 * 499500);
+}
+
+TEST_CASE("JobSystem parallel_for rethrows the exception of a chunk",
+          "[job_system]")
+{
+  dc::JobSystem job_system{threads_count, "Test"};
+
+  std::atomic<std::size_t> run_count{0};
+  REQUIRE_THROWS_AS(job_system.parallel_for(
+                        0,
+                        100,
+                        1,
+                        [&](std::size_t first, std::size_t)
+                        {
+                          ++run_count;
+                          if (first == 50)
+                          {
+                            throw std::runtime_error{"Chunk failed"};
+                          }
+                        }),
+                    std::runtime_error);
+  // all other chunks still ran, nothing may reference the stack anymore
+  REQUIRE(run_count == 100);
+}
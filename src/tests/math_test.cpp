@@ -0,0 +1,112 @@
+#include "math.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+struct Transform
+{
+  glm::vec3 position_{0.0f};
+  glm::quat rotation_{1.0f, 0.0f, 0.0f, 0.0f};
+  glm::vec3 scale_{1.0f};
+};
+
+std::vector<Transform> make_transforms(std::size_t count)
+{
+  std::mt19937                          random{42};
+  std::uniform_real_distribution<float> distribution{-10.0f, 10.0f};
+  std::uniform_real_distribution<float> scale_distribution{0.1f, 4.0f};
+
+  std::vector<Transform> transforms(count);
+  for (auto &transform : transforms)
+  {
+    transform.position_ = {distribution(random),
+                           distribution(random),
+                           distribution(random)};
+    transform.rotation_ = glm::normalize(glm::quat{distribution(random),
+                                                   distribution(random),
+                                                   distribution(random),
+                                                   distribution(random)});
+    transform.scale_    = {scale_distribution(random),
+                           scale_distribution(random),
+                           scale_distribution(random)};
+  }
+  return transforms;
+}
+
+/// Composed like TransformComponent does it
+glm::mat4 glm_transform_matrix(const Transform &transform)
+{
+  glm::mat4 transform_matrix{1.0f};
+  transform_matrix = glm::translate(transform_matrix, transform.position_);
+  transform_matrix *= glm::toMat4(transform.rotation_);
+  transform_matrix = glm::scale(transform_matrix, transform.scale_);
+  return transform_matrix;
+}
+
+} // namespace
+
+TEST_CASE("compose_transform_matrices matches glm", "[math]")
+{
+  // covers the vector loops, the scalar remainder and unaligned starts
+  const auto count = static_cast<std::size_t>(GENERATE(range(0, 20)));
+  const auto first = static_cast<std::size_t>(GENERATE(0, 3));
+
+  const auto          transforms = make_transforms(first + count);
+  dc::math::TrsBuffer trs_buffer;
+  trs_buffer.resize(transforms.size());
+  for (std::size_t i{0}; i < transforms.size(); ++i)
+  {
+    trs_buffer.set(i,
+                   transforms[i].position_,
+                   transforms[i].rotation_,
+                   transforms[i].scale_);
+  }
+
+  // the matrix after the last one must not be written
+  const glm::mat4        untouched{-1.0f};
+  std::vector<glm::mat4> matrices(count + 1, untouched);
+  dc::math::compose_transform_matrices(trs_buffer.arrays(first),
+                                       count,
+                                       matrices.data());
+
+  for (std::size_t i{0}; i < count; ++i)
+  {
+    const auto expected = glm_transform_matrix(transforms[first + i]);
+    for (glm::length_t column{0}; column < 4; ++column)
+    {
+      for (glm::length_t row{0}; row < 4; ++row)
+      {
+        INFO("transform " << i << ", column " << column << ", row " << row);
+        REQUIRE(matrices[i][column][row] ==
+                Approx(expected[column][row]).margin(1e-4));
+      }
+    }
+  }
+  REQUIRE(matrices[count] == untouched);
+}
+
+TEST_CASE("AffineMatrixBuffer keeps the matrices", "[math]")
+{
+  const auto                   transforms = make_transforms(17);
+  dc::math::AffineMatrixBuffer matrix_buffer;
+  matrix_buffer.resize(transforms.size());
+  REQUIRE(matrix_buffer.size() == transforms.size());
+  for (std::size_t i{0}; i < transforms.size(); ++i)
+  {
+    matrix_buffer.set(i, glm_transform_matrix(transforms[i]));
+  }
+
+  // growing keeps the stored matrices
+  matrix_buffer.resize(transforms.size() * 2);
+  for (std::size_t i{0}; i < transforms.size(); ++i)
+  {
+    INFO("matrix " << i);
+    REQUIRE(matrix_buffer.get(i) == glm_transform_matrix(transforms[i]));
+  }
+}
@@ -0,0 +1,281 @@
+#include "mesh_optimizer.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+struct Position
+{
+  float x{0.0f};
+  float y{0.0f};
+  float z{0.0f};
+};
+
+struct Vertex
+{
+  Position      position{};
+  std::uint32_t id{0};
+};
+
+using Triangle = std::array<std::uint32_t, 3>;
+
+/**
+ * Grid of columns_count x rows_count vertices in the xy plane with the
+ * triangles in random order, so that the cache has something to optimize
+ */
+void make_grid(std::size_t                 columns_count,
+               std::size_t                 rows_count,
+               std::vector<Vertex>        &vertices,
+               std::vector<std::uint32_t> &indices)
+{
+  vertices.clear();
+  indices.clear();
+  for (std::size_t y{0}; y < rows_count; ++y)
+  {
+    for (std::size_t x{0}; x < columns_count; ++x)
+    {
+      Vertex vertex{};
+      vertex.position.x = static_cast<float>(x);
+      vertex.position.y = static_cast<float>(y);
+      vertex.id         = static_cast<std::uint32_t>(vertices.size());
+      vertices.push_back(vertex);
+    }
+  }
+
+  std::vector<Triangle> triangles;
+  for (std::size_t y{0}; y + 1 < rows_count; ++y)
+  {
+    for (std::size_t x{0}; x + 1 < columns_count; ++x)
+    {
+      const auto i0 = static_cast<std::uint32_t>(y * columns_count + x);
+      const auto i1 = i0 + 1;
+      const auto i2 = static_cast<std::uint32_t>(i0 + columns_count);
+      const auto i3 = i2 + 1;
+      triangles.push_back({i0, i1, i3});
+      triangles.push_back({i0, i3, i2});
+    }
+  }
+  std::shuffle(triangles.begin(), triangles.end(), std::mt19937{42});
+
+  for (const auto &triangle : triangles)
+  {
+    indices.insert(indices.end(), triangle.begin(), triangle.end());
+  }
+}
+
+/**
+ * Triangles as sorted list, every triangle rotated so that it starts with
+ * its smallest index. Keeps the winding, so flipped triangles compare
+ * different.
+ */
+std::vector<Triangle> triangle_set(const std::vector<std::uint32_t> &indices)
+{
+  std::vector<Triangle> triangles;
+  for (std::size_t i{0}; i + 2 < indices.size(); i += 3)
+  {
+    Triangle triangle{indices[i], indices[i + 1], indices[i + 2]};
+    std::rotate(triangle.begin(),
+                std::min_element(triangle.begin(), triangle.end()),
+                triangle.end());
+    triangles.push_back(triangle);
+  }
+  std::sort(triangles.begin(), triangles.end());
+  return triangles;
+}
+
+/// Index buffer in terms of the original vertex ids
+std::vector<std::uint32_t> original_indices(
+    const std::vector<Vertex>        &vertices,
+    const std::vector<std::uint32_t> &indices)
+{
+  std::vector<std::uint32_t> result;
+  for (const auto index : indices)
+  {
+    result.push_back(vertices[index].id);
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("optimize_vertex_cache keeps the triangles", "[mesh_optimizer]")
+{
+  std::vector<Vertex>        vertices;
+  std::vector<std::uint32_t> indices;
+  make_grid(20, 30, vertices, indices);
+  const auto expected_triangles = triangle_set(indices);
+
+  dc::optimize_vertex_cache(indices.data(), indices.size(), vertices.size());
+
+  REQUIRE(triangle_set(indices) == expected_triangles);
+}
+
+TEST_CASE("optimize_overdraw keeps the triangles", "[mesh_optimizer]")
+{
+  std::vector<Vertex>        vertices;
+  std::vector<std::uint32_t> indices;
+  make_grid(20, 30, vertices, indices);
+  dc::optimize_vertex_cache(indices.data(), indices.size(), vertices.size());
+  const auto expected_triangles = triangle_set(indices);
+
+  dc::optimize_overdraw(indices.data(),
+                        indices.size(),
+                        &vertices[0].position.x,
+                        sizeof(Vertex),
+                        vertices.size());
+
+  REQUIRE(triangle_set(indices) == expected_triangles);
+}
+
+TEST_CASE("optimize_vertex_cache lowers the ACMR", "[mesh_optimizer]")
+{
+  std::vector<Vertex>        vertices;
+  std::vector<std::uint32_t> indices;
+  make_grid(40, 40, vertices, indices);
+
+  const auto before =
+      dc::analyze_vertex_cache(indices.data(), indices.size(), vertices.size());
+  dc::optimize_vertex_cache(indices.data(), indices.size(), vertices.size());
+  const auto after =
+      dc::analyze_vertex_cache(indices.data(), indices.size(), vertices.size());
+
+  INFO("ACMR before " << before.acmr_ << ", after " << after.acmr_);
+  REQUIRE(after.acmr_ < before.acmr_ * 0.5f);
+  // a regular grid gets close to one vertex per triangle with a 16 entries
+  // cache
+  REQUIRE(after.acmr_ < 0.8f);
+  REQUIRE(after.atvr_ >= 1.0f);
+}
+
+TEST_CASE("optimize_vertex_fetch returns a valid remap table",
+          "[mesh_optimizer]")
+{
+  std::vector<Vertex>        vertices;
+  std::vector<std::uint32_t> indices;
+  make_grid(10, 10, vertices, indices);
+  // drop the triangles of the last rows, so that some vertices are unused
+  indices.resize(indices.size() / 2);
+  const auto old_indices = indices;
+
+  std::size_t used_count{0};
+  const auto  remap = dc::optimize_vertex_fetch(indices.data(),
+                                               indices.size(),
+                                               vertices.size(),
+                                               used_count);
+
+  REQUIRE(remap.size() == vertices.size());
+  std::vector<bool> is_referenced(vertices.size(), false);
+  for (const auto index : old_indices)
+  {
+    is_referenced[index] = true;
+  }
+  REQUIRE(used_count ==
+          static_cast<std::size_t>(
+              std::count(is_referenced.begin(), is_referenced.end(), true)));
+
+  // used vertices map to a permutation of [0, used_count), unused ones to
+  // UINT32_MAX
+  std::vector<bool> is_mapped(used_count, false);
+  for (std::size_t i{0}; i < vertices.size(); ++i)
+  {
+    INFO("vertex " << i);
+    if (!is_referenced[i])
+    {
+      REQUIRE(remap[i] == UINT32_MAX);
+      continue;
+    }
+    REQUIRE(remap[i] < used_count);
+    REQUIRE(!is_mapped[remap[i]]);
+    is_mapped[remap[i]] = true;
+  }
+
+  // the new indices reference the same vertices in first use order
+  std::uint32_t next_index{0};
+  for (std::size_t i{0}; i < indices.size(); ++i)
+  {
+    REQUIRE(indices[i] == remap[old_indices[i]]);
+    REQUIRE(indices[i] <= next_index);
+    if (indices[i] == next_index)
+    {
+      ++next_index;
+    }
+  }
+}
+
+TEST_CASE("optimize_mesh keeps the mesh and is deterministic",
+          "[mesh_optimizer]")
+{
+  std::vector<Vertex>        vertices;
+  std::vector<std::uint32_t> indices;
+  make_grid(33, 17, vertices, indices);
+  const auto expected_triangles = triangle_set(indices);
+
+  auto       first_vertices = vertices;
+  auto       first_indices  = indices;
+  const auto statistics = dc::optimize_mesh(first_vertices, first_indices);
+
+  REQUIRE(statistics.after_.acmr_ < statistics.before_.acmr_);
+  REQUIRE(first_vertices.size() == vertices.size());
+  REQUIRE(triangle_set(original_indices(first_vertices, first_indices)) ==
+          expected_triangles);
+
+  auto second_vertices = vertices;
+  auto second_indices  = indices;
+  dc::optimize_mesh(second_vertices, second_indices);
+
+  REQUIRE(second_indices == first_indices);
+  for (std::size_t i{0}; i < first_vertices.size(); ++i)
+  {
+    REQUIRE(second_vertices[i].id == first_vertices[i].id);
+  }
+}
+
+TEST_CASE("simplify_mesh reaches the target on a flat grid",
+          "[mesh_optimizer]")
+{
+  std::vector<Vertex>        vertices;
+  std::vector<std::uint32_t> indices;
+  make_grid(27, 61, vertices, indices);
+  REQUIRE(indices.size() == 9360);
+
+  // a flat grid can be simplified without error down to the locked border
+  const std::size_t          target_indices_count{indices.size() / 4};
+  std::vector<std::uint32_t> simplified(indices.size());
+  float                      error{0.0f};
+  const auto                 simplified_count =
+      dc::simplify_mesh(simplified.data(),
+                        indices.data(),
+                        indices.size(),
+                        &vertices[0].position.x,
+                        sizeof(Vertex),
+                        vertices.size(),
+                        target_indices_count,
+                        1e10f,
+                        error);
+  simplified.resize(simplified_count);
+
+  REQUIRE(simplified_count <= target_indices_count);
+  REQUIRE(error < 1e-4f);
+
+  // no triangle got flipped and the area stays the same
+  float area{0.0f};
+  for (std::size_t i{0}; i < simplified.size(); i += 3)
+  {
+    const auto &p0 = vertices[simplified[i + 0]].position;
+    const auto &p1 = vertices[simplified[i + 1]].position;
+    const auto &p2 = vertices[simplified[i + 2]].position;
+    const auto  signed_area =
+        ((p1.x - p0.x) * (p2.y - p0.y) - (p2.x - p0.x) * (p1.y - p0.y)) * 0.5f;
+    REQUIRE(signed_area > 0.0f);
+    area += signed_area;
+  }
+  REQUIRE(area == Approx(26.0f * 60.0f));
+}
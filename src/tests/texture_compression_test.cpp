@@ -0,0 +1,508 @@
+#include "texture_compression.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+using Block = std::array<std::uint8_t, 16 * 4>;
+
+// Reference decoders written after the format specification, independent
+// of the encoders. They decode into 4x4 RGBA8 blocks in row order.
+
+std::array<int, 3> decode_rgb565(std::uint16_t color)
+{
+  const auto r = (color >> 11) & 31;
+  const auto g = (color >> 5) & 63;
+  const auto b = color & 31;
+  return {(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)};
+}
+
+void decode_bc1_block(const std::uint8_t *data, Block &block)
+{
+  const auto color0 = static_cast<std::uint16_t>(data[0] | (data[1] << 8));
+  const auto color1 = static_cast<std::uint16_t>(data[2] | (data[3] << 8));
+  const auto c0     = decode_rgb565(color0);
+  const auto c1     = decode_rgb565(color1);
+
+  std::array<std::array<int, 4>, 4> palette{};
+  for (int c = 0; c < 3; ++c)
+  {
+    palette[0][c] = c0[c];
+    palette[1][c] = c1[c];
+    if (color0 > color1)
+    {
+      palette[2][c] = (2 * c0[c] + c1[c]) / 3;
+      palette[3][c] = (c0[c] + 2 * c1[c]) / 3;
+    }
+    else
+    {
+      palette[2][c] = (c0[c] + c1[c]) / 2;
+      palette[3][c] = 0;
+    }
+  }
+  palette[0][3] = palette[1][3] = palette[2][3] = 255;
+  palette[3][3] = color0 > color1 ? 255 : 0;
+
+  const auto indices = static_cast<std::uint32_t>(data[4]) |
+                       (static_cast<std::uint32_t>(data[5]) << 8) |
+                       (static_cast<std::uint32_t>(data[6]) << 16) |
+                       (static_cast<std::uint32_t>(data[7]) << 24);
+  for (int i = 0; i < 16; ++i)
+  {
+    const auto &color = palette[(indices >> (i * 2)) & 3];
+    for (int c = 0; c < 4; ++c)
+    {
+      block[i * 4 + c] = static_cast<std::uint8_t>(color[c]);
+    }
+  }
+}
+
+void decode_bc4_block(const std::uint8_t *data, int channel, Block &block)
+{
+  const int value0 = data[0];
+  const int value1 = data[1];
+
+  std::array<int, 8> palette{value0, value1};
+  if (value0 > value1)
+  {
+    for (int i = 1; i < 7; ++i)
+    {
+      palette[i + 1] = ((7 - i) * value0 + i * value1) / 7;
+    }
+  }
+  else
+  {
+    for (int i = 1; i < 5; ++i)
+    {
+      palette[i + 1] = ((5 - i) * value0 + i * value1) / 5;
+    }
+    palette[6] = 0;
+    palette[7] = 255;
+  }
+
+  std::uint64_t indices{0};
+  for (int i = 0; i < 6; ++i)
+  {
+    indices |= static_cast<std::uint64_t>(data[2 + i]) << (i * 8);
+  }
+  for (int i = 0; i < 16; ++i)
+  {
+    block[i * 4 + channel] =
+        static_cast<std::uint8_t>(palette[(indices >> (i * 3)) & 7]);
+  }
+}
+
+void decode_bc3_block(const std::uint8_t *data, Block &block)
+{
+  decode_bc1_block(data + 8, block);
+  decode_bc4_block(data, 3, block);
+}
+
+void decode_bc5_block(const std::uint8_t *data, Block &block)
+{
+  block.fill(0);
+  decode_bc4_block(data, 0, block);
+  decode_bc4_block(data + 8, 1, block);
+}
+
+/// Reads bits starting with the least significant one
+class BitReader
+{
+public:
+  explicit BitReader(const std::uint8_t *data) : data_{data} {}
+
+  int read(int bits_count)
+  {
+    int value{0};
+    for (int i = 0; i < bits_count; ++i, ++position_)
+    {
+      value |= ((data_[position_ / 8] >> (position_ % 8)) & 1) << i;
+    }
+    return value;
+  }
+
+private:
+  const std::uint8_t *data_;
+  int                 position_{0};
+};
+
+/// Only decodes mode 6, which is the only mode the encoder writes
+bool decode_bc7_block(const std::uint8_t *data, Block &block)
+{
+  BitReader reader{data};
+  if (reader.read(7) != (1 << 6))
+  {
+    return false;
+  }
+
+  std::array<std::array<int, 4>, 2> endpoints{};
+  for (int c = 0; c < 4; ++c)
+  {
+    endpoints[0][c] = reader.read(7);
+    endpoints[1][c] = reader.read(7);
+  }
+  const auto p_bit0 = reader.read(1);
+  const auto p_bit1 = reader.read(1);
+  for (int c = 0; c < 4; ++c)
+  {
+    endpoints[0][c] = (endpoints[0][c] << 1) | p_bit0;
+    endpoints[1][c] = (endpoints[1][c] << 1) | p_bit1;
+  }
+
+  static constexpr std::array<int, 16> weights{
+      0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+  for (int i = 0; i < 16; ++i)
+  {
+    const auto index = reader.read(i == 0 ? 3 : 4);
+    for (int c = 0; c < 4; ++c)
+    {
+      block[i * 4 + c] = static_cast<std::uint8_t>(
+          ((64 - weights[index]) * endpoints[0][c] +
+           weights[index] * endpoints[1][c] + 32) >>
+          6);
+    }
+  }
+  return true;
+}
+
+/// Root mean square error of the channels in [first_channel, last_channel)
+double block_error(const Block &block,
+                   const Block &decoded_block,
+                   int          first_channel,
+                   int          last_channel)
+{
+  double error{0.0};
+  for (int i = 0; i < 16; ++i)
+  {
+    for (int c = first_channel; c < last_channel; ++c)
+    {
+      const double diff = block[i * 4 + c] - decoded_block[i * 4 + c];
+      error += diff * diff;
+    }
+  }
+  return std::sqrt(error / (16 * (last_channel - first_channel)));
+}
+
+Block solid_block(std::uint8_t r,
+                  std::uint8_t g,
+                  std::uint8_t b,
+                  std::uint8_t a)
+{
+  Block block{};
+  for (int i = 0; i < 16; ++i)
+  {
+    block[i * 4 + 0] = r;
+    block[i * 4 + 1] = g;
+    block[i * 4 + 2] = b;
+    block[i * 4 + 3] = a;
+  }
+  return block;
+}
+
+/// Smooth gradient with a bit of noise, like most texture content
+Block gradient_block(std::mt19937 &random)
+{
+  std::uniform_int_distribution<int> start_distribution{0, 255};
+  std::uniform_int_distribution<int> step_distribution{-12, 12};
+  std::uniform_int_distribution<int> noise_distribution{-3, 3};
+
+  std::array<int, 4> start{};
+  std::array<int, 4> step{};
+  for (int c = 0; c < 4; ++c)
+  {
+    start[c] = start_distribution(random);
+    step[c]  = step_distribution(random);
+  }
+
+  Block block{};
+  for (int y = 0; y < 4; ++y)
+  {
+    for (int x = 0; x < 4; ++x)
+    {
+      for (int c = 0; c < 4; ++c)
+      {
+        const auto value =
+            start[c] + step[c] * (x + y) + noise_distribution(random);
+        block[(y * 4 + x) * 4 + c] =
+            static_cast<std::uint8_t>(std::clamp(value, 0, 255));
+      }
+    }
+  }
+  return block;
+}
+
+/// Half of the pixels have one color, the other half another one
+Block two_color_block(std::mt19937 &random)
+{
+  std::uniform_int_distribution<int> distribution{0, 255};
+  std::array<std::uint8_t, 4>        colors[2]{};
+  for (auto &color : colors)
+  {
+    for (auto &value : color)
+    {
+      value = static_cast<std::uint8_t>(distribution(random));
+    }
+  }
+
+  Block block{};
+  for (int i = 0; i < 16; ++i)
+  {
+    const auto &color = colors[(i * 7) % 16 < 8 ? 0 : 1];
+    std::copy(color.begin(), color.end(), block.begin() + i * 4);
+  }
+  return block;
+}
+
+/**
+ * The difference of the two colors sums up to zero, so it is orthogonal to
+ * the gray axis (1, 1, 1)
+ */
+Block orthogonal_two_color_block()
+{
+  Block block{};
+  for (int i = 0; i < 16; ++i)
+  {
+    const std::array<std::uint8_t, 4> color =
+        i % 2 == 0 ? std::array<std::uint8_t, 4>{148, 29, 154, 255}
+                   : std::array<std::uint8_t, 4>{19, 121, 191, 255};
+    std::copy(color.begin(), color.end(), block.begin() + i * 4);
+  }
+  return block;
+}
+
+} // namespace
+
+TEST_CASE("BC1 blocks decode to the original colors", "[texture_compression]")
+{
+  std::array<std::uint8_t, 8> data{};
+  Block                       decoded_block{};
+
+  SECTION("solid colors are exact up to the 565 quantization")
+  {
+    for (const auto &block : {solid_block(0, 0, 0, 255),
+                              solid_block(255, 255, 255, 255),
+                              solid_block(200, 17, 99, 255)})
+    {
+      dc::compress_bc1_block(block.data(), data.data());
+      decode_bc1_block(data.data(), decoded_block);
+      for (int i = 0; i < 16; ++i)
+      {
+        REQUIRE(std::abs(block[i * 4 + 0] - decoded_block[i * 4 + 0]) <= 4);
+        REQUIRE(std::abs(block[i * 4 + 1] - decoded_block[i * 4 + 1]) <= 2);
+        REQUIRE(std::abs(block[i * 4 + 2] - decoded_block[i * 4 + 2]) <= 4);
+        // the encoder always uses the opaque four color mode
+        REQUIRE(decoded_block[i * 4 + 3] == 255);
+      }
+    }
+  }
+
+  SECTION("gradients and two color blocks stay close")
+  {
+    std::mt19937 random{1};
+    for (int i = 0; i < 500; ++i)
+    {
+      const auto block = gradient_block(random);
+      dc::compress_bc1_block(block.data(), data.data());
+      decode_bc1_block(data.data(), decoded_block);
+      REQUIRE(block_error(block, decoded_block, 0, 3) < 10.0);
+    }
+    // the endpoints get moved inwards, which costs a bit on hard edges
+    for (int i = 0; i < 500; ++i)
+    {
+      const auto block = two_color_block(random);
+      dc::compress_bc1_block(block.data(), data.data());
+      decode_bc1_block(data.data(), decoded_block);
+      REQUIRE(block_error(block, decoded_block, 0, 3) < 16.0);
+    }
+  }
+
+  SECTION("colors that differ orthogonal to the gray axis stay close")
+  {
+    const auto block = orthogonal_two_color_block();
+    dc::compress_bc1_block(block.data(), data.data());
+    decode_bc1_block(data.data(), decoded_block);
+    REQUIRE(block_error(block, decoded_block, 0, 3) < 16.0);
+  }
+}
+
+TEST_CASE("BC3 blocks decode to the original colors and alpha",
+          "[texture_compression]")
+{
+  std::array<std::uint8_t, 16> data{};
+  Block                        decoded_block{};
+
+  std::mt19937 random{2};
+  for (int i = 0; i < 500; ++i)
+  {
+    const auto block = gradient_block(random);
+    dc::compress_bc3_block(block.data(), data.data());
+    decode_bc3_block(data.data(), decoded_block);
+    REQUIRE(block_error(block, decoded_block, 0, 3) < 10.0);
+    REQUIRE(block_error(block, decoded_block, 3, 4) < 5.0);
+  }
+
+  // a constant alpha is stored exactly
+  const auto block = solid_block(10, 20, 30, 77);
+  dc::compress_bc3_block(block.data(), data.data());
+  decode_bc3_block(data.data(), decoded_block);
+  for (int i = 0; i < 16; ++i)
+  {
+    REQUIRE(decoded_block[i * 4 + 3] == 77);
+  }
+}
+
+TEST_CASE("BC5 blocks decode to the original red and green channels",
+          "[texture_compression]")
+{
+  std::array<std::uint8_t, 16> data{};
+  Block                        decoded_block{};
+
+  std::mt19937 random{3};
+  for (int i = 0; i < 500; ++i)
+  {
+    for (const auto &block : {gradient_block(random), two_color_block(random)})
+    {
+      dc::compress_bc5_block(block.data(), data.data());
+      decode_bc5_block(data.data(), decoded_block);
+      REQUIRE(block_error(block, decoded_block, 0, 2) < 5.0);
+    }
+  }
+
+  // two values per channel are the endpoints and therefore exact
+  std::mt19937 two_color_random{4};
+  const auto   block = two_color_block(two_color_random);
+  dc::compress_bc5_block(block.data(), data.data());
+  decode_bc5_block(data.data(), decoded_block);
+  REQUIRE(block_error(block, decoded_block, 0, 2) == 0.0);
+}
+
+TEST_CASE("BC7 blocks decode to the original colors and alpha",
+          "[texture_compression]")
+{
+  std::array<std::uint8_t, 16> data{};
+  Block                        decoded_block{};
+
+  SECTION("solid colors are exact up to the p-bit rounding")
+  {
+    for (const auto &block : {solid_block(0, 0, 0, 0),
+                              solid_block(255, 255, 255, 255),
+                              solid_block(200, 17, 99, 128)})
+    {
+      dc::compress_bc7_block(block.data(), data.data());
+      REQUIRE(decode_bc7_block(data.data(), decoded_block));
+      REQUIRE(block_error(block, decoded_block, 0, 4) <= 1.0);
+    }
+  }
+
+  SECTION("gradients and two color blocks stay close")
+  {
+    std::mt19937 random{5};
+    for (int i = 0; i < 500; ++i)
+    {
+      const auto block = gradient_block(random);
+      dc::compress_bc7_block(block.data(), data.data());
+      REQUIRE(decode_bc7_block(data.data(), decoded_block));
+      REQUIRE(block_error(block, decoded_block, 0, 4) < 6.0);
+    }
+    for (int i = 0; i < 500; ++i)
+    {
+      const auto block = two_color_block(random);
+      dc::compress_bc7_block(block.data(), data.data());
+      REQUIRE(decode_bc7_block(data.data(), decoded_block));
+      REQUIRE(block_error(block, decoded_block, 0, 4) < 16.0);
+    }
+  }
+
+  SECTION("colors that differ orthogonal to the gray axis stay close")
+  {
+    const auto block = orthogonal_two_color_block();
+    dc::compress_bc7_block(block.data(), data.data());
+    REQUIRE(decode_bc7_block(data.data(), decoded_block));
+    REQUIRE(block_error(block, decoded_block, 0, 4) < 16.0);
+  }
+}
+
+TEST_CASE("Texture levels pad the border blocks", "[texture_compression]")
+{
+  // 5x3 pixels need 2x1 blocks. The pixels outside of the image repeat the
+  // last row and column
+  constexpr int             width{5};
+  constexpr int             height{3};
+  std::vector<std::uint8_t> pixels(width * height * 4);
+  for (int y = 0; y < height; ++y)
+  {
+    for (int x = 0; x < width; ++x)
+    {
+      const auto value = static_cast<std::uint8_t>(x == width - 1 ? 255 : 0);
+      for (int c = 0; c < 4; ++c)
+      {
+        pixels[(y * width + x) * 4 + c] = value;
+      }
+    }
+  }
+
+  const auto level = dc::compress_texture_level(pixels.data(),
+                                                width,
+                                                height,
+                                                dc::TextureFormat::Bc7);
+  REQUIRE(level.size() ==
+          dc::texture_level_size(dc::TextureFormat::Bc7, width, height));
+  REQUIRE(level.size() == 2 * 16);
+
+  Block decoded_block{};
+  REQUIRE(decode_bc7_block(level.data(), decoded_block));
+  REQUIRE(block_error(solid_block(0, 0, 0, 0), decoded_block, 0, 4) <= 1.0);
+  REQUIRE(decode_bc7_block(level.data() + 16, decoded_block));
+  REQUIRE(block_error(solid_block(255, 255, 255, 255), decoded_block, 0, 4) <=
+          1.0);
+}
+
+TEST_CASE("Texture mip chains go down to one pixel", "[texture_compression]")
+{
+  constexpr int             width{16};
+  constexpr int             height{4};
+  std::vector<std::uint8_t> pixels(width * height * 4, 100);
+
+  const auto format = GENERATE(dc::TextureFormat::Rgba8,
+                               dc::TextureFormat::Bc1,
+                               dc::TextureFormat::Bc3,
+                               dc::TextureFormat::Bc5,
+                               dc::TextureFormat::Bc7);
+  const auto levels =
+      dc::encode_texture_levels(pixels.data(), width, height, format);
+
+  // 16x4, 8x2, 4x1, 2x1, 1x1
+  REQUIRE(levels.size() == 5);
+  int level_width{width};
+  int level_height{height};
+  for (const auto &level : levels)
+  {
+    REQUIRE(level.size() ==
+            dc::texture_level_size(format, level_width, level_height));
+    level_width  = std::max(level_width / 2, 1);
+    level_height = std::max(level_height / 2, 1);
+  }
+}
+
+TEST_CASE("Texture levels get downsampled with a box filter",
+          "[texture_compression]")
+{
+  // 2x2 pixels average into one, the odd column of a 3 pixel wide image
+  // gets dropped
+  const std::vector<std::uint8_t> pixels{
+      0,  0,  0,  0,  4,  8,  12, 16, 255, 255, 255, 255,
+      8,  16, 24, 32, 12, 24, 36, 48, 255, 255, 255, 255,
+  };
+  const auto output = dc::downsample_texture_level(pixels.data(), 3, 2);
+
+  REQUIRE(output == std::vector<std::uint8_t>{6, 12, 18, 24});
+}
@@ -0,0 +1,74 @@
+#include "asset_packer_layer.hpp"
+#include "asset_archive.hpp"
+#include "cmd_args_parser.hpp"
+#include "engine.hpp"
+#include "string.hpp"
+
+#include <filesystem>
+#include <stdexcept>
+
+namespace dc
+{
+
+void AssetPackerLayer::add_cmd_line_args(ArgsParser &args_parser)
+{
+  ArgsParser::Option output_option;
+  output_option.name_        = "output";
+  output_option.description_ = "File path of the archive. Defaults to "
+                               "assets.dcpak in the data directory";
+  output_option.type_        = ArgsParser::OptionType::Value;
+  output_option.importance_  = ArgsParser::OptionImportance::Optional;
+  args_parser.add_option(output_option);
+
+  ArgsParser::Option types_option;
+  types_option.name_        = "types";
+  types_option.description_ = "Comma separated asset types to pack";
+  types_option.type_        = ArgsParser::OptionType::Value;
+  types_option.importance_  = ArgsParser::OptionImportance::Optional;
+  args_parser.add_option(types_option);
+}
+
+void AssetPackerLayer::eval_cmd_line_args(ArgsParser &args_parser)
+{
+  output_file_path_ = args_parser.value_as_string("output").value_or("");
+  // scenes and audio get loaded from loose files
+  asset_types_ = args_parser.value_as_string("types").value_or(
+      ".dctex,.dcmat,.dcmesh,.dcskinmesh,.dcenv");
+}
+
+void AssetPackerLayer::init()
+{
+  const auto data_directory = Engine::instance()->base_directory();
+
+  auto archive_file_path = std::filesystem::path{output_file_path_};
+  if (archive_file_path.empty())
+  {
+    archive_file_path = data_directory / "assets.dcpak";
+  }
+
+  try
+  {
+    write_asset_archive(data_directory,
+                        string_split(asset_types_, ","),
+                        archive_file_path);
+  }
+  catch (const std::runtime_error &error)
+  {
+    DC_LOG_ERROR("Error while packing assets {}", error.what());
+  }
+}
+
+void AssetPackerLayer::shutdown() {}
+
+bool AssetPackerLayer::update(float /*delta_time*/)
+{
+  Engine::instance()->set_close(true);
+
+  return false;
+}
+
+bool AssetPackerLayer::render() { return false; }
+
+bool AssetPackerLayer::on_event(const Event & /*event*/) { return false; }
+
+} // namespace dc
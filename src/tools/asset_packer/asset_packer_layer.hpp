@@ -0,0 +1,29 @@
+#pragma once
+
+#include "layer.hpp"
+
+#include <string>
+
+namespace dc
+{
+
+class AssetPackerLayer : public Layer
+{
+public:
+  void add_cmd_line_args(ArgsParser &args_parser) override;
+  void eval_cmd_line_args(ArgsParser &args_parser) override;
+
+  void init() override;
+  void shutdown() override;
+
+  bool update(float delta_time) override;
+  bool render() override;
+
+  bool on_event(const Event &event) override;
+
+private:
+  std::string output_file_path_;
+  std::string asset_types_;
+};
+
+} // namespace dc
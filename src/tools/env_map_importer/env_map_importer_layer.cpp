@@ -74,6 +74,7 @@ bool EnvMapImporter::update(float /*delta_time*/)
 
     AssetDescription          asset_description{};
     EnvironmentMapDescription env_map_description{};
+    asset_description.compression_codec_  = asset_compression_codec();
     env_map_description.env_map_data_     = std::move(hdr_map_data);
     env_map_description.save(base_directory / "envs" /
                                  sanitize_file_path(name_ + ".dcenv"),
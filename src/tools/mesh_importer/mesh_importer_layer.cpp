@@ -1,6 +1,7 @@
 #include "mesh_importer_layer.hpp"
 #include "cmd_args_parser.hpp"
 #include "engine.hpp"
+#include "importer.hpp"
 #include "mesh_asset_importer.hpp"
 #include "skinned_mesh_asset_importer.hpp"
 
@@ -13,12 +14,30 @@ namespace dc
 void MeshImporterLayer::add_cmd_line_args(ArgsParser &args_parser)
 {
   ArgsParser::Option file_path_option;
-  file_path_option.name_        = "file-path";
-  file_path_option.description_ = "File path of mesh to import";
-  file_path_option.type_        = ArgsParser::OptionType::Value;
-  file_path_option.importance_  = ArgsParser::OptionImportance::Required;
+  file_path_option.name_               = "file-path";
+  file_path_option.description_        = "File path of mesh to import";
+  file_path_option.type_               = ArgsParser::OptionType::Value;
+  file_path_option.importance_         = ArgsParser::OptionImportance::Optional;
+  file_path_option.mutually_exclusive_ = {"directory"};
   args_parser.add_option(file_path_option);
 
+  ArgsParser::Option directory_option;
+  directory_option.name_ = "directory";
+  directory_option.description_ =
+      "Import all meshes below the directory in parallel. Only meshes that "
+      "changed since the last import get imported";
+  directory_option.type_               = ArgsParser::OptionType::Value;
+  directory_option.importance_         = ArgsParser::OptionImportance::Optional;
+  directory_option.mutually_exclusive_ = {"file-path", "name"};
+  args_parser.add_option(directory_option);
+
+  ArgsParser::Option force_option;
+  force_option.name_        = "force";
+  force_option.description_ = "Import even if the outputs are up to date";
+  force_option.type_        = ArgsParser::OptionType::NonValue;
+  force_option.importance_  = ArgsParser::OptionImportance::Optional;
+  args_parser.add_option(force_option);
+
   ArgsParser::Option skinned_option;
   skinned_option.name_        = "skinned";
   skinned_option.description_ = "Import the mesh with skinning info";
@@ -26,32 +45,65 @@ void MeshImporterLayer::add_cmd_line_args(ArgsParser &args_parser)
   skinned_option.importance_  = ArgsParser::OptionImportance::Optional;
   args_parser.add_option(skinned_option);
 
+  ArgsParser::Option packed_option;
+  packed_option.name_ = "packed-vertices";
+  packed_option.description_ =
+      "Store compact vertices with quantized normals, tangents and uvs";
+  packed_option.type_       = ArgsParser::OptionType::NonValue;
+  packed_option.importance_ = ArgsParser::OptionImportance::Optional;
+  args_parser.add_option(packed_option);
+
   ArgsParser::Option name_option;
   name_option.name_        = "name";
   name_option.description_ = "Name of the imported mesh";
   name_option.type_        = ArgsParser::OptionType::Value;
-  name_option.importance_  = ArgsParser::OptionImportance::Required;
+  name_option.importance_  = ArgsParser::OptionImportance::Optional;
   args_parser.add_option(name_option);
 }
 
 void MeshImporterLayer::eval_cmd_line_args(ArgsParser &args_parser)
 {
-  file_path_ = args_parser.value_as_string("file-path").value();
-  mesh_name_  = args_parser.value_as_string("name").value();
+  file_path_  = args_parser.value_as_string("file-path").value_or("");
+  directory_  = args_parser.value_as_string("directory").value_or("");
+  mesh_name_  = args_parser.value_as_string("name").value_or("");
   is_skinned_ = args_parser.is_option_set("skinned");
+  is_packed_  = args_parser.is_option_set("packed-vertices");
+  is_forced_  = args_parser.is_option_set("force");
 }
 
 void MeshImporterLayer::init()
 {
-  try
+  const auto vertex_format =
+      is_packed_ ? VertexFormat::Packed : VertexFormat::Float;
+  const auto import = [this, vertex_format](
+                          const std::filesystem::path &file_path,
+                          const std::string           &name)
   {
     if (is_skinned_)
     {
-      import_skinned_mesh_asset(std::filesystem::path{file_path_}, mesh_name_);
+      return import_skinned_mesh_asset(file_path,
+                                       name,
+                                       vertex_format,
+                                       is_forced_);
+    }
+    return import_mesh_asset(file_path, name, vertex_format, is_forced_);
+  };
+
+  try
+  {
+    if (!directory_.empty())
+    {
+      import_directory(std::filesystem::path{directory_},
+                       is_model_file,
+                       import);
+    }
+    else if (file_path_.empty() || mesh_name_.empty())
+    {
+      DC_LOG_ERROR("Either --directory or --file-path and --name are needed");
     }
     else
     {
-      import_mesh_asset(std::filesystem::path{file_path_}, mesh_name_);
+      import(std::filesystem::path{file_path_}, mesh_name_);
     }
   }
   catch (const std::runtime_error &error)
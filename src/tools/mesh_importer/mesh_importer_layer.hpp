@@ -21,8 +21,11 @@ public:
 
 private:
   std::string file_path_;
+  std::string directory_;
   std::string mesh_name_;
   bool        is_skinned_{false};
+  bool        is_packed_{false};
+  bool        is_forced_{false};
 };
 
 } // namespace dc
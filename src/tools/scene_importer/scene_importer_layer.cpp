@@ -1,10 +1,13 @@
 #include "scene_importer_layer.hpp"
 #include "cmd_args_parser.hpp"
 #include "engine.hpp"
+#include "importer.hpp"
+#include "mesh_asset_importer.hpp"
 #include "scene_asset_importer.hpp"
 
 #include <filesystem>
 #include <stdexcept>
+#include <string>
 
 namespace dc
 {
@@ -12,31 +15,82 @@ namespace dc
 void SceneImporterLayer::add_cmd_line_args(ArgsParser &args_parser)
 {
   ArgsParser::Option file_path_option;
-  file_path_option.name_        = "file-path";
-  file_path_option.description_ = "File path of the scene to import";
-  file_path_option.type_        = ArgsParser::OptionType::Value;
-  file_path_option.importance_  = ArgsParser::OptionImportance::Required;
+  file_path_option.name_               = "file-path";
+  file_path_option.description_        = "File path of the scene to import";
+  file_path_option.type_               = ArgsParser::OptionType::Value;
+  file_path_option.importance_         = ArgsParser::OptionImportance::Optional;
+  file_path_option.mutually_exclusive_ = {"directory"};
   args_parser.add_option(file_path_option);
 
+  ArgsParser::Option directory_option;
+  directory_option.name_ = "directory";
+  directory_option.description_ =
+      "Import all scenes below the directory in parallel. Only scenes that "
+      "changed since the last import get imported";
+  directory_option.type_               = ArgsParser::OptionType::Value;
+  directory_option.importance_         = ArgsParser::OptionImportance::Optional;
+  directory_option.mutually_exclusive_ = {"file-path", "name"};
+  args_parser.add_option(directory_option);
+
+  ArgsParser::Option force_option;
+  force_option.name_        = "force";
+  force_option.description_ = "Import even if the outputs are up to date";
+  force_option.type_        = ArgsParser::OptionType::NonValue;
+  force_option.importance_  = ArgsParser::OptionImportance::Optional;
+  args_parser.add_option(force_option);
+
+  ArgsParser::Option cell_size_option;
+  cell_size_option.name_ = "cell-size";
+  cell_size_option.description_ =
+      "Split the meshes of the scene into cells of this size, which get "
+      "streamed around the camera";
+  cell_size_option.type_       = ArgsParser::OptionType::Value;
+  cell_size_option.importance_ = ArgsParser::OptionImportance::Optional;
+  args_parser.add_option(cell_size_option);
+
   ArgsParser::Option name_option;
   name_option.name_        = "name";
   name_option.description_ = "Name of the imported scene";
   name_option.type_        = ArgsParser::OptionType::Value;
-  name_option.importance_  = ArgsParser::OptionImportance::Required;
+  name_option.importance_  = ArgsParser::OptionImportance::Optional;
   args_parser.add_option(name_option);
 }
 
 void SceneImporterLayer::eval_cmd_line_args(ArgsParser &args_parser)
 {
-  file_path_ = args_parser.value_as_string("file-path").value();
-  name_      = args_parser.value_as_string("name").value();
+  file_path_ = args_parser.value_as_string("file-path").value_or("");
+  directory_ = args_parser.value_as_string("directory").value_or("");
+  name_      = args_parser.value_as_string("name").value_or("");
+  is_forced_ = args_parser.is_option_set("force");
+
+  const auto cell_size = args_parser.value_as_string("cell-size");
+  cell_size_           = cell_size ? std::stof(*cell_size) : 0.0f;
 }
 
 void SceneImporterLayer::init()
 {
   try
   {
-    import_scene_asset(std::filesystem::path{file_path_}, name_);
+    if (!directory_.empty())
+    {
+      const auto import = [this](const std::filesystem::path &file_path,
+                                 const std::string           &name)
+      { return import_scene_asset(file_path, name, is_forced_, cell_size_); };
+      import_directory(std::filesystem::path{directory_},
+                       is_model_file,
+                       import);
+    }
+    else if (file_path_.empty() || name_.empty())
+    {
+      DC_LOG_ERROR("Either --directory or --file-path and --name are needed");
+    }
+    else
+    {
+      import_scene_asset(std::filesystem::path{file_path_},
+                         name_,
+                         is_forced_,
+                         cell_size_);
+    }
   }
   catch (const std::runtime_error &error)
   {
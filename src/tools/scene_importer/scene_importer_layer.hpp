@@ -21,7 +21,10 @@ public:
 
 private:
   std::string file_path_;
+  std::string directory_;
   std::string name_;
+  bool        is_forced_{false};
+  float       cell_size_{0.0f};
 };
 
 } // namespace dc